@@ -50,6 +50,11 @@ auto constexpr TMP_OFFSETS_EXT = OFFSET_EXT EXTENSION_TMP;
 #define RESTRICTIONS_FILE_TAG "restrictions"
 #define ROUTING_FILE_TAG "routing"
 #define CROSS_MWM_FILE_TAG "cross_mwm"
+#define ROUTING_SHORTCUTS_FILE_TAG "routing_shortcuts"
+#define ROUTING_LANDMARKS_FILE_TAG "routing_landmarks"
+#define ROUTING_GEOMETRY_FILE_TAG "routing_geometry"
+#define ROUTING_SNAP_FILE_TAG "routing_snap"
+#define ROUTING_SPEED_PROFILES_FILE_TAG "speed_profiles"
 #define FEATURE_OFFSETS_FILE_TAG "offs"
 #define RELATION_OFFSETS_FILE_TAG "rel_offs"
 #define SEARCH_RANKS_FILE_TAG "ranks"
@@ -132,3 +132,23 @@ unsigned char const relation_o5m_data[] = /* 224 */
      0x65, 0x00, 0x00, 0x70, 0x6C, 0x61, 0x63, 0x65, 0x00, 0x74, 0x6F, 0x77, 0x6E, 0x00, 0x00, 0x74, 0x79, 0x70, 0x65,
      0x00, 0x6D, 0x75, 0x6C, 0x74, 0x69, 0x70, 0x6F, 0x6C, 0x79, 0x67, 0x6F, 0x6E, 0x00, 0xFE};
 static_assert(sizeof(relation_o5m_data) == 224, "Size check failed");
+
+// binary data: relation.pbf
+unsigned char const relation_pbf_data[] = /* 288 */
+{0x00, 0x00, 0x00, 0x0D, 0x0A, 0x09, 0x4F, 0x53, 0x4D, 0x48, 0x65, 0x61, 0x64, 0x65, 0x72, 0x18, 0x25, 0x0A, 0x23,
+     0x22, 0x0E, 0x4F, 0x73, 0x6D, 0x53, 0x63, 0x68, 0x65, 0x6D, 0x61, 0x2D, 0x56, 0x30, 0x2E, 0x36, 0x22, 0x0A, 0x44,
+     0x65, 0x6E, 0x73, 0x65, 0x4E, 0x6F, 0x64, 0x65, 0x73, 0x82, 0x01, 0x04, 0x74, 0x65, 0x73, 0x74, 0x00, 0x00, 0x00,
+     0x0C, 0x0A, 0x07, 0x4F, 0x53, 0x4D, 0x44, 0x61, 0x74, 0x61, 0x18, 0xDA, 0x01, 0x10, 0xE0, 0x01, 0x1A, 0xD4, 0x01,
+     0x78, 0x9C, 0xE3, 0xB2, 0xE1, 0x62, 0xE0, 0x62, 0xC9, 0x4B, 0xCC, 0x4D, 0xE5, 0xE2, 0x0A, 0xCF, 0xC8, 0x2C, 0x49,
+     0xCD, 0xC8, 0x2F, 0x2A, 0x4E, 0xE5, 0x62, 0x2D, 0xC8, 0x49, 0x4C, 0x4E, 0xE5, 0x62, 0x29, 0xC9, 0x2F, 0xCF, 0x03,
+     0x92, 0x95, 0x05, 0xA9, 0x5C, 0x3C, 0xB9, 0xA5, 0x39, 0x25, 0x99, 0x05, 0xF9, 0x39, 0x95, 0xE9, 0xF9, 0x79, 0x5C,
+     0xAC, 0xF9, 0xA5, 0x25, 0xA9, 0x45, 0x42, 0x51, 0x42, 0x11, 0x5C, 0xDC, 0xD7, 0xD7, 0x28, 0xEA, 0xB0, 0x80, 0x01,
+     0x93, 0x93, 0xF4, 0xB2, 0x73, 0x1D, 0x87, 0x59, 0x6E, 0x66, 0x7C, 0xFF, 0x26, 0xFA, 0xFB, 0x8C, 0xE0, 0xBF, 0x59,
+     0x4C, 0x87, 0x96, 0xF3, 0x5F, 0x38, 0x2C, 0xF9, 0xE0, 0xAE, 0xD8, 0x5C, 0x4F, 0x2F, 0xD9, 0xF5, 0xE7, 0xFF, 0xB4,
+     0x73, 0xCD, 0x99, 0xA0, 0x72, 0xE7, 0xAC, 0x5C, 0xFF, 0x65, 0xAD, 0xE7, 0x53, 0x13, 0xA6, 0xDF, 0x13, 0xDE, 0x32,
+     0x4F, 0x64, 0x45, 0xBF, 0xD2, 0xB2, 0x6F, 0x92, 0x41, 0xBC, 0x8C, 0x4C, 0xCC, 0x2C, 0x0C, 0x30, 0x20, 0x24, 0x25,
+     0x25, 0xC1, 0xF1, 0x75, 0xE5, 0xFB, 0xFF, 0x60, 0xC0, 0xE8, 0xC4, 0x3D, 0x71, 0x8D, 0x22, 0x23, 0x33, 0x18, 0x48,
+     0x09, 0xA9, 0x2A, 0x29, 0x73, 0x3C, 0x87, 0xCB, 0x09, 0x31, 0x33, 0x32, 0xB3, 0x4A, 0x31, 0x33, 0xB1, 0xB0, 0x39,
+     0x31, 0xB1, 0x33, 0x78, 0xB1, 0x4C, 0x5D, 0xA3, 0xE8, 0x18, 0xC4, 0xC4, 0xC8, 0xD0, 0xC1, 0x98, 0x02, 0x00, 0x80,
+     0x0E, 0x4D, 0xDD};
+static_assert(sizeof(relation_pbf_data) == 288, "Size check failed");
@@ -8,3 +8,4 @@ extern char const way_xml_data[];
 extern unsigned char const way_o5m_data[175];
 extern char const relation_xml_data[];
 extern unsigned char const relation_o5m_data[224];
+extern unsigned char const relation_pbf_data[288];
@@ -59,3 +59,27 @@ UNIT_TEST(Source_To_Element_check_equivalence)
   for (size_t i = 0; i < elementsO5M.size(); ++i)
     TEST_EQUAL(elementsXML[i], elementsO5M[i], ());
 }
+
+UNIT_TEST(Source_To_Element_check_pbf_equivalence)
+{
+  std::istringstream ss1(relation_xml_data);
+  SourceReader readerXML(ss1);
+
+  std::vector<OsmElement> elementsXML;
+  ProcessOsmElementsFromXML(readerXML, [&elementsXML](OsmElement && e) { elementsXML.push_back(std::move(e)); });
+
+  for (size_t threadsCount : {1, 4})
+  {
+    std::string src(std::begin(relation_pbf_data), std::end(relation_pbf_data));
+    std::istringstream ss2(src);
+    SourceReader readerPbf(ss2);
+
+    std::vector<OsmElement> elementsPbf;
+    ProcessOsmElementsFromPbf(readerPbf, [&elementsPbf](OsmElement && e) { elementsPbf.push_back(std::move(e)); },
+                              threadsCount);
+
+    TEST_EQUAL(elementsXML.size(), elementsPbf.size(), ());
+    for (size_t i = 0; i < elementsPbf.size(); ++i)
+      TEST_EQUAL(elementsXML[i], elementsPbf[i], ());
+  }
+}
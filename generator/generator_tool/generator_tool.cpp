@@ -25,6 +25,7 @@
 #include "generator/routing_index_generator.hpp"
 #include "generator/routing_world_roads_generator.hpp"
 #include "generator/search_index_builder.hpp"
+#include "generator/speed_profiles_builder.hpp"
 #include "generator/statistics.hpp"
 #include "generator/traffic_generator.hpp"
 #include "generator/transit_generator.hpp"
@@ -73,7 +74,7 @@ DEFINE_bool(emit_coasts, false, "Push coasts features from intermediate file to
 
 // Generator settings and paths.
 DEFINE_string(osm_file_name, "", "Input osm area file.");
-DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m].");
+DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m, pbf].");
 DEFINE_string(data_path, "", GetDataPathHelp());
 DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
 DEFINE_string(intermediate_data_path, "", "Path to stored intermediate data.");
@@ -111,6 +112,14 @@ DEFINE_string(addresses_path, "", "Path to addresses directory. If set, adds add
 // Routing.
 DEFINE_bool(make_routing_index, false, "Make sections with the routing information.");
 DEFINE_bool(make_cross_mwm, false, "Make section for cross mwm routing (for dynamic indexed routing).");
+DEFINE_bool(make_routing_shortcuts, false, "Make section with shortcuts for long car routes inside mwm.");
+DEFINE_bool(make_routing_landmarks, false, "Make section with landmarks for pedestrian and bicycle routing.");
+DEFINE_bool(make_routing_geometry, false, "Make section with flat geometry of roads for fast loading.");
+DEFINE_bool(make_routing_snap, false, "Make section with spatial index of roads for snapping of route points.");
+DEFINE_string(speed_profiles_path, "",
+              "Path to directory with csv files of historical speed profiles of road segments, one "
+              "<country>.csv file per mwm. If set, generates a section with speed profiles for car routing "
+              "with departure time.");
 DEFINE_bool(make_transit_cross_mwm, false, "Make section for cross mwm transit routing.");
 DEFINE_bool(make_transit_cross_mwm_experimental, false,
             "Experimental parameter. If set the new version of transit cross-mwm section will be "
@@ -253,7 +262,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
   if (FLAGS_preprocess)
   {
     LOG(LINFO, ("Generating intermediate data ...."));
-    if (!GenerateIntermediateData(genInfo))
+    if (!GenerateIntermediateData(genInfo, threadsCount))
       return EXIT_FAILURE;
   }
 
@@ -283,9 +292,10 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 
   // Load mwm tree only if we need it
   std::unique_ptr<storage::CountryParentGetter> countryParentGetter;
-  if (FLAGS_make_routing_index || FLAGS_make_cross_mwm || FLAGS_make_transit_cross_mwm ||
-      FLAGS_make_transit_cross_mwm_experimental || !FLAGS_uk_postcodes_dataset.empty() ||
-      !FLAGS_us_postcodes_dataset.empty())
+  if (FLAGS_make_routing_index || FLAGS_make_cross_mwm || FLAGS_make_routing_shortcuts ||
+      FLAGS_make_routing_landmarks || FLAGS_make_routing_geometry || FLAGS_make_routing_snap ||
+      FLAGS_make_transit_cross_mwm || FLAGS_make_transit_cross_mwm_experimental ||
+      !FLAGS_uk_postcodes_dataset.empty() || !FLAGS_us_postcodes_dataset.empty())
   {
     countryParentGetter = std::make_unique<storage::CountryParentGetter>();
   }
@@ -522,6 +532,36 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
       }
     }
 
+    if (FLAGS_make_routing_shortcuts || FLAGS_make_routing_landmarks || FLAGS_make_routing_geometry ||
+        FLAGS_make_routing_snap)
+    {
+      if (!countryParentGetter)
+      {
+        // All the mwms should use proper VehicleModels.
+        LOG(LCRITICAL, ("Countries file is needed. Please set countries file name (countries.txt). "
+                        "File must be located in data directory."));
+        return EXIT_FAILURE;
+      }
+
+      if (FLAGS_make_routing_shortcuts)
+        BuildRoutingShortcutsSection(path, dataFile, country, *countryParentGetter);
+      if (FLAGS_make_routing_landmarks)
+        BuildRoutingLandmarksSection(path, dataFile, country, *countryParentGetter);
+      if (FLAGS_make_routing_geometry)
+        BuildRoutingGeometrySection(dataFile, country, *countryParentGetter);
+      if (FLAGS_make_routing_snap)
+        BuildRoutingSnapSection(dataFile, country, *countryParentGetter);
+    }
+
+    if (!FLAGS_speed_profiles_path.empty())
+    {
+      string const profilesFilename = base::JoinPath(FLAGS_speed_profiles_path, country + ".csv");
+      if (!Platform::IsFileExistsByFullPath(profilesFilename))
+        LOG(LINFO, ("No speed profiles for", country));
+      else if (!BuildSpeedProfilesSection(dataFile, profilesFilename))
+        LOG(LCRITICAL, ("Error generating speed profiles section for", country));
+    }
+
     // Check !generate_popular_places to avoid mixing, generate_popular_places stage uses the same wiki flags.
     if (!FLAGS_generate_popular_places && !FLAGS_wikipedia_pages.empty())
     {
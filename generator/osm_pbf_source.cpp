@@ -0,0 +1,486 @@
+#include "generator/osm_pbf_source.hpp"
+
+#include "coding/zlib.hpp"
+
+#include "base/assert.hpp"
+
+#include <iterator>
+#include <string_view>
+
+namespace osm
+{
+namespace
+{
+// Maximum sizes from the format specification.
+uint32_t constexpr kMaxBlobHeaderSize = 64 * 1024;
+uint32_t constexpr kMaxBlobSize = 32 * 1024 * 1024;
+
+// Minimal reader of the protobuf wire format. Only the features used by OSM PBF are supported.
+class ProtoReader
+{
+public:
+  enum WireType : uint8_t
+  {
+    Varint = 0,
+    Fixed64 = 1,
+    LengthDelimited = 2,
+    Fixed32 = 5
+  };
+
+  ProtoReader() = default;
+  ProtoReader(uint8_t const * begin, uint8_t const * end) : m_cur(begin), m_end(end) {}
+  explicit ProtoReader(std::string_view data)
+    : ProtoReader(reinterpret_cast<uint8_t const *>(data.data()),
+                  reinterpret_cast<uint8_t const *>(data.data()) + data.size())
+  {}
+
+  // Moves to the next field. Returns false at the end of the message.
+  bool Next()
+  {
+    if (m_cur == m_end)
+      return false;
+
+    uint64_t const key = ReadVarint();
+    m_field = static_cast<uint32_t>(key >> 3);
+    m_wireType = static_cast<uint8_t>(key & 0x7);
+    return true;
+  }
+
+  uint32_t Field() const { return m_field; }
+
+  uint64_t ReadVarint()
+  {
+    uint64_t res = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+      if (m_cur == m_end)
+        MYTHROW(PbfException, ("Truncated varint."));
+      uint8_t const b = *m_cur++;
+      res |= static_cast<uint64_t>(b & 0x7F) << shift;
+      if ((b & 0x80) == 0)
+        return res;
+    }
+    MYTHROW(PbfException, ("Too long varint."));
+  }
+
+  int64_t ReadSVarint()
+  {
+    uint64_t const v = ReadVarint();
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+  }
+
+  std::string_view ReadBytes()
+  {
+    CheckWireType(LengthDelimited);
+    uint64_t const size = ReadVarint();
+    if (size > static_cast<uint64_t>(m_end - m_cur))
+      MYTHROW(PbfException, ("Truncated length-delimited field", m_field));
+    std::string_view const res(reinterpret_cast<char const *>(m_cur), size);
+    m_cur += size;
+    return res;
+  }
+
+  ProtoReader ReadMessage() { return ProtoReader(ReadBytes()); }
+
+  // Calls |fn| for every value of a packed repeated varint field.
+  template <typename Fn>
+  void ForEachPackedVarint(Fn && fn)
+  {
+    ProtoReader packed = ReadMessage();
+    while (packed.m_cur != packed.m_end)
+      fn(packed.ReadVarint());
+  }
+
+  template <typename Fn>
+  void ForEachPackedSVarint(Fn && fn)
+  {
+    ProtoReader packed = ReadMessage();
+    while (packed.m_cur != packed.m_end)
+      fn(packed.ReadSVarint());
+  }
+
+  void Skip()
+  {
+    switch (m_wireType)
+    {
+    case Varint: ReadVarint(); break;
+    case Fixed64: Advance(8); break;
+    case LengthDelimited: ReadBytes(); break;
+    case Fixed32: Advance(4); break;
+    default: MYTHROW(PbfException, ("Unsupported wire type", m_wireType, "of field", m_field));
+    }
+  }
+
+private:
+  void CheckWireType(WireType type) const
+  {
+    if (m_wireType != type)
+      MYTHROW(PbfException, ("Unexpected wire type", m_wireType, "of field", m_field));
+  }
+
+  void Advance(size_t size)
+  {
+    if (size > static_cast<size_t>(m_end - m_cur))
+      MYTHROW(PbfException, ("Truncated fixed field", m_field));
+    m_cur += size;
+  }
+
+  uint8_t const * m_cur = nullptr;
+  uint8_t const * m_end = nullptr;
+  uint32_t m_field = 0;
+  uint8_t m_wireType = Varint;
+};
+
+class PrimitiveBlockDecoder
+{
+public:
+  explicit PrimitiveBlockDecoder(std::vector<OsmElement> & elements) : m_elements(elements) {}
+
+  void Decode(std::string_view data)
+  {
+    // Block parameters are allowed to follow primitive groups, so read them first.
+    std::vector<std::string_view> groups;
+    ProtoReader block(data);
+    while (block.Next())
+    {
+      switch (block.Field())
+      {
+      case 1: ReadStringTable(block.ReadMessage()); break;
+      case 2: groups.push_back(block.ReadBytes()); break;
+      case 17: m_granularity = static_cast<int32_t>(block.ReadVarint()); break;
+      case 19: m_latOffset = static_cast<int64_t>(block.ReadVarint()); break;
+      case 20: m_lonOffset = static_cast<int64_t>(block.ReadVarint()); break;
+      default: block.Skip();
+      }
+    }
+
+    for (auto const & group : groups)
+      ReadPrimitiveGroup(ProtoReader(group));
+  }
+
+private:
+  void ReadStringTable(ProtoReader table)
+  {
+    while (table.Next())
+    {
+      if (table.Field() == 1)
+        m_strings.push_back(table.ReadBytes());
+      else
+        table.Skip();
+    }
+  }
+
+  void ReadPrimitiveGroup(ProtoReader group)
+  {
+    while (group.Next())
+    {
+      switch (group.Field())
+      {
+      case 1: ReadNode(group.ReadMessage()); break;
+      case 2: ReadDenseNodes(group.ReadMessage()); break;
+      case 3: ReadWay(group.ReadMessage()); break;
+      case 4: ReadRelation(group.ReadMessage()); break;
+      default: group.Skip();
+      }
+    }
+  }
+
+  std::string_view const & GetString(uint64_t index) const
+  {
+    if (index >= m_strings.size())
+      MYTHROW(PbfException, ("String index", index, "is out of string table of size", m_strings.size()));
+    return m_strings[index];
+  }
+
+  double ToDegrees(int64_t offset, int64_t value) const { return 1e-9 * (offset + m_granularity * value); }
+
+  OsmElement & AddElement(OsmElement::EntityType type, int64_t id)
+  {
+    auto & element = m_elements.emplace_back();
+    element.m_type = type;
+    element.m_id = static_cast<uint64_t>(id);
+    return element;
+  }
+
+  void AddTags(OsmElement & element, std::vector<uint32_t> const & keys, std::vector<uint32_t> const & vals)
+  {
+    if (keys.size() != vals.size())
+      MYTHROW(PbfException, ("Keys and values mismatch for", element.m_id));
+    for (size_t i = 0; i < keys.size(); ++i)
+      element.AddTag(GetString(keys[i]), GetString(vals[i]));
+  }
+
+  void ReadNode(ProtoReader node)
+  {
+    int64_t id = 0, lat = 0, lon = 0;
+    std::vector<uint32_t> keys, vals;
+    while (node.Next())
+    {
+      switch (node.Field())
+      {
+      case 1: id = node.ReadSVarint(); break;
+      case 2: node.ForEachPackedVarint([&](uint64_t v) { keys.push_back(static_cast<uint32_t>(v)); }); break;
+      case 3: node.ForEachPackedVarint([&](uint64_t v) { vals.push_back(static_cast<uint32_t>(v)); }); break;
+      case 8: lat = node.ReadSVarint(); break;
+      case 9: lon = node.ReadSVarint(); break;
+      default: node.Skip();
+      }
+    }
+
+    auto & element = AddElement(OsmElement::EntityType::Node, id);
+    element.m_lat = ToDegrees(m_latOffset, lat);
+    element.m_lon = ToDegrees(m_lonOffset, lon);
+    AddTags(element, keys, vals);
+    element.Validate();
+  }
+
+  void ReadDenseNodes(ProtoReader dense)
+  {
+    std::vector<int64_t> ids, lats, lons;
+    std::vector<uint32_t> keysVals;
+    while (dense.Next())
+    {
+      switch (dense.Field())
+      {
+      case 1: dense.ForEachPackedSVarint([&](int64_t v) { ids.push_back(v); }); break;
+      case 8: dense.ForEachPackedSVarint([&](int64_t v) { lats.push_back(v); }); break;
+      case 9: dense.ForEachPackedSVarint([&](int64_t v) { lons.push_back(v); }); break;
+      case 10: dense.ForEachPackedVarint([&](uint64_t v) { keysVals.push_back(static_cast<uint32_t>(v)); }); break;
+      default: dense.Skip();
+      }
+    }
+
+    if (ids.size() != lats.size() || ids.size() != lons.size())
+      MYTHROW(PbfException, ("Inconsistent dense nodes:", ids.size(), lats.size(), lons.size()));
+
+    m_elements.reserve(m_elements.size() + ids.size());
+
+    // Ids and coordinates are delta coded, tags are (key, value)* sequences delimited by 0.
+    int64_t id = 0, lat = 0, lon = 0;
+    size_t kv = 0;
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+      id += ids[i];
+      lat += lats[i];
+      lon += lons[i];
+
+      auto & element = AddElement(OsmElement::EntityType::Node, id);
+      element.m_lat = ToDegrees(m_latOffset, lat);
+      element.m_lon = ToDegrees(m_lonOffset, lon);
+
+      while (kv < keysVals.size() && keysVals[kv] != 0)
+      {
+        if (kv + 1 == keysVals.size())
+          MYTHROW(PbfException, ("Dense node", id, "has a key without value"));
+        element.AddTag(GetString(keysVals[kv]), GetString(keysVals[kv + 1]));
+        kv += 2;
+      }
+      ++kv;  // Skip the delimiter.
+
+      element.Validate();
+    }
+  }
+
+  void ReadWay(ProtoReader way)
+  {
+    int64_t id = 0;
+    std::vector<uint32_t> keys, vals;
+    std::vector<int64_t> refs;
+    while (way.Next())
+    {
+      switch (way.Field())
+      {
+      case 1: id = static_cast<int64_t>(way.ReadVarint()); break;
+      case 2: way.ForEachPackedVarint([&](uint64_t v) { keys.push_back(static_cast<uint32_t>(v)); }); break;
+      case 3: way.ForEachPackedVarint([&](uint64_t v) { vals.push_back(static_cast<uint32_t>(v)); }); break;
+      case 8: way.ForEachPackedSVarint([&](int64_t v) { refs.push_back(v); }); break;
+      default: way.Skip();
+      }
+    }
+
+    auto & element = AddElement(OsmElement::EntityType::Way, id);
+    int64_t ref = 0;
+    for (int64_t const delta : refs)
+    {
+      ref += delta;
+      element.AddNd(static_cast<uint64_t>(ref));
+    }
+    AddTags(element, keys, vals);
+    element.Validate();
+  }
+
+  void ReadRelation(ProtoReader relation)
+  {
+    int64_t id = 0;
+    std::vector<uint32_t> keys, vals, roles;
+    std::vector<int64_t> memberIds;
+    std::vector<uint8_t> types;
+    while (relation.Next())
+    {
+      switch (relation.Field())
+      {
+      case 1: id = static_cast<int64_t>(relation.ReadVarint()); break;
+      case 2: relation.ForEachPackedVarint([&](uint64_t v) { keys.push_back(static_cast<uint32_t>(v)); }); break;
+      case 3: relation.ForEachPackedVarint([&](uint64_t v) { vals.push_back(static_cast<uint32_t>(v)); }); break;
+      case 8: relation.ForEachPackedVarint([&](uint64_t v) { roles.push_back(static_cast<uint32_t>(v)); }); break;
+      case 9: relation.ForEachPackedSVarint([&](int64_t v) { memberIds.push_back(v); }); break;
+      case 10: relation.ForEachPackedVarint([&](uint64_t v) { types.push_back(static_cast<uint8_t>(v)); }); break;
+      default: relation.Skip();
+      }
+    }
+
+    if (roles.size() != memberIds.size() || types.size() != memberIds.size())
+      MYTHROW(PbfException, ("Inconsistent members of relation", id));
+
+    auto & element = AddElement(OsmElement::EntityType::Relation, id);
+    int64_t ref = 0;
+    for (size_t i = 0; i < memberIds.size(); ++i)
+    {
+      ref += memberIds[i];
+      element.AddMember(static_cast<uint64_t>(ref), ToEntityType(types[i]), std::string(GetString(roles[i])));
+    }
+    AddTags(element, keys, vals);
+    element.Validate();
+  }
+
+  static OsmElement::EntityType ToEntityType(uint8_t type)
+  {
+    switch (type)
+    {
+    case 0: return OsmElement::EntityType::Node;
+    case 1: return OsmElement::EntityType::Way;
+    case 2: return OsmElement::EntityType::Relation;
+    default: return OsmElement::EntityType::Unknown;
+    }
+  }
+
+  std::vector<OsmElement> & m_elements;
+  std::vector<std::string_view> m_strings;
+  int64_t m_granularity = 100;
+  int64_t m_latOffset = 0;
+  int64_t m_lonOffset = 0;
+};
+
+void CheckHeaderBlock(std::string_view data)
+{
+  ProtoReader header(data);
+  while (header.Next())
+  {
+    // required_features
+    if (header.Field() == 4)
+    {
+      auto const feature = header.ReadBytes();
+      if (feature != "OsmSchema-V0.6" && feature != "DenseNodes")
+        MYTHROW(PbfException, ("Unsupported required feature:", feature));
+    }
+    else
+    {
+      header.Skip();
+    }
+  }
+}
+
+// Returns the uncompressed content of a Blob message. |buffer| is used as storage when inflating.
+std::string_view UnpackBlob(std::vector<uint8_t> const & data, std::string & buffer)
+{
+  ProtoReader blob(data.data(), data.data() + data.size());
+  std::string_view raw, zlibData;
+  uint64_t rawSize = 0;
+  while (blob.Next())
+  {
+    switch (blob.Field())
+    {
+    case 1: raw = blob.ReadBytes(); break;
+    case 2: rawSize = blob.ReadVarint(); break;
+    case 3: zlibData = blob.ReadBytes(); break;
+    case 4:
+    case 5:
+    case 6:
+    case 7: MYTHROW(PbfException, ("Unsupported blob compression, field", blob.Field()));
+    default: blob.Skip();
+    }
+  }
+
+  if (!zlibData.empty())
+  {
+    if (rawSize > kMaxBlobSize)
+      MYTHROW(PbfException, ("Too big raw blob size:", rawSize));
+
+    buffer.clear();
+    buffer.reserve(rawSize);
+    coding::ZLib::Inflate const inflate(coding::ZLib::Inflate::Format::ZLib);
+    if (!inflate(zlibData.data(), zlibData.size(), std::back_inserter(buffer)) || buffer.size() != rawSize)
+      MYTHROW(PbfException, ("Can't inflate blob of size", zlibData.size()));
+    return buffer;
+  }
+
+  return raw;
+}
+}  // namespace
+
+bool PbfBlobReader::ReadExactly(uint8_t * buffer, size_t size, bool allowEof)
+{
+  size_t read = 0;
+  while (read < size)
+  {
+    size_t const n = m_reader(buffer + read, size - read);
+    if (n == 0)
+      break;
+    read += n;
+  }
+
+  if (read == size)
+    return true;
+  if (read == 0 && allowEof)
+    return false;
+  MYTHROW(PbfException, ("Unexpected end of pbf stream."));
+}
+
+bool PbfBlobReader::Read(Blob & blob)
+{
+  uint8_t sizeBuffer[4];
+  if (!ReadExactly(sizeBuffer, sizeof(sizeBuffer), true /* allowEof */))
+    return false;
+
+  // BlobHeader length is stored in network byte order.
+  uint32_t const headerSize = (uint32_t(sizeBuffer[0]) << 24) | (uint32_t(sizeBuffer[1]) << 16) |
+                              (uint32_t(sizeBuffer[2]) << 8) | uint32_t(sizeBuffer[3]);
+  if (headerSize > kMaxBlobHeaderSize)
+    MYTHROW(PbfException, ("Too big blob header:", headerSize));
+
+  m_headerBuffer.resize(headerSize);
+  ReadExactly(m_headerBuffer.data(), headerSize, false /* allowEof */);
+
+  blob.m_type.clear();
+  uint64_t dataSize = 0;
+  ProtoReader header(m_headerBuffer.data(), m_headerBuffer.data() + m_headerBuffer.size());
+  while (header.Next())
+  {
+    switch (header.Field())
+    {
+    case 1: blob.m_type = header.ReadBytes(); break;
+    case 3: dataSize = header.ReadVarint(); break;
+    default: header.Skip();
+    }
+  }
+
+  if (dataSize > kMaxBlobSize)
+    MYTHROW(PbfException, ("Too big blob:", dataSize));
+
+  blob.m_data.resize(dataSize);
+  ReadExactly(blob.m_data.data(), dataSize, false /* allowEof */);
+  return true;
+}
+
+void DecodePbfBlob(PbfBlobReader::Blob const & blob, std::vector<OsmElement> & elements)
+{
+  std::string buffer;
+  auto const data = UnpackBlob(blob.m_data, buffer);
+
+  if (blob.m_type == "OSMHeader")
+    CheckHeaderBlock(data);
+  else if (blob.m_type == "OSMData")
+    PrimitiveBlockDecoder(elements).Decode(data);
+  // Unknown blob types should be skipped according to the specification.
+}
+}  // namespace osm
@@ -0,0 +1,48 @@
+// See PBF Format definition at https://wiki.openstreetmap.org/wiki/PBF_Format
+#pragma once
+
+#include "generator/osm_element.hpp"
+
+#include "base/exception.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace osm
+{
+DECLARE_EXCEPTION(PbfException, RootException);
+
+// Splits an OSM PBF stream into raw (still compressed) blobs. Reading is sequential and cheap,
+// so the heavy part - inflating and decoding of blobs - may be done by DecodePbfBlob() in parallel.
+class PbfBlobReader
+{
+public:
+  using ReadFunc = std::function<size_t(uint8_t *, size_t)>;
+
+  struct Blob
+  {
+    // Type from BlobHeader: "OSMHeader" or "OSMData".
+    std::string m_type;
+    // Serialized Blob message.
+    std::vector<uint8_t> m_data;
+  };
+
+  explicit PbfBlobReader(ReadFunc reader) : m_reader(std::move(reader)) {}
+
+  // Returns false at the end of the stream. Throws PbfException on truncated input.
+  bool Read(Blob & blob);
+
+private:
+  bool ReadExactly(uint8_t * buffer, size_t size, bool allowEof);
+
+  ReadFunc m_reader;
+  std::vector<uint8_t> m_headerBuffer;
+};
+
+// Inflates |blob| and appends all nodes, ways and relations of an OSMData block to |elements|
+// in the order they are stored in the file. OSMHeader blobs are checked for unsupported
+// required features and produce no elements. Throws PbfException on malformed data.
+void DecodePbfBlob(PbfBlobReader::Blob const & blob, std::vector<OsmElement> & elements);
+}  // namespace osm
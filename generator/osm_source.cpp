@@ -10,6 +10,7 @@
 #include "base/assert.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <memory>
 
@@ -118,6 +119,19 @@ void ProcessOsmElementsFromO5M(SourceReader & stream, std::function<void(OsmElem
   }
 }
 
+void ProcessOsmElementsFromPbf(SourceReader & stream, std::function<void(OsmElement &&)> const & processor,
+                               size_t threadsCount)
+{
+  ProcessorOsmElementsFromPbf processorOsmElementsFromPbf(stream, threadsCount);
+  OsmElement element;
+  while (processorOsmElementsFromPbf.TryRead(element))
+  {
+    processor(std::move(element));
+    // It is safe to use `element` here as `Clear` will restore the state after the move.
+    element.Clear();
+  }
+}
+
 ProcessorOsmElementsFromO5M::ProcessorOsmElementsFromO5M(SourceReader & stream)
   : m_stream(stream)
   , m_dataset([&](uint8_t * buffer, size_t size) { return m_stream.Read(reinterpret_cast<char *>(buffer), size); })
@@ -182,6 +196,52 @@ bool ProcessorOsmElementsFromO5M::TryRead(OsmElement & element)
   return true;
 }
 
+ProcessorOsmElementsFromPbf::ProcessorOsmElementsFromPbf(SourceReader & stream, size_t threadsCount)
+  : m_stream(stream)
+  , m_reader([&](uint8_t * buffer, size_t size) { return m_stream.Read(reinterpret_cast<char *>(buffer), size); })
+  // Keep a few blobs per thread queued so that workers don't wait for the reader.
+  , m_maxBlobsInFlight(2 * std::max(threadsCount, size_t(1)))
+  , m_threadPool(std::max(threadsCount, size_t(1)))
+{}
+
+void ProcessorOsmElementsFromPbf::SubmitBlobs()
+{
+  while (!m_readerIsEnd && m_blocks.size() < m_maxBlobsInFlight)
+  {
+    osm::PbfBlobReader::Blob blob;
+    if (!m_reader.Read(blob))
+    {
+      m_readerIsEnd = true;
+      break;
+    }
+
+    m_blocks.push(m_threadPool.Submit([blob = std::move(blob)]()
+    {
+      std::vector<OsmElement> elements;
+      osm::DecodePbfBlob(blob, elements);
+      return elements;
+    }));
+  }
+}
+
+bool ProcessorOsmElementsFromPbf::TryRead(OsmElement & element)
+{
+  while (m_currentIdx == m_current.size())
+  {
+    SubmitBlobs();
+    if (m_blocks.empty())
+      return false;
+
+    // Decoding exceptions are rethrown here.
+    m_current = m_blocks.front().get();
+    m_blocks.pop();
+    m_currentIdx = 0;
+  }
+
+  element = std::move(m_current[m_currentIdx++]);
+  return true;
+}
+
 ProcessorOsmElementsFromXml::ProcessorOsmElementsFromXml(SourceReader & stream)
   : m_xmlSource([&, this](OsmElement && e) { m_queue.emplace(std::move(e)); })
   , m_parser(stream, m_xmlSource)
@@ -215,7 +275,7 @@ bool ProcessorOsmElementsFromXml::TryRead(OsmElement & element)
 // Generate functions implementations.
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool GenerateIntermediateData(feature::GenerateInfo & info)
+bool GenerateIntermediateData(feature::GenerateInfo & info, size_t threadsCount)
 {
   auto nodes = cache::CreatePointStorageWriter(info.m_nodeStorageType, info.GetCacheFileName(NODES_FILE));
   cache::IntermediateDataWriter cache(*nodes, info);
@@ -234,6 +294,7 @@ bool GenerateIntermediateData(feature::GenerateInfo & info)
   {
   case feature::GenerateInfo::OsmSourceType::XML: ProcessOsmElementsFromXML(reader, processor); break;
   case feature::GenerateInfo::OsmSourceType::O5M: ProcessOsmElementsFromO5M(reader, processor); break;
+  case feature::GenerateInfo::OsmSourceType::PBF: ProcessOsmElementsFromPbf(reader, processor, threadsCount); break;
   }
 
   cache.SaveIndex();
@@ -3,12 +3,16 @@
 #include "generator/generate_info.hpp"
 #include "generator/intermediate_data.hpp"
 #include "generator/osm_o5m_source.hpp"
+#include "generator/osm_pbf_source.hpp"
 #include "generator/osm_xml_source.hpp"
 #include "generator/translator_interface.hpp"
 
 #include "coding/parse_xml.hpp"
 
+#include "base/thread_pool_computational.hpp"
+
 #include <functional>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <queue>
@@ -45,10 +49,12 @@ public:
   uint64_t Pos() const { return m_pos; }
 };
 
-bool GenerateIntermediateData(feature::GenerateInfo & info);
+bool GenerateIntermediateData(feature::GenerateInfo & info, size_t threadsCount = 1);
 
 void ProcessOsmElementsFromO5M(SourceReader & stream, std::function<void(OsmElement &&)> const & processor);
 void ProcessOsmElementsFromXML(SourceReader & stream, std::function<void(OsmElement &&)> const & processor);
+void ProcessOsmElementsFromPbf(SourceReader & stream, std::function<void(OsmElement &&)> const & processor,
+                               size_t threadsCount = 1);
 
 class ProcessorOsmElementsInterface
 {
@@ -72,6 +78,29 @@ private:
   osm::O5MSource::Iterator m_pos;
 };
 
+// Reads blobs sequentially and decodes them on |threadsCount| threads. Elements are returned
+// in the file order.
+class ProcessorOsmElementsFromPbf : public ProcessorOsmElementsInterface
+{
+public:
+  explicit ProcessorOsmElementsFromPbf(SourceReader & stream, size_t threadsCount = 1);
+
+  // ProcessorOsmElementsInterface overrides:
+  bool TryRead(OsmElement & element) override;
+
+private:
+  void SubmitBlobs();
+
+  SourceReader & m_stream;
+  osm::PbfBlobReader m_reader;
+  bool m_readerIsEnd = false;
+  size_t const m_maxBlobsInFlight;
+  std::queue<std::future<std::vector<OsmElement>>> m_blocks;
+  std::vector<OsmElement> m_current;
+  size_t m_currentIdx = 0;
+  base::ComputationalThreadPool m_threadPool;
+};
+
 class ProcessorOsmElementsFromXml : public ProcessorOsmElementsInterface
 {
 public:
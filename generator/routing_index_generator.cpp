@@ -14,6 +14,11 @@
 #include "routing/index_graph_serialization.hpp"
 #include "routing/index_graph_starter_joints.hpp"
 #include "routing/joint_segment.hpp"
+#include "routing/routing_geometry.hpp"
+#include "routing/routing_landmarks.hpp"
+#include "routing/routing_options.hpp"
+#include "routing/routing_shortcuts.hpp"
+#include "routing/routing_snap_index.hpp"
 #include "routing/vehicle_mask.hpp"
 #include "routing/world_graph.hpp"
 
@@ -24,8 +29,12 @@
 #include "routing_common/car_model.hpp"
 #include "routing_common/pedestrian_model.hpp"
 
+#include "indexer/altitude_loader.hpp"
 #include "indexer/feature.hpp"
 #include "indexer/feature_processor.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include "platform/local_country_file.hpp"
 
 #include "coding/files_container.hpp"
 #include "coding/point_coding.hpp"
@@ -53,6 +62,12 @@ using namespace platform;
 using namespace routing;
 using std::string, std::vector;
 
+// Max number of road points in a cell of ROUTING_SHORTCUTS_FILE_TAG section. Smaller cells are
+// faster to build, bigger cells give fewer vertices to the overlay graph.
+size_t constexpr kMaxPointsInShortcutsCell = 10000;
+// Number of landmarks of ROUTING_LANDMARKS_FILE_TAG section for every vehicle type.
+size_t constexpr kRoutingLandmarksCount = 8;
+
 class VehicleMaskBuilder final
 {
 public:
@@ -164,7 +179,7 @@ public:
   Segment GetStartSegment() const { return m_start; }
   Segment GetFinishSegment() const { return {}; }
   bool ConvertToReal(Segment const & /* segment */) const { return false; }
-  RouteWeight HeuristicCostEstimate(Segment const & /* from */, ms::LatLon const & /* to */)
+  RouteWeight HeuristicCostEstimate(Segment const & /* from */, Segment const & /* to */)
   {
     CHECK(false, ("This method exists only for compatibility with IndexGraphStarterJoints"));
     return GetAStarWeightZero<RouteWeight>();
@@ -455,6 +470,42 @@ void CalcCrossMwmConnectors(string const & path, string const & mwmFile, string
   LOG(LINFO, ("Transitions count =", builder.GetTransitionsCount(), "elapsed:", timer.ElapsedSeconds(), "seconds"));
 }
 
+std::shared_ptr<VehicleModelInterface> GetVehicleModel(VehicleType vhType, string const & country,
+                                                       CountryParentNameGetterFn const & countryParentNameGetterFn)
+{
+  switch (vhType)
+  {
+  case VehicleType::Pedestrian:
+    return PedestrianModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
+  case VehicleType::Bicycle: return BicycleModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
+  case VehicleType::Car: return CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
+  case VehicleType::Transit:
+  case VehicleType::Count: break;
+  }
+  CHECK(false, ("Unsupported vehicle type:", vhType));
+  return nullptr;
+}
+
+/// \brief Loads |vhType| routing graph of |mwmFile| with restrictions and road access.
+/// Altitudes are loaded for pedestrians and bicycles because their weights depend on climbs.
+std::unique_ptr<IndexGraph> LoadIndexGraph(VehicleType vhType, string const & path, string const & mwmFile,
+                                           string const & country,
+                                           CountryParentNameGetterFn const & countryParentNameGetterFn)
+{
+  auto vehicleModel = GetVehicleModel(vhType, country, countryParentNameGetterFn);
+  bool const loadAltitudes = vhType != VehicleType::Car;
+
+  MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
+  uint32_t mwmNumRoads = DeserializeIndexGraphNumRoads(mwmValue, vhType);
+  auto graph = std::make_unique<IndexGraph>(
+      std::make_shared<Geometry>(GeometryLoader::CreateFromFile(mwmFile, vehicleModel, loadAltitudes), mwmNumRoads),
+      EdgeEstimator::Create(vhType, *vehicleModel, nullptr /* trafficStash */, nullptr /* dataSource */,
+                            nullptr /* numMvmIds */));
+  graph->SetCurrentTimeGetter([time = GetCurrentTimestamp()] { return time; });
+  DeserializeIndexGraph(mwmValue, vhType, *graph);
+  return graph;
+}
+
 template <typename CrossMwmId>
 void FillWeights(string const & path, string const & mwmFile, string const & country,
                  CountryParentNameGetterFn const & countryParentNameGetterFn,
@@ -465,16 +516,8 @@ void FillWeights(string const & path, string const & mwmFile, string const & cou
   // We use leaps for cars only. To use leaps for other vehicle types add weights generation
   // here and change WorldGraph mode selection rule in IndexRouter::CalculateSubroute.
   VehicleType const vhType = VehicleType::Car;
-  std::shared_ptr<VehicleModelInterface> vehicleModel =
-      CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
-
-  MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
-  uint32_t mwmNumRoads = DeserializeIndexGraphNumRoads(mwmValue, vhType);
-  IndexGraph graph(std::make_shared<Geometry>(GeometryLoader::CreateFromFile(mwmFile, vehicleModel), mwmNumRoads),
-                   EdgeEstimator::Create(vhType, *vehicleModel, nullptr /* trafficStash */, nullptr /* dataSource */,
-                                         nullptr /* numMvmIds */));
-  graph.SetCurrentTimeGetter([time = GetCurrentTimestamp()] { return time; });
-  DeserializeIndexGraph(mwmValue, vhType, graph);
+  auto const graphPtr = LoadIndexGraph(vhType, path, mwmFile, country, countryParentNameGetterFn);
+  IndexGraph & graph = *graphPtr;
 
   std::map<Segment, std::map<Segment, RouteWeight>> weights;
 
@@ -659,6 +702,138 @@ void BuildRoutingCrossMwmSection(string const & path, string const & mwmFile, st
   SerializeCrossMwm(mwmFile, CROSS_MWM_FILE_TAG, builder);
 }
 
+void BuildRoutingShortcutsSection(string const & path, string const & mwmFile, string const & country,
+                                  CountryParentNameGetterFn const & countryParentNameGetterFn)
+{
+  LOG(LINFO, ("Building routing shortcuts section for", country));
+  base::Timer timer;
+
+  auto const graph = LoadIndexGraph(VehicleType::Car, path, mwmFile, country, countryParentNameGetterFn);
+  auto const shortcuts = BuildRoutingShortcuts(*graph, kGeneratorMwmId, kMaxPointsInShortcutsCell);
+
+  FilesContainerW cont(mwmFile, FileWriter::OP_WRITE_EXISTING);
+  auto writer = cont.GetWriter(ROUTING_SHORTCUTS_FILE_TAG);
+  auto const startPos = writer->Pos();
+  shortcuts.Serialize(*writer);
+  auto const sectionSize = writer->Pos() - startPos;
+
+  LOG(LINFO, ("Routing shortcuts section generated, size:", sectionSize, "bytes, elapsed:", timer.ElapsedSeconds(),
+              "seconds"));
+}
+
+void BuildRoutingLandmarksSection(string const & path, string const & mwmFile, string const & country,
+                                  CountryParentNameGetterFn const & countryParentNameGetterFn)
+{
+  LOG(LINFO, ("Building routing landmarks section for", country));
+  base::Timer timer;
+
+  vector<std::pair<VehicleType, RoutingLandmarks>> tables;
+  for (auto const vhType : {VehicleType::Pedestrian, VehicleType::Bicycle})
+  {
+    auto const graph = LoadIndexGraph(vhType, path, mwmFile, country, countryParentNameGetterFn);
+    tables.emplace_back(vhType, BuildRoutingLandmarks(*graph, kGeneratorMwmId, kRoutingLandmarksCount));
+  }
+
+  FilesContainerW cont(mwmFile, FileWriter::OP_WRITE_EXISTING);
+  auto writer = cont.GetWriter(ROUTING_LANDMARKS_FILE_TAG);
+  auto const startPos = writer->Pos();
+  SerializeRoutingLandmarksSection(*writer, tables);
+  auto const sectionSize = writer->Pos() - startPos;
+
+  LOG(LINFO, ("Routing landmarks section generated, size:", sectionSize, "bytes, elapsed:", timer.ElapsedSeconds(),
+              "seconds"));
+}
+
+void BuildRoutingGeometrySection(string const & mwmFile, string const & country,
+                                 CountryParentNameGetterFn const & countryParentNameGetterFn)
+{
+  LOG(LINFO, ("Building routing geometry section for", country));
+  base::Timer timer;
+
+  VehicleMaskBuilder const maskBuilder(country, countryParentNameGetterFn);
+  auto const & optionsClassifier = RoutingOptionsClassifier::Instance();
+
+  MwmValue const mwmValue(LocalCountryFile::MakeTemporary(mwmFile));
+  AltitudeLoaderBase altitudeLoader(mwmValue);
+  bool const hasAltitudes = altitudeLoader.HasAltitudes();
+
+  std::map<uint32_t, RoutingGeometry::Road> roads;
+  size_t skippedCount = 0;
+  ForEachFeature(mwmFile, [&](FeatureType & f, uint32_t featureId)
+  {
+    if (maskBuilder.CalcRoadMask(f) == 0)
+      return;
+
+    // Ferries and shuttle trains with duration need metadata, so they are loaded from features.
+    feature::TypesHolder const types(f);
+    bool const isFerry = std::any_of(types.begin(), types.end(), [&](uint32_t type)
+    {
+      auto const road = optionsClassifier.Get(type);
+      return road && *road == RoutingOptions::Road::Ferry;
+    });
+    if (isFerry || !f.GetMetadata(feature::Metadata::FMD_DURATION).empty())
+    {
+      ++skippedCount;
+      return;
+    }
+
+    f.ParseGeometry(FeatureType::BEST_GEOMETRY);
+    auto & road = roads[featureId];
+    road.m_points.reserve(f.GetPointsCount());
+    for (size_t i = 0; i < f.GetPointsCount(); ++i)
+      road.m_points.push_back(f.GetPoint(i));
+    road.m_types.assign(types.begin(), types.end());
+    if (hasAltitudes)
+      road.m_altitudes = altitudeLoader.GetAltitudes(featureId, road.m_points.size());
+  });
+
+  FilesContainerW cont(mwmFile, FileWriter::OP_WRITE_EXISTING);
+  auto writer = cont.GetWriter(ROUTING_GEOMETRY_FILE_TAG);
+  auto const startPos = writer->Pos();
+  RoutingGeometry::Serialize(*writer, roads, hasAltitudes);
+  auto const sectionSize = writer->Pos() - startPos;
+
+  LOG(LINFO, ("Routing geometry section generated, size:", sectionSize, "bytes,", roads.size(), "roads,", skippedCount,
+              "roads with metadata skipped, elapsed:", timer.ElapsedSeconds(), "seconds"));
+}
+
+void BuildRoutingSnapSection(string const & mwmFile, string const & country,
+                             CountryParentNameGetterFn const & countryParentNameGetterFn)
+{
+  LOG(LINFO, ("Building routing snap section for", country));
+  base::Timer timer;
+
+  VehicleMaskBuilder const maskBuilder(country, countryParentNameGetterFn);
+
+  std::map<uint32_t, RoutingSnapIndex::Road> roads;
+  ForEachFeature(mwmFile, [&](FeatureType & f, uint32_t featureId)
+  {
+    VehicleMask const roadMask = maskBuilder.CalcRoadMask(f);
+    if (roadMask == 0)
+      return;
+
+    f.ParseGeometry(FeatureType::BEST_GEOMETRY);
+    if (f.GetPointsCount() < 2)
+      return;
+
+    auto & road = roads[featureId];
+    road.m_roadMask = roadMask;
+    road.m_oneWayMask = maskBuilder.CalcOneWayMask(f);
+    road.m_points.reserve(f.GetPointsCount());
+    for (size_t i = 0; i < f.GetPointsCount(); ++i)
+      road.m_points.push_back(f.GetPoint(i));
+  });
+
+  FilesContainerW cont(mwmFile, FileWriter::OP_WRITE_EXISTING);
+  auto writer = cont.GetWriter(ROUTING_SNAP_FILE_TAG);
+  auto const startPos = writer->Pos();
+  RoutingSnapIndex::Serialize(*writer, roads);
+  auto const sectionSize = writer->Pos() - startPos;
+
+  LOG(LINFO, ("Routing snap section generated, size:", sectionSize, "bytes,", roads.size(), "roads, elapsed:",
+              timer.ElapsedSeconds(), "seconds"));
+}
+
 void BuildTransitCrossMwmSection(string const & path, string const & mwmFile, string const & country,
                                  CountryParentNameGetterFn const & countryParentNameGetterFn,
                                  ::transit::experimental::EdgeIdToFeatureId const & edgeIdToFeatureId,
@@ -22,6 +22,33 @@ void BuildRoutingCrossMwmSection(std::string const & path, std::string const & m
                                  CountryParentNameGetterFn const & countryParentNameGetterFn,
                                  std::string const & osmToFeatureFile);
 
+/// \brief Builds ROUTING_SHORTCUTS_FILE_TAG section with shortcuts for long car routes inside the mwm.
+/// \note Before call of this method
+/// * routing section should be generated
+/// * restrictions and road access sections should be generated
+void BuildRoutingShortcutsSection(std::string const & path, std::string const & mwmFile, std::string const & country,
+                                  CountryParentNameGetterFn const & countryParentNameGetterFn);
+
+/// \brief Builds ROUTING_LANDMARKS_FILE_TAG section with ALT landmarks for pedestrian and bicycle routing.
+/// \note Before call of this method
+/// * routing section should be generated
+/// * altitudes section should be generated if it's planned
+void BuildRoutingLandmarksSection(std::string const & path, std::string const & mwmFile, std::string const & country,
+                                  CountryParentNameGetterFn const & countryParentNameGetterFn);
+
+/// \brief Builds ROUTING_GEOMETRY_FILE_TAG section with flat geometry of roads of all vehicle types.
+/// \note Before call of this method
+/// * all features and feature geometry should be generated
+/// * altitudes section should be generated if it's planned
+void BuildRoutingGeometrySection(std::string const & mwmFile, std::string const & country,
+                                 CountryParentNameGetterFn const & countryParentNameGetterFn);
+
+/// \brief Builds ROUTING_SNAP_FILE_TAG section with the spatial index of roads of all vehicle types.
+/// \note Before call of this method all features and feature geometry should be generated. The index
+/// is used only with ROUTING_GEOMETRY_FILE_TAG section which keeps the road points.
+void BuildRoutingSnapSection(std::string const & mwmFile, std::string const & country,
+                             CountryParentNameGetterFn const & countryParentNameGetterFn);
+
 /// \brief Builds TRANSIT_CROSS_MWM_FILE_TAG section.
 /// \note Before a call of this method TRANSIT_FILE_TAG should be built.
 void BuildTransitCrossMwmSection(std::string const & path, std::string const & mwmFile, std::string const & country,
@@ -0,0 +1,132 @@
+#include "generator/speed_profiles_builder.hpp"
+
+#include "coding/file_writer.hpp"
+#include "coding/files_container.hpp"
+
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+
+#include "defines.hpp"
+
+namespace routing_builder
+{
+using namespace routing;
+using namespace std;
+
+namespace
+{
+char constexpr kDelim[] = ", \t\r\n";
+size_t constexpr kHoursCount = 7 * 24;
+uint32_t constexpr kBucketsPerHour = 60 / SpeedProfiles::kBucketMinutes;
+
+SpeedProfiles::Profile MakeProfile(array<double, kHoursCount> const & speeds)
+{
+  double const maxSpeed = *max_element(speeds.cbegin(), speeds.cend());
+  CHECK_GREATER(maxSpeed, 0.0, ());
+
+  SpeedProfiles::Profile profile;
+  for (uint32_t bucket = 0; bucket < SpeedProfiles::kBucketsCount; ++bucket)
+  {
+    // Hourly speeds are taken at the middles of the hours and are linearly interpolated
+    // to the middles of the buckets, the week is cyclic.
+    double const hour = (bucket + 0.5) / kBucketsPerHour - 0.5;
+    double const hourFloor = floor(hour);
+    double const ratio = hour - hourFloor;
+    auto const prev = static_cast<size_t>((static_cast<int64_t>(hourFloor) + kHoursCount) % kHoursCount);
+    auto const next = (prev + 1) % kHoursCount;
+    double const speed = speeds[prev] * (1.0 - ratio) + speeds[next] * ratio;
+    profile[bucket] = SpeedProfiles::QuantizeFactor(speed / maxSpeed);
+  }
+  return profile;
+}
+}  // namespace
+
+bool ParseSpeedProfiles(string const & filePath, SegmentToSpeedProfile & profiles)
+{
+  profiles.clear();
+
+  ifstream stream(filePath);
+  if (!stream)
+    return false;
+
+  string line;
+  while (getline(stream, line))
+  {
+    strings::SimpleTokenizer iter(line, kDelim);
+    if (!iter)  // empty line
+      continue;
+
+    uint32_t featureId = 0;
+    uint32_t segmentIdx = 0;
+    uint32_t forward = 0;
+    if (!strings::to_uint(*iter, featureId) || !(++iter) || !strings::to_uint(*iter, segmentIdx) || !(++iter) ||
+        !strings::to_uint(*iter, forward) || forward > 1)
+    {
+      LOG(LWARNING, ("Wrong segment of speed profile:", line));
+      return false;
+    }
+
+    array<double, kHoursCount> speeds;
+    for (auto & speed : speeds)
+    {
+      if (!(++iter) || !strings::to_double(*iter, speed) || speed < 0.0)
+      {
+        LOG(LWARNING, ("Wrong speeds of speed profile:", line));
+        return false;
+      }
+    }
+
+    if (++iter)
+    {
+      LOG(LWARNING, ("Too many speeds of speed profile:", line));
+      return false;
+    }
+
+    // A segment without speeds keeps speeds of the vehicle model.
+    if (*max_element(speeds.cbegin(), speeds.cend()) == 0.0)
+      continue;
+
+    if (!profiles.emplace(SpeedProfiles::SegmentKey(featureId, segmentIdx, forward == 1), MakeProfile(speeds)).second)
+    {
+      LOG(LWARNING, ("Duplicated speed profile:", line));
+      return false;
+    }
+  }
+  return true;
+}
+
+bool BuildSpeedProfilesSection(string const & dataPath, string const & profilesFilename)
+{
+  LOG(LINFO, ("Building speed profiles section for", dataPath, "with", profilesFilename));
+  base::Timer timer;
+
+  SegmentToSpeedProfile profiles;
+  if (!ParseSpeedProfiles(profilesFilename, profiles))
+  {
+    LOG(LERROR, ("Can't parse speed profiles from", profilesFilename));
+    return false;
+  }
+
+  if (profiles.empty())
+  {
+    LOG(LINFO, ("No speed profiles in", profilesFilename));
+    return true;
+  }
+
+  FilesContainerW cont(dataPath, FileWriter::OP_WRITE_EXISTING);
+  auto writer = cont.GetWriter(ROUTING_SPEED_PROFILES_FILE_TAG);
+  auto const startPos = writer->Pos();
+  SpeedProfiles::Serialize(*writer, profiles);
+  auto const sectionSize = writer->Pos() - startPos;
+
+  LOG(LINFO, ("Speed profiles section generated, size:", sectionSize, "bytes,", profiles.size(),
+              "segment directions, elapsed:", timer.ElapsedSeconds(), "seconds"));
+  return true;
+}
+}  // namespace routing_builder
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "routing/speed_profiles.hpp"
+
+#include <map>
+#include <string>
+
+namespace routing_builder
+{
+using SegmentToSpeedProfile = std::map<routing::SpeedProfiles::SegmentKey, routing::SpeedProfiles::Profile>;
+
+/// \brief Parses csv file with |filePath| and stores the result in |profiles|.
+/// Every line of the file is a speed profile of one direction of a road segment:
+/// feature id, segment idx, 1 for forward or 0 for backward direction and 168 speeds in km/h of
+/// every hour of a week in UTC starting from Monday 00:00. Speeds are normalized by the max speed
+/// of the week and interpolated to the buckets of SpeedProfiles.
+/// \returns false if the file can't be read or has a wrong line.
+bool ParseSpeedProfiles(std::string const & filePath, SegmentToSpeedProfile & profiles);
+
+/// \brief Builds ROUTING_SPEED_PROFILES_FILE_TAG section in mwm with |dataPath| with profiles
+/// from csv file |profilesFilename|, see ParseSpeedProfiles(). Feature ids are ids of the mwm,
+/// for example road segments of tracks matched with track_analyzing.
+bool BuildSpeedProfilesSection(std::string const & dataPath, std::string const & profilesFilename);
+}  // namespace routing_builder
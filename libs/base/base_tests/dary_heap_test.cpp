@@ -0,0 +1,80 @@
+#include "testing/testing.hpp"
+
+#include "base/dary_heap.hpp"
+
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+using namespace base;
+
+UNIT_TEST(DAryHeap_Smoke)
+{
+  dary_heap<int> q;
+  TEST(q.empty(), ());
+
+  q.push(5);
+  q.push(-1);
+  q.emplace(3);
+  TEST_EQUAL(q.top(), 5, ());
+  TEST_EQUAL(q.size(), 3, ());
+
+  q.pop();
+  TEST_EQUAL(q.top(), 3, ());
+  q.pop();
+  TEST_EQUAL(q.top(), -1, ());
+  q.pop();
+  TEST(q.empty(), ());
+}
+
+UNIT_TEST(DAryHeap_ClearKeepsMemory)
+{
+  dary_heap<int, std::greater<int>> q;
+  for (int i = 0; i < 100; ++i)
+    q.push(i);
+
+  auto const capacity = q.capacity();
+  q.clear();
+  TEST(q.empty(), ());
+  TEST_EQUAL(q.capacity(), capacity, ());
+
+  q.release();
+  TEST_EQUAL(q.capacity(), 0, ());
+}
+
+UNIT_TEST(DAryHeap_PriorityQueue)
+{
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> value(0, 1000);
+
+  dary_heap<int, std::greater<int>> q;
+  dary_heap<int, std::greater<int>, 2> binaryQ;
+  std::priority_queue<int, std::vector<int>, std::greater<int>> expected;
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    // Pushes are more frequent than pops, so the queues grow.
+    if (i % 3 == 2)
+    {
+      TEST_EQUAL(q.top(), expected.top(), (i));
+      TEST_EQUAL(binaryQ.top(), expected.top(), (i));
+      q.pop();
+      binaryQ.pop();
+      expected.pop();
+      continue;
+    }
+
+    int const v = value(rng);
+    q.push(v);
+    binaryQ.push(v);
+    expected.push(v);
+  }
+
+  while (!expected.empty())
+  {
+    TEST_EQUAL(q.top(), expected.top(), ());
+    q.pop();
+    expected.pop();
+  }
+  TEST(q.empty(), ());
+}
@@ -22,6 +22,8 @@ public:
     return value;
   }
 
+  void Erase(Key const & key) { m_cache.Erase(key); }
+
   bool IsValid() const { return m_cache.IsValidForTesting(); }
 
 private:
@@ -172,3 +174,30 @@ UNIT_TEST(LruCacheLoaderCallsTest)
   cache.GetValue(1);
   TEST(cache.IsValid(), ());
 }
+
+UNIT_TEST(LruCacheEraseTest)
+{
+  using Key = int;
+  using Value = int;
+  bool shouldLoadBeCalled = true;
+  auto loader = [&shouldLoadBeCalled](Key k, Value & v)
+  {
+    TEST(shouldLoadBeCalled, ());
+    v = k;
+  };
+
+  LruCacheTest<Key, Value> cache(2 /* maxCacheSize */, loader);
+  cache.GetValue(1);
+  cache.GetValue(2);
+  cache.Erase(1);
+  cache.Erase(3);
+  TEST(cache.IsValid(), ());
+
+  // The erased key is loaded again and doesn't evict the other one.
+  cache.GetValue(1);
+  TEST(cache.IsValid(), ());
+  shouldLoadBeCalled = false;
+  cache.GetValue(2);
+  TEST_EQUAL(cache.GetValue(1), 1, ());
+  TEST(cache.IsValid(), ());
+}
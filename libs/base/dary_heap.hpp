@@ -0,0 +1,116 @@
+#pragma once
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace base
+{
+// Priority queue with the interface of std::priority_queue on a d-ary heap: top() is the greatest
+// element according to |CompareT|. A 4-ary heap is twice as shallow as the binary one and the children
+// of a node are next to each other in memory, so push() and pop() of a large queue are faster.
+// clear() keeps the allocated memory, so a queue may be reused by several searches without allocations.
+template <typename T, typename CompareT = std::less<T>, size_t Arity = 4>
+class dary_heap
+{
+  static_assert(Arity >= 2, "Arity of a heap should be at least 2.");
+
+public:
+  using value_type = T;
+
+  explicit dary_heap(CompareT compare = CompareT()) : m_compare(compare) {}
+
+  bool empty() const { return m_heap.empty(); }
+  size_t size() const { return m_heap.size(); }
+  size_t capacity() const { return m_heap.capacity(); }
+
+  T const & top() const
+  {
+    ASSERT(!empty(), ());
+    return m_heap.front();
+  }
+
+  void push(T const & t)
+  {
+    m_heap.push_back(t);
+    SiftUp(m_heap.size() - 1);
+  }
+
+  void push(T && t)
+  {
+    m_heap.push_back(std::move(t));
+    SiftUp(m_heap.size() - 1);
+  }
+
+  template <typename... Args>
+  void emplace(Args &&... args)
+  {
+    m_heap.emplace_back(std::forward<Args>(args)...);
+    SiftUp(m_heap.size() - 1);
+  }
+
+  void pop()
+  {
+    ASSERT(!empty(), ());
+    if (m_heap.size() > 1)
+      m_heap.front() = std::move(m_heap.back());
+    m_heap.pop_back();
+    if (!m_heap.empty())
+      SiftDown(0);
+  }
+
+  void clear() { m_heap.clear(); }
+  void reserve(size_t n) { m_heap.reserve(n); }
+
+  // Releases the allocated memory.
+  void release() { std::vector<T>().swap(m_heap); }
+
+private:
+  void SiftUp(size_t i)
+  {
+    T value = std::move(m_heap[i]);
+    while (i > 0)
+    {
+      size_t const parent = (i - 1) / Arity;
+      if (!m_compare(m_heap[parent], value))
+        break;
+
+      m_heap[i] = std::move(m_heap[parent]);
+      i = parent;
+    }
+    m_heap[i] = std::move(value);
+  }
+
+  void SiftDown(size_t i)
+  {
+    size_t const size = m_heap.size();
+    T value = std::move(m_heap[i]);
+    while (true)
+    {
+      size_t const first = i * Arity + 1;
+      if (first >= size)
+        break;
+
+      size_t const last = std::min(first + Arity, size);
+      size_t best = first;
+      for (size_t child = first + 1; child < last; ++child)
+        if (m_compare(m_heap[best], m_heap[child]))
+          best = child;
+
+      if (!m_compare(value, m_heap[best]))
+        break;
+
+      m_heap[i] = std::move(m_heap[best]);
+      i = best;
+    }
+    m_heap[i] = std::move(value);
+  }
+
+  std::vector<T> m_heap;
+  CompareT m_compare;
+};
+}  // namespace base
@@ -45,6 +45,13 @@ public:
     return value;
   }
 
+  // Removes @key and its value. Does nothing if there's no @key in the cache.
+  void Erase(Key const & key)
+  {
+    if (m_cache.erase(key) != 0)
+      m_keyAge.RemoveKey(key);
+  }
+
   void Clear()
   {
     m_cache.clear();
@@ -127,6 +134,16 @@ private:
       m_ageToKey.erase(m_ageToKey.begin());
     }
 
+    /// \note This method should be used only if there's |key| in |m_ageToKey| and |m_keyToAge|.
+    void RemoveKey(Key const & key)
+    {
+      auto const keyToAgeIt = m_keyToAge.find(key);
+      CHECK(keyToAgeIt != m_keyToAge.end(), ());
+      size_t const removed = m_ageToKey.erase(keyToAgeIt->second);
+      CHECK_EQUAL(removed, 1, ());
+      m_keyToAge.erase(keyToAgeIt);
+    }
+
     /// \brief Checks for coherence class params.
     /// \note It's a time consumption method and should be called for tests only.
     bool IsValidForTesting() const
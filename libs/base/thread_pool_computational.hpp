@@ -109,6 +109,8 @@ public:
     m_condition.notify_all();
   }
 
+  size_t GetThreadsCount() const { return m_threads.size(); }
+
   void WaitingStop()
   {
     {
@@ -3,11 +3,16 @@
 #include "coding/compressed_bit_vector.hpp"
 #include "coding/writer.hpp"
 
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
 #include <algorithm>
 #include <cstdint>
 #include <iterator>
 #include <memory>
+#include <random>
 #include <set>
+#include <string>
 #include <vector>
 
 using namespace std;
@@ -79,6 +84,56 @@ void CheckUnion(vector<uint64_t> & setBits1, coding::CompressedBitVector::Storag
   TEST_EQUAL(resultStrategy, cbv3->GetStorageStrategy(), ());
   CheckUnion(setBits1, setBits2, *cbv3);
 }
+
+// Returns sorted positions of bits which are set with |probability| out of |numBits| bits.
+vector<uint64_t> GenerateSetBits(mt19937 & engine, uint64_t numBits, double probability)
+{
+  bernoulli_distribution isSet(probability);
+  vector<uint64_t> setBits;
+  for (uint64_t i = 0; i < numBits; ++i)
+    if (isSet(engine))
+      setBits.push_back(i);
+  return setBits;
+}
+
+vector<uint64_t> GetSetBits(coding::CompressedBitVector const & cbv)
+{
+  vector<uint64_t> setBits;
+  coding::CompressedBitVectorEnumerator::ForEach(cbv, [&setBits](uint64_t bit) { setBits.push_back(bit); });
+  return setBits;
+}
+
+// Returns milliseconds per call of |fn|.
+template <typename Fn>
+double GetMsPerRun(size_t numRuns, Fn && fn)
+{
+  base::Timer timer;
+  for (size_t i = 0; i < numRuns; ++i)
+    fn();
+  return timer.ElapsedSeconds() * 1000.0 / numRuns;
+}
+
+// Compares |cbvOp| with |setOp| which is applied to sorted positions of set bits.
+template <typename CBVOp, typename SetOp>
+void BenchmarkOp(string const & name, CBVOp && cbvOp, SetOp && setOp, vector<uint64_t> const & setBits1,
+                 vector<uint64_t> const & setBits2, coding::CompressedBitVector const & cbv1,
+                 coding::CompressedBitVector const & cbv2)
+{
+  size_t constexpr kNumRuns = 20;
+
+  vector<uint64_t> expected;
+  double const setMs = GetMsPerRun(kNumRuns, [&]
+  {
+    expected.clear();
+    setOp(setBits1.begin(), setBits1.end(), setBits2.begin(), setBits2.end(), back_inserter(expected));
+  });
+
+  unique_ptr<coding::CompressedBitVector> result;
+  double const cbvMs = GetMsPerRun(kNumRuns, [&] { result = cbvOp(cbv1, cbv2); });
+
+  TEST_EQUAL(GetSetBits(*result), expected, (name));
+  LOG(LINFO, (name, "ms per op, cbv:", cbvMs, "sorted positions:", setMs));
+}
 }  // namespace
 
 UNIT_TEST(CompressedBitVector_Intersect1)
@@ -295,6 +350,37 @@ UNIT_TEST(CompressedBitVector_Union4)
              coding::CompressedBitVector::StorageStrategy::Sparse /* resultStrategy */);
 }
 
+UNIT_TEST(CompressedBitVector_RandomOps)
+{
+  mt19937 engine(0);
+  // Both dense and sparse vectors, and pairs of sparse vectors of very different sizes.
+  vector<double> const probabilities = {0.0, 0.0005, 0.005, 0.05, 0.2, 0.5, 0.95};
+  for (double const p1 : probabilities)
+  {
+    for (double const p2 : probabilities)
+    {
+      auto setBits1 = GenerateSetBits(engine, 20000 /* numBits */, p1);
+      auto setBits2 = GenerateSetBits(engine, 15000 /* numBits */, p2);
+      auto const cbv1 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits1);
+      auto const cbv2 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits2);
+      TEST_EQUAL(GetSetBits(*cbv1), setBits1, (p1));
+      TEST_EQUAL(GetSetBits(*cbv2), setBits2, (p2));
+
+      vector<uint64_t> expected;
+      Intersect(setBits1, setBits2, expected);
+      TEST_EQUAL(GetSetBits(*coding::CompressedBitVector::Intersect(*cbv1, *cbv2)), expected, (p1, p2));
+
+      expected.clear();
+      Subtract(setBits1, setBits2, expected);
+      TEST_EQUAL(GetSetBits(*coding::CompressedBitVector::Subtract(*cbv1, *cbv2)), expected, (p1, p2));
+
+      expected.clear();
+      Union(setBits1, setBits2, expected);
+      TEST_EQUAL(GetSetBits(*coding::CompressedBitVector::Union(*cbv1, *cbv2)), expected, (p1, p2));
+    }
+  }
+}
+
 UNIT_TEST(CompressedBitVector_SerializationDense)
 {
   int const kNumBits = 100;
@@ -453,3 +539,52 @@ UNIT_TEST(CompressedBitVector_SparseLeaveFirstNBits)
   for (uint64_t bit = 0; bit < (1 << 10); ++bit)
     TEST(!cbv->GetBit(bit), (bit));
 }
+
+// Densities are close to the ones of Geocoder's retrieval results, viewport and category filters
+// in a big mwm. Uses the public interface only, so it may be run against older versions.
+UNIT_TEST(CompressedBitVector_Benchmark)
+{
+  uint64_t constexpr kNumBits = 2000000;
+
+  struct Case
+  {
+    string m_name;
+    double m_probability1;
+    double m_probability2;
+  };
+
+  vector<Case> const cases = {{"dense (50%) & dense (40%)", 0.5, 0.4},
+                              {"sparse (5%) & tiny (0.005%)", 0.05, 0.00005},
+                              {"viewport (35%) & tokens (0.1%)", 0.35, 0.001},
+                              {"sparse (1%) & sparse (2%)", 0.01, 0.02}};
+
+  mt19937 engine(0);
+  for (auto const & c : cases)
+  {
+    auto const setBits1 = GenerateSetBits(engine, kNumBits, c.m_probability1);
+    auto const setBits2 = GenerateSetBits(engine, kNumBits, c.m_probability2);
+    auto const cbv1 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits1);
+    auto const cbv2 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits2);
+
+    BenchmarkOp(c.m_name + " intersect", &coding::CompressedBitVector::Intersect,
+                [](auto b1, auto e1, auto b2, auto e2, auto out) { set_intersection(b1, e1, b2, e2, out); }, setBits1,
+                setBits2, *cbv1, *cbv2);
+    BenchmarkOp(c.m_name + " union", &coding::CompressedBitVector::Union,
+                [](auto b1, auto e1, auto b2, auto e2, auto out) { set_union(b1, e1, b2, e2, out); }, setBits1,
+                setBits2, *cbv1, *cbv2);
+    BenchmarkOp(c.m_name + " subtract", &coding::CompressedBitVector::Subtract,
+                [](auto b1, auto e1, auto b2, auto e2, auto out) { set_difference(b1, e1, b2, e2, out); }, setBits1,
+                setBits2, *cbv1, *cbv2);
+  }
+
+  auto const setBits = GenerateSetBits(engine, kNumBits, 0.5);
+  auto const cbv = coding::CompressedBitVectorBuilder::FromBitPositions(setBits);
+  TEST_EQUAL(cbv->GetStorageStrategy(), coding::CompressedBitVector::StorageStrategy::Dense, ());
+  uint64_t sum = 0;
+  double const forEachMs = GetMsPerRun(20 /* numRuns */, [&]
+  {
+    coding::CompressedBitVectorEnumerator::ForEach(*cbv, [&sum](uint64_t bit) { sum += bit; });
+  });
+  TEST_GREATER(sum, 0, ());
+  LOG(LINFO, ("dense (50%) ForEach ms:", forEachMs));
+}
@@ -13,28 +13,70 @@ using std::make_unique, std::max, std::min, std::unique_ptr, std::vector;
 
 namespace
 {
+// When one sorted sequence is this times longer than the other one, the shorter sequence is
+// intersected with the longer one by galloping search instead of the linear merge.
+size_t constexpr kGallopingRatio = 32;
+
+// Appends the elements of |small| which are present in |large| to |result|. Each element of
+// |small| is searched in the rest of |large| by exponential search, so the time is
+// O(|small| * log(|large| / |small|)).
+template <typename TIt>
+void IntersectGalloping(TIt smallBegin, TIt smallEnd, TIt largeBegin, TIt largeEnd, vector<uint64_t> & result)
+{
+  auto it = largeBegin;
+  for (auto s = smallBegin; s != smallEnd && it != largeEnd; ++s)
+  {
+    size_t const rest = static_cast<size_t>(largeEnd - it);
+    size_t step = 1;
+    while (step < rest && *(it + step) < *s)
+      step *= 2;
+
+    // Elements before |it + step / 2| are less than |*s|.
+    it = lower_bound(it + step / 2, it + min(step + 1, rest), *s);
+    if (it != largeEnd && *it == *s)
+      result.push_back(*it++);
+  }
+}
+
+void IntersectSorted(SparseCBV const & a, SparseCBV const & b, vector<uint64_t> & result)
+{
+  size_t const sizeA = a.PopCount();
+  size_t const sizeB = b.PopCount();
+  if (sizeA * kGallopingRatio < sizeB)
+    IntersectGalloping(a.Begin(), a.End(), b.Begin(), b.End(), result);
+  else if (sizeB * kGallopingRatio < sizeA)
+    IntersectGalloping(b.Begin(), b.End(), a.Begin(), a.End(), result);
+  else
+    set_intersection(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(result));
+}
+
 struct IntersectOp
 {
   IntersectOp() {}
 
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a, coding::DenseCBV const & b) const
   {
-    size_t const sizeA = a.NumBitGroups();
-    size_t const sizeB = b.NumBitGroups();
-    vector<uint64_t> resGroups(min(sizeA, sizeB));
+    auto const & groupsA = a.GetBitGroups();
+    auto const & groupsB = b.GetBitGroups();
+    vector<uint64_t> resGroups(min(groupsA.size(), groupsB.size()));
+    // Plain loop over words without bound checks, so it's vectorized by the compiler.
     for (size_t i = 0; i < resGroups.size(); ++i)
-      resGroups[i] = a.GetBitGroup(i) & b.GetBitGroup(i);
+      resGroups[i] = groupsA[i] & groupsB[i];
     return coding::CompressedBitVectorBuilder::FromBitGroups(std::move(resGroups));
   }
 
   // The intersection of dense and sparse is always sparse.
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a, coding::SparseCBV const & b) const
   {
+    auto const & groups = a.GetBitGroups();
+    uint64_t const numBits = groups.size() * DenseCBV::kBlockSize;
+
     vector<uint64_t> resPos;
-    for (size_t i = 0; i < b.PopCount(); ++i)
+    // Positions are sorted, so the rest of them are out of |a| after the first one which is out.
+    for (auto it = b.Begin(); it != b.End() && *it < numBits; ++it)
     {
-      auto pos = b.Select(i);
-      if (a.GetBit(pos))
+      auto const pos = *it;
+      if (((groups[pos / DenseCBV::kBlockSize] >> (pos % DenseCBV::kBlockSize)) & 1) > 0)
         resPos.push_back(pos);
     }
     return make_unique<coding::SparseCBV>(std::move(resPos));
@@ -48,7 +90,7 @@ struct IntersectOp
   unique_ptr<coding::CompressedBitVector> operator()(coding::SparseCBV const & a, coding::SparseCBV const & b) const
   {
     vector<uint64_t> resPos;
-    set_intersection(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
+    IntersectSorted(a, b, resPos);
     return make_unique<coding::SparseCBV>(std::move(resPos));
   }
 };
@@ -59,11 +101,12 @@ struct SubtractOp
 
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a, coding::DenseCBV const & b) const
   {
-    size_t const sizeA = a.NumBitGroups();
-    size_t const sizeB = b.NumBitGroups();
-    vector<uint64_t> resGroups(min(sizeA, sizeB));
-    for (size_t i = 0; i < resGroups.size(); ++i)
-      resGroups[i] = a.GetBitGroup(i) & ~b.GetBitGroup(i);
+    auto const & groupsA = a.GetBitGroups();
+    auto const & groupsB = b.GetBitGroups();
+    size_t const commonSize = min(groupsA.size(), groupsB.size());
+    vector<uint64_t> resGroups(groupsA);
+    for (size_t i = 0; i < commonSize; ++i)
+      resGroups[i] &= ~groupsB[i];
     return CompressedBitVectorBuilder::FromBitGroups(std::move(resGroups));
   }
 
@@ -115,20 +158,14 @@ struct UnionOp
 
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a, coding::DenseCBV const & b) const
   {
-    size_t const sizeA = a.NumBitGroups();
-    size_t const sizeB = b.NumBitGroups();
-
-    size_t commonSize = min(sizeA, sizeB);
-    size_t resultSize = max(sizeA, sizeB);
-    vector<uint64_t> resGroups(resultSize);
-    for (size_t i = 0; i < commonSize; ++i)
-      resGroups[i] = a.GetBitGroup(i) | b.GetBitGroup(i);
-    if (a.NumBitGroups() == resultSize)
-      for (size_t i = commonSize; i < resultSize; ++i)
-        resGroups[i] = a.GetBitGroup(i);
-    else
-      for (size_t i = commonSize; i < resultSize; ++i)
-        resGroups[i] = b.GetBitGroup(i);
+    auto const & groupsA = a.GetBitGroups();
+    auto const & groupsB = b.GetBitGroups();
+    auto const & longer = groupsA.size() >= groupsB.size() ? groupsA : groupsB;
+    auto const & shorter = groupsA.size() >= groupsB.size() ? groupsB : groupsA;
+
+    vector<uint64_t> resGroups(longer);
+    for (size_t i = 0; i < shorter.size(); ++i)
+      resGroups[i] |= shorter[i];
     return CompressedBitVectorBuilder::FromBitGroups(std::move(resGroups));
   }
 
@@ -430,13 +467,13 @@ unique_ptr<CompressedBitVector> CompressedBitVectorBuilder::FromBitGroups(vector
     return DenseCBV::BuildFromBitGroups(std::move(bitGroups));
 
   vector<uint64_t> setBits;
+  setBits.reserve(static_cast<size_t>(popCount));
   for (size_t i = 0; i < bitGroups.size(); ++i)
   {
-    for (size_t j = 0; j < kBlockSize; ++j)
-      if (((bitGroups[i] >> j) & 1) > 0)
-        setBits.push_back(kBlockSize * i + j);
+    for (uint64_t group = bitGroups[i]; group != 0; group &= group - 1)
+      setBits.push_back(kBlockSize * i + std::countr_zero(group));
   }
-  return make_unique<SparseCBV>(setBits);
+  return make_unique<SparseCBV>(std::move(setBits));
 }
 
 std::string DebugPrint(CompressedBitVector::StorageStrategy strat)
@@ -8,6 +8,7 @@
 #include "base/control_flow.hpp"
 #include "base/ref_counted.hpp"
 
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -101,6 +102,7 @@ public:
   static std::unique_ptr<DenseCBV> BuildFromBitGroups(std::vector<uint64_t> && bitGroups);
 
   size_t NumBitGroups() const { return m_bitGroups.size(); }
+  std::vector<uint64_t> const & GetBitGroups() const { return m_bitGroups; }
 
   template <typename Fn>
   void ForEach(Fn && f) const
@@ -108,14 +110,10 @@ public:
     base::ControlFlowWrapper<Fn> wrapper(std::forward<Fn>(f));
     for (size_t i = 0; i < m_bitGroups.size(); ++i)
     {
-      for (size_t j = 0; j < kBlockSize; ++j)
-      {
-        if (((m_bitGroups[i] >> j) & 1) > 0)
-        {
-          if (wrapper(kBlockSize * i + j) == base::ControlFlow::Break)
-            return;
-        }
-      }
+      // Visits only set bits, the lowest set bit is cleared on each step.
+      for (uint64_t group = m_bitGroups[i]; group != 0; group &= group - 1)
+        if (wrapper(kBlockSize * i + std::countr_zero(group)) == base::ControlFlow::Break)
+          return;
     }
   }
 
@@ -346,7 +346,13 @@ Framework::Framework(FrameworkParams const & params, bool loadMaps)
   LOG(LINFO, ("System languages:", languages::GetPreferred()));
 
   editor.SetDelegate(make_unique<search::EditorDelegate>(m_featuresFetcher.GetDataSource()));
-  editor.SetInvalidateFn([this]() { InvalidateRect(GetCurrentViewport()); });
+  editor.SetInvalidateFn([this]()
+  {
+    InvalidateRect(GetCurrentViewport());
+    // Cached search results may contain edited features.
+    if (m_searchAPI)
+      m_searchAPI->ClearResultsCache();
+  });
 
   /// @todo Uncomment when we will integrate a traffic provider.
   // m_trafficManager.SetCurrentDataVersion(m_storage.GetCurrentDataVersion());
@@ -1,5 +1,6 @@
 #include "testing/testing.hpp"
 
+#include "search/batch_reverse_geocoder.hpp"
 #include "search/reverse_geocoder.hpp"
 
 #include "indexer/classificator_loader.hpp"
@@ -14,6 +15,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace address_tests
 {
@@ -103,4 +105,55 @@ UNIT_TEST(ReverseGeocoder_Smoke)
     TestAddress(coder, mwmInfo, {53.89745, 27.55835}, streetNames, "18А");
   }
 }
+
+UNIT_TEST(ReverseGeocoder_Batch)
+{
+  classificator::Load();
+
+  FrozenDataSource dataSource;
+  auto const regResult = dataSource.RegisterMap(LocalCountryFile::MakeForTesting("minsk-pass"));
+  TEST_EQUAL(regResult.second, MwmSet::RegResult::Success, ());
+
+  // Grid of points in the center of Minsk.
+  std::vector<m2::PointD> points;
+  for (size_t i = 0; i < 30; ++i)
+  {
+    for (size_t j = 0; j < 30; ++j)
+      points.push_back(mercator::FromLatLon(53.89 + i * 0.001, 27.53 + j * 0.001));
+  }
+
+  ReverseGeocoder const coder(dataSource);
+  BatchReverseGeocoder const batchCoder(dataSource, 1 /* numThreads */);
+  BatchReverseGeocoder::Stats stats;
+  auto const addresses = batchCoder.GetNearbyAddresses(points, ReverseGeocoder::kLookupRadiusM, &stats);
+  TEST_EQUAL(addresses.size(), points.size(), ());
+  TEST_EQUAL(stats.m_numPoints, points.size(), ());
+  TEST_GREATER(stats.m_numAddresses, 0, ());
+  LOG(LINFO, (stats));
+
+  size_t numEqual = 0;
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    ReverseGeocoder::Address addr;
+    coder.GetNearbyAddress(points[i], addr);
+    if (addr.IsValid() == addresses[i].IsValid() && addr.GetHouseNumber() == addresses[i].GetHouseNumber() &&
+        addr.GetStreetName() == addresses[i].GetStreetName())
+    {
+      ++numEqual;
+    }
+  }
+  LOG(LINFO, ("Equal addresses:", numEqual, "of", points.size()));
+  // Only a few nearest buildings are checked, so rare addresses may differ.
+  TEST_GREATER_OR_EQUAL(numEqual * 10, points.size() * 9, (numEqual, points.size()));
+
+  // Results don't depend on the number of threads.
+  BatchReverseGeocoder const parallelCoder(dataSource, 4 /* numThreads */);
+  auto const parallelAddresses = parallelCoder.GetNearbyAddresses(points);
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    TEST_EQUAL(parallelAddresses[i].IsValid(), addresses[i].IsValid(), (i));
+    TEST_EQUAL(parallelAddresses[i].m_building.m_id, addresses[i].m_building.m_id, (i));
+    TEST_EQUAL(parallelAddresses[i].GetStreetName(), addresses[i].GetStreetName(), (i));
+  }
+}
 }  // namespace address_tests
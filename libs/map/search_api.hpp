@@ -101,6 +101,7 @@ public:
   void CancelSearch(search::Mode mode);
   void CancelAllSearches();
   void ClearCaches() { return m_engine.ClearCaches(); }
+  void ClearResultsCache() { m_engine.ClearResultsCache(); }
 
   // *SearchCallback::Delegate overrides:
   void RunUITask(std::function<void()> fn) override;
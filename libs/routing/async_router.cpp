@@ -181,6 +181,18 @@ void AsyncRouter::SetGuidesTracks(GuidesTracks && guides)
   m_guides = std::move(guides);
 }
 
+void AsyncRouter::SetAlternativesParams(AlternativesParams const & params)
+{
+  unique_lock ul(m_guard);
+  m_alternativesParams = params;
+}
+
+void AsyncRouter::SetDepartureTime(std::optional<time_t> departureTime)
+{
+  unique_lock ul(m_guard);
+  m_departureTime = departureTime;
+}
+
 void AsyncRouter::ClearState()
 {
   unique_lock ul(m_guard);
@@ -292,6 +304,8 @@ void AsyncRouter::CalculateRoute()
     routerName = router->GetName();
     router->SetGuides(std::move(m_guides));
     m_guides.clear();
+    router->SetAlternativesParams(m_alternativesParams);
+    router->SetDepartureTime(m_departureTime);
   }
 
   auto route = std::make_shared<Route>(router->GetName(), routeId);
@@ -313,7 +327,7 @@ void AsyncRouter::CalculateRoute()
     router->SetGuides({});
     elapsedSec = timer.ElapsedSeconds();  // routing time
     LogCode(code, elapsedSec);
-    LOG(LINFO, ("ETA:", route->GetTotalTimeSec(), "sec."));
+    LOG(LINFO, ("ETA:", route->GetTotalTimeSec(), "sec. Alternatives:", route->GetAlternatives().size()));
   }
   catch (RootException const & e)
   {
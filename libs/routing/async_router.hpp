@@ -13,9 +13,11 @@
 
 #include <condition_variable>
 #include <cstdint>
+#include <ctime>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>
@@ -53,6 +55,11 @@ public:
                       uint32_t timeoutSec = RouterDelegate::kNoTimeout);
 
   void SetGuidesTracks(GuidesTracks && guides);
+  /// \brief Sets parameters of alternative routes for next route calculations. The alternatives
+  /// are passed to |readyCallback| with the route, see Route::GetAlternatives().
+  void SetAlternativesParams(AlternativesParams const & params);
+  /// \brief Sets departure time for next route calculations, see IRouter::SetDepartureTime().
+  void SetDepartureTime(std::optional<time_t> departureTime);
   /// Interrupt routing and clear buffers
   void ClearState();
 
@@ -112,6 +119,8 @@ private:
   bool m_clearState = false;
   Checkpoints m_checkpoints;
   GuidesTracks m_guides;
+  AlternativesParams m_alternativesParams;
+  std::optional<time_t> m_departureTime;
 
   m2::PointD m_startDirection = m2::PointD::Zero();
   bool m_adjustToPrevRoute = false;
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+
+namespace routing
+{
+/// \brief Parameters of alternative routes which are found together with the best route on the search
+/// spaces of bidirectional A*, see AStarAlgorithm::FindPathBidirectionalAlternatives().
+struct AlternativesParams
+{
+  bool IsEnabled() const { return m_maxAlternatives != 0; }
+
+  // Max number of alternative routes besides the best one. Zero switches alternatives off.
+  size_t m_maxAlternatives = 0;
+  // Quality bound: an alternative route weight is not more than (1 + |m_maxStretch|) * best route weight.
+  double m_maxStretch = 0.25;
+  // An alternative route shares not more than |m_maxSharing| of its weight with the best route
+  // and with the alternatives chosen before it.
+  double m_maxSharing = 0.7;
+  // After the best route is found the waves make not more than |m_maxExtraSearch| * (steps made before)
+  // steps to widen the search spaces. It bounds the extra cost of alternatives.
+  double m_maxExtraSearch = 0.5;
+};
+}  // namespace routing
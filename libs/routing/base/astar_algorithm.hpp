@@ -1,5 +1,6 @@
 #pragma once
 
+#include "routing/base/alternatives_params.hpp"
 #include "routing/base/astar_graph.hpp"
 #include "routing/base/astar_vertex_data.hpp"
 #include "routing/base/astar_weight.hpp"
@@ -7,15 +8,23 @@
 
 #include "base/assert.hpp"
 #include "base/cancellable.hpp"
+#include "base/dary_heap.hpp"
 #include "base/logging.hpp"
+#include "base/thread.hpp"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <exception>
 #include <functional>
 #include <iostream>
+#include <iterator>
 #include <map>
+#include <mutex>
 #include <optional>
-#include <queue>
 #include <type_traits>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -121,6 +130,29 @@ public:
     base::Cancellable const m_dummy;
   };
 
+private:
+  // State is what is going to be put in the priority queue. See the
+  // comment for FindPath for more information.
+  struct State
+  {
+    State(Vertex const & vertex, Weight const & distance, Weight const & heuristic)
+      : vertex(vertex)
+      , distance(distance)
+      , heuristic(heuristic)
+    {}
+    State(Vertex const & vertex, Weight const & distance) : State(vertex, distance, Weight()) {}
+
+    inline bool operator>(State const & rhs) const { return distance > rhs.distance; }
+
+    Vertex vertex;
+    Weight distance;
+    Weight heuristic;
+  };
+
+  // Priority queue of states with the least distance on the top.
+  using Queue = base::dary_heap<State, std::greater<State>>;
+
+public:
   class Context final
   {
   public:
@@ -130,6 +162,7 @@ public:
 
     void Clear()
     {
+      m_queue.clear();
       m_distanceMap.clear();
       m_parents.clear();
     }
@@ -160,14 +193,143 @@ public:
 
     typename Graph::Parents & GetParents() { return m_parents; }
 
+    // The queue is kept in the context, so the waves of PropagateWave() with the same context reuse its memory.
+    Queue & GetQueue() { return m_queue; }
+
     void ReconstructPath(Vertex const & v, std::vector<Vertex> & path) const;
 
   private:
     Graph & m_graph;
+    Queue m_queue;
     ska::bytell_hash_map<Vertex, Weight> m_distanceMap;
     typename Graph::Parents m_parents;
   };
 
+  /// \brief Shortest path tree to the finish of a route which is built by BuildBackwardTree(). Keeps
+  /// distances of vertices to the finish and the next vertices on the way to it, so it may be reused
+  /// by AdjustRoute() for all the deviations from the same route.
+  class BackwardTree final
+  {
+  public:
+    void Clear()
+    {
+      m_distances.clear();
+      m_parents.clear();
+    }
+
+    bool IsEmpty() const { return m_distances.empty(); }
+    size_t GetSize() const { return m_distances.size(); }
+
+    std::optional<Weight> GetDistance(Vertex const & vertex) const
+    {
+      auto const it = m_distances.find(vertex);
+      return it != m_distances.cend() ? std::optional<Weight>(it->second) : std::nullopt;
+    }
+
+    void SetDistance(Vertex const & vertex, Weight const & distance) { m_distances.insert_or_assign(vertex, distance); }
+
+    // |next| is the next vertex after |vertex| on the way to the finish.
+    void SetParent(Vertex const & vertex, Vertex const & next) { m_parents.insert_or_assign(vertex, next); }
+
+    // Non-const since the graph interface takes non-const parents.
+    typename Graph::Parents & GetParents() { return m_parents; }
+
+    /// \brief Removes the vertices for which |isRemoved| returns true and the vertices which go to
+    /// the finish through them.
+    template <typename IsRemoved>
+    void RemoveIf(IsRemoved && isRemoved)
+    {
+      std::vector<Vertex> removed;
+      for (auto const & [vertex, distance] : m_distances)
+        if (isRemoved(vertex))
+          removed.push_back(vertex);
+
+      while (!removed.empty())
+      {
+        for (auto const & vertex : removed)
+        {
+          m_distances.erase(vertex);
+          m_parents.erase(vertex);
+        }
+
+        removed.clear();
+        for (auto const & [vertex, next] : m_parents)
+          if (m_distances.find(next) == m_distances.cend())
+            removed.push_back(vertex);
+      }
+    }
+
+    /// \brief Appends the vertices after |vertex| on the way to the finish to |path|.
+    void AppendPathToFinish(Vertex const & vertex, std::vector<Vertex> & path) const
+    {
+      auto it = m_parents.find(vertex);
+      for (size_t i = 0; it != m_parents.cend(); ++i)
+      {
+        CHECK_LESS(i, m_parents.size(), ("Loop in backward tree at", vertex));
+        path.push_back(it->second);
+        it = m_parents.find(it->second);
+      }
+    }
+
+  private:
+    ska::bytell_hash_map<Vertex, Weight> m_distances;
+    typename Graph::Parents m_parents;
+  };
+
+  /// \brief Memory of the waves of bidirectional searches which may be kept between the searches, see
+  /// AStarAlgorithm(Storage &). The queues and the maps of the waves are cleared but keep their capacity,
+  /// so a series of searches of a similar size, for example refinements of leaps, runs without allocations
+  /// and rehashes. The memory of a wave is released after a search which has reached more than
+  /// |maxKeptVertices| vertices to limit the memory which is kept between searches.
+  class Storage final
+  {
+  public:
+    static size_t constexpr kMaxKeptVertices = 1 << 16;
+
+    explicit Storage(size_t maxKeptVertices = kMaxKeptVertices) : m_maxKeptVertices(maxKeptVertices) {}
+
+    // Storage can't be copied since searches keep references to it.
+    Storage(Storage const &) = delete;
+    Storage & operator=(Storage const &) = delete;
+
+    /// \returns capacity of the queue of the forward or the backward wave, it's used in tests.
+    size_t GetQueueCapacity(bool forward) const { return m_waves[forward ? 0 : 1].m_queue.capacity(); }
+
+  private:
+    friend class AStarAlgorithm;
+
+    struct Wave
+    {
+      void Clear()
+      {
+        m_queue.clear();
+        m_distances.clear();
+        m_parents.clear();
+      }
+
+      void Release()
+      {
+        m_queue.release();
+        ska::bytell_hash_map<Vertex, Weight>().swap(m_distances);
+        typename Graph::Parents().swap(m_parents);
+      }
+
+      Queue m_queue;
+      ska::bytell_hash_map<Vertex, Weight> m_distances;
+      typename Graph::Parents m_parents;
+    };
+
+    Wave & GetWave(bool forward) { return m_waves[forward ? 0 : 1]; }
+
+    size_t const m_maxKeptVertices;
+    // True while a search uses the storage, a nested search uses its own one.
+    bool m_isUsed = false;
+    std::array<Wave, 2> m_waves;
+  };
+
+  AStarAlgorithm() = default;
+  explicit AStarAlgorithm(Storage & storage) : m_storage(&storage) {}
+
   // VisitVertex returns true: wave will continue
   // VisitVertex returns false: wave will stop
   template <typename VisitVertex, typename AdjustEdgeWeight, typename FilterStates, typename ReducedToRealLength>
@@ -196,12 +358,49 @@ public:
     });
   }
 
+  /// \brief Same as FindPathBidirectional() but after the best route is found the waves go on until
+  /// routes (1 + |alternativesParams.m_maxStretch|) times longer are found or the extra steps limit is
+  /// reached. Then the vertices reached by both waves are tried as via vertices of alternative routes
+  /// in the order of the via route weights (via-vertex method). A via route is taken if it has no loops
+  /// and doesn't share too much with the routes taken before.
+  /// \note |results| are the best route and then up to |alternativesParams.m_maxAlternatives| alternatives.
+  /// Weights of alternatives are calculated with the distances of the waves, so an alternative may be
+  /// slightly longer than its weight if a wave has found a shorter path to some of its vertices later.
+  template <class P>
+  Result FindPathBidirectionalAlternatives(P & params, AlternativesParams const & alternativesParams,
+                                           std::vector<RoutingResult<Vertex, Weight>> & results) const;
+
+  /// \brief Same as FindPathBidirectional() but the forward wave runs on the calling thread and
+  /// the backward wave runs on another one. Graphs are not thread-safe, so |backwardParams.m_graph|
+  /// should be an independent copy of |params.m_graph| with the same vertices. Callbacks of
+  /// |backwardParams| are called on the backward wave thread.
+  /// \note The found path has the same weight as the one of FindPathBidirectional(), but another
+  /// path of the same weight may be chosen depending on the waves timing.
+  template <class P, class BackwardP>
+  Result FindPathBidirectionalParallel(P & params, BackwardP & backwardParams,
+                                       RoutingResult<Vertex, Weight> & result) const;
+
+  /// \brief Builds |tree| of the vertices of |prevRoute| with their remaining distances along the route
+  /// and propagates a backward wave from the vertices of |prevRoute| in [|waveBeginIdx|, |waveEndIdx|),
+  /// so the tree covers the vertices which reach this part of the route within |params.m_checkLengthCallback|
+  /// limit. Distances of the wave are distances to the finish. The wave stops when |tree| has |maxTreeSize|
+  /// vertices. Expects |params.m_checkLengthCallback| to check the weight of a detour to the route.
+  template <typename P>
+  Result BuildBackwardTree(P & params, std::vector<Edge> const & prevRoute, size_t waveBeginIdx, size_t waveEndIdx,
+                           size_t maxTreeSize, BackwardTree & tree) const;
+
   // Adjust route to the previous one.
   // Expects |params.m_checkLengthCallback| to check wave propagation limit.
   template <typename P>
   typename AStarAlgorithm<Vertex, Edge, Weight>::Result AdjustRoute(P & params, std::vector<Edge> const & prevRoute,
                                                                     RoutingResult<Vertex, Weight> & result) const;
 
+  /// \brief Same as AdjustRoute() above but joins |tree| of the previous route, see BuildBackwardTree().
+  /// The forward wave stops as soon as it can't improve the best joined route, so a reroute near
+  /// the tree needs a short search only.
+  template <typename P>
+  Result AdjustRoute(P & params, BackwardTree & tree, RoutingResult<Vertex, Weight> & result) const;
+
 private:
   // Periodicity of switching a wave of bidirectional algorithm.
   static uint32_t constexpr kQueueSwitchPeriod = 128;
@@ -227,24 +426,6 @@ private:
     uint32_t count = 0;
   };
 
-  // State is what is going to be put in the priority queue. See the
-  // comment for FindPath for more information.
-  struct State
-  {
-    State(Vertex const & vertex, Weight const & distance, Weight const & heuristic)
-      : vertex(vertex)
-      , distance(distance)
-      , heuristic(heuristic)
-    {}
-    State(Vertex const & vertex, Weight const & distance) : State(vertex, distance, Weight()) {}
-
-    inline bool operator>(State const & rhs) const { return distance > rhs.distance; }
-
-    Vertex vertex;
-    Weight distance;
-    Weight heuristic;
-  };
-
   // BidirectionalStepContext keeps all the information that is needed to
   // search starting from one of the two directions. Its main
   // purpose is to make the code that changes directions more readable.
@@ -252,12 +433,17 @@ private:
   {
     using Parents = typename Graph::Parents;
 
-    BidirectionalStepContext(bool forward, Vertex const & startVertex, Vertex const & finalVertex, Graph & graph)
+    BidirectionalStepContext(bool forward, Vertex const & startVertex, Vertex const & finalVertex, Graph & graph,
+                             typename Storage::Wave & wave)
       : forward(forward)
       , startVertex(startVertex)
       , finalVertex(finalVertex)
       , graph(graph)
+      , queue(wave.m_queue)
+      , bestDistance(wave.m_distances)
+      , parent(wave.m_parents)
     {
+      wave.Clear();
       bestVertex = forward ? startVertex : finalVertex;
       pS = ConsistentHeuristic(bestVertex);
       graph.SetAStarParents(forward, parent);
@@ -339,20 +525,87 @@ private:
     Vertex const & finalVertex;
     Graph & graph;
 
-    std::priority_queue<State, std::vector<State>, std::greater<State>> queue;
-    ska::bytell_hash_map<Vertex, Weight> bestDistance;
-    Parents parent;
+    Queue & queue;
+    ska::bytell_hash_map<Vertex, Weight> & bestDistance;
+    Parents & parent;
     Vertex bestVertex;
 
     Weight pS;
   };
 
+  // A wave of FindPathBidirectionalParallel(). |m_mutex| guards distances and parents of the wave
+  // which are written by the wave thread and read by the other one.
+  struct ParallelWave
+  {
+    ParallelWave(bool forward, Vertex const & startVertex, Vertex const & finalVertex, Graph & graph,
+                 typename Storage::Wave & wave)
+      : m_context(forward, startVertex, finalVertex, graph, wave)
+    {}
+
+    BidirectionalStepContext m_context;
+    std::mutex m_mutex;
+  };
+
+  // Meeting point and stop conditions shared by the waves of FindPathBidirectionalParallel().
+  struct ParallelWavesState
+  {
+    // Guards all the fields except for atomic ones.
+    std::mutex m_mutex;
+    // Reduced distances of the queue tops of the forward and the backward waves.
+    std::array<Weight, 2> m_topDistances = {kZeroDistance, kZeroDistance};
+    bool m_foundAnyPath = false;
+    Weight m_bestPathReducedLength = kZeroDistance;
+    Weight m_bestPathRealLength = kZeroDistance;
+    Vertex m_bestForwardVertex;
+    Vertex m_bestBackwardVertex;
+
+    std::atomic<bool> m_stop = false;
+    std::atomic<bool> m_cancelled = false;
+  };
+
+  // Storage of a search: |m_storage| of the algorithm if it's set and isn't used by another search or
+  // an own storage of the search otherwise.
+  class StorageGuard final
+  {
+  public:
+    explicit StorageGuard(Storage * storage)
+    {
+      if (storage == nullptr || storage->m_isUsed)
+        storage = &m_ownStorage.emplace();
+
+      m_storage = storage;
+      m_storage->m_isUsed = true;
+    }
+
+    ~StorageGuard()
+    {
+      m_storage->m_isUsed = false;
+      for (auto & wave : m_storage->m_waves)
+        if (wave.m_distances.size() > m_storage->m_maxKeptVertices)
+          wave.Release();
+    }
+
+    typename Storage::Wave & GetWave(bool forward) { return m_storage->GetWave(forward); }
+
+  private:
+    std::optional<Storage> m_ownStorage;
+    Storage * m_storage = nullptr;
+  };
+
+  template <class P>
+  void PropagateParallelWave(P & params, ParallelWave & cur, ParallelWave & nxt, ParallelWavesState & state) const;
+
+  // Fills |tree| with the vertices of |prevRoute| and their remaining distances along the route.
+  static void FillBackwardTree(std::vector<Edge> const & prevRoute, BackwardTree & tree);
+
   static void ReconstructPath(Vertex const & v, typename BidirectionalStepContext::Parents const & parent,
                               std::vector<Vertex> & path);
   static void ReconstructPathBidirectional(Vertex const & v, Vertex const & w,
                                            typename BidirectionalStepContext::Parents const & parentV,
                                            typename BidirectionalStepContext::Parents const & parentW,
                                            std::vector<Vertex> & path);
+
+  Storage * m_storage = nullptr;
 };
 
 template <typename Vertex, typename Edge, typename Weight>
@@ -373,7 +626,7 @@ void AStarAlgorithm<Vertex, Edge, Weight>::PropagateWave(Graph & graph, Vertex c
 
   context.Clear();
 
-  std::priority_queue<State, std::vector<State>, std::greater<State>> queue;
+  auto & queue = context.GetQueue();
 
   context.SetDistance(startVertex, kZeroDistance);
   queue.push(State(startVertex, kZeroDistance));
@@ -529,8 +782,9 @@ typename AStarAlgorithm<Vertex, Edge, Weight>::Result AStarAlgorithm<Vertex, Edg
   auto const & finalVertex = params.m_finalVertex;
   auto const & startVertex = params.m_startVertex;
 
-  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph);
-  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph);
+  StorageGuard storage(m_storage);
+  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph, storage.GetWave(true));
+  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph, storage.GetWave(false));
 
   auto & forwardParents = forward.GetParents();
   auto & backwardParents = backward.GetParents();
@@ -688,14 +942,534 @@ typename AStarAlgorithm<Vertex, Edge, Weight>::Result AStarAlgorithm<Vertex, Edg
   return Result::NoPath;
 }
 
+template <typename Vertex, typename Edge, typename Weight>
+template <class P>
+typename AStarAlgorithm<Vertex, Edge, Weight>::Result
+AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectionalAlternatives(
+    P & params, AlternativesParams const & alternativesParams,
+    std::vector<RoutingResult<Vertex, Weight>> & results) const
+{
+  // Max number of via vertices which routes are reconstructed.
+  size_t constexpr kMaxViaCandidatesCount = 64;
+
+  results.clear();
+
+  auto const epsilon = params.m_weightEpsilon;
+  auto & graph = params.m_graph;
+  auto const & finalVertex = params.m_finalVertex;
+  auto const & startVertex = params.m_startVertex;
+
+  StorageGuard storage(m_storage);
+  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph, storage.GetWave(true));
+  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph, storage.GetWave(false));
+
+  auto & forwardParents = forward.GetParents();
+  auto & backwardParents = backward.GetParents();
+
+  // p_f(v) + p_r(v) = 0, so the real weight of a path through v is the sum of the reduced distances
+  // of v in both waves and |pathConst|.
+  Weight const pathConst = forward.pS + backward.pS;
+  double const stretch = 1.0 + alternativesParams.m_maxStretch;
+
+  bool foundAnyPath = false;
+  bool isBestPathProved = false;
+  Weight bestPathReducedLength = kZeroDistance;
+  Weight bestPathRealLength = kZeroDistance;
+  Weight maxPathReducedLength = kZeroDistance;
+  uint32_t maxSteps = 0;
+
+  forward.UpdateDistance(State(startVertex, kZeroDistance));
+  forward.queue.push(State(startVertex, kZeroDistance, forward.ConsistentHeuristic(startVertex)));
+
+  backward.UpdateDistance(State(finalVertex, kZeroDistance));
+  backward.queue.push(State(finalVertex, kZeroDistance, backward.ConsistentHeuristic(finalVertex)));
+
+  BidirectionalStepContext * cur = &forward;
+  BidirectionalStepContext * nxt = &backward;
+
+  auto const TakeBestPath = [&]()
+  {
+    results.emplace_back();
+    ReconstructPathBidirectional(forward.bestVertex, backward.bestVertex, forwardParents, backwardParents,
+                                 results.back().m_path);
+    results.back().m_distance = bestPathRealLength;
+  };
+
+  typename Graph::EdgeListT adj;
+
+  uint32_t steps = 0;
+  PeriodicPollCancellable periodicCancellable(params.m_cancellable);
+
+  while (true)
+  {
+    if (cur->queue.empty() || nxt->queue.empty())
+    {
+      // No path is found if a wave is exhausted before the waves meet. Otherwise the other wave
+      // may still reach vertices of the exhausted one which are vertices of alternatives.
+      if (!foundAnyPath || (cur->queue.empty() && nxt->queue.empty()))
+        break;
+
+      if (cur->queue.empty())
+        std::swap(cur, nxt);
+    }
+
+    ++steps;
+
+    if (periodicCancellable.IsCancelled())
+      return Result::Cancelled;
+
+    if (steps % kQueueSwitchPeriod == 0 && !nxt->queue.empty())
+      std::swap(cur, nxt);
+
+    if (foundAnyPath)
+    {
+      // Distances of an exhausted wave are final and not less than zero.
+      auto const topsLength = cur->TopDistance() + (nxt->queue.empty() ? kZeroDistance : nxt->TopDistance());
+
+      // The same stop condition as the one of FindPathBidirectionalEx(). Parents of the best path
+      // vertices may be changed by the waves later, so the path is reconstructed now.
+      if (!isBestPathProved && topsLength >= bestPathReducedLength - epsilon)
+      {
+        isBestPathProved = true;
+        maxSteps = steps + static_cast<uint32_t>(alternativesParams.m_maxExtraSearch * steps);
+        TakeBestPath();
+        if (!alternativesParams.IsEnabled())
+          return Result::OK;
+      }
+
+      // Paths through the vertices which are not reached by both waves are too long now.
+      if (isBestPathProved && (steps > maxSteps || topsLength >= maxPathReducedLength - epsilon))
+        break;
+    }
+
+    State const stateV = cur->queue.top();
+    cur->queue.pop();
+
+    if (cur->ExistsStateWithBetterDistance(stateV))
+      continue;
+
+    auto const endV = cur->forward ? cur->finalVertex : cur->startVertex;
+    params.m_onVisitedVertexCallback(std::make_pair(stateV, cur), endV);
+
+    cur->GetAdjacencyList(stateV, adj);
+    auto const & pV = stateV.heuristic;
+    for (auto const & edge : adj)
+    {
+      State stateW(edge.GetTarget(), kZeroDistance);
+
+      if (stateV.vertex == stateW.vertex)
+        continue;
+
+      auto const weight = edge.GetWeight();
+      auto const pW = cur->ConsistentHeuristic(stateW.vertex);
+      auto const reducedWeight = weight + pW - pV;
+
+      if (reducedWeight < -epsilon && params.m_badReducedWeight(reducedWeight, std::max(pW, pV)))
+      {
+        LOG(LERROR,
+            ("Invariant violated for:", "v =", stateV.vertex, "w =", stateW.vertex, "reduced weight =", reducedWeight));
+      }
+
+      stateW.distance = stateV.distance + std::max(reducedWeight, kZeroDistance);
+
+      auto const fullLength = weight + stateV.distance + cur->pS - pV;
+      if (!params.m_checkLengthCallback(fullLength))
+        continue;
+
+      if (cur->ExistsStateWithBetterDistance(stateW, epsilon))
+        continue;
+
+      stateW.heuristic = pW;
+      cur->UpdateDistance(stateW);
+      cur->UpdateParent(stateW.vertex, stateV.vertex);
+
+      if (auto op = nxt->GetDistance(stateW.vertex); op && !isBestPathProved)
+      {
+        auto const curPathReducedLength = stateW.distance + *op;
+        if ((!foundAnyPath || bestPathReducedLength > curPathReducedLength) &&
+            graph.AreWavesConnectible(forwardParents, stateW.vertex, backwardParents))
+        {
+          bestPathReducedLength = curPathReducedLength;
+
+          bestPathRealLength = stateV.distance + weight + *op;
+          bestPathRealLength += cur->pS - pV;
+          bestPathRealLength += nxt->pS - nxt->ConsistentHeuristic(stateW.vertex);
+          maxPathReducedLength = stretch * bestPathRealLength - pathConst;
+
+          foundAnyPath = true;
+          cur->bestVertex = stateV.vertex;
+          nxt->bestVertex = stateW.vertex;
+        }
+      }
+
+      if (stateW.vertex != endV)
+        cur->queue.push(stateW);
+    }
+  }
+
+  if (!foundAnyPath)
+    return Result::NoPath;
+
+  if (!isBestPathProved)
+    TakeBestPath();
+
+  if (!alternativesParams.IsEnabled())
+    return Result::OK;
+
+  Weight const maxPathLength = stretch * bestPathRealLength;
+  std::vector<std::pair<Weight, Vertex>> viaVertices;
+  for (auto const & [vertex, forwardDistance] : forward.bestDistance)
+  {
+    auto const backwardDistance = backward.GetDistance(vertex);
+    if (!backwardDistance)
+      continue;
+
+    Weight const length = forwardDistance + *backwardDistance + pathConst;
+    if (length <= maxPathLength)
+      viaVertices.emplace_back(length, vertex);
+  }
+  std::sort(viaVertices.begin(), viaVertices.end(), [](auto const & l, auto const & r) { return l.first < r.first; });
+
+  auto const GetRealDistance = [](BidirectionalStepContext const & context, Vertex const & vertex)
+  { return *context.GetDistance(vertex) + context.pS - context.ConsistentHeuristic(vertex); };
+
+  // Vertices of the routes which are taken.
+  std::unordered_set<Vertex> routesVertices(results.front().m_path.cbegin(), results.front().m_path.cend());
+  // Vertices of the routes which are taken or rejected. Via routes through them are alike to the tried ones.
+  std::unordered_set<Vertex> triedVertices = routesVertices;
+  std::unordered_set<Vertex> pathVertices;
+  std::vector<Vertex> backwardPath;
+  size_t viaCandidatesCount = 0;
+
+  for (auto const & [length, via] : viaVertices)
+  {
+    if (results.size() > alternativesParams.m_maxAlternatives || viaCandidatesCount == kMaxViaCandidatesCount)
+      break;
+
+    if (triedVertices.count(via) != 0 || !graph.AreWavesConnectible(forwardParents, via, backwardParents))
+      continue;
+
+    ++viaCandidatesCount;
+
+    RoutingResult<Vertex, Weight> result;
+    ReconstructPath(via, forwardParents, result.m_path);
+    size_t const viaIdx = result.m_path.size() - 1;
+    ReconstructPath(via, backwardParents, backwardPath);
+    result.m_path.insert(result.m_path.end(), std::next(backwardPath.rbegin()), backwardPath.rend());
+    result.m_distance = length;
+
+    // Weight of an edge is the difference of the real distances of its vertices from the start.
+    Weight const viaForwardDistance = GetRealDistance(forward, via);
+    Weight const viaBackwardDistance = GetRealDistance(backward, via);
+    auto const GetDistanceFromStart = [&](size_t i)
+    {
+      if (i <= viaIdx)
+        return GetRealDistance(forward, result.m_path[i]);
+      return viaForwardDistance + viaBackwardDistance - GetRealDistance(backward, result.m_path[i]);
+    };
+
+    bool hasLoop = false;
+    Weight sharedLength = kZeroDistance;
+    Weight prevDistance = GetDistanceFromStart(0);
+    pathVertices.clear();
+    pathVertices.insert(result.m_path.front());
+    for (size_t i = 1; i < result.m_path.size(); ++i)
+    {
+      auto const & from = result.m_path[i - 1];
+      auto const & to = result.m_path[i];
+      hasLoop = hasLoop || !pathVertices.insert(to).second;
+
+      Weight const distance = GetDistanceFromStart(i);
+      if (routesVertices.count(from) != 0 && routesVertices.count(to) != 0)
+        sharedLength += distance - prevDistance;
+      prevDistance = distance;
+    }
+
+    triedVertices.insert(result.m_path.cbegin(), result.m_path.cend());
+    if (hasLoop || sharedLength > alternativesParams.m_maxSharing * length)
+      continue;
+
+    routesVertices.insert(result.m_path.cbegin(), result.m_path.cend());
+    results.push_back(std::move(result));
+  }
+
+  return Result::OK;
+}
+
+template <typename Vertex, typename Edge, typename Weight>
+template <class P, class BackwardP>
+typename AStarAlgorithm<Vertex, Edge, Weight>::Result AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectionalParallel(
+    P & params, BackwardP & backwardParams, RoutingResult<Vertex, Weight> & result) const
+{
+  auto const & finalVertex = params.m_finalVertex;
+  auto const & startVertex = params.m_startVertex;
+  ASSERT(startVertex == backwardParams.m_startVertex, ());
+  ASSERT(finalVertex == backwardParams.m_finalVertex, ());
+
+  StorageGuard storage(m_storage);
+  ParallelWave forward(true /* forward */, startVertex, finalVertex, params.m_graph, storage.GetWave(true));
+  ParallelWave backward(false /* forward */, startVertex, finalVertex, backwardParams.m_graph, storage.GetWave(false));
+
+  forward.m_context.UpdateDistance(State(startVertex, kZeroDistance));
+  forward.m_context.queue.push(State(startVertex, kZeroDistance, forward.m_context.ConsistentHeuristic(startVertex)));
+
+  backward.m_context.UpdateDistance(State(finalVertex, kZeroDistance));
+  backward.m_context.queue.push(
+      State(finalVertex, kZeroDistance, backward.m_context.ConsistentHeuristic(finalVertex)));
+
+  ParallelWavesState state;
+  std::exception_ptr backwardException;
+  threads::SimpleThread backwardThread([&]()
+  {
+    try
+    {
+      PropagateParallelWave(backwardParams, backward, forward, state);
+    }
+    catch (...)
+    {
+      backwardException = std::current_exception();
+      state.m_stop = true;
+    }
+  });
+
+  try
+  {
+    PropagateParallelWave(params, forward, backward, state);
+  }
+  catch (...)
+  {
+    state.m_stop = true;
+    backwardThread.join();
+    throw;
+  }
+
+  backwardThread.join();
+  if (backwardException)
+    std::rethrow_exception(backwardException);
+
+  if (state.m_cancelled)
+    return Result::Cancelled;
+
+  if (!state.m_foundAnyPath)
+    return Result::NoPath;
+
+  result.Clear();
+  ReconstructPathBidirectional(state.m_bestForwardVertex, state.m_bestBackwardVertex, forward.m_context.parent,
+                               backward.m_context.parent, result.m_path);
+  result.m_distance = state.m_bestPathRealLength;
+  return Result::OK;
+}
+
+template <typename Vertex, typename Edge, typename Weight>
+template <class P>
+void AStarAlgorithm<Vertex, Edge, Weight>::PropagateParallelWave(P & params, ParallelWave & cur, ParallelWave & nxt,
+                                                                 ParallelWavesState & state) const
+{
+  auto const epsilon = params.m_weightEpsilon;
+  auto & curContext = cur.m_context;
+  auto & nxtContext = nxt.m_context;
+  auto & forwardParents = curContext.forward ? curContext.GetParents() : nxtContext.GetParents();
+  auto & backwardParents = curContext.forward ? nxtContext.GetParents() : curContext.GetParents();
+  size_t const curIdx = curContext.forward ? 0 : 1;
+  auto const endV = curContext.forward ? curContext.finalVertex : curContext.startVertex;
+
+  typename Graph::EdgeListT adj;
+  PeriodicPollCancellable periodicCancellable(params.m_cancellable);
+
+  // The waves stop together: when a path is proved to be the best one or when any of the queues
+  // is exhausted, see FindPathBidirectionalEx() for details.
+  while (!state.m_stop && !curContext.queue.empty())
+  {
+    if (periodicCancellable.IsCancelled())
+    {
+      state.m_cancelled = true;
+      break;
+    }
+
+    {
+      auto const curTop = curContext.TopDistance();
+      std::lock_guard guard(state.m_mutex);
+      state.m_topDistances[curIdx] = curTop;
+      // The other wave top distance may be outdated. It only grows, so the check is conservative.
+      if (state.m_foundAnyPath &&
+          curTop + state.m_topDistances[1 - curIdx] >= state.m_bestPathReducedLength - epsilon)
+      {
+        break;
+      }
+    }
+
+    State const stateV = curContext.queue.top();
+    curContext.queue.pop();
+
+    // Distances of the wave are written by this thread only, so they may be read without a lock.
+    if (curContext.ExistsStateWithBetterDistance(stateV))
+      continue;
+
+    params.m_onVisitedVertexCallback(std::make_pair(stateV, &curContext), endV);
+
+    curContext.GetAdjacencyList(stateV, adj);
+    auto const & pV = stateV.heuristic;
+    for (auto const & edge : adj)
+    {
+      State stateW(edge.GetTarget(), kZeroDistance);
+
+      if (stateV.vertex == stateW.vertex)
+        continue;
+
+      auto const weight = edge.GetWeight();
+      auto const pW = curContext.ConsistentHeuristic(stateW.vertex);
+      auto const reducedWeight = weight + pW - pV;
+
+      if (reducedWeight < -epsilon && params.m_badReducedWeight(reducedWeight, std::max(pW, pV)))
+      {
+        LOG(LERROR,
+            ("Invariant violated for:", "v =", stateV.vertex, "w =", stateW.vertex, "reduced weight =", reducedWeight));
+      }
+
+      stateW.distance = stateV.distance + std::max(reducedWeight, kZeroDistance);
+
+      auto const fullLength = weight + stateV.distance + curContext.pS - pV;
+      if (!params.m_checkLengthCallback(fullLength))
+        continue;
+
+      if (curContext.ExistsStateWithBetterDistance(stateW, epsilon))
+        continue;
+
+      stateW.heuristic = pW;
+      {
+        std::lock_guard guard(cur.m_mutex);
+        curContext.UpdateDistance(stateW);
+        curContext.UpdateParent(stateW.vertex, stateV.vertex);
+      }
+
+      // The distance is written before the other wave is checked, so at least one of the waves
+      // sees the meeting vertex in both waves.
+      std::scoped_lock lock(nxt.m_mutex, state.m_mutex);
+      if (auto const distW = nxtContext.GetDistance(stateW.vertex); distW)
+      {
+        auto const curPathReducedLength = stateW.distance + *distW;
+        if ((!state.m_foundAnyPath || state.m_bestPathReducedLength > curPathReducedLength) &&
+            params.m_graph.AreWavesConnectible(forwardParents, stateW.vertex, backwardParents))
+        {
+          state.m_bestPathReducedLength = curPathReducedLength;
+
+          // Potential of the other wave is the opposite one: p_r(v) = -p_f(v).
+          state.m_bestPathRealLength = stateV.distance + weight + *distW;
+          state.m_bestPathRealLength += curContext.pS - pV;
+          state.m_bestPathRealLength += nxtContext.pS + pW;
+
+          state.m_foundAnyPath = true;
+          state.m_bestForwardVertex = curContext.forward ? stateV.vertex : stateW.vertex;
+          state.m_bestBackwardVertex = curContext.forward ? stateW.vertex : stateV.vertex;
+        }
+      }
+
+      if (stateW.vertex != endV)
+        curContext.queue.push(stateW);
+    }
+  }
+
+  state.m_stop = true;
+}
+
+template <typename Vertex, typename Edge, typename Weight>
+template <typename P>
+typename AStarAlgorithm<Vertex, Edge, Weight>::Result AStarAlgorithm<Vertex, Edge, Weight>::BuildBackwardTree(
+    P & params, std::vector<Edge> const & prevRoute, size_t waveBeginIdx, size_t waveEndIdx, size_t maxTreeSize,
+    BackwardTree & tree) const
+{
+  auto & graph = params.m_graph;
+  auto const epsilon = params.m_weightEpsilon;
+  CHECK(!prevRoute.empty(), ());
+  CHECK_LESS_OR_EQUAL(waveBeginIdx, waveEndIdx, ());
+  CHECK_LESS_OR_EQUAL(waveEndIdx, prevRoute.size(), ());
+
+  FillBackwardTree(prevRoute, tree);
+
+  // Distances to the finish of the route vertices which the wave vertices are reached from.
+  // They are used to check the weights of detours to the route.
+  ska::bytell_hash_map<Vertex, Weight> routeDistances;
+  Queue queue;
+  for (size_t i = waveBeginIdx; i < waveEndIdx; ++i)
+  {
+    auto const & edge = prevRoute[i];
+    auto const distance = tree.GetDistance(edge.GetTarget());
+    CHECK(distance, ());
+    if (routeDistances.emplace(edge.GetTarget(), *distance).second)
+      queue.push(State(edge.GetTarget(), *distance));
+  }
+
+  graph.SetAStarParents(false /* forward */, tree.GetParents());
+  PeriodicPollCancellable periodicCancellable(params.m_cancellable);
+  typename Graph::EdgeListT adj;
+
+  while (!queue.empty())
+  {
+    State const stateV = queue.top();
+    queue.pop();
+
+    if (stateV.distance > *tree.GetDistance(stateV.vertex))
+      continue;
+
+    if (periodicCancellable.IsCancelled())
+    {
+      graph.DropAStarParents();
+      return Result::Cancelled;
+    }
+
+    // The vertices which are already in the tree keep their ways to the finish, though some of them
+    // could be improved by the rest of the wave.
+    if (tree.GetSize() >= maxTreeSize)
+      break;
+
+    auto const routeDistance = routeDistances.at(stateV.vertex);
+    astar::VertexData const vertexData(stateV.vertex, stateV.distance);
+    graph.GetIngoingEdgesList(vertexData, adj);
+    for (auto const & edge : adj)
+    {
+      auto const & vertexW = edge.GetTarget();
+      if (stateV.vertex == vertexW)
+        continue;
+
+      auto const newDistance = stateV.distance + edge.GetWeight();
+      auto const distanceW = tree.GetDistance(vertexW);
+      if (distanceW && newDistance >= *distanceW - epsilon)
+        continue;
+
+      if (!params.m_checkLengthCallback(newDistance - routeDistance))
+        continue;
+
+      tree.SetDistance(vertexW, newDistance);
+      tree.SetParent(vertexW, stateV.vertex);
+      routeDistances.insert_or_assign(vertexW, routeDistance);
+      queue.push(State(vertexW, newDistance));
+    }
+  }
+
+  graph.DropAStarParents();
+  return Result::OK;
+}
+
 template <typename Vertex, typename Edge, typename Weight>
 template <typename P>
 typename AStarAlgorithm<Vertex, Edge, Weight>::Result AStarAlgorithm<Vertex, Edge, Weight>::AdjustRoute(
     P & params, std::vector<Edge> const & prevRoute, RoutingResult<Vertex, Weight> & result) const
+{
+  CHECK(!prevRoute.empty(), ());
+
+  BackwardTree tree;
+  FillBackwardTree(prevRoute, tree);
+  return AdjustRoute(params, tree, result);
+}
+
+template <typename Vertex, typename Edge, typename Weight>
+template <typename P>
+typename AStarAlgorithm<Vertex, Edge, Weight>::Result AStarAlgorithm<Vertex, Edge, Weight>::AdjustRoute(
+    P & params, BackwardTree & tree, RoutingResult<Vertex, Weight> & result) const
 {
   auto & graph = params.m_graph;
   auto const & startVertex = params.m_startVertex;
-  CHECK(!prevRoute.empty(), ());
+  CHECK(!tree.IsEmpty(), ());
 
   result.Clear();
 
@@ -703,15 +1477,6 @@ typename AStarAlgorithm<Vertex, Edge, Weight>::Result AStarAlgorithm<Vertex, Edg
   auto minDistance = kInfiniteDistance;
   Vertex returnVertex;
 
-  std::map<Vertex, Weight> remainingDistances;
-  auto remainingDistance = kZeroDistance;
-
-  for (auto it = prevRoute.crbegin(); it != prevRoute.crend(); ++it)
-  {
-    remainingDistances[it->GetTarget()] = remainingDistance;
-    remainingDistance += it->GetWeight();
-  }
-
   Context context(graph);
   PeriodicPollCancellable periodicCancellable(params.m_cancellable);
 
@@ -723,17 +1488,20 @@ typename AStarAlgorithm<Vertex, Edge, Weight>::Result AStarAlgorithm<Vertex, Edg
       return false;
     }
 
+    // Vertices are visited in the order of distances and distances to the finish are not negative,
+    // so the rest of the vertices can't improve the best route.
+    auto const distance = context.GetDistance(vertex);
+    if (distance >= minDistance)
+      return false;
+
     params.m_onVisitedVertexCallback(startVertex, vertex);
 
-    auto it = remainingDistances.find(vertex);
-    if (it != remainingDistances.cend())
+    auto const remainingDistance = tree.GetDistance(vertex);
+    if (remainingDistance && distance + *remainingDistance < minDistance &&
+        graph.AreWavesConnectible(context.GetParents(), vertex, tree.GetParents()))
     {
-      auto const fullDistance = context.GetDistance(vertex) + it->second;
-      if (fullDistance < minDistance)
-      {
-        minDistance = fullDistance;
-        returnVertex = vertex;
-      }
+      minDistance = distance + *remainingDistance;
+      returnVertex = vertex;
     }
 
     return true;
@@ -753,27 +1521,34 @@ typename AStarAlgorithm<Vertex, Edge, Weight>::Result AStarAlgorithm<Vertex, Edg
     return Result::NoPath;
 
   context.ReconstructPath(returnVertex, result.m_path);
+  tree.AppendPathToFinish(returnVertex, result.m_path);
+  result.m_distance = minDistance;
+  return Result::OK;
+}
 
-  // Append remaining route.
-  bool found = false;
-  for (size_t i = 0; i < prevRoute.size(); ++i)
+// static
+template <typename Vertex, typename Edge, typename Weight>
+void AStarAlgorithm<Vertex, Edge, Weight>::FillBackwardTree(std::vector<Edge> const & prevRoute, BackwardTree & tree)
+{
+  tree.Clear();
+
+  // Vertices are added from the finish and the last occurrence of a vertex is kept, so the way to
+  // the finish skips the loops of the route.
+  std::optional<Vertex> next;
+  auto nextWeight = kZeroDistance;
+  for (auto it = prevRoute.crbegin(); it != prevRoute.crend(); ++it)
   {
-    if (prevRoute[i].GetTarget() == returnVertex)
+    Vertex const vertex = it->GetTarget();
+    if (!tree.GetDistance(vertex))
     {
-      for (size_t j = i + 1; j < prevRoute.size(); ++j)
-        result.m_path.push_back(prevRoute[j].GetTarget());
-
-      found = true;
-      break;
+      tree.SetDistance(vertex, next ? *tree.GetDistance(*next) + nextWeight : kZeroDistance);
+      if (next)
+        tree.SetParent(vertex, *next);
     }
-  }
 
-  CHECK(found, ("Can't find", returnVertex, ", prev:", prevRoute.size(), ", adjust:", result.m_path.size()));
-
-  auto const & it = remainingDistances.find(returnVertex);
-  CHECK(it != remainingDistances.end(), ());
-  result.m_distance = context.GetDistance(returnVertex) + it->second;
-  return Result::OK;
+    next = vertex;
+    nextWeight = it->GetWeight();
+  }
 }
 
 // static
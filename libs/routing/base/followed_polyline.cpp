@@ -78,6 +78,7 @@ void FollowedPolyline::Swap(FollowedPolyline & rhs)
   m_poly.Swap(rhs.m_poly);
   m_segDistance.swap(rhs.m_segDistance);
   m_segProj.swap(rhs.m_segProj);
+  m_segRects.swap(rhs.m_segRects);
   swap(m_current, rhs.m_current);
   swap(m_nextCheckpointIndex, rhs.m_nextCheckpointIndex);
 }
@@ -105,9 +106,33 @@ void FollowedPolyline::Update()
     m_segProj.emplace_back(p1, p2);
   }
 
+  BuildSegmentIndex();
   m_current = Iter(m_poly.Front(), 0);
 }
 
+void FollowedPolyline::BuildSegmentIndex()
+{
+  m_segRects.clear();
+  size_t const segmentsCount = m_segProj.size();
+  if (segmentsCount < kMinSegmentsForIndex)
+    return;
+
+  size_t leavesCount = 1;
+  while (leavesCount * kSegmentsPerLeaf < segmentsCount)
+    leavesCount *= 2;
+
+  // Rects of the leaves after the last segment stay empty and never intersect anything.
+  m_segRects.resize(2 * leavesCount);
+  for (size_t i = 0; i < segmentsCount; ++i)
+    m_segRects[leavesCount + i / kSegmentsPerLeaf].Add(m2::RectD(m_poly.GetPoint(i), m_poly.GetPoint(i + 1)));
+
+  for (size_t node = leavesCount - 1; node > 0; --node)
+  {
+    m_segRects[node] = m_segRects[2 * node];
+    m_segRects[node].Add(m_segRects[2 * node + 1]);
+  }
+}
+
 bool FollowedPolyline::IsFakeSegment(size_t index) const
 {
   return binary_search(m_fakeSegmentIndexes.begin(), m_fakeSegmentIndexes.end(), index);
@@ -220,20 +245,20 @@ Iter FollowedPolyline::GetClosestMatchingProjectionInInterval(m2::RectD const &
 
   m2::PointD const currPos = posRect.Center();
 
-  for (size_t i = startIdx; i < endIdx; ++i)
+  ForEachSegmentNearRect(posRect, startIdx, endIdx, [&](size_t i)
   {
     m2::PointD const pt = m_segProj[i].ClosestPointTo(currPos);
 
     if (!posRect.IsPointInside(pt))
-      continue;
+      return;
 
     double const dp = mercator::DistanceOnEarth(pt, currPos);
     if (dp >= minDist)
-      continue;
+      return;
 
     nearestIter = Iter(pt, i);
     minDist = dp;
-  }
+  });
 
   return nearestIter;
 }
@@ -6,6 +6,7 @@
 #include "geometry/polyline2d.hpp"
 #include "geometry/rect2d.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <limits>
 #include <vector>
@@ -15,6 +16,10 @@ namespace routing
 class FollowedPolyline
 {
 public:
+  /// Polylines with at least this number of segments get a spatial index of segments, so projection
+  /// to a long route doesn't scan all its segments.
+  static size_t constexpr kMinSegmentsForIndex = 512;
+
   FollowedPolyline() = default;
 
   template <typename Iter>
@@ -102,12 +107,12 @@ public:
     Iter res;
     double minDist = std::numeric_limits<double>::max();
 
-    for (size_t i = startIdx; i < endIdx; ++i)
+    ForEachSegmentNearRect(posRect, startIdx, endIdx, [&](size_t i)
     {
       m2::PointD const & pt = m_segProj[i].ClosestPointTo(posRect.Center());
 
       if (!posRect.IsPointInside(pt))
-        continue;
+        return;
 
       Iter it(pt, i);
       double const dp = distFn(it);
@@ -116,7 +121,7 @@ public:
         res = it;
         minDist = dp;
       }
-    }
+    });
 
     return res;
   }
@@ -135,7 +140,44 @@ private:
 
   Iter GetBestMatchingProjection(m2::RectD const & posRect) const;
 
+  /// \brief Calls |fn| in increasing order for indexes of segments from [startIdx, endIdx)
+  /// which may have points inside |rect|. Without |m_segRects| all the indexes are visited.
+  template <typename Fn>
+  void ForEachSegmentNearRect(m2::RectD const & rect, size_t startIdx, size_t endIdx, Fn && fn) const
+  {
+    if (m_segRects.empty())
+    {
+      for (size_t i = startIdx; i < endIdx; ++i)
+        fn(i);
+      return;
+    }
+
+    size_t const leavesCount = m_segRects.size() / 2;
+    ForEachSegmentInSubtree(rect, startIdx, endIdx, 1 /* node */, 0 /* nodeBegin */,
+                            leavesCount * kSegmentsPerLeaf /* nodeEnd */, fn);
+  }
+
+  template <typename Fn>
+  void ForEachSegmentInSubtree(m2::RectD const & rect, size_t startIdx, size_t endIdx, size_t node,
+                               size_t nodeBegin, size_t nodeEnd, Fn & fn) const
+  {
+    if (nodeEnd <= startIdx || endIdx <= nodeBegin || !m_segRects[node].IsIntersect(rect))
+      return;
+
+    if (nodeEnd - nodeBegin == kSegmentsPerLeaf)
+    {
+      for (size_t i = std::max(startIdx, nodeBegin); i < std::min(endIdx, nodeEnd); ++i)
+        fn(i);
+      return;
+    }
+
+    size_t const nodeMiddle = nodeBegin + (nodeEnd - nodeBegin) / 2;
+    ForEachSegmentInSubtree(rect, startIdx, endIdx, 2 * node, nodeBegin, nodeMiddle, fn);
+    ForEachSegmentInSubtree(rect, startIdx, endIdx, 2 * node + 1, nodeMiddle, nodeEnd, fn);
+  }
+
   void Update();
+  void BuildSegmentIndex();
 
   m2::PolylineD m_poly;
   /// Indexes of all unmatching segments on route.
@@ -148,5 +190,10 @@ private:
   std::vector<m2::ParametrizedSegment<m2::PointD>> m_segProj;
   /// Accumulated cache of segments length in meters.
   std::vector<double> m_segDistance;
+
+  static size_t constexpr kSegmentsPerLeaf = 8;
+  /// Implicit segment tree of bounding rects of |m_segProj| for long polylines, empty for short ones.
+  /// Node 1 is the root, children of node k are 2k and 2k + 1. A leaf covers kSegmentsPerLeaf segments.
+  std::vector<m2::RectD> m_segRects;
 };
 }  // namespace routing
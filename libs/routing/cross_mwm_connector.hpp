@@ -11,8 +11,10 @@
 #include "base/assert.hpp"
 #include "base/buffer_vector.hpp"
 
+#include <algorithm>
+#include <optional>
 #include <string>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace routing
@@ -82,8 +84,9 @@ public:
   /// @return {} if there is no transition for such cross mwm id.
   std::optional<Segment> GetTransition(CrossMwmId const & crossMwmId, uint32_t segmentIdx, bool isEnter) const
   {
-    auto const fIt = m_crossMwmIdToFeatureId.find(crossMwmId);
-    if (fIt == m_crossMwmIdToFeatureId.cend())
+    auto const fIt = std::lower_bound(m_crossMwmIdToFeatureId.cbegin(), m_crossMwmIdToFeatureId.cend(), crossMwmId,
+                                      LessIF());
+    if (fIt == m_crossMwmIdToFeatureId.cend() || !(fIt->first == crossMwmId))
       return {};
 
     uint32_t const featureId = fIt->second;
@@ -196,7 +199,7 @@ public:
   size_t GetMemorySize() const
   {
     return (m_transitions.capacity() * sizeof(KeyTransitionT) +
-            m_crossMwmIdToFeatureId.size() * sizeof(typename MwmID2FeatureIDMapT::value_type) +
+            m_crossMwmIdToFeatureId.capacity() * sizeof(IdFeatureT) +
             m_weights.GetMemorySize());
   }
 
@@ -280,8 +283,16 @@ private:
   };
   std::vector<KeyTransitionT> m_transitions;
 
-  using MwmID2FeatureIDMapT = std::unordered_map<CrossMwmId, uint32_t, connector::HashKey>;
-  MwmID2FeatureIDMapT m_crossMwmIdToFeatureId;
+  // Sorted by cross mwm id, so it's searched without building a hash map on connector loading.
+  // The first feature is kept for an id if there are several ones.
+  using IdFeatureT = std::pair<CrossMwmId, uint32_t>;
+  struct LessIF
+  {
+    bool operator()(IdFeatureT const & l, IdFeatureT const & r) const { return l.first < r.first; }
+    bool operator()(IdFeatureT const & l, CrossMwmId const & r) const { return l.first < r; }
+    bool operator()(CrossMwmId const & l, IdFeatureT const & r) const { return l < r.first; }
+  };
+  std::vector<IdFeatureT> m_crossMwmIdToFeatureId;
 
   // Weight is the time required for the route to pass edge, measured in seconds rounded upwards.
   struct Weights
@@ -72,6 +72,26 @@ public:
 
   void AddTransition(CrossMwmId const & crossMwmId, uint32_t featureId, uint32_t segmentIdx, bool oneWay,
                      bool forwardIsEnter)
+  {
+    PushTransition(crossMwmId, featureId, segmentIdx, oneWay, forwardIsEnter);
+
+    // Keep transitions and ids sorted after every transition, they are added one by one in tests only.
+    auto & transitions = m_c.m_transitions;
+    auto const trIt = std::upper_bound(transitions.begin(), transitions.end() - 1, transitions.back(),
+                                       typename ConnectorT::LessKT());
+    std::rotate(trIt, transitions.end() - 1, transitions.end());
+
+    auto & ids = m_c.m_crossMwmIdToFeatureId;
+    auto const idIt = std::upper_bound(ids.begin(), ids.end() - 1, ids.back(), typename ConnectorT::LessIF());
+    if (idIt != ids.begin() && std::prev(idIt)->first == ids.back().first)
+      ids.pop_back();
+    else
+      std::rotate(idIt, ids.end() - 1, ids.end());
+  }
+
+protected:
+  void PushTransition(CrossMwmId const & crossMwmId, uint32_t featureId, uint32_t segmentIdx, bool oneWay,
+                      bool forwardIsEnter)
   {
     featureId += m_featureNumerationOffset;
 
@@ -91,21 +111,28 @@ public:
     }
 
     m_c.m_transitions.emplace_back(typename ConnectorT::Key(featureId, segmentIdx), transition);
-    m_c.m_crossMwmIdToFeatureId.emplace(crossMwmId, featureId);
+    m_c.m_crossMwmIdToFeatureId.emplace_back(crossMwmId, featureId);
   }
 
-protected:
   template <class GetTransition>
   void FillTransitions(size_t count, VehicleType requiredVehicle, GetTransition && getter)
   {
     auto const vhMask = GetVehicleMask(requiredVehicle);
 
     m_c.m_transitions.reserve(count);
+    m_c.m_crossMwmIdToFeatureId.reserve(count);
     for (size_t i = 0; i < count; ++i)
       AddTransition(getter(i), vhMask);
 
     // Sort by FeatureID to make lower_bound queries.
     std::sort(m_c.m_transitions.begin(), m_c.m_transitions.end(), typename ConnectorT::LessKT());
+
+    // Sort by CrossMwmId to make lower_bound queries. Stable sort keeps the first feature of an id.
+    auto & ids = m_c.m_crossMwmIdToFeatureId;
+    std::stable_sort(ids.begin(), ids.end(), typename ConnectorT::LessIF());
+    ids.erase(std::unique(ids.begin(), ids.end(), [](auto const & l, auto const & r) { return l.first == r.first; }),
+              ids.end());
+    ids.shrink_to_fit();
   }
 
   class Transition final
@@ -342,7 +369,7 @@ protected:
       return false;
 
     bool const isOneWay = (transition.GetOneWayMask() & requiredMask) != 0;
-    AddTransition(transition.GetCrossMwmId(), transition.GetFeatureId(), transition.GetSegmentIdx(), isOneWay,
+    PushTransition(transition.GetCrossMwmId(), transition.GetFeatureId(), transition.GetSegmentIdx(), isOneWay,
                   transition.ForwardIsEnter());
     return true;
   }
@@ -62,8 +62,20 @@ bool CrossMwmGraph::GetAllLoadedNeighbors(NumMwmId numMwmId, vector<NumMwmId> &
 
 void CrossMwmGraph::DeserializeTransitions(vector<NumMwmId> const & mwmIds)
 {
-  for (auto mwmId : mwmIds)
-    m_crossMwmIndexGraph.LoadCrossMwmConnectorWithTransitions(mwmId);
+  m_crossMwmIndexGraph.LoadCrossMwmConnectors(mwmIds, false /* withWeights */);
+}
+
+void CrossMwmGraph::LoadCrossMwmConnectors(vector<NumMwmId> const & mwmIds)
+{
+  vector<NumMwmId> existingMwmIds;
+  existingMwmIds.reserve(mwmIds.size());
+  for (auto const mwmId : mwmIds)
+  {
+    if (GetCrossMwmStatus(mwmId) == MwmStatus::SectionExists)
+      existingMwmIds.push_back(mwmId);
+  }
+
+  m_crossMwmIndexGraph.LoadCrossMwmConnectors(existingMwmIds, true /* withWeights */);
 }
 
 void CrossMwmGraph::DeserializeTransitTransitions(vector<NumMwmId> const & mwmIds)
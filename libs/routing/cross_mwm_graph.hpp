@@ -88,6 +88,10 @@ public:
 
   RouteWeight GetWeightSure(Segment const & from, Segment const & to);
 
+  /// \brief Loads connectors with weights of |mwmIds| in parallel to warm up cross mwm routing.
+  /// Mwms which are not loaded or have no cross mwm section are skipped.
+  void LoadCrossMwmConnectors(std::vector<NumMwmId> const & mwmIds);
+
   // void Clear();
   void Purge();
 
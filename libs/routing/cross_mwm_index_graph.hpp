@@ -17,11 +17,18 @@
 #include "indexer/data_source.hpp"
 
 #include "base/logging.hpp"
+#include "base/thread.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <exception>
 #include <map>
 #include <memory>
+#include <set>
+#include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace routing
@@ -168,6 +175,84 @@ public:
 
   void LoadCrossMwmConnectorWithTransitions(NumMwmId numMwmId) { GetCrossMwmConnectorWithTransitions(numMwmId); }
 
+  /// \brief Loads connectors of |mwmIds| which are not in the cache. Weights are loaded too
+  /// if |withWeights|. Connectors of different mwms are deserialized in parallel threads,
+  /// the threads read sections of their own mwms only.
+  void LoadCrossMwmConnectors(std::vector<NumMwmId> const & mwmIds, bool withWeights)
+  {
+    struct Task
+    {
+      Task(NumMwmId numMwmId, FilesContainerR::TReader && reader)
+        : m_mwmId(numMwmId)
+        , m_reader(std::move(reader))
+        , m_connector(numMwmId)
+      {}
+
+      NumMwmId m_mwmId;
+      FilesContainerR::TReader m_reader;
+      CrossMwmConnector<CrossMwmId> m_connector;
+      std::exception_ptr m_exception;
+    };
+
+    // Handles and readers are taken in this thread, |m_dataSource| is not thread-safe.
+    std::vector<Task> tasks;
+    std::set<NumMwmId> taskMwmIds;
+    for (NumMwmId const numMwmId : mwmIds)
+    {
+      auto const it = m_connectors.find(numMwmId);
+      if (it != m_connectors.cend())
+      {
+        if (withWeights)
+          GetCrossMwmConnectorWithWeights(numMwmId);
+        continue;
+      }
+
+      if (taskMwmIds.insert(numMwmId).second)
+        tasks.emplace_back(numMwmId, connector::GetReader<CrossMwmId>(m_dataSource.GetMwmValue(numMwmId).m_cont));
+    }
+
+    if (tasks.empty())
+      return;
+
+    std::atomic<size_t> nextTask = 0;
+    auto const deserialize = [&]()
+    {
+      for (size_t i = nextTask++; i < tasks.size(); i = nextTask++)
+      {
+        auto & task = tasks[i];
+        try
+        {
+          CrossMwmConnectorBuilder<CrossMwmId> builder(task.m_connector);
+          builder.ApplyNumerationOffset();
+          builder.DeserializeTransitions(m_vehicleType, task.m_reader);
+          if (withWeights && !task.m_connector.WeightsWereLoaded())
+            builder.DeserializeWeights(task.m_reader);
+        }
+        catch (...)
+        {
+          task.m_exception = std::current_exception();
+        }
+      }
+    };
+
+    size_t const threadsCount = std::min<size_t>(tasks.size(), std::max(1U, std::thread::hardware_concurrency()));
+    std::vector<threads::SimpleThread> threads;
+    threads.reserve(threadsCount - 1);
+    for (size_t i = 1; i < threadsCount; ++i)
+      threads.emplace_back(deserialize);
+    deserialize();
+    for (auto & thread : threads)
+      thread.join();
+
+    for (auto & task : tasks)
+    {
+      if (task.m_exception)
+        std::rethrow_exception(task.m_exception);
+
+      m_connectors.emplace(task.m_mwmId, std::move(task.m_connector));
+    }
+  }
+
   template <class FnT>
   void ForEachTransition(NumMwmId numMwmId, bool isEnter, FnT && fn)
   {
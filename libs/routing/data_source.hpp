@@ -8,7 +8,9 @@
 #include "base/lru_cache.hpp"
 
 #include <map>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace routing
 {
@@ -103,6 +105,22 @@ public:
     m_dataSource.ForEachInRect(fn, rect, scales::GetUpperScale());
   }
 
+  /// Calls |fn(MwmSet::MwmId const &)| for every country mwm which borders intersect |rect|.
+  template <class FnT>
+  void ForEachCountryInRect(FnT && fn, m2::RectD const & rect) const
+  {
+    std::vector<std::shared_ptr<MwmInfo>> infos;
+    m_dataSource.GetMwmsInfo(infos);
+    for (auto const & info : infos)
+    {
+      if (info->GetType() == MwmInfo::COUNTRY && rect.IsIntersect(info->m_bordersRect))
+        fn(MwmSet::MwmId(info));
+    }
+  }
+
+  /// @return Handle which is not held by MwmDataSource. It may be not alive.
+  MwmSet::MwmHandle GetNotHeldHandle(MwmSet::MwmId const & mwmId) const { return m_dataSource.GetMwmHandleById(mwmId); }
+
   MwmSet::MwmHandle const & GetHandle(MwmSet::MwmId const & mwmId)
   {
     if (m_numMwmIDs)
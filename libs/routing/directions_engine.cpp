@@ -55,6 +55,7 @@ void DirectionsEngine::Clear()
 {
   m_adjacentEdges.clear();
   m_pathSegments.clear();
+  m_candidates.clear();
 }
 
 unique_ptr<FeatureType> DirectionsEngine::GetFeature(FeatureID const & featureId)
@@ -81,6 +82,7 @@ void DirectionsEngine::LoadPathAttributes(FeatureID const & featureId, LoadedPat
   ASSERT(pathSegment.m_highwayClass != HighwayClass::Undefined, (featureId));
 
   pathSegment.m_isLink = m_linkChecker(types);
+  m_candidates.emplace(featureId, CandidateAttributes{pathSegment.m_highwayClass, pathSegment.m_isLink});
   pathSegment.m_onRoundabout = m_roundAboutChecker(types);
   pathSegment.m_isOneWay = m_onewayChecker(types);
 
@@ -93,6 +95,20 @@ void DirectionsEngine::LoadPathAttributes(FeatureID const & featureId, LoadedPat
   pathSegment.m_roadNameInfo.m_name = ft->GetName(StringUtf8Multilang::kDefaultCode);
 }
 
+DirectionsEngine::CandidateAttributes const * DirectionsEngine::GetCandidateAttributes(FeatureID const & featureId)
+{
+  auto [it, inserted] = m_candidates.emplace(featureId, nullopt);
+  if (inserted)
+  {
+    if (auto ft = GetFeature(featureId))
+    {
+      feature::TypesHolder types(*ft);
+      it->second = CandidateAttributes{GetHighwayClass(types), m_linkChecker(types)};
+    }
+  }
+  return it->second ? &*it->second : nullptr;
+}
+
 void DirectionsEngine::GetSegmentRangeAndAdjacentEdges(IRoadGraph::EdgeListT const & outgoingEdges, Edge const & inEdge,
                                                        uint32_t startSegId, uint32_t endSegId,
                                                        SegmentRange & segmentRange, TurnCandidates & outgoingTurns)
@@ -110,14 +126,11 @@ void DirectionsEngine::GetSegmentRangeAndAdjacentEdges(IRoadGraph::EdgeListT con
     if (edge.IsFake())
       continue;
 
-    auto ft = GetFeature(edge.GetFeatureId());
-    if (!ft)
+    auto const * attrs = GetCandidateAttributes(edge.GetFeatureId());
+    if (!attrs)
       continue;
 
-    feature::TypesHolder types(*ft);
-
-    auto const highwayClass = GetHighwayClass(types);
-    ASSERT(highwayClass != HighwayClass::Undefined, (edge.PrintLatLon()));
+    ASSERT(attrs->m_highwayClass != HighwayClass::Undefined, (edge.PrintLatLon()));
 
     double angle = 0;
 
@@ -138,8 +151,8 @@ void DirectionsEngine::GetSegmentRangeAndAdjacentEdges(IRoadGraph::EdgeListT con
       outgoingTurns.isCandidatesAngleValid = false;
     }
 
-    outgoingTurns.candidates.emplace_back(angle, ConvertEdgeToSegment(*m_numMwmIds, edge), highwayClass,
-                                          m_linkChecker(types));
+    outgoingTurns.candidates.emplace_back(angle, ConvertEdgeToSegment(*m_numMwmIds, edge), attrs->m_highwayClass,
+                                          attrs->m_isLink);
   }
 
   if (outgoingTurns.isCandidatesAngleValid)
@@ -235,6 +248,7 @@ bool DirectionsEngine::Generate(IndexRoadGraph const & graph, vector<geometry::P
 
   m_adjacentEdges.clear();
   m_pathSegments.clear();
+  m_candidates.clear();
 
   CHECK_NOT_EQUAL(m_vehicleType, VehicleType::Count, (m_vehicleType));
 
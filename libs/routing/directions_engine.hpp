@@ -6,14 +6,19 @@
 #include "routing/vehicle_mask.hpp"
 
 #include "indexer/feature.hpp"
+#include "indexer/feature_decl.hpp"
+#include "indexer/ftypes_matcher.hpp"
 
 #include "geometry/point_with_altitude.hpp"
 
 #include "base/cancellable.hpp"
 
 #include <memory>
+#include <optional>
 #include <vector>
 
+#include "3party/skarupke/flat_hash_map.hpp"
+
 namespace routing
 {
 namespace turns
@@ -72,10 +77,25 @@ protected:
   VehicleType m_vehicleType = VehicleType::Count;
 
 private:
+  // Attributes of a turn candidate feature which are needed for turn generation.
+  struct CandidateAttributes
+  {
+    ftypes::HighwayClass m_highwayClass = ftypes::HighwayClass::Undefined;
+    bool m_isLink = false;
+  };
+
+  /// \returns attributes of |featureId| or nullptr for fake and absent features.
+  /// The same features are candidates at many junctions of a route, so attributes are loaded
+  /// once per Generate() call and kept in |m_candidates|.
+  CandidateAttributes const * GetCandidateAttributes(FeatureID const & featureId);
+
   void MakeTurnAnnotation(IndexRoadGraph::EdgeVector const & routeEdges, std::vector<RouteSegment> & routeSegments);
 
   ftypes::IsLinkChecker const & m_linkChecker;
   ftypes::IsRoundAboutChecker const & m_roundAboutChecker;
   ftypes::IsOneWayChecker const & m_onewayChecker;
+
+  // Nullopt value means that the feature is fake or can't be loaded.
+  ska::flat_hash_map<FeatureID, std::optional<CandidateAttributes>> m_candidates;
 };
 }  // namespace routing
@@ -70,7 +70,11 @@ public:
     return RouteWeight(ms::DistanceOnEarth(from, to));
   }
 
-  double CalculateETA(Segment const & from, Segment const & to) override { UNREACHABLE(); }
+  double CalculateETA(Segment const & from, Segment const & to,
+                      std::optional<RouteWeight const> const & timeToFrom) override
+  {
+    UNREACHABLE();
+  }
 
   double CalculateETAWithoutPenalty(Segment const & segment) override { UNREACHABLE(); }
 
@@ -8,7 +8,12 @@
 
 #include "coding/point_coding.hpp"
 
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
 #include <limits>
+#include <utility>
 
 namespace routing
 {
@@ -102,9 +107,11 @@ void FeaturesRoadGraph::RoadInfoCache::Clear()
 }
 
 FeaturesRoadGraphBase::FeaturesRoadGraphBase(MwmDataSource & dataSource, IRoadGraph::Mode mode,
-                                             shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory)
+                                             shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
+                                             VehicleType vehicleType)
   : m_dataSource(dataSource)
   , m_mode(mode)
+  , m_vehicleType(vehicleType)
   , m_vehicleModel(vehicleModelFactory)
 {}
 
@@ -147,6 +154,13 @@ void FeaturesRoadGraphBase::FindClosestEdges(m2::RectD const & rect, uint32_t co
 {
   NearestEdgeFinder finder(rect.Center(), nullptr /* IsEdgeProjGood */);
 
+  if (ForEachRoadWithSnapIndex(rect, [&](FeatureID const & featureId, RoadInfo const & roadInfo)
+      { finder.AddInformationSource(IRoadGraph::FullRoadInfo(featureId, roadInfo)); }))
+  {
+    finder.MakeResult(vicinities, count);
+    return;
+  }
+
   m_dataSource.ForEachStreet([&](FeatureType & ft)
   {
     if (!m_vehicleModel.IsRoad(ft))
@@ -166,6 +180,17 @@ vector<IRoadGraph::FullRoadInfo> FeaturesRoadGraphBase::FindRoads(m2::RectD cons
 {
   vector<IRoadGraph::FullRoadInfo> roads;
 
+  if (ForEachRoadWithSnapIndex(rect, [&](FeatureID const & featureId, RoadInfo const & roadInfo)
+  {
+    if (isGoodFeature && !isGoodFeature(featureId))
+      return;
+    if (RectCoversPolyline(roadInfo.m_junctions, rect))
+      roads.emplace_back(featureId, roadInfo);
+  }))
+  {
+    return roads;
+  }
+
   m_dataSource.ForEachStreet([&](FeatureType & ft)
   {
     if (!m_vehicleModel.IsRoad(ft))
@@ -224,6 +249,7 @@ void FeaturesRoadGraphBase::ClearState()
 {
   m_cache.Clear();
   m_vehicleModel.Clear();
+  m_snapIndexes.clear();
 }
 
 bool FeaturesRoadGraphBase::IsRoad(FeatureType & ft) const
@@ -300,6 +326,117 @@ IRoadGraph::RoadInfo const & FeaturesRoadGraphBase::GetCachedRoadInfo(FeatureID
   return ri;
 }
 
+bool FeaturesRoadGraphBase::ForEachRoadWithSnapIndex(m2::RectD const & rect, RoadFn const & fn) const
+{
+  if (m_vehicleType == VehicleType::Count)
+    return false;
+
+  vector<pair<MwmSet::MwmId, SnapIndex const *>> snapIndexes;
+  bool hasAllIndexes = true;
+  m_dataSource.ForEachCountryInRect([&](MwmSet::MwmId const & mwmId)
+  {
+    if (!hasAllIndexes)
+      return;
+
+    auto const & snapIndex = GetSnapIndex(mwmId);
+    if (snapIndex.m_index)
+      snapIndexes.emplace_back(mwmId, &snapIndex);
+    else
+      hasAllIndexes = false;
+  }, rect);
+
+  if (!hasAllIndexes)
+    return false;
+
+  for (auto const & [mwmId, snapIndex] : snapIndexes)
+  {
+    snapIndex->m_index->ForEachRoadInRect(rect, m_vehicleType, [&](uint32_t featureId)
+    {
+      FeatureID const id(mwmId, featureId);
+      auto const & roadInfo = GetCachedRoadInfo(id, *snapIndex);
+      if (roadInfo.m_junctions.size() >= 2)
+        fn(id, roadInfo);
+    });
+  }
+  return true;
+}
+
+FeaturesRoadGraphBase::SnapIndex const & FeaturesRoadGraphBase::GetSnapIndex(MwmSet::MwmId const & mwmId) const
+{
+  auto it = m_snapIndexes.find(mwmId);
+  if (it != m_snapIndexes.end())
+    return it->second;
+
+  SnapIndex snapIndex;
+  snapIndex.m_handle = m_dataSource.GetNotHeldHandle(mwmId);
+  if (snapIndex.m_handle.IsAlive())
+  {
+    auto const & cont = snapIndex.m_handle.GetValue()->m_cont;
+    if (cont.IsExist(ROUTING_SNAP_FILE_TAG) && cont.IsExist(ROUTING_GEOMETRY_FILE_TAG))
+    {
+      try
+      {
+        auto const indexReader = cont.GetReader(ROUTING_SNAP_FILE_TAG);
+        auto const geometryReader = cont.GetReader(ROUTING_GEOMETRY_FILE_TAG);
+        snapIndex.m_index = make_unique<RoutingSnapIndex>(indexReader.GetPtr()->CreateSubReader(0, indexReader.Size()));
+        snapIndex.m_geometry =
+            make_unique<RoutingGeometry>(geometryReader.GetPtr()->CreateSubReader(0, geometryReader.Size()));
+      }
+      catch (RootException const & e)
+      {
+        LOG(LERROR, ("Wrong", ROUTING_SNAP_FILE_TAG, "or", ROUTING_GEOMETRY_FILE_TAG, "section of", mwmId, ":",
+                     e.Msg()));
+        snapIndex.m_index.reset();
+        snapIndex.m_geometry.reset();
+      }
+    }
+  }
+
+  it = m_snapIndexes.emplace(mwmId, std::move(snapIndex)).first;
+  return it->second;
+}
+
+IRoadGraph::RoadInfo const & FeaturesRoadGraphBase::GetCachedRoadInfo(FeatureID const & featureId,
+                                                                      SnapIndex const & snapIndex) const
+{
+  bool found = false;
+  RoadInfo & ri = m_cache.Find(featureId, found);
+  if (found)
+    return ri;
+
+  // Ferries and shuttle trains with duration are not in the geometry section.
+  if (!snapIndex.m_geometry->GetRoad(featureId.m_index, m_snapRoad))
+  {
+    auto ft = m_dataSource.GetFeature(featureId);
+    if (ft)
+      ExtractRoadInfo(featureId, *ft, kInvalidSpeedKMPH, ri);
+    return ri;
+  }
+
+  ri.m_speedKMPH = kInvalidSpeedKMPH;
+  ri.m_bidirectional = !snapIndex.m_index->IsOneWay(featureId.m_index, m_vehicleType);
+
+  auto const & points = m_snapRoad.m_points;
+  size_t const pointsCount = points.size();
+
+  // Altitudes of the section are used only if the graph loads altitudes at all.
+  geometry::Altitudes altitudes;
+  auto const loader = GetAltitudesLoader(featureId.m_mwmId);
+  if (loader && snapIndex.m_geometry->HasAltitudes())
+    altitudes = std::move(m_snapRoad.m_altitudes);
+  else if (loader)
+    altitudes = loader->GetAltitudes(featureId.m_index, pointsCount);
+  else
+    altitudes = geometry::Altitudes(pointsCount, geometry::kDefaultAltitudeMeters);
+
+  CHECK_EQUAL(altitudes.size(), pointsCount, ("GetAltitudes for", featureId, "returns wrong altitudes:", altitudes));
+
+  ri.m_junctions.resize(pointsCount);
+  for (size_t i = 0; i < pointsCount; ++i)
+    ri.m_junctions[i] = geometry::PointWithAltitude(points[i], altitudes[i]);
+  return ri;
+}
+
 feature::AltitudeLoaderCached * FeaturesRoadGraph::GetAltitudesLoader(MwmSet::MwmId const & mwmId) const
 {
   auto it = m_altitudes.find(mwmId);
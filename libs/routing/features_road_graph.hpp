@@ -1,6 +1,9 @@
 #pragma once
 
 #include "routing/road_graph.hpp"
+#include "routing/routing_geometry.hpp"
+#include "routing/routing_snap_index.hpp"
+#include "routing/vehicle_mask.hpp"
 
 #include "routing_common/vehicle_model.hpp"
 
@@ -13,6 +16,7 @@
 
 #include "base/cache.hpp"
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -77,7 +81,11 @@ private:
 public:
   static double constexpr kClosestEdgesRadiusM = 150.0;
 
-  FeaturesRoadGraphBase(MwmDataSource & dataSource, IRoadGraph::Mode mode, VehicleModelFactoryPtrT modelFactory);
+  /// \param vehicleType is used to find roads of |vehicleType| with ROUTING_SNAP_FILE_TAG sections.
+  /// Roads are found with the feature covering if it's VehicleType::Count or mwms have no the section
+  /// or no ROUTING_GEOMETRY_FILE_TAG section.
+  FeaturesRoadGraphBase(MwmDataSource & dataSource, IRoadGraph::Mode mode, VehicleModelFactoryPtrT modelFactory,
+                        VehicleType vehicleType = VehicleType::Count);
 
   static int GetStreetReadScale();
 
@@ -109,6 +117,21 @@ protected:
 private:
   friend class CrossFeaturesLoader;
 
+  struct SnapIndex
+  {
+    // Keeps the section readers alive.
+    MwmSet::MwmHandle m_handle;
+    // Both are null if the mwm has no one of the sections.
+    std::unique_ptr<RoutingSnapIndex> m_index;
+    std::unique_ptr<RoutingGeometry> m_geometry;
+  };
+
+  using RoadFn = std::function<void(FeatureID const & featureId, RoadInfo const & roadInfo)>;
+  // Calls |fn| for every road which may cross |rect| found with snap indexes. Returns false and
+  // calls nothing if the roads should be found with the feature covering.
+  bool ForEachRoadWithSnapIndex(m2::RectD const & rect, RoadFn const & fn) const;
+  SnapIndex const & GetSnapIndex(MwmSet::MwmId const & mwmId) const;
+
   bool IsOneWay(FeatureType & ft) const;
   double GetSpeedKMpHFromFt(FeatureType & ft, SpeedParams const & speedParams) const;
 
@@ -118,11 +141,17 @@ private:
   // Searches a feature RoadInfo in the cache, and if does not find then takes passed feature and speed.
   // This version is used to prevent redundant feature loading when feature speed is known.
   RoadInfo const & GetCachedRoadInfo(FeatureID const & featureId, FeatureType & ft, double speedKMPH) const;
+  // Searches a feature RoadInfo in the cache, and if does not find then reads it from |snapIndex|.
+  RoadInfo const & GetCachedRoadInfo(FeatureID const & featureId, SnapIndex const & snapIndex) const;
   void ExtractRoadInfo(FeatureID const & featureId, FeatureType & ft, double speedKMpH, RoadInfo & ri) const;
 
   IRoadGraph::Mode const m_mode;
+  VehicleType const m_vehicleType;
   mutable RoadInfoCache m_cache;
   mutable CrossCountryVehicleModel m_vehicleModel;
+  mutable std::map<MwmSet::MwmId, SnapIndex> m_snapIndexes;
+  // Buffer for reading of roads from routing geometry sections.
+  mutable RoutingGeometry::Road m_snapRoad;
 };
 
 class FeaturesRoadGraph : public FeaturesRoadGraphBase
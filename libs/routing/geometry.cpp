@@ -2,10 +2,16 @@
 
 #include "routing/city_roads.hpp"
 #include "routing/maxspeeds.hpp"
+#include "routing/road_geometry_cache.hpp"
+#include "routing/routing_geometry.hpp"
 
 #include "indexer/altitude_loader.hpp"
 #include "indexer/feature.hpp"
+#include "indexer/feature_data.hpp"
 #include "indexer/feature_source.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include "platform/local_country_file.hpp"
 
 #include "geometry/distance_on_sphere.hpp"
 #include "geometry/mercator.hpp"
@@ -76,11 +82,42 @@ public:
     , m_altitudeLoader(*handle.GetValue())
     , m_loadAltitudes(loadAltitudes)
   {
-    m_attrsGetter.Load(handle.GetValue()->m_cont);
+    auto const & cont = handle.GetValue()->m_cont;
+    m_attrsGetter.Load(cont);
+
+    if (cont.IsExist(ROUTING_GEOMETRY_FILE_TAG))
+    {
+      try
+      {
+        auto const reader = cont.GetReader(ROUTING_GEOMETRY_FILE_TAG);
+        m_routingGeometry = make_unique<RoutingGeometry>(reader.GetPtr()->CreateSubReader(0, reader.Size()));
+      }
+      catch (RootException const & e)
+      {
+        LOG(LERROR, ("Error while reading", ROUTING_GEOMETRY_FILE_TAG, "section in",
+                     handle.GetValue()->GetCountryFileName(), ":", e.Msg()));
+      }
+    }
   }
 
   void Load(uint32_t featureId, RoadGeometry & road) override
   {
+    if (m_routingGeometry && m_routingGeometry->GetRoad(featureId, m_road))
+    {
+      if (m_loadAltitudes && !m_routingGeometry->HasAltitudes())
+        m_road.m_altitudes = m_altitudeLoader.GetAltitudes(featureId, m_road.m_points.size());
+
+      feature::TypesHolder types(feature::GeomType::Line);
+      for (uint32_t const type : m_road.m_types)
+        types.Add(type);
+
+      bool const hasAltitudes = m_loadAltitudes && !m_road.m_altitudes.empty();
+      road.Load(*m_vehicleModel, featureId, types, m_road.m_points, hasAltitudes ? &m_road.m_altitudes : nullptr,
+                m_attrsGetter);
+      return;
+    }
+
+    // Roads which are not in the section need metadata or the section is absent.
     auto feature = m_source.GetOriginalFeature(featureId);
     feature->ParseGeometry(FeatureType::BEST_GEOMETRY);
 
@@ -103,16 +140,24 @@ private:
   FeatureSource m_source;
   feature::AltitudeLoaderBase m_altitudeLoader;
   bool const m_loadAltitudes;
+  unique_ptr<RoutingGeometry> m_routingGeometry;
+  // Buffer for loading from |m_routingGeometry|.
+  RoutingGeometry::Road m_road;
 };
 
 class FileGeometryLoader final : public GeometryLoader
 {
 public:
-  FileGeometryLoader(string const & fileName, VehicleModelPtrT const & vehicleModel)
+  FileGeometryLoader(string const & fileName, VehicleModelPtrT const & vehicleModel, bool loadAltitudes)
     : m_featuresVector(fileName)
     , m_vehicleModel(vehicleModel)
   {
     m_attrsGetter.Load(m_featuresVector.GetContainer());
+    if (loadAltitudes)
+    {
+      m_mwmValue = make_unique<MwmValue>(platform::LocalCountryFile::MakeTemporary(fileName));
+      m_altitudeLoader = make_unique<feature::AltitudeLoaderBase>(*m_mwmValue);
+    }
   }
 
   void Load(uint32_t featureId, RoadGeometry & road) override
@@ -122,15 +167,20 @@ public:
     feature->SetID({{}, featureId});
     feature->ParseGeometry(FeatureType::BEST_GEOMETRY);
 
-    // Note. If FileGeometryLoader is used for generation cross mwm section for bicycle or
-    // pedestrian routing |altitudes| should be used here.
-    road.Load(*m_vehicleModel, *feature, nullptr /* altitudes */, m_attrsGetter);
+    geometry::Altitudes altitudes;
+    if (m_altitudeLoader)
+      altitudes = m_altitudeLoader->GetAltitudes(featureId, feature->GetPointsCount());
+
+    road.Load(*m_vehicleModel, *feature, altitudes.empty() ? nullptr : &altitudes, m_attrsGetter);
   }
 
 private:
   FeaturesVectorTest m_featuresVector;
   RoadAttrsGetter m_attrsGetter;
   VehicleModelPtrT m_vehicleModel;
+  // Altitudes are loaded if they are asked for only.
+  unique_ptr<MwmValue> m_mwmValue;
+  unique_ptr<feature::AltitudeLoaderBase> m_altitudeLoader;
 };
 }  // namespace
 
@@ -163,17 +213,66 @@ void RoadGeometry::Load(VehicleModelInterface const & vehicleModel, FeatureType
   CHECK_GREATER(count, 1, ());
   CHECK(altitudes == nullptr || altitudes->size() == count, ());
 
-  feature::TypesHolder types(feature);
+  uint32_t const fID = feature.GetID().m_index;
+  LoadAttrs(vehicleModel, fID, feature::TypesHolder(feature), attrs);
+  LoadJunctions(count, [&feature](size_t i) { return feature.GetPoint(i); }, altitudes);
+
+  bool const isFerry = m_routingOptions.Has(RoutingOptions::Road::Ferry);
+  /// @todo Add RouteShuttleTrain into RoutingOptions?
+  if (isFerry || (m_highwayType && *m_highwayType == HighwayType::RouteShuttleTrain))
+  {
+    // Skip shuttle train calculation without duration.
+    auto const durationMeta = feature.GetMetadata(feature::Metadata::FMD_DURATION);
+    if (isFerry || !durationMeta.empty())
+    {
+      /// @todo Also process "interval" OSM tag (without additional boarding penalties).
+      // https://github.com/organicmaps/organicmaps/issues/3695
+
+      auto const roadLenKm = GetRoadLengthM() / 1000.0;
+      double const durationH = CalcFerryDurationHours(durationMeta, roadLenKm);
+      CHECK(!AlmostEqualAbs(durationH, 0.0, 1e-5), (durationH));
+
+      if (roadLenKm != 0.0)
+      {
+        double const speed = roadLenKm / durationH;
+        ASSERT_LESS_OR_EQUAL(speed, vehicleModel.GetMaxWeightSpeed(), (roadLenKm, durationH, fID));
+        m_forwardSpeed = m_backwardSpeed = SpeedKMpH(speed);
+      }
+    }
+  }
+
+  if (m_valid)
+    ASSERT(m_forwardSpeed.IsValid() && m_backwardSpeed.IsValid(), (feature.DebugString()));
+}
+
+void RoadGeometry::Load(VehicleModelInterface const & vehicleModel, uint32_t featureId,
+                        feature::TypesHolder const & types, vector<m2::PointD> const & points,
+                        geometry::Altitudes const * altitudes, RoadAttrsGetter & attrs)
+{
+  size_t const count = points.size();
+  CHECK_GREATER(count, 1, ());
+  CHECK(altitudes == nullptr || altitudes->size() == count, ());
+
+  LoadAttrs(vehicleModel, featureId, types, attrs);
+  LoadJunctions(count, [&points](size_t i) { return points[i]; }, altitudes);
+
+  ASSERT(!m_routingOptions.Has(RoutingOptions::Road::Ferry), (featureId));
+  if (m_valid)
+    ASSERT(m_forwardSpeed.IsValid() && m_backwardSpeed.IsValid(), (featureId));
+}
+
+void RoadGeometry::LoadAttrs(VehicleModelInterface const & vehicleModel, uint32_t featureId,
+                             feature::TypesHolder const & types, RoadAttrsGetter & attrs)
+{
   m_highwayType = vehicleModel.GetHighwayType(types);
 
   m_valid = vehicleModel.IsRoad(types);
   m_isOneWay = vehicleModel.IsOneWay(types);
   m_isPassThroughAllowed = vehicleModel.IsPassThroughAllowed(types);
 
-  uint32_t const fID = feature.GetID().m_index;
-  m_inCity = attrs.m_cityRoads.IsCityRoad(fID);
+  m_inCity = attrs.m_cityRoads.IsCityRoad(featureId);
 
-  SpeedParams params(attrs.m_maxSpeeds.GetMaxspeed(fID),
+  SpeedParams params(attrs.m_maxSpeeds.GetMaxspeed(featureId),
                      m_highwayType ? attrs.m_maxSpeeds.GetDefaultSpeed(m_inCity, *m_highwayType) : kInvalidSpeed,
                      m_inCity);
   params.m_forward = true;
@@ -185,12 +284,16 @@ void RoadGeometry::Load(VehicleModelInterface const & vehicleModel, FeatureType
   for (uint32_t type : types)
     if (auto const it = optionsClassfier.Get(type))
       m_routingOptions.Add(*it);
+}
 
+template <typename ToPointFn>
+void RoadGeometry::LoadJunctions(size_t count, ToPointFn && toPoint, geometry::Altitudes const * altitudes)
+{
   m_junctions.clear();
   m_junctions.reserve(count);
   for (size_t i = 0; i < count; ++i)
   {
-    auto const ll = mercator::ToLatLon(feature.GetPoint(i));
+    auto const ll = mercator::ToLatLon(toPoint(i));
     m_junctions.emplace_back(ll, altitudes ? (*altitudes)[i] : geometry::kDefaultAltitudeMeters);
 
 #ifdef DEBUG
@@ -211,34 +314,7 @@ void RoadGeometry::Load(VehicleModelInterface const & vehicleModel, FeatureType
     }
 #endif
   }
-  m_distances.resize(count - 1, -1);
-
-  bool const isFerry = m_routingOptions.Has(RoutingOptions::Road::Ferry);
-  /// @todo Add RouteShuttleTrain into RoutingOptions?
-  if (isFerry || (m_highwayType && *m_highwayType == HighwayType::RouteShuttleTrain))
-  {
-    // Skip shuttle train calculation without duration.
-    auto const durationMeta = feature.GetMetadata(feature::Metadata::FMD_DURATION);
-    if (isFerry || !durationMeta.empty())
-    {
-      /// @todo Also process "interval" OSM tag (without additional boarding penalties).
-      // https://github.com/organicmaps/organicmaps/issues/3695
-
-      auto const roadLenKm = GetRoadLengthM() / 1000.0;
-      double const durationH = CalcFerryDurationHours(durationMeta, roadLenKm);
-      CHECK(!AlmostEqualAbs(durationH, 0.0, 1e-5), (durationH));
-
-      if (roadLenKm != 0.0)
-      {
-        double const speed = roadLenKm / durationH;
-        ASSERT_LESS_OR_EQUAL(speed, vehicleModel.GetMaxWeightSpeed(), (roadLenKm, durationH, fID));
-        m_forwardSpeed = m_backwardSpeed = SpeedKMpH(speed);
-      }
-    }
-  }
-
-  if (m_valid)
-    ASSERT(m_forwardSpeed.IsValid() && m_backwardSpeed.IsValid(), (feature.DebugString()));
+  m_distances.assign(count - 1, -1);
 }
 
 double RoadGeometry::GetDistance(uint32_t idx) const
@@ -248,6 +324,12 @@ double RoadGeometry::GetDistance(uint32_t idx) const
   return m_distances[idx];
 }
 
+void RoadGeometry::CalcDistances() const
+{
+  for (uint32_t i = 0; i + 1 < GetPointsCount(); ++i)
+    GetDistance(i);
+}
+
 SpeedKMpH const & RoadGeometry::GetSpeed(bool forward) const
 {
   return forward ? m_forwardSpeed : m_backwardSpeed;
@@ -274,11 +356,27 @@ Geometry::Geometry(unique_ptr<GeometryLoader> loader, size_t roadsCacheSize) : m
       roadsCacheSize, [this](uint32_t featureId, RoadGeometry & road) { m_loader->Load(featureId, road); });
 }
 
+Geometry::Geometry(unique_ptr<GeometryLoader> loader, shared_ptr<RoadGeometryCache> sharedCache, uint32_t sourceId,
+                   size_t roadsCacheSize)
+  : m_loader(std::move(loader))
+  , m_sharedCache(std::move(sharedCache))
+{
+  CHECK(m_loader, ());
+  CHECK(m_sharedCache, ());
+
+  m_featureIdToSharedRoad = make_unique<SharedRoutingCacheT>(
+      roadsCacheSize, [this, sourceId](uint32_t featureId, RoadPtrT & road)
+  { road = m_sharedCache->GetRoad(sourceId, featureId, *m_loader); });
+}
+
 RoadGeometry const & Geometry::GetRoad(uint32_t featureId)
 {
-  ASSERT(m_featureIdToRoad, ());
   ASSERT(m_loader, ());
 
+  if (m_featureIdToSharedRoad)
+    return *m_featureIdToSharedRoad->GetValue(featureId);
+
+  ASSERT(m_featureIdToRoad, ());
   return m_featureIdToRoad->GetValue(featureId);
 }
 
@@ -298,9 +396,9 @@ unique_ptr<GeometryLoader> GeometryLoader::Create(MwmSet::MwmHandle const & hand
 
 // static
 unique_ptr<GeometryLoader> GeometryLoader::CreateFromFile(string const & fileName,
-                                                          VehicleModelPtrT const & vehicleModel)
+                                                          VehicleModelPtrT const & vehicleModel, bool loadAltitudes)
 {
   CHECK(vehicleModel, ());
-  return make_unique<FileGeometryLoader>(fileName, vehicleModel);
+  return make_unique<FileGeometryLoader>(fileName, vehicleModel, loadAltitudes);
 }
 }  // namespace routing
@@ -20,6 +20,11 @@
 
 class DataSource;
 
+namespace feature
+{
+class TypesHolder;
+}  // namespace feature
+
 namespace routing
 {
 // @TODO(bykoianko) Consider setting cache size based on available memory.
@@ -27,6 +32,7 @@ namespace routing
 size_t constexpr kRoadsCacheSize = 10000;
 
 class RoadAttrsGetter;
+class RoadGeometryCache;
 
 class RoadGeometry final
 {
@@ -40,6 +46,11 @@ public:
   /// @param[in] altitudes May be nullptr.
   void Load(VehicleModelInterface const & vehicleModel, FeatureType & feature, geometry::Altitudes const * altitudes,
             RoadAttrsGetter & attrs);
+  /// \brief Loads the road of ROUTING_GEOMETRY_FILE_TAG section without FeatureType. Metadata
+  /// isn't used, so ferries and shuttle trains with duration should be loaded from features.
+  /// @param[in] altitudes May be nullptr.
+  void Load(VehicleModelInterface const & vehicleModel, uint32_t featureId, feature::TypesHolder const & types,
+            std::vector<m2::PointD> const & points, geometry::Altitudes const * altitudes, RoadAttrsGetter & attrs);
 
   SpeedKMpH const & GetSpeed(bool forward) const;
   std::optional<HighwayType> GetHighwayType() const { return m_highwayType; }
@@ -54,6 +65,8 @@ public:
   }
 
   double GetDistance(uint32_t segmendIdx) const;
+  /// \brief Fills the distances cache, after it the road may be read from several threads.
+  void CalcDistances() const;
   double GetRoadLengthM() const;
 
   ms::LatLon const & GetPoint(uint32_t pointId) const { return GetJunction(pointId).GetLatLon(); }
@@ -82,6 +95,11 @@ public:
   RoutingOptions GetRoutingOptions() const { return m_routingOptions; }
 
 private:
+  void LoadAttrs(VehicleModelInterface const & vehicleModel, uint32_t featureId, feature::TypesHolder const & types,
+                 RoadAttrsGetter & attrs);
+  template <typename ToPointFn>
+  void LoadJunctions(size_t count, ToPointFn && toPoint, geometry::Altitudes const * altitudes);
+
   std::vector<LatLonWithAltitude> m_junctions;
   mutable std::vector<double> m_distances;  ///< as cache, @see GetDistance()
 
@@ -113,8 +131,10 @@ public:
 
   /// This is for stand-alone work.
   /// Use in generator_tool and unit tests.
+  /// @param[in] loadAltitudes is needed for bicycle and pedestrian weights, which depend on climbs.
   static std::unique_ptr<GeometryLoader> CreateFromFile(std::string const & filePath,
-                                                        VehicleModelPtrT const & vehicleModel);
+                                                        VehicleModelPtrT const & vehicleModel,
+                                                        bool loadAltitudes = false);
 };
 
 /// \brief This class supports loading geometry of roads for routing.
@@ -125,6 +145,8 @@ public:
 /// \note The cache |m_featureIdToRoad| is used for road geometry for single-directional
 /// and bidirectional A*. According to tests it's faster to use one cache for both directions
 /// in bidirectional A* case than two separate caches, one for each direction (one for each A* wave).
+/// \note Geometry may load roads through RoadGeometryCache shared with other Geometry instances.
+/// Then |m_featureIdToSharedRoad| keeps pointers to the shared roads instead of the roads.
 class Geometry final
 {
 public:
@@ -132,6 +154,9 @@ public:
   /// \brief Geometry constructor
   /// \param roadsCacheSize in-memory geometry elements count limit
   Geometry(std::unique_ptr<GeometryLoader> loader, size_t roadsCacheSize = kRoadsCacheSize);
+  /// \param sourceId id of |loader| roads in |sharedCache|, see RoadGeometryCache::GetSourceId().
+  Geometry(std::unique_ptr<GeometryLoader> loader, std::shared_ptr<RoadGeometryCache> sharedCache, uint32_t sourceId,
+           size_t roadsCacheSize = kRoadsCacheSize);
 
   /// \note The reference returned by the method is valid until the next call of GetRoad()
   /// of GetPoint() methods.
@@ -149,8 +174,13 @@ public:
 private:
   /// @todo Use LRU cache?
   using RoutingCacheT = FifoCache<uint32_t, RoadGeometry, ska::bytell_hash_map<uint32_t, RoadGeometry>>;
+  using RoadPtrT = std::shared_ptr<RoadGeometry const>;
+  using SharedRoutingCacheT = FifoCache<uint32_t, RoadPtrT, ska::bytell_hash_map<uint32_t, RoadPtrT>>;
 
   std::unique_ptr<GeometryLoader> m_loader;
   std::unique_ptr<RoutingCacheT> m_featureIdToRoad;
+
+  std::shared_ptr<RoadGeometryCache> m_sharedCache;
+  std::unique_ptr<SharedRoutingCacheT> m_featureIdToSharedRoad;
 };
 }  // namespace routing
@@ -243,6 +243,12 @@ void IndexGraph::SetRoadPenalty(RoadPenalty && roadPenalty)
   m_roadPenalty = std::move(roadPenalty);
 }
 
+void IndexGraph::SetSpeedProfiles(shared_ptr<SpeedProfiles const> speedProfiles, time_t departureTime)
+{
+  m_speedProfiles = std::move(speedProfiles);
+  m_departureTime = departureTime;
+}
+
 void IndexGraph::GetNeighboringEdges(astar::VertexData<Segment, RouteWeight> const & fromVertexData,
                                      RoadPoint const & rp, bool isOutgoing, bool useRoutingOptions,
                                      SegmentEdgeListT & edges, Parents<Segment> const & parents,
@@ -539,12 +545,24 @@ RouteWeight IndexGraph::CalculateEdgeWeight(EdgeEstimator::Purpose purpose, bool
   auto const & to_segment = isOutgoing ? to : from;
   auto const & from_segment = isOutgoing ? from : to;
   auto const & to_road = GetRoadGeometry(to_segment.GetFeatureId());
-  auto const weight = RouteWeight(m_estimator->CalcSegmentWeight(to_segment, to_road, purpose));
+  double segmentWeight = m_estimator->CalcSegmentWeight(to_segment, to_road, purpose);
+  // The backward wave doesn't know the time when the user is at |to_segment|.
+  if (m_speedProfiles && isOutgoing && prevWeight)
+  {
+    auto const time = m_departureTime + static_cast<time_t>(prevWeight->GetWeight());
+    segmentWeight /= m_speedProfiles->GetFactor(to_segment, SpeedProfiles::GetBucket(time));
+  }
+  auto const weight = RouteWeight(segmentWeight);
   auto const penalties = GetPenalties(purpose, isOutgoing ? from : to, isOutgoing ? to : from, prevWeight);
   auto const turn_penalty = getTurnPenalty(purpose, from_segment, to_segment);
   return weight + penalties + turn_penalty;
 }
 
+RouteWeight IndexGraph::CalcSegmentWeight(Segment const & segment, EdgeEstimator::Purpose purpose) const
+{
+  return RouteWeight(m_estimator->CalcSegmentWeight(segment, GetRoadGeometry(segment.GetFeatureId()), purpose));
+}
+
 RouteWeight IndexGraph::getTurnPenalty(EdgeEstimator::Purpose purpose, Segment const & from, Segment const & to) const
 {
   if (from.GetFeatureId() == to.GetFeatureId())
@@ -15,11 +15,13 @@
 #include "routing/road_point.hpp"
 #include "routing/routing_options.hpp"
 #include "routing/segment.hpp"
+#include "routing/speed_profiles.hpp"
 
 #include "indexer/feature_meta.hpp"
 
 #include "geometry/point2d.hpp"
 
+#include <ctime>
 #include <memory>
 #include <optional>
 #include <unordered_map>
@@ -93,6 +95,9 @@ public:
   void SetUTurnRestrictions(std::vector<RestrictionUTurn> && noUTurnRestrictions);
   void SetRoadAccess(RoadAccess && roadAccess);
   void SetRoadPenalty(RoadPenalty && roadPenalty);
+  /// \brief Makes weights of segments time-dependent with |speedProfiles| for a route which starts
+  /// at |departureTime|. The time of a segment is known for outgoing edges only, see CalculateEdgeWeight().
+  void SetSpeedProfiles(std::shared_ptr<SpeedProfiles const> speedProfiles, time_t departureTime);
 
   void PushFromSerializer(Joint::Id jointId, RoadPoint const & rp) { m_roadIndex.PushFromSerializer(jointId, rp); }
 
@@ -128,12 +133,14 @@ public:
   bool IsUTurnAndRestricted(Segment const & parent, Segment const & child, bool isOutgoing) const;
 
   /// @param[in]  isOutgoing true, when movig from -> to, false otherwise.
-  /// @param[in]  prevWeight used for fetching access:conditional.
+  /// @param[in]  prevWeight used for fetching access:conditional and speed profiles.
   /// I suppose :) its time when user will be at the end of |from| (|to| if \a isOutgoing == false) segment.
   /// @return Transition weight + |to| (|from| if \a isOutgoing == false) segment's weight.
   RouteWeight CalculateEdgeWeight(EdgeEstimator::Purpose purpose, bool isOutgoing, Segment const & from,
                                   Segment const & to,
                                   std::optional<RouteWeight const> const & prevWeight = std::nullopt) const;
+  /// @return Weight of |segment| without transition penalties.
+  RouteWeight CalcSegmentWeight(Segment const & segment, EdgeEstimator::Purpose purpose) const;
 
   template <typename T>
   void SetCurrentTimeGetter(T && t)
@@ -206,6 +213,9 @@ private:
   std::unordered_map<uint32_t, UTurnEnding> m_noUTurnRestrictions;
   RoadAccess m_roadAccess;
   RoadPenalty m_roadPenalty;
+  // nullptr if weights are not time-dependent.
+  std::shared_ptr<SpeedProfiles const> m_speedProfiles;
+  time_t m_departureTime = 0;
   RoutingOptions m_avoidRoutingOptions;
   bool m_isLeftHandTraffic;
 
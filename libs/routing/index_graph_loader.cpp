@@ -3,6 +3,7 @@
 #include "routing/data_source.hpp"
 #include "routing/index_graph_serialization.hpp"
 #include "routing/restriction_loader.hpp"
+#include "routing/road_geometry_cache.hpp"
 #include "routing/road_access.hpp"
 #include "routing/road_access_serialization.hpp"
 #include "routing/road_penalty.hpp"
@@ -17,6 +18,8 @@
 
 #include <algorithm>
 #include <map>
+#include <optional>
+#include <string>
 #include <unordered_map>
 
 namespace routing
@@ -31,14 +34,22 @@ public:
   IndexGraphLoaderImpl(VehicleType vehicleType, bool loadAltitudes,
                        shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
                        shared_ptr<EdgeEstimator> estimator, MwmDataSource & dataSource,
-                       RoutingOptions routingOptions = RoutingOptions())
+                       RoutingOptions routingOptions = RoutingOptions(),
+                       shared_ptr<RoadGeometryCache> roadGeometryCache = nullptr,
+                       optional<time_t> departureTime = nullopt)
     : m_vehicleType(vehicleType)
     , m_loadAltitudes(loadAltitudes)
     , m_dataSource(dataSource)
     , m_vehicleModelFactory(std::move(vehicleModelFactory))
     , m_estimator(std::move(estimator))
     , m_avoidRoutingOptions(routingOptions)
+    , m_roadGeometryCache(std::move(roadGeometryCache))
+    , m_departureTime(departureTime)
   {
+    // Conditional road access is checked at the departure time too.
+    if (m_departureTime)
+      m_currentTimeGetter = [time = *m_departureTime]() { return time; };
+
     CHECK(m_vehicleModelFactory, ());
     CHECK(m_estimator, ());
   }
@@ -46,6 +57,8 @@ public:
   // IndexGraphLoader overrides:
   IndexGraph & GetIndexGraph(NumMwmId numMwmId) override;
   Geometry & GetGeometry(NumMwmId numMwmId) override;
+  RoutingShortcuts const * GetRoutingShortcuts(NumMwmId numMwmId) override;
+  RoutingLandmarks const * GetRoutingLandmarks(NumMwmId numMwmId) override;
   vector<RouteSegment::SpeedCamera> GetSpeedCameraInfo(Segment const & segment) override;
   void Clear() override;
 
@@ -54,6 +67,7 @@ private:
   GeometryPtrT CreateGeometry(NumMwmId numMwmId);
   using GraphPtrT = unique_ptr<IndexGraph>;
   GraphPtrT CreateIndexGraph(NumMwmId numMwmId, GeometryPtrT & geometry);
+  shared_ptr<SpeedProfiles const> GetSpeedProfiles(NumMwmId numMwmId);
 
   VehicleType m_vehicleType;
   bool m_loadAltitudes;
@@ -69,10 +83,21 @@ private:
   };
   unordered_map<NumMwmId, GraphAttrs> m_graphs;
 
+  // nullptr for mwms without routing shortcuts section.
+  unordered_map<NumMwmId, unique_ptr<RoutingShortcuts>> m_shortcuts;
+  // nullptr for mwms without routing landmarks table for the vehicle type.
+  unordered_map<NumMwmId, unique_ptr<RoutingLandmarks>> m_landmarks;
+  // nullptr for mwms without speed profiles section.
+  unordered_map<NumMwmId, shared_ptr<SpeedProfiles const>> m_speedProfiles;
+
   unordered_map<NumMwmId, SpeedCamerasMapT> m_cachedCameras;
   SpeedCamerasMapT const & ReceiveSpeedCamsFromMwm(NumMwmId numMwmId);
 
   RoutingOptions m_avoidRoutingOptions;
+  // May be nullptr, then every Geometry keeps its own roads.
+  shared_ptr<RoadGeometryCache> m_roadGeometryCache;
+  // Weights are time-dependent if the departure time is set.
+  optional<time_t> m_departureTime;
   std::function<time_t()> m_currentTimeGetter = [time = GetCurrentTimestamp()]() { return time; };
 };
 
@@ -98,6 +123,50 @@ Geometry & IndexGraphLoaderImpl::GetGeometry(NumMwmId numMwmId)
   return *(res.first->second.m_geometry);
 }
 
+RoutingShortcuts const * IndexGraphLoaderImpl::GetRoutingShortcuts(NumMwmId numMwmId)
+{
+  // Shortcuts are built for cars only.
+  if (m_vehicleType != VehicleType::Car)
+    return nullptr;
+
+  auto res = m_shortcuts.try_emplace(numMwmId, nullptr);
+  if (res.second)
+  {
+    auto shortcuts = make_unique<RoutingShortcuts>();
+    if (ReadRoutingShortcutsFromMwm(m_dataSource.GetMwmValue(numMwmId), numMwmId, *shortcuts))
+      res.first->second = std::move(shortcuts);
+  }
+  return res.first->second.get();
+}
+
+RoutingLandmarks const * IndexGraphLoaderImpl::GetRoutingLandmarks(NumMwmId numMwmId)
+{
+  // Landmarks are built for pedestrians and bicycles only.
+  if (m_vehicleType != VehicleType::Pedestrian && m_vehicleType != VehicleType::Bicycle)
+    return nullptr;
+
+  auto res = m_landmarks.try_emplace(numMwmId, nullptr);
+  if (res.second)
+  {
+    auto landmarks = make_unique<RoutingLandmarks>();
+    if (ReadRoutingLandmarksFromMwm(m_dataSource.GetMwmValue(numMwmId), m_vehicleType, *landmarks))
+      res.first->second = std::move(landmarks);
+  }
+  return res.first->second.get();
+}
+
+shared_ptr<SpeedProfiles const> IndexGraphLoaderImpl::GetSpeedProfiles(NumMwmId numMwmId)
+{
+  auto res = m_speedProfiles.try_emplace(numMwmId, nullptr);
+  if (res.second)
+  {
+    auto speedProfiles = make_shared<SpeedProfiles>();
+    if (ReadSpeedProfilesFromMwm(m_dataSource.GetMwmValue(numMwmId), *speedProfiles))
+      res.first->second = std::move(speedProfiles);
+  }
+  return res.first->second;
+}
+
 SpeedCamerasMapT const & IndexGraphLoaderImpl::ReceiveSpeedCamsFromMwm(NumMwmId numMwmId)
 {
   auto res = m_cachedCameras.try_emplace(numMwmId, SpeedCamerasMapT{});
@@ -135,13 +204,15 @@ IndexGraphLoaderImpl::GraphPtrT IndexGraphLoaderImpl::CreateIndexGraph(NumMwmId
     base::Timer timer;
 
     if (!geometry)
-    {
-      auto vehicleModel = m_vehicleModelFactory->GetVehicleModelForCountry(value->GetCountryFileName());
-      geometry = make_shared<Geometry>(GeometryLoader::Create(handle, std::move(vehicleModel), m_loadAltitudes));
-    }
+      geometry = CreateGeometry(numMwmId);
 
     auto graph = make_unique<IndexGraph>(geometry, m_estimator, m_avoidRoutingOptions, &value->GetRegionData());
     graph->SetCurrentTimeGetter(m_currentTimeGetter);
+    if (m_departureTime)
+    {
+      if (auto speedProfiles = GetSpeedProfiles(numMwmId))
+        graph->SetSpeedProfiles(std::move(speedProfiles), *m_departureTime);
+    }
     DeserializeIndexGraph(*value, m_vehicleType, *graph);
 
     LOG(LINFO,
@@ -161,12 +232,22 @@ IndexGraphLoaderImpl::GeometryPtrT IndexGraphLoaderImpl::CreateGeometry(NumMwmId
   MwmValue const * value = handle.GetValue();
 
   auto vehicleModel = m_vehicleModelFactory->GetVehicleModelForCountry(value->GetCountryFileName());
-  return make_shared<Geometry>(GeometryLoader::Create(handle, std::move(vehicleModel), m_loadAltitudes));
+  auto loader = GeometryLoader::Create(handle, std::move(vehicleModel), m_loadAltitudes);
+  if (!m_roadGeometryCache)
+    return make_shared<Geometry>(std::move(loader));
+
+  // Roads depend on the mwm version, the vehicle model and altitudes.
+  string const sourceName = value->GetCountryFileName() + ":" + to_string(handle.GetInfo()->GetVersion()) + ":" +
+                            ToString(m_vehicleType) + (m_loadAltitudes ? ":altitudes" : "");
+  return make_shared<Geometry>(std::move(loader), m_roadGeometryCache, m_roadGeometryCache->GetSourceId(sourceName));
 }
 
 void IndexGraphLoaderImpl::Clear()
 {
   m_graphs.clear();
+  m_shortcuts.clear();
+  m_landmarks.clear();
+  m_speedProfiles.clear();
 }
 
 }  // namespace
@@ -191,6 +272,74 @@ bool ReadSpeedCamsFromMwm(MwmValue const & mwmValue, SpeedCamerasMapT & camerasM
   return false;
 }
 
+bool ReadRoutingShortcutsFromMwm(MwmValue const & mwmValue, NumMwmId numMwmId, RoutingShortcuts & shortcuts)
+{
+  if (!mwmValue.m_cont.IsExist(ROUTING_SHORTCUTS_FILE_TAG))
+    return false;
+
+  try
+  {
+    base::Timer timer;
+    auto const reader = mwmValue.m_cont.GetReader(ROUTING_SHORTCUTS_FILE_TAG);
+    ReaderSource src(reader);
+    shortcuts.Deserialize(src, numMwmId);
+    LOG(LINFO, (ROUTING_SHORTCUTS_FILE_TAG, "section for", mwmValue.GetCountryFileName(), "loaded in",
+                timer.ElapsedSeconds(), "seconds,", shortcuts.GetNumCells(), "cells"));
+    return true;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Error while reading", ROUTING_SHORTCUTS_FILE_TAG, "section in", mwmValue.GetCountryFileName(), ":",
+                 e.Msg()));
+  }
+  return false;
+}
+
+bool ReadRoutingLandmarksFromMwm(MwmValue const & mwmValue, VehicleType vehicleType, RoutingLandmarks & landmarks)
+{
+  if (!mwmValue.m_cont.IsExist(ROUTING_LANDMARKS_FILE_TAG))
+    return false;
+
+  try
+  {
+    auto const reader = mwmValue.m_cont.GetReader(ROUTING_LANDMARKS_FILE_TAG);
+    ReaderSource src(reader);
+    if (!DeserializeRoutingLandmarksSection(src, vehicleType, landmarks))
+      return false;
+
+    LOG(LINFO, (ROUTING_LANDMARKS_FILE_TAG, "section for", mwmValue.GetCountryFileName(), "loaded,",
+                landmarks.GetNumLandmarks(), "landmarks"));
+    return true;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Error while reading", ROUTING_LANDMARKS_FILE_TAG, "section in", mwmValue.GetCountryFileName(), ":",
+                 e.Msg()));
+  }
+  return false;
+}
+
+bool ReadSpeedProfilesFromMwm(MwmValue const & mwmValue, SpeedProfiles & speedProfiles)
+{
+  if (!mwmValue.m_cont.IsExist(ROUTING_SPEED_PROFILES_FILE_TAG))
+    return false;
+
+  try
+  {
+    auto const reader = mwmValue.m_cont.GetReader(ROUTING_SPEED_PROFILES_FILE_TAG);
+    speedProfiles.Deserialize(*reader.GetPtr());
+    LOG(LINFO, (ROUTING_SPEED_PROFILES_FILE_TAG, "section for", mwmValue.GetCountryFileName(), "loaded,",
+                speedProfiles.GetProfilesCount(), "profiles"));
+    return true;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Error while reading", ROUTING_SPEED_PROFILES_FILE_TAG, "section in", mwmValue.GetCountryFileName(),
+                 ":", e.Msg()));
+  }
+  return false;
+}
+
 bool ReadRoadAccessFromMwm(MwmValue const & mwmValue, VehicleType vehicleType, RoadAccess & roadAccess)
 {
   try
@@ -249,10 +398,12 @@ bool ReadRoadPenaltyFromMwm(MwmValue const & mwmValue, VehicleType vehicleType,
 unique_ptr<IndexGraphLoader> IndexGraphLoader::Create(VehicleType vehicleType, bool loadAltitudes,
                                                       shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
                                                       shared_ptr<EdgeEstimator> estimator, MwmDataSource & dataSource,
-                                                      RoutingOptions routingOptions)
+                                                      RoutingOptions routingOptions,
+                                                      shared_ptr<RoadGeometryCache> roadGeometryCache,
+                                                      optional<time_t> departureTime)
 {
   return make_unique<IndexGraphLoaderImpl>(vehicleType, loadAltitudes, vehicleModelFactory, estimator, dataSource,
-                                           routingOptions);
+                                           routingOptions, std::move(roadGeometryCache), departureTime);
 }
 
 void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph)
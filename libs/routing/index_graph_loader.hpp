@@ -3,13 +3,18 @@
 #include "routing/edge_estimator.hpp"
 #include "routing/index_graph.hpp"
 #include "routing/route.hpp"
+#include "routing/routing_landmarks.hpp"
+#include "routing/routing_shortcuts.hpp"
 #include "routing/speed_camera_ser_des.hpp"
+#include "routing/speed_profiles.hpp"
 #include "routing/vehicle_mask.hpp"
 
 #include "routing_common/num_mwm_id.hpp"
 #include "routing_common/vehicle_model.hpp"
 
+#include <ctime>
 #include <memory>
+#include <optional>
 #include <vector>
 
 class MwmValue;
@@ -17,6 +22,7 @@ class MwmValue;
 namespace routing
 {
 class MwmDataSource;
+class RoadGeometryCache;
 
 class IndexGraphLoader
 {
@@ -25,6 +31,8 @@ public:
 
   virtual IndexGraph & GetIndexGraph(NumMwmId mwmId) = 0;
   virtual Geometry & GetGeometry(NumMwmId numMwmId) = 0;
+  virtual RoutingShortcuts const * GetRoutingShortcuts(NumMwmId /* numMwmId */) { return nullptr; }
+  virtual RoutingLandmarks const * GetRoutingLandmarks(NumMwmId /* numMwmId */) { return nullptr; }
 
   // Because several cameras can lie on one segment we return vector of them.
   virtual std::vector<RouteSegment::SpeedCamera> GetSpeedCameraInfo(Segment const & segment) = 0;
@@ -33,7 +41,9 @@ public:
   static std::unique_ptr<IndexGraphLoader> Create(VehicleType vehicleType, bool loadAltitudes,
                                                   std::shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
                                                   std::shared_ptr<EdgeEstimator> estimator, MwmDataSource & dataSource,
-                                                  RoutingOptions routingOptions = RoutingOptions());
+                                                  RoutingOptions routingOptions = RoutingOptions(),
+                                                  std::shared_ptr<RoadGeometryCache> roadGeometryCache = nullptr,
+                                                  std::optional<time_t> departureTime = std::nullopt);
 };
 
 void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph);
@@ -42,4 +52,7 @@ uint32_t DeserializeIndexGraphNumRoads(MwmValue const & mwmValue, VehicleType ve
 
 bool ReadRoadAccessFromMwm(MwmValue const & mwmValue, VehicleType vehicleType, RoadAccess & roadAccess);
 bool ReadSpeedCamsFromMwm(MwmValue const & mwmValue, SpeedCamerasMapT & camerasMap);
+bool ReadRoutingShortcutsFromMwm(MwmValue const & mwmValue, NumMwmId numMwmId, RoutingShortcuts & shortcuts);
+bool ReadRoutingLandmarksFromMwm(MwmValue const & mwmValue, VehicleType vehicleType, RoutingLandmarks & landmarks);
+bool ReadSpeedProfilesFromMwm(MwmValue const & mwmValue, SpeedProfiles & speedProfiles);
 }  // namespace routing
@@ -53,6 +53,22 @@ IndexGraphStarter::IndexGraphStarter(FakeEnding const & startEnding, FakeEnding
   m_startToFinishDistanceM = ms::DistanceOnEarth(startPoint, finishPoint);
 }
 
+IndexGraphStarter::IndexGraphStarter(IndexGraphStarter const & starter, WorldGraph & graph)
+  : m_graph(graph)
+  , m_start(starter.m_start)
+  , m_finish(starter.m_finish)
+  , m_startToFinishDistanceM(starter.m_startToFinishDistanceM)
+  , m_fake(starter.m_fake)
+  , m_guides(starter.m_guides)
+  , m_fakeNumerationStart(starter.m_fakeNumerationStart)
+  , m_otherEndings(starter.m_otherEndings)
+  , m_regionsGraph(starter.m_regionsGraph)
+  , m_landmarks(starter.m_landmarks)
+  , m_startTime(starter.m_startTime)
+{
+  CHECK_EQUAL(m_graph.GetMode(), starter.m_graph.GetMode(), ());
+}
+
 void IndexGraphStarter::Append(FakeEdgesContainer const & container)
 {
   m_finish = container.m_finish;
@@ -71,6 +87,24 @@ void IndexGraphStarter::SetGuides(GuidesGraph const & guides)
   m_guides = guides;
 }
 
+void IndexGraphStarter::SetLandmarks(RoutingLandmarks const & landmarks, NumMwmId mwmId)
+{
+  // Fake parts of an ending are connected with both points of its real segments.
+  auto const getPoints = [mwmId](Ending const & ending)
+  {
+    vector<RoadPoint> points;
+    for (auto const & segment : ending.m_real)
+    {
+      CHECK_EQUAL(segment.GetMwmId(), mwmId, ());
+      points.emplace_back(segment.GetFeatureId(), segment.GetPointId(false /* front */));
+      points.emplace_back(segment.GetFeatureId(), segment.GetPointId(true /* front */));
+    }
+    return points;
+  };
+
+  m_landmarks.emplace(landmarks, mwmId, getPoints(m_start), getPoints(m_finish));
+}
+
 void IndexGraphStarter::SetRegionsGraphMode(std::shared_ptr<RegionsSparseGraph> regionsSparseGraph)
 {
   m_regionsGraph = std::move(regionsSparseGraph);
@@ -202,9 +236,17 @@ void IndexGraphStarter::GetEdgesList(astar::VertexData<Vertex, Weight> const & v
         }
         else
         {
-          astar::VertexData const replacedFakeSegment(real, vertexData.m_realDistance);
+          astar::VertexData const replacedFakeSegment(real, m_startTime + vertexData.m_realDistance);
           m_graph.GetEdgeList(replacedFakeSegment, isOutgoing, true /* useRoutingOptions */, useAccessConditional,
                               edges);
+          // Ingoing edges of |real| are weighted with the whole |real|, but the forward wave reaches
+          // |segment| with the weight of |segment| only (see AddFakeEdges()). The same weight should be
+          // used by the backward wave, otherwise bidirectional routes depend on where the waves meet.
+          if (!isOutgoing)
+          {
+            for (auto & edge : edges)
+              edge.GetWeight() = ingoingSegmentWeight;
+          }
         }
       }
     }
@@ -222,7 +264,8 @@ void IndexGraphStarter::GetEdgesList(astar::VertexData<Vertex, Weight> const & v
   }
   else
   {
-    m_graph.GetEdgeList(vertexData, isOutgoing, true /* useRoutingOptions */, useAccessConditional, edges);
+    m_graph.GetEdgeList({segment, m_startTime + vertexData.m_realDistance}, isOutgoing, true /* useRoutingOptions */,
+                        useAccessConditional, edges);
   }
 
   AddFakeEdges(segment, isOutgoing, edges);
@@ -278,7 +321,8 @@ RouteWeight IndexGraphStarter::CalcSegmentWeight(Segment const & segment, EdgeEs
   return m_graph.CalcOffroadWeight(vertex.GetPointFrom(), vertex.GetPointTo(), purpose);
 }
 
-double IndexGraphStarter::CalculateETA(Segment const & from, Segment const & to) const
+double IndexGraphStarter::CalculateETA(Segment const & from, Segment const & to,
+                                       optional<RouteWeight const> const & timeToFrom) const
 {
   // We don't distinguish fake segment weight and fake segment transit time.
   if (IsFakeSegment(to))
@@ -306,7 +350,7 @@ double IndexGraphStarter::CalculateETA(Segment const & from, Segment const & to)
   if (IsRegionsGraphMode())
     return m_regionsGraph->CalcSegmentWeight(from).GetWeight() + m_regionsGraph->CalcSegmentWeight(to).GetWeight();
 
-  return m_graph.CalculateETA(from, to);
+  return m_graph.CalculateETA(from, to, timeToFrom);
 }
 
 double IndexGraphStarter::CalculateETAWithoutPenalty(Segment const & segment) const
@@ -586,6 +630,21 @@ Segment IndexGraphStarter::GetFakeSegmentAndIncr()
   return GetFakeSegment(m_fakeNumerationStart++);
 }
 
+RouteWeight IndexGraphStarter::HeuristicCostEstimate(Vertex const & from, Vertex const & to)
+{
+  auto const weight = m_graph.HeuristicCostEstimate(GetPoint(from, true /* front */), GetPoint(to, true /* front */));
+  if (!m_landmarks || IsFakeSegment(from))
+    return weight;
+
+  // Landmark bounds are known for real segments only. A route from a real segment reaches the finish
+  // through a point of a real segment of the finish ending, so the bounds for that point hold.
+  if (to == GetFinishSegment())
+    return max(weight, RouteWeight(m_landmarks->GetWeightToFinish(from)));
+  if (to == GetStartSegment())
+    return max(weight, RouteWeight(m_landmarks->GetWeightFromStart(from)));
+  return weight;
+}
+
 RouteWeight IndexGraphStarter::GetAStarWeightEpsilon()
 {
   // Epsilon for double calculations.
@@ -10,12 +10,14 @@
 #include "routing/index_graph.hpp"
 #include "routing/latlon_with_altitude.hpp"
 #include "routing/route_weight.hpp"
+#include "routing/routing_landmarks.hpp"
 #include "routing/segment.hpp"
 #include "routing/world_graph.hpp"
 
 #include "routing_common/num_mwm_id.hpp"
 
 #include <memory>
+#include <optional>
 #include <set>
 #include <vector>
 
@@ -62,11 +64,26 @@ public:
   // place two fake edges to the m_segment with both directions.
   IndexGraphStarter(FakeEnding const & startEnding, FakeEnding const & finishEnding, uint32_t fakeNumerationStart,
                     bool strictForward, WorldGraph & graph);
+  // Copies fake edges, endings and settings of |starter| to route on |graph|. |graph| should be
+  // an independent instance of the world graph of |starter|, so both starters may be used on
+  // different threads.
+  IndexGraphStarter(IndexGraphStarter const & starter, WorldGraph & graph);
 
   void Append(FakeEdgesContainer const & container);
 
   void SetGuides(GuidesGraph const & guides);
 
+  // Makes HeuristicCostEstimate() use ALT lower bounds of |landmarks| together with the straight
+  // line estimate. Both route endings should be in |mwmId|. The bounds hold for paths inside |mwmId|
+  // only, so the graph should be in SingleMwm or JointSingleMwm mode while they are used.
+  void SetLandmarks(RoutingLandmarks const & landmarks, NumMwmId mwmId);
+  void ResetLandmarks() { m_landmarks.reset(); }
+
+  // Time-dependent weights of the graph (see IndexGraph::CalculateEdgeWeight()) are taken at
+  // |startTime| after the departure plus the time from the route start. It's not zero for routes
+  // which continue other routes, e.g. for the leaps of LeapsOnly mode.
+  void SetStartTime(RouteWeight const & startTime) { m_startTime = startTime; }
+
   void SetRegionsGraphMode(std::shared_ptr<RegionsSparseGraph> regionsSparseGraph);
   bool IsRegionsGraphMode() const { return m_regionsGraph != nullptr; }
 
@@ -100,8 +117,8 @@ public:
   void GetEdgeList(astar::VertexData<JointSegment, Weight> const & parentVertexData, Segment const & segment,
                    bool isOutgoing, JointEdgeListT & edges, WeightListT & parentWeights) const
   {
-    return m_graph.GetEdgeList(parentVertexData, segment, isOutgoing, true /* useAccessConditional */, edges,
-                               parentWeights);
+    return m_graph.GetEdgeList({parentVertexData.m_vertex, m_startTime + parentVertexData.m_realDistance}, segment,
+                               isOutgoing, true /* useAccessConditional */, edges, parentWeights);
   }
 
   // AStarGraph overridings:
@@ -116,10 +133,7 @@ public:
     GetEdgesList(vertexData, false /* isOutgoing */, true /* useAccessConditional */, edges);
   }
 
-  RouteWeight HeuristicCostEstimate(Vertex const & from, Vertex const & to) override
-  {
-    return m_graph.HeuristicCostEstimate(GetPoint(from, true /* front */), GetPoint(to, true /* front */));
-  }
+  RouteWeight HeuristicCostEstimate(Vertex const & from, Vertex const & to) override;
 
   void SetAStarParents(bool forward, Parents<Segment> & parents) override { m_graph.SetAStarParents(forward, parents); }
 
@@ -146,7 +160,8 @@ public:
 
   RouteWeight CalcSegmentWeight(Segment const & segment, EdgeEstimator::Purpose purpose) const;
   RouteWeight CalcGuidesSegmentWeight(Segment const & segment, EdgeEstimator::Purpose purpose) const;
-  double CalculateETA(Segment const & from, Segment const & to) const;
+  double CalculateETA(Segment const & from, Segment const & to,
+                      std::optional<RouteWeight const> const & timeToFrom = std::nullopt) const;
   double CalculateETAWithoutPenalty(Segment const & segment) const;
 
   /// @name For compatibility with IndexGraphStarterJoints.
@@ -241,5 +256,9 @@ private:
 
   // Field for routing in mode for finding all route mwms.
   std::shared_ptr<RegionsSparseGraph> m_regionsGraph = nullptr;
+
+  std::optional<LandmarksHeuristic> m_landmarks;
+
+  RouteWeight m_startTime = GetAStarWeightZero<RouteWeight>();
 };
 }  // namespace routing
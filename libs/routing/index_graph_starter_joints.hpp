@@ -164,9 +164,6 @@ private:
   Segment m_startSegment;
   Segment m_endSegment;
 
-  ms::LatLon m_startPoint;
-  ms::LatLon m_endPoint;
-
   // See comments in |GetEdgeList()| about |m_savedWeight|.
   ska::bytell_hash_map<Vertex, Weight> m_savedWeight;
 
@@ -215,7 +212,6 @@ IndexGraphStarterJoints<Graph>::IndexGraphStarterJoints(Graph & graph, Segment c
 
   m_endSegment = Segment();
   m_endJoint = JointSegment();
-  m_endPoint = ms::LatLon();
 
   m_init = true;
 }
@@ -235,9 +231,6 @@ void IndexGraphStarterJoints<Graph>::InitEnding(Segment const & ending, bool sta
   auto & segment = start ? m_startSegment : m_endSegment;
   segment = ending;
 
-  auto & point = start ? m_startPoint : m_endPoint;
-  point = m_graph.GetPoint(ending, true /* front */);
-
   auto & endingJoint = start ? m_startJoint : m_endJoint;
   if (IsRealSegment(ending))
   {
@@ -279,8 +272,8 @@ RouteWeight IndexGraphStarterJoints<Graph>::HeuristicCostEstimate(JointSegment c
     fromSegment = from.GetSegment(false /* start */);
   }
 
-  return (to == m_endJoint) ? m_graph.HeuristicCostEstimate(fromSegment, m_endPoint)
-                            : m_graph.HeuristicCostEstimate(fromSegment, m_startPoint);
+  return (to == m_endJoint) ? m_graph.HeuristicCostEstimate(fromSegment, m_endSegment)
+                            : m_graph.HeuristicCostEstimate(fromSegment, m_startSegment);
 }
 
 template <typename Graph>
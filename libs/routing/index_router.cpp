@@ -9,6 +9,7 @@
 #include "routing/index_graph_starter.hpp"
 #include "routing/index_graph_starter_joints.hpp"
 #include "routing/index_road_graph.hpp"
+#include "routing/isochrone.hpp"
 #include "routing/junction_visitor.hpp"
 #include "routing/leaps_graph.hpp"
 #include "routing/leaps_postprocessor.hpp"
@@ -17,10 +18,12 @@
 #include "routing/route.hpp"
 #include "routing/routing_helpers.hpp"
 #include "routing/routing_options.hpp"
+#include "routing/shortcuts_graph.hpp"
 #include "routing/single_vehicle_world_graph.hpp"
 #include "routing/speed_camera_prohibition.hpp"
 #include "routing/traffic_stash.hpp"
 #include "routing/transit_world_graph.hpp"
+#include "routing/travel_time_matrix.hpp"
 #include "routing/vehicle_mask.hpp"
 
 #include "transit/transit_entities.hpp"
@@ -37,6 +40,7 @@
 #include "geometry/mercator.hpp"
 #include "geometry/parametrized_segment.hpp"
 #include "geometry/polyline2d.hpp"
+#include "geometry/rect_intersect.hpp"
 #include "geometry/segment2d.hpp"
 
 #include "base/assert.hpp"
@@ -44,13 +48,17 @@
 #include "base/logging.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread.hpp"
 
 #include "defines.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <deque>
+#include <exception>
 #include <iterator>
 #include <map>
+#include <thread>
 
 namespace routing
 {
@@ -61,6 +69,8 @@ namespace
 size_t constexpr kMaxRoadCandidates = 10;
 uint32_t constexpr kVisitPeriodForLeaps = 10;
 uint32_t constexpr kVisitPeriod = 40;
+// Threads which calculate routes through the mwms of leaps, including the calling thread.
+size_t constexpr kMaxParallelLeapsThreads = 4;
 
 double constexpr kLeapsStageContribution = 0.15;
 double constexpr kCandidatesStageContribution = 0.55;
@@ -70,8 +80,19 @@ double constexpr kAlmostZeroContribution = 1e-7;
 double constexpr kAdjustRangeM = 5000.0;
 // Full rebuild if distance(meters) is less.
 double constexpr kMinDistanceToFinishM = 10000;
+// The backward tree of adjust is built around the part of the previous route from kBackwardTreeBehindSec
+// behind the user to kBackwardTreeAheadSec ahead of them. The adjust wave doesn't reach the route farther
+// than the adjust limit, so the tree is reused while at least kBackwardTreeMinAheadSec of it is ahead.
+double constexpr kBackwardTreeBehindSec = 60;
+double constexpr kBackwardTreeAheadSec = 10 * 60;
+double constexpr kBackwardTreeMinAheadSec = 5 * 60;
+// The backward tree is kept between adjusts, so the number of its segments is limited.
+size_t constexpr kMaxBackwardTreeSize = 100000;
 // Near MWMs criteria when choosing routing mode.
 double constexpr kCloseMwmPointsDistanceM = 300000;
+// Routing shortcuts are used for longer routes only. Shorter ones are settled mostly in
+// the cells of the route endings anyway.
+double constexpr kMinShortcutsRouteDistanceM = 50000;
 
 double CalcMaxSpeed(NumMwmIds const & numMwmIds, VehicleModelFactoryInterface const & vehicleModelFactory,
                     VehicleType vehicleType)
@@ -95,6 +116,18 @@ SpeedKMpH const & CalcOffroadSpeed(VehicleModelFactoryInterface const & vehicleM
   return vehicleModelFactory.GetVehicleModel()->GetOffroadSpeed();
 }
 
+// Returns the index of the step in [|beginIdx|, |endIdx|) of |steps| which is the nearest to |point|.
+size_t FindNearestStepIdx(vector<SegmentedRoute::Step> const & steps, size_t beginIdx, size_t endIdx,
+                          m2::PointD const & point)
+{
+  CHECK_LESS(beginIdx, endIdx, ());
+  size_t nearestIdx = beginIdx;
+  for (size_t i = beginIdx + 1; i < endIdx; ++i)
+    if (point.SquaredLength(steps[i].GetPoint()) < point.SquaredLength(steps[nearestIdx].GetPoint()))
+      nearestIdx = i;
+  return nearestIdx;
+}
+
 shared_ptr<VehicleModelFactoryInterface> CreateVehicleModelFactory(
     VehicleType vehicleType, CountryParentNameGetterFn const & countryParentNameGetterFn)
 {
@@ -238,6 +271,7 @@ IndexRouter::IndexRouter(VehicleType vehicleType, bool loadAltitudes,
   , m_loadAltitudes(loadAltitudes)
   , m_name("astar-bidirectional-" + ToString(m_vehicleType))
   , m_dataSource(dataSource, numMwmIds)
+  , m_backwardDataSource(dataSource, numMwmIds)
   , m_vehicleModelFactory(CreateVehicleModelFactory(m_vehicleType, countryParentNameGetterFn))
   , m_countryFileFn(countryFileFn)
   , m_countryRectFn(countryRectFn)
@@ -248,7 +282,7 @@ IndexRouter::IndexRouter(VehicleType vehicleType, bool loadAltitudes,
                 vehicleType == VehicleType::Pedestrian || vehicleType == VehicleType::Transit
                     ? IRoadGraph::Mode::IgnoreOnewayTag
                     : IRoadGraph::Mode::ObeyOnewayTag,
-                m_vehicleModelFactory)
+                m_vehicleModelFactory, m_vehicleType)
   , m_estimator(EdgeEstimator::Create(m_vehicleType, CalcMaxSpeed(*m_numMwmIds, *m_vehicleModelFactory, m_vehicleType),
                                       CalcOffroadSpeed(*m_vehicleModelFactory), m_trafficStash, &dataSource,
                                       m_numMwmIds))
@@ -260,6 +294,10 @@ IndexRouter::IndexRouter(VehicleType vehicleType, bool loadAltitudes,
   CHECK(m_numMwmTree, ());
   CHECK(m_estimator, ());
   CHECK(m_directionsEngine, ());
+
+  size_t const leapsThreadsCount = min<size_t>(kMaxParallelLeapsThreads, max(1U, thread::hardware_concurrency()));
+  for (size_t i = 1; i < leapsThreadsCount; ++i)
+    m_leapsDataSources.push_back(make_unique<MwmDataSource>(dataSource, m_numMwmIds));
 }
 
 unique_ptr<WorldGraph> IndexRouter::MakeSingleMwmWorldGraph()
@@ -274,6 +312,9 @@ void IndexRouter::ClearState()
   m_roadGraph.ClearState();
   m_directionsEngine->Clear();
   m_dataSource.FreeHandles();
+  m_backwardDataSource.FreeHandles();
+  for (auto & dataSource : m_leapsDataSources)
+    dataSource->FreeHandles();
 }
 
 bool IndexRouter::FindClosestProjectionToRoad(m2::PointD const & point, m2::PointD const & direction, double radius,
@@ -354,6 +395,83 @@ RouterResultCode IndexRouter::CalculateRoute(Checkpoints const & checkpoints, m2
   }
 }
 
+RouterResultCode IndexRouter::CalculateMatrix(vector<m2::PointD> const & sources, vector<m2::PointD> const & targets,
+                                              double maxTimeSec, RouterDelegate const & delegate,
+                                              TravelTimeMatrix & matrix)
+{
+  try
+  {
+    SCOPE_GUARD(featureRoadGraphClear, [this] { ClearState(); });
+
+    TrafficStash::Guard guard(m_trafficStash);
+    auto graph = MakeWorldGraph();
+    graph->SetMode(WorldGraphMode::NoLeaps);
+
+    PointsOnEdgesSnapping snapping(*this, *graph);
+    auto const makeEndings = [&](vector<m2::PointD> const & points, bool isOutgoing)
+    {
+      vector<FakeEnding> endings;
+      endings.reserve(points.size());
+      for (auto const & point : points)
+      {
+        vector<Segment> segments;
+        bool dummy = false;
+        if (snapping.FindBestSegments(point, m2::PointD::Zero() /* direction */, isOutgoing, segments, dummy))
+        {
+          endings.push_back(MakeFakeEnding(segments, point, *graph));
+        }
+        else
+        {
+          LOG(LWARNING, ("Can't find roads near", mercator::ToLatLon(point)));
+          endings.emplace_back();
+        }
+      }
+      return endings;
+    };
+
+    auto const sourceEndings = makeEndings(sources, true /* isOutgoing */);
+    auto const targetEndings = makeEndings(targets, false /* isOutgoing */);
+    return CalculateTravelTimeMatrix(*graph, sourceEndings, targetEndings, maxTimeSec, delegate.GetCancellable(),
+                                     matrix);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't calculate travel time matrix", sources.size(), "x", targets.size(), ":\n ", e.what()));
+    return RouterResultCode::InternalError;
+  }
+}
+
+RouterResultCode IndexRouter::CalculateIsochrone(m2::PointD const & start, double maxTimeSec,
+                                                 RouterDelegate const & delegate, vector<IsochroneSegment> & segments)
+{
+  segments.clear();
+  try
+  {
+    SCOPE_GUARD(featureRoadGraphClear, [this] { ClearState(); });
+
+    TrafficStash::Guard guard(m_trafficStash);
+    auto graph = MakeWorldGraph();
+    graph->SetMode(WorldGraphMode::NoLeaps);
+
+    PointsOnEdgesSnapping snapping(*this, *graph);
+    vector<Segment> startSegments;
+    bool dummy = false;
+    if (!snapping.FindBestSegments(start, m2::PointD::Zero() /* direction */, true /* isOutgoing */, startSegments,
+                                   dummy))
+    {
+      return RouterResultCode::StartPointNotFound;
+    }
+
+    return routing::CalculateIsochrone(*graph, MakeFakeEnding(startSegments, start, *graph), maxTimeSec,
+                                       delegate.GetCancellable(), segments);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't calculate isochrone from", mercator::ToLatLon(start), ":\n ", e.what()));
+    return RouterResultCode::InternalError;
+  }
+}
+
 std::vector<Segment> IndexRouter::GetBestOutgoingSegments(m2::PointD const & checkpoint, WorldGraph & graph)
 {
   bool dummy = false;
@@ -492,6 +610,7 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
                                                RouterDelegate const & delegate, Route & route)
 {
   m_lastRoute.reset();
+  m_lastBackwardTree.Clear();
   // MwmId used for guides segments in RedressRoute().
   NumMwmId guidesMwmId = kFakeNumMwmId;
 
@@ -541,6 +660,10 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
 
   PointsOnEdgesSnapping snapping(*this, *graph);
   size_t const subroutesCount = checkpoints.GetNumSubroutes();
+
+  // Alternatives are found for routes without intermediate points only.
+  bool const findAlternatives = m_alternativesParams.IsEnabled() && checkpoints.GetPassedIdx() + 1 == subroutesCount;
+  vector<vector<Segment>> alternatives;
   for (size_t i = checkpoints.GetPassedIdx(); i < subroutesCount; ++i)
   {
     auto const & startCheckpoint = checkpoints.GetPoint(i);
@@ -587,8 +710,8 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
     progress->AppendSubProgress(subProgress);
     SCOPE_GUARD(eraseProgress, [&progress]() { progress->PushAndDropLastSubProgress(); });
 
-    auto const result =
-        CalculateSubroute(checkpoints, i, delegate, progress, subrouteStarter, subroute, m_guides.IsAttached());
+    auto const result = CalculateSubroute(checkpoints, i, delegate, progress, subrouteStarter, subroute,
+                                          m_guides.IsAttached(), findAlternatives ? &alternatives : nullptr);
 
     if (result != RouterResultCode::NoError)
       return result;
@@ -628,6 +751,9 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
 
   LOG(LINFO, ("Route length:", route.GetTotalDistanceMeters(), "meters. ETA:", route.GetTotalTimeSec(), "seconds."));
 
+  if (!alternatives.empty())
+    RedressAlternatives(alternatives, delegate.GetCancellable(), *starter, route);
+
   m_lastRoute = make_unique<SegmentedRoute>(checkpoints.GetStart(), checkpoints.GetFinish(), route.GetSubroutes());
   for (Segment const & segment : segments)
     m_lastRoute->AddStep(segment, mercator::FromLatLon(starter->GetPoint(segment, true /* front */)));
@@ -667,9 +793,12 @@ vector<Segment> ProcessJoints(vector<JointSegment> const & jointsPath,
 RouterResultCode IndexRouter::CalculateSubroute(Checkpoints const & checkpoints, size_t subrouteIdx,
                                                 RouterDelegate const & delegate,
                                                 shared_ptr<AStarProgress> const & progress, IndexGraphStarter & starter,
-                                                vector<Segment> & subroute, bool guidesActive /* = false */)
+                                                vector<Segment> & subroute, bool guidesActive /* = false */,
+                                                vector<vector<Segment>> * alternatives /* = nullptr */)
 {
   subroute.clear();
+  if (guidesActive || IsTimeDependent())
+    alternatives = nullptr;
 
   SetupAlgorithmMode(starter, guidesActive);
 
@@ -677,10 +806,51 @@ RouterResultCode IndexRouter::CalculateSubroute(Checkpoints const & checkpoints,
   LOG(LINFO, ("Routing in mode:", mode));
 
   base::ScopedTimerWithLog timer("Route build");
+  if (!guidesActive && (mode == WorldGraphMode::Joints || mode == WorldGraphMode::NoLeaps))
+  {
+    if (auto const * landmarks = GetRoutingLandmarks(starter))
+    {
+      LOG(LINFO, ("Routing with", ROUTING_LANDMARKS_FILE_TAG));
+      starter.SetLandmarks(*landmarks, *starter.GetStartMwms().begin());
+      bool const joints = mode == WorldGraphMode::Joints;
+      starter.GetGraph().SetMode(joints ? WorldGraphMode::JointSingleMwm : WorldGraphMode::SingleMwm);
+      auto const result = joints ? CalculateSubrouteJointsMode(starter, delegate, progress, subroute, alternatives)
+                                 : CalculateSubrouteNoLeapsMode(starter, delegate, progress, subroute, alternatives);
+      starter.GetGraph().SetMode(mode);
+      starter.ResetLandmarks();
+      if (result != RouterResultCode::RouteNotFound)
+        return result;
+
+      // Landmark bounds are not valid for paths through other mwms.
+      LOG(LWARNING, ("Route with landmarks is not found. Routing in mode:", mode));
+      subroute.clear();
+    }
+  }
+
+  // Shortcuts skip the vertices inside cells, so the waves of alternatives don't meet there.
+  // Weights of shortcuts are static.
+  if (mode == WorldGraphMode::Joints && !alternatives && !IsTimeDependent())
+  {
+    if (auto const * shortcuts = GetRoutingShortcuts(starter))
+    {
+      LOG(LINFO, ("Routing with", ROUTING_SHORTCUTS_FILE_TAG));
+      starter.GetGraph().SetMode(WorldGraphMode::SingleMwm);
+      auto const result = CalculateSubrouteShortcutsMode(*shortcuts, starter, delegate, progress, subroute);
+      starter.GetGraph().SetMode(mode);
+      if (result != RouterResultCode::RouteNotFound)
+        return result;
+
+      // Shortcuts skip paths which change road access or pass-through type inside a cell.
+      LOG(LWARNING, ("Route with shortcuts is not found. Routing in mode:", mode));
+      subroute.clear();
+    }
+  }
+
   switch (mode)
   {
-  case WorldGraphMode::Joints: return CalculateSubrouteJointsMode(starter, delegate, progress, subroute);
-  case WorldGraphMode::NoLeaps: return CalculateSubrouteNoLeapsMode(starter, delegate, progress, subroute);
+  case WorldGraphMode::Joints: return CalculateSubrouteJointsMode(starter, delegate, progress, subroute, alternatives);
+  case WorldGraphMode::NoLeaps:
+    return CalculateSubrouteNoLeapsMode(starter, delegate, progress, subroute, alternatives);
   case WorldGraphMode::LeapsOnly:
     return CalculateSubrouteLeapsOnlyMode(checkpoints, subrouteIdx, starter, delegate, progress, subroute);
   default: CHECK(false, ("Wrong WorldGraphMode here:", mode));
@@ -690,7 +860,8 @@ RouterResultCode IndexRouter::CalculateSubroute(Checkpoints const & checkpoints,
 
 RouterResultCode IndexRouter::CalculateSubrouteJointsMode(IndexGraphStarter & starter, RouterDelegate const & delegate,
                                                           shared_ptr<AStarProgress> const & progress,
-                                                          vector<Segment> & subroute)
+                                                          vector<Segment> & subroute,
+                                                          vector<vector<Segment>> * alternatives)
 {
   using JointsStarter = IndexGraphStarterJoints<IndexGraphStarter>;
   JointsStarter jointStarter(starter, starter.GetStartSegment(), starter.GetFinishSegment());
@@ -707,7 +878,35 @@ RouterResultCode IndexRouter::CalculateSubrouteJointsMode(IndexGraphStarter & st
       std::move(visitor), AStarLengthChecker(starter));
 
   RoutingResult<Vertex, Weight> routingResult;
-  RouterResultCode const result = FindPath<Vertex, Edge, Weight>(params, {} /* mwmIds */, routingResult);
+  RouterResultCode result;
+  if (alternatives)
+  {
+    vector<RoutingResult<Vertex, Weight>> routingResults;
+    result = FindPathWithAlternatives<Vertex, Edge, Weight>(params, {} /* mwmIds */, routingResults);
+    if (result == RouterResultCode::NoError)
+    {
+      routingResult = std::move(routingResults.front());
+      for (size_t i = 1; i < routingResults.size(); ++i)
+        alternatives->push_back(ProcessJoints(routingResults[i].m_path, jointStarter));
+    }
+  }
+  else if (auto backwardGraph = MakeBackwardWaveWorldGraph(starter))
+  {
+    // Fake joints are numerated in the same way for the same starter, so vertices of both
+    // joint starters are the same.
+    IndexGraphStarter backwardStarter(starter, *backwardGraph);
+    JointsStarter backwardJointStarter(backwardStarter, backwardStarter.GetStartSegment(),
+                                       backwardStarter.GetFinishSegment());
+    AStarAlgorithm<Vertex, Edge, Weight>::Params<astar::DefaultVisitor, AStarLengthChecker> backwardParams(
+        backwardJointStarter, backwardJointStarter.GetStartJoint(), backwardJointStarter.GetFinishJoint(),
+        delegate.GetCancellable(), astar::DefaultVisitor(), AStarLengthChecker(backwardStarter));
+
+    result = FindPathParallel<Vertex, Edge, Weight>(params, backwardParams, {} /* mwmIds */, routingResult);
+  }
+  else
+  {
+    result = FindPath<Vertex, Edge, Weight>(params, {} /* mwmIds */, routingResult);
+  }
 
   if (result != RouterResultCode::NoError)
     return result;
@@ -719,7 +918,8 @@ RouterResultCode IndexRouter::CalculateSubrouteJointsMode(IndexGraphStarter & st
 
 RouterResultCode IndexRouter::CalculateSubrouteNoLeapsMode(IndexGraphStarter & starter, RouterDelegate const & delegate,
                                                            shared_ptr<AStarProgress> const & progress,
-                                                           vector<Segment> & subroute)
+                                                           vector<Segment> & subroute,
+                                                           vector<vector<Segment>> * alternatives)
 {
   using Vertex = IndexGraphStarter::Vertex;
   using Edge = IndexGraphStarter::Edge;
@@ -734,7 +934,31 @@ RouterResultCode IndexRouter::CalculateSubrouteNoLeapsMode(IndexGraphStarter & s
 
   RoutingResult<Vertex, Weight> routingResult;
   set<NumMwmId> const mwmIds = starter.GetMwms();
-  RouterResultCode const result = FindPath<Vertex, Edge, Weight>(params, mwmIds, routingResult);
+  RouterResultCode result;
+  if (alternatives)
+  {
+    vector<RoutingResult<Vertex, Weight>> routingResults;
+    result = FindPathWithAlternatives<Vertex, Edge, Weight>(params, mwmIds, routingResults);
+    if (result == RouterResultCode::NoError)
+    {
+      routingResult = std::move(routingResults.front());
+      for (size_t i = 1; i < routingResults.size(); ++i)
+        alternatives->push_back(std::move(routingResults[i].m_path));
+    }
+  }
+  else if (auto backwardGraph = MakeBackwardWaveWorldGraph(starter))
+  {
+    IndexGraphStarter backwardStarter(starter, *backwardGraph);
+    AStarAlgorithm<Vertex, Edge, Weight>::Params<astar::DefaultVisitor, AStarLengthChecker> backwardParams(
+        backwardStarter, backwardStarter.GetStartSegment(), backwardStarter.GetFinishSegment(),
+        delegate.GetCancellable(), astar::DefaultVisitor(), AStarLengthChecker(backwardStarter));
+
+    result = FindPathParallel<Vertex, Edge, Weight>(params, backwardParams, mwmIds, routingResult);
+  }
+  else
+  {
+    result = FindPath<Vertex, Edge, Weight>(params, mwmIds, routingResult);
+  }
 
   if (result != RouterResultCode::NoError)
     return result;
@@ -744,6 +968,75 @@ RouterResultCode IndexRouter::CalculateSubrouteNoLeapsMode(IndexGraphStarter & s
   return result;
 }
 
+RouterResultCode IndexRouter::CalculateSubrouteShortcutsMode(RoutingShortcuts const & shortcuts,
+                                                             IndexGraphStarter & starter,
+                                                             RouterDelegate const & delegate,
+                                                             shared_ptr<AStarProgress> const & progress,
+                                                             vector<Segment> & subroute)
+{
+  using Vertex = ShortcutsGraph::Vertex;
+  using Edge = ShortcutsGraph::Edge;
+  using Weight = ShortcutsGraph::Weight;
+
+  ShortcutsGraph shortcutsGraph(starter, shortcuts);
+
+  using Visitor = JunctionVisitor<ShortcutsGraph>;
+  Visitor visitor(shortcutsGraph, delegate, kVisitPeriod, progress);
+
+  AStarAlgorithm<Vertex, Edge, Weight>::Params<Visitor, AStarLengthChecker> params(
+      shortcutsGraph, shortcutsGraph.GetStartSegment(), shortcutsGraph.GetFinishSegment(), delegate.GetCancellable(),
+      std::move(visitor), AStarLengthChecker(starter));
+
+  RoutingResult<Vertex, Weight> routingResult;
+  RouterResultCode const result = FindPath<Vertex, Edge, Weight>(params, {} /* mwmIds */, routingResult);
+
+  if (result != RouterResultCode::NoError)
+    return result;
+
+  LOG(LDEBUG, ("Result route weight:", routingResult.m_distance));
+  if (!shortcutsGraph.UnpackPath(routingResult.m_path, delegate.GetCancellable(), subroute))
+  {
+    subroute.clear();
+    return delegate.GetCancellable().IsCancelled() ? RouterResultCode::Cancelled : RouterResultCode::RouteNotFound;
+  }
+  return result;
+}
+
+RoutingShortcuts const * IndexRouter::GetRoutingShortcuts(IndexGraphStarter & starter) const
+{
+  if (!m_useShortcuts || m_vehicleType != VehicleType::Car)
+    return nullptr;
+
+  auto const & mwmIds = starter.GetStartMwms();
+  if (mwmIds.size() != 1 || mwmIds != starter.GetFinishMwms())
+    return nullptr;
+
+  if (ms::DistanceOnEarth(starter.GetStartJunction().GetLatLon(), starter.GetFinishJunction().GetLatLon()) <
+      kMinShortcutsRouteDistanceM)
+  {
+    return nullptr;
+  }
+
+  // Shortcut weights are calculated without traffic and avoid routing options.
+  NumMwmId const mwmId = *mwmIds.begin();
+  if ((m_trafficStash && m_trafficStash->Has(mwmId)) || starter.GetGraph().GetAvoidRoutingOptions().GetOptions() != 0)
+    return nullptr;
+
+  return starter.GetGraph().GetRoutingShortcuts(mwmId);
+}
+
+RoutingLandmarks const * IndexRouter::GetRoutingLandmarks(IndexGraphStarter & starter) const
+{
+  if (!m_useLandmarks || (m_vehicleType != VehicleType::Pedestrian && m_vehicleType != VehicleType::Bicycle))
+    return nullptr;
+
+  auto const & mwmIds = starter.GetStartMwms();
+  if (mwmIds.size() != 1 || mwmIds != starter.GetFinishMwms())
+    return nullptr;
+
+  return starter.GetGraph().GetRoutingLandmarks(*mwmIds.begin());
+}
+
 namespace
 {
 void CollapseForward_ReverseLoops(std::vector<Segment> & path)
@@ -761,6 +1054,24 @@ void CollapseForward_ReverseLoops(std::vector<Segment> & path)
 }
 }  // namespace
 
+void IndexRouter::LoadCrossMwmConnectors(m2::PointD const & start, m2::PointD const & finish, WorldGraph & graph) const
+{
+  CHECK(m_numMwmTree, ());
+
+  vector<NumMwmId> mwmIds;
+  m_numMwmTree->ForEachInRect(m2::RectD(start, finish), [&](NumMwmId id)
+  {
+    m2::PointD p1 = start;
+    m2::PointD p2 = finish;
+    if (m2::Intersect(m_countryRectFn(m_numMwmIds->GetFile(id).GetName()), p1, p2))
+      mwmIds.push_back(id);
+  });
+
+  base::Timer timer;
+  graph.GetCrossMwmGraph().LoadCrossMwmConnectors(mwmIds);
+  LOG(LINFO, ("Cross mwm connectors of", mwmIds.size(), "mwms loaded in", timer.ElapsedMilliseconds(), "ms"));
+}
+
 RouterResultCode IndexRouter::CalculateSubrouteLeapsOnlyMode(Checkpoints const & checkpoints, size_t subrouteIdx,
                                                              IndexGraphStarter & starter,
                                                              RouterDelegate const & delegate,
@@ -771,6 +1082,12 @@ RouterResultCode IndexRouter::CalculateSubrouteLeapsOnlyMode(Checkpoints const &
   using Edge = LeapsGraph::Edge;
   using Weight = LeapsGraph::Weight;
 
+  if (m_crossMwmWarmStart)
+  {
+    LoadCrossMwmConnectors(checkpoints.GetPoint(subrouteIdx), checkpoints.GetPoint(subrouteIdx + 1),
+                           starter.GetGraph());
+  }
+
   // Get cross-mwm routes-candidates.
   std::vector<RoutingResultT> candidates;
   std::vector<RouteWeight> candidateMidWeights;
@@ -821,7 +1138,8 @@ RouterResultCode IndexRouter::CalculateSubrouteLeapsOnlyMode(Checkpoints const &
     base::Timer timer;
 
     using AlgoT = AStarAlgorithm<Vertex, Edge, Weight>;
-    auto const result = AlgoT().FindPathBidirectionalEx(params, [&](RoutingResultT && route)
+    AlgoT algorithm(GetAStarStorage<Vertex, Edge, Weight>());
+    auto const result = algorithm.FindPathBidirectionalEx(params, [&](RoutingResultT && route)
     {
       // Take unique routes by key vertices.
       auto const be = getBegEnd(route);
@@ -910,7 +1228,7 @@ RouterResultCode IndexRouter::CalculateSubrouteLeapsOnlyMode(Checkpoints const &
   // CrossMwmConnector takes a lot of memory with its weights matrix now.
   starter.GetGraph().GetCrossMwmGraph().Purge();
 
-  RoutesCalculator calculator(starter, delegate);
+  RoutesCalculator calculator(starter, delegate, m_jointsAStarStorage, IsTimeDependent());
   RoutingResultT const * bestC = nullptr;
 
   {
@@ -926,10 +1244,14 @@ RouterResultCode IndexRouter::CalculateSubrouteLeapsOnlyMode(Checkpoints const &
       LOG(LDEBUG, ("Process leaps:", c.m_distance, c.m_path));
 
       size_t const sz = c.m_path.size();
-      auto const * r1 = calculator.Calc2Times(c.m_path[0], c.m_path[1], progress, candidateContribution);
-      auto const * r2 = calculator.Calc2Times(c.m_path[sz - 2], c.m_path[sz - 1], progress, candidateContribution);
+      auto const * r1 = calculator.Calc2Times(c.m_path[0], c.m_path[1], GetAStarWeightZero<RouteWeight>(), progress,
+                                              candidateContribution);
+      if (!r1)
+        continue;
 
-      if (r1 && r2)
+      auto const * r2 = calculator.Calc2Times(c.m_path[sz - 2], c.m_path[sz - 1],
+                                              r1->m_distance + candidateMidWeights[i], progress, candidateContribution);
+      if (r2)
       {
         RouteWeight const w = r1->m_distance + candidateMidWeights[i] + r2->m_distance;
         if (w < bestW)
@@ -997,15 +1319,6 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints, m2::P
 
   starter.Append(*m_lastFakeEdges);
 
-  vector<SegmentEdge> prevEdges;
-  CHECK_LESS_OR_EQUAL(lastSubroute.GetEndSegmentIdx(), steps.size(), ());
-  for (size_t i = lastSubroute.GetBeginSegmentIdx(); i < lastSubroute.GetEndSegmentIdx(); ++i)
-  {
-    auto const & step = steps[i];
-    prevEdges.emplace_back(step.GetSegment(),
-                           starter.CalcSegmentWeight(step.GetSegment(), EdgeEstimator::Purpose::Weight));
-  }
-
   using Visitor = JunctionVisitor<IndexGraphStarter>;
   Visitor visitor(starter, delegate, kVisitPeriod);
 
@@ -1014,12 +1327,69 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints, m2::P
   using Weight = IndexGraphStarter::Weight;
 
   AStarAlgorithm<Vertex, Edge, Weight> algorithm;
+  size_t const beginIdx = lastSubroute.GetBeginSegmentIdx();
+  size_t const endIdx = lastSubroute.GetEndSegmentIdx();
+  CHECK_LESS_OR_EQUAL(endIdx, steps.size(), ());
+  size_t const nearestIdx = FindNearestStepIdx(steps, beginIdx, endIdx, pointFrom);
+  // The tree doesn't depend on the start, so only the first deviation near a part of the subroute pays for it.
+  if (m_lastBackwardTree.IsEmpty() || m_lastBackwardTreeSubrouteIdx != checkpoints.GetPassedIdx() ||
+      nearestIdx < m_lastBackwardTreeBeginIdx || nearestIdx >= m_lastBackwardTreeEndIdx)
+  {
+    base::Timer treeTimer;
+    vector<SegmentEdge> prevEdges;
+    for (size_t i = beginIdx; i < endIdx; ++i)
+    {
+      auto const & step = steps[i];
+      prevEdges.emplace_back(step.GetSegment(),
+                             starter.CalcSegmentWeight(step.GetSegment(), EdgeEstimator::Purpose::Weight));
+    }
+
+    // The wave is propagated from the edges in [waveBeginIdx, waveEndIdx) near the user.
+    size_t waveBeginIdx = nearestIdx - beginIdx;
+    for (double timeSec = 0.0; waveBeginIdx > 0 && timeSec < kBackwardTreeBehindSec; --waveBeginIdx)
+      timeSec += prevEdges[waveBeginIdx].GetWeight().GetWeight();
+
+    size_t waveEndIdx = nearestIdx - beginIdx + 1;
+    size_t reuseEndIdx = waveEndIdx;
+    for (double timeSec = 0.0; waveEndIdx < prevEdges.size() && timeSec < kBackwardTreeAheadSec; ++waveEndIdx)
+    {
+      timeSec += prevEdges[waveEndIdx].GetWeight().GetWeight();
+      if (timeSec <= kBackwardTreeAheadSec - kBackwardTreeMinAheadSec)
+        reuseEndIdx = waveEndIdx + 1;
+    }
+
+    AStarAlgorithm<Vertex, Edge, Weight>::Params<astar::DefaultVisitor, BackwardTreeLengthChecker> treeParams(
+        starter, {} /* startVertex */, {} /* finalVertex */, delegate.GetCancellable(), astar::DefaultVisitor(),
+        BackwardTreeLengthChecker());
+    auto const treeCode = ConvertResult<Vertex, Edge, Weight>(algorithm.BuildBackwardTree(
+        treeParams, prevEdges, waveBeginIdx, waveEndIdx, kMaxBackwardTreeSize, m_lastBackwardTree));
+    if (treeCode != RouterResultCode::NoError)
+    {
+      m_lastBackwardTree.Clear();
+      return treeCode;
+    }
+
+    // Fake segments of the start are numbered after the ones of |m_lastFakeEdges| and are different
+    // for every adjust, so they are not kept in the tree.
+    uint32_t const numFakeEdges = m_lastFakeEdges->GetNumFakeEdges();
+    m_lastBackwardTree.RemoveIf([numFakeEdges](Segment const & segment)
+    { return IndexGraphStarter::IsFakeSegment(segment) && segment.GetSegmentIdx() >= numFakeEdges; });
+
+    m_lastBackwardTreeSubrouteIdx = checkpoints.GetPassedIdx();
+    m_lastBackwardTreeBeginIdx = beginIdx + waveBeginIdx;
+    // The tree near the end of the subroute is reused till the end.
+    m_lastBackwardTreeEndIdx = beginIdx + (waveEndIdx == prevEdges.size() ? waveEndIdx : reuseEndIdx);
+    LOG(LINFO, ("Backward tree of", waveEndIdx - waveBeginIdx, "of", prevEdges.size(),
+                "route segments:", m_lastBackwardTree.GetSize(), "segments, elapsed:", treeTimer.ElapsedSeconds()));
+  }
+
   AStarAlgorithm<Vertex, Edge, Weight>::Params<Visitor, AdjustLengthChecker> params(
       starter, starter.GetStartSegment(), {} /* finalVertex */, delegate.GetCancellable(), std::move(visitor),
       AdjustLengthChecker(starter));
 
   RoutingResult<Segment, RouteWeight> result;
-  auto const resultCode = ConvertResult<Vertex, Edge, Weight>(algorithm.AdjustRoute(params, prevEdges, result));
+  auto const resultCode =
+      ConvertResult<Vertex, Edge, Weight>(algorithm.AdjustRoute(params, m_lastBackwardTree, result));
   if (resultCode != RouterResultCode::NoError)
     return resultCode;
 
@@ -1060,7 +1430,7 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints, m2::P
   return RouterResultCode::NoError;
 }
 
-unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph()
+unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph(MwmDataSource & dataSource)
 {
   // Use saved routing options for all types (car, bicycle, pedestrian).
   RoutingOptions const routingOptions = RoutingOptions::LoadCarOptionsFromSettings();
@@ -1071,11 +1441,12 @@ unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph()
 
   auto crossMwmGraph = make_unique<CrossMwmGraph>(
       m_numMwmIds, m_numMwmTree, m_vehicleType == VehicleType::Transit ? VehicleType::Pedestrian : m_vehicleType,
-      m_countryRectFn, m_dataSource);
+      m_countryRectFn, dataSource);
 
   auto indexGraphLoader =
       IndexGraphLoader::Create(m_vehicleType == VehicleType::Transit ? VehicleType::Pedestrian : m_vehicleType,
-                               m_loadAltitudes, m_vehicleModelFactory, m_estimator, m_dataSource, routingOptions);
+                               m_loadAltitudes, m_vehicleModelFactory, m_estimator, dataSource, routingOptions,
+                               m_roadGeometryCache, m_departureTime);
 
   if (m_vehicleType != VehicleType::Transit)
   {
@@ -1086,11 +1457,46 @@ unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph()
     return graph;
   }
 
-  auto transitGraphLoader = TransitGraphLoader::Create(m_dataSource, m_estimator);
+  auto transitGraphLoader = TransitGraphLoader::Create(dataSource, m_estimator);
   return make_unique<TransitWorldGraph>(std::move(crossMwmGraph), std::move(indexGraphLoader),
                                         std::move(transitGraphLoader), m_estimator);
 }
 
+unique_ptr<WorldGraph> IndexRouter::MakeBackwardWaveWorldGraph(IndexGraphStarter const & starter)
+{
+  if (!m_useParallelWaves || m_vehicleType == VehicleType::Transit || starter.IsRegionsGraphMode() ||
+      IsTimeDependent())
+  {
+    return nullptr;
+  }
+
+  auto const mode = starter.GetMode();
+  if (mode != WorldGraphMode::Joints && mode != WorldGraphMode::NoLeaps)
+    return nullptr;
+
+  auto graph = MakeWorldGraph(m_backwardDataSource);
+  graph->SetMode(mode);
+  return graph;
+}
+
+vector<unique_ptr<WorldGraph>> IndexRouter::MakeLeapsWorldGraphs(IndexGraphStarter const & starter)
+{
+  vector<unique_ptr<WorldGraph>> graphs;
+  if (!m_useParallelLeaps || m_vehicleType == VehicleType::Transit || starter.IsRegionsGraphMode() ||
+      IsTimeDependent())
+  {
+    return graphs;
+  }
+
+  for (auto & dataSource : m_leapsDataSources)
+  {
+    auto graph = MakeWorldGraph(*dataSource);
+    graph->SetMode(WorldGraphMode::JointSingleMwm);
+    graphs.push_back(std::move(graph));
+  }
+  return graphs;
+}
+
 int IndexRouter::PointsOnEdgesSnapping::Snap(m2::PointD const & start, m2::PointD const & finish,
                                              m2::PointD const & direction, FakeEnding & startEnding,
                                              FakeEnding & finishEnding, bool & startIsCodirectional)
@@ -1356,11 +1762,49 @@ bool IndexRouter::PointsOnEdgesSnapping::FindBestEdges(m2::PointD const & checkp
   return true;
 }
 
+// static
+template <typename MakeVisitor>
+bool IndexRouter::RoutesCalculator::CalcRoute(IndexGraphStarter & starter, Segment const & beg, Segment const & end,
+                                              RouteWeight const & startTime, bool timeDependent,
+                                              base::Cancellable const & cancellable, MakeVisitor && makeVisitor,
+                                              AStarStorage * storage, RoutingResultT & result)
+{
+  starter.SetStartTime(startTime);
+  SCOPE_GUARD(startTimeGuard, [&starter]() { starter.SetStartTime(GetAStarWeightZero<RouteWeight>()); });
+
+  using JointsStarter = IndexGraphStarterJoints<IndexGraphStarter>;
+  JointsStarter jointStarter(starter);
+  jointStarter.Init(beg, end);
+
+  using Vertex = JointsStarter::Vertex;
+  using Edge = JointsStarter::Edge;
+  using Weight = JointsStarter::Weight;
+  using AlgoT = AStarAlgorithm<Vertex, Edge, Weight>;
+
+  AlgoT::Params<decltype(makeVisitor(jointStarter)), AStarLengthChecker> params(
+      jointStarter, jointStarter.GetStartJoint(), jointStarter.GetFinishJoint(), cancellable,
+      makeVisitor(jointStarter), AStarLengthChecker(starter));
+
+  RoutingResult<JointSegment, RouteWeight> route;
+  auto algorithm = storage ? AlgoT(*storage) : AlgoT();
+  // Time-dependent weights are known for the forward wave only.
+  auto const code =
+      timeDependent ? algorithm.FindPath(params, route) : algorithm.FindPathBidirectional(params, route);
+  if (code != AlgoT::Result::OK)
+    return false;
+
+  result.m_path = ProcessJoints(route.m_path, jointStarter);
+  result.m_distance = route.m_distance;
+  return true;
+}
+
 IndexRouter::RoutingResultT const * IndexRouter::RoutesCalculator::Calc(Segment const & beg, Segment const & end,
+                                                                        RouteWeight const & startTime,
                                                                         ProgressPtrT const & progress,
                                                                         double progressCoef)
 {
-  auto itCache = m_cache.insert({{beg, end}, {}});
+  auto const routeStartTime = m_timeDependent ? startTime : GetAStarWeightZero<RouteWeight>();
+  auto itCache = m_cache.insert({{beg, end, routeStartTime.GetWeight()}, {}});
   auto * res = &itCache.first->second;
 
   // Actually, we can (should?) append/push-drop progress even if the route is already in cache,
@@ -1371,28 +1815,13 @@ IndexRouter::RoutingResultT const * IndexRouter::RoutesCalculator::Calc(Segment
     progress->AppendSubProgress({m_starter.GetPoint(beg, true), m_starter.GetPoint(end, true), progressCoef});
 
     using JointsStarter = IndexGraphStarterJoints<IndexGraphStarter>;
-    JointsStarter jointStarter(m_starter);
-    jointStarter.Init(beg, end);
-
-    using Vertex = JointsStarter::Vertex;
-    using Edge = JointsStarter::Edge;
-    using Weight = JointsStarter::Weight;
-
-    using Visitor = JunctionVisitor<JointsStarter>;
-    AStarAlgorithm<Vertex, Edge, Weight>::Params<Visitor, AStarLengthChecker> params(
-        jointStarter, jointStarter.GetStartJoint(), jointStarter.GetFinishJoint(), m_delegate.GetCancellable(),
-        Visitor(jointStarter, m_delegate, kVisitPeriod, progress), AStarLengthChecker(m_starter));
-
-    RoutingResult<JointSegment, RouteWeight> route;
-    using AlgoT = AStarAlgorithm<Vertex, Edge, Weight>;
+    auto const makeVisitor = [&](JointsStarter & jointStarter)
+    { return JunctionVisitor<JointsStarter>(jointStarter, m_delegate, kVisitPeriod, progress); };
 
-    if (AlgoT().FindPathBidirectional(params, route) == AlgoT::Result::OK)
+    if (CalcRoute(m_starter, beg, end, routeStartTime, m_timeDependent, m_delegate.GetCancellable(), makeVisitor,
+                  &m_storage, *res))
     {
-      LOG(LDEBUG, ("Sub-route weight:", route.m_distance));
-
-      res->m_path = ProcessJoints(route.m_path, jointStarter);
-      res->m_distance = route.m_distance;
-
+      LOG(LDEBUG, ("Sub-route weight:", res->m_distance));
       progress->PushAndDropLastSubProgress();
     }
     else
@@ -1408,7 +1837,80 @@ IndexRouter::RoutingResultT const * IndexRouter::RoutesCalculator::Calc(Segment
   return res;
 }
 
+void IndexRouter::RoutesCalculator::CalcParallel(vector<pair<Segment, Segment>> const & leaps,
+                                                 vector<unique_ptr<WorldGraph>> const & graphs)
+{
+  struct Task
+  {
+    Task(Segment const & beg, Segment const & end) : m_beg(beg), m_end(end) {}
+
+    Segment m_beg;
+    Segment m_end;
+    RoutingResultT m_result;
+    bool m_found = false;
+    exception_ptr m_exception;
+  };
+
+  CHECK(!m_timeDependent, ());
+
+  vector<Task> tasks;
+  set<pair<Segment, Segment>> taskLeaps;
+  for (auto const & leap : leaps)
+    if (m_cache.count({leap.first, leap.second, 0.0}) == 0 && taskLeaps.insert(leap).second)
+      tasks.emplace_back(leap.first, leap.second);
+
+  if (tasks.empty())
+    return;
+
+  // Starters are copied on this thread. Every thread uses its own graph and starter.
+  m_starter.GetGraph().SetMode(WorldGraphMode::JointSingleMwm);
+  size_t const threadsCount = min(tasks.size(), graphs.size() + 1);
+  deque<IndexGraphStarter> starters;
+  for (size_t i = 1; i < threadsCount; ++i)
+    starters.emplace_back(m_starter, *graphs[i - 1]);
+
+  atomic<size_t> nextTask = 0;
+  auto const calc = [&](IndexGraphStarter & starter, AStarStorage * storage)
+  {
+    auto const makeVisitor = [](IndexGraphStarterJoints<IndexGraphStarter> &) { return astar::DefaultVisitor(); };
+    for (size_t i = nextTask++; i < tasks.size(); i = nextTask++)
+    {
+      auto & task = tasks[i];
+      try
+      {
+        task.m_found = CalcRoute(starter, task.m_beg, task.m_end, GetAStarWeightZero<RouteWeight>(),
+                                 false /* timeDependent */, m_delegate.GetCancellable(), makeVisitor, storage,
+                                 task.m_result);
+      }
+      catch (...)
+      {
+        task.m_exception = current_exception();
+      }
+    }
+  };
+
+  vector<threads::SimpleThread> threads;
+  threads.reserve(starters.size());
+  for (auto & starter : starters)
+    threads.emplace_back([&calc, &starter]() { calc(starter, nullptr /* storage */); });
+  calc(m_starter, &m_storage);
+  for (auto & thread : threads)
+    thread.join();
+
+  for (auto & task : tasks)
+  {
+    if (task.m_exception)
+      rethrow_exception(task.m_exception);
+
+    if (task.m_found)
+      m_cache.emplace(LeapKey(task.m_beg, task.m_end, 0.0), std::move(task.m_result));
+  }
+
+  LOG(LDEBUG, ("Sub-routes calculated in parallel:", tasks.size(), "threads:", threadsCount));
+}
+
 IndexRouter::RoutingResultT const * IndexRouter::RoutesCalculator::Calc2Times(Segment const & beg, Segment const & end,
+                                                                              RouteWeight const & startTime,
                                                                               ProgressPtrT const & progress,
                                                                               double progressCoef)
 {
@@ -1416,11 +1918,11 @@ IndexRouter::RoutingResultT const * IndexRouter::RoutesCalculator::Calc2Times(Se
   /// Enter Tuscany motorway (43.5016115, 11.1872607) is splitted by MWM boundaries many times.
 
   m_starter.GetGraph().SetMode(WorldGraphMode::JointSingleMwm);
-  auto const * r = Calc(beg, end, progress, progressCoef);
+  auto const * r = Calc(beg, end, startTime, progress, progressCoef);
   if (r == nullptr)
   {
     m_starter.GetGraph().SetMode(WorldGraphMode::Joints);
-    r = Calc(beg, end, progress, progressCoef);
+    r = Calc(beg, end, startTime, progress, progressCoef);
   }
   return r;
 }
@@ -1470,10 +1972,36 @@ RouterResultCode IndexRouter::ProcessLeapsJoints(vector<Segment> const & input,
   size_t const variantsCount = arrBeg.size() * arrEnd.size();
   ASSERT(variantsCount > 0, ());
 
+  // Routes through the mwms don't depend on each other. The ones which are needed if every route is
+  // found in JointSingleMwm mode are calculated in parallel here, then the loop below takes them from
+  // the |calculator| cache.
+  if (auto const graphs = MakeLeapsWorldGraphs(starter); !graphs.empty())
+  {
+    vector<pair<Segment, Segment>> leaps;
+    for (size_t startLeapEnd : arrBeg)
+    {
+      for (size_t finishLeapStart : arrEnd)
+      {
+        if (startLeapEnd > finishLeapStart)
+          continue;
+
+        leaps.emplace_back(input.front(), input[startLeapEnd]);
+        for (size_t i = startLeapEnd + 1; i < finishLeapStart; i += 2)
+          leaps.emplace_back(input[i], input[i + 1]);
+        leaps.emplace_back(input[finishLeapStart], input.back());
+      }
+    }
+    calculator.CalcParallel(leaps, graphs);
+  }
+
   for (size_t startLeapEnd : arrBeg)
     for (size_t finishLeapStart : arrEnd)
     {
       size_t maxStart = 0;
+      size_t lastPrev = 0;
+      // Weight of the leaps before the current one, it's the time when the current leap starts.
+      RouteWeight currentWeight = GetAStarWeightZero<RouteWeight>();
+      RouteWeight lastWeight = currentWeight;
 
       auto const runAStarAlgorithm = [&](size_t start, size_t end, WorldGraphMode mode)
       {
@@ -1489,7 +2017,7 @@ RouterResultCode IndexRouter::ProcessLeapsJoints(vector<Segment> const & input,
         // worldGraph.ClearCachedGraphs();
         worldGraph.SetMode(mode);
 
-        return calculator.Calc(input[start], input[end], progress, contribCoef);
+        return calculator.Calc(input[start], input[end], currentWeight, progress, contribCoef);
       };
 
       vector<vector<Segment>> paths;
@@ -1525,10 +2053,6 @@ RouterResultCode IndexRouter::ProcessLeapsJoints(vector<Segment> const & input,
         return res;
       };
 
-      size_t lastPrev = 0;
-      RouteWeight currentWeight = GetAStarWeightZero<RouteWeight>();
-      RouteWeight lastWeight = currentWeight;
-
       for (size_t i = startLeapEnd; i <= finishLeapStart; ++i)
       {
         size_t prev, next;
@@ -1630,7 +2154,8 @@ RouterResultCode IndexRouter::RedressRoute(vector<Segment> const & segments, bas
 
   for (size_t i = 1; i < segments.size(); ++i)
   {
-    time += starter.CalculateETA(segments[i - 1], segments[i]);
+    time += starter.CalculateETA(segments[i - 1], segments[i],
+                                 IsTimeDependent() ? make_optional<RouteWeight const>(time) : nullopt);
     times.emplace_back(time);
   }
 
@@ -1709,6 +2234,40 @@ RouterResultCode IndexRouter::RedressRoute(vector<Segment> const & segments, bas
   return RouterResultCode::NoError;
 }
 
+void IndexRouter::RedressAlternatives(vector<vector<Segment>> const & alternativeSegments,
+                                      base::Cancellable const & cancellable, IndexGraphStarter & starter, Route & route)
+{
+  vector<shared_ptr<Route>> alternatives;
+  for (auto const & segments : alternativeSegments)
+  {
+    // Alternatives differ from |route| in the last subroute only.
+    vector<Route::SubrouteAttrs> subroutes = route.GetSubroutes();
+    auto const & last = subroutes.back();
+    subroutes.back() = Route::SubrouteAttrs(last.GetStart(), last.GetFinish(), last.GetBeginSegmentIdx(),
+                                            last.GetBeginSegmentIdx() + segments.size());
+
+    auto alternative = make_shared<Route>(route.GetRouterId(), route.GetRouteId());
+    alternative->SetCurrentSubrouteIdx(route.GetCurrentSubrouteIdx());
+    alternative->SetSubroteAttrs(std::move(subroutes));
+
+    auto const result = RedressRoute(segments, cancellable, starter, *alternative);
+    if (result == RouterResultCode::Cancelled)
+      break;
+
+    if (result != RouterResultCode::NoError)
+    {
+      LOG(LWARNING, ("Can't redress an alternative route:", result));
+      continue;
+    }
+
+    LOG(LINFO, ("Alternative route length:", alternative->GetTotalDistanceMeters(),
+                "meters. ETA:", alternative->GetTotalTimeSec(), "seconds."));
+    alternatives.push_back(std::move(alternative));
+  }
+
+  route.SetAlternatives(std::move(alternatives));
+}
+
 bool IndexRouter::AreSpeedCamerasProhibited(NumMwmId mwmID) const
 {
   if (routing::AreSpeedCamerasProhibited(m_numMwmIds->GetFile(mwmID)))
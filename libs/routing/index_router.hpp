@@ -10,6 +10,7 @@
 #include "routing/fake_edges_container.hpp"
 #include "routing/features_road_graph.hpp"
 #include "routing/guides_connections.hpp"
+#include "routing/joint_segment.hpp"
 #include "routing/nearest_edge_finder.hpp"
 #include "routing/regions_decl.hpp"
 #include "routing/router.hpp"
@@ -25,10 +26,15 @@
 #include "geometry/point2d.hpp"
 #include "geometry/tree4d.hpp"
 
+#include <ctime>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace traffic
@@ -40,6 +46,11 @@ namespace routing
 {
 class IndexGraph;
 class IndexGraphStarter;
+class RoutingLandmarks;
+class RoutingShortcuts;
+class TravelTimeMatrix;
+struct IsochroneSegment;
+class RoadGeometryCache;
 
 class IndexRouter : public IRouter
 {
@@ -80,6 +91,14 @@ public:
   void ClearState() override;
 
   void SetGuides(GuidesTracks && guides) override;
+  /// \note Alternatives are found for routes without intermediate points and guides in Joints and
+  /// NoLeaps modes only. Routing shortcuts and parallel waves are not used then.
+  void SetAlternativesParams(AlternativesParams const & params) override { m_alternativesParams = params; }
+  /// \note Car routes with departure time use ROUTING_SPEED_PROFILES_FILE_TAG sections and are found
+  /// by forward A* only, because the time when the user is at a segment is known for the forward wave.
+  /// Alternatives, routing shortcuts and parallel waves are not used then. Routes through mwms of
+  /// LeapsOnly mode start at the time of arrival to their mwms by the routes through the previous mwms.
+  void SetDepartureTime(std::optional<time_t> departureTime) override { m_departureTime = departureTime; }
   RouterResultCode CalculateRoute(Checkpoints const & checkpoints, m2::PointD const & startDirection,
                                   bool adjustToPrevRoute, RouterDelegate const & delegate, Route & route) override;
 
@@ -90,29 +109,99 @@ public:
 
   VehicleType GetVehicleType() const { return m_vehicleType; }
 
+  /// \brief Enables ALT heuristic with ROUTING_LANDMARKS_FILE_TAG section for pedestrian and bicycle
+  /// routes inside one mwm. It's off by default: such routes are searched in SingleMwm and JointSingleMwm
+  /// modes, so paths through other mwms are found only if there is no route inside the mwm at all.
+  void SetUseLandmarks(bool useLandmarks) { m_useLandmarks = useLandmarks; }
+
+  /// \brief Enables ROUTING_SHORTCUTS_FILE_TAG sections for car routes inside one mwm in Joints mode.
+  /// It's off by default: shortcuts are searched in SingleMwm mode and don't take into account
+  /// restrictions and access:conditional changes inside cells, so such routes are found only if
+  /// there is no route with shortcuts at all.
+  void SetUseShortcuts(bool useShortcuts) { m_useShortcuts = useShortcuts; }
+
+  /// \brief Makes bidirectional A* in Joints and NoLeaps modes propagate the forward and the backward
+  /// waves on different threads. The backward wave uses its own world graph, so memory for graph
+  /// caches is doubled. It's off by default.
+  void SetUseParallelWaves(bool useParallelWaves) { m_useParallelWaves = useParallelWaves; }
+
+  /// \brief Makes LeapsOnly mode load cross mwm connectors with weights of all the mwms between
+  /// the subroute checkpoints in parallel before the leaps search. It's off by default.
+  void SetCrossMwmWarmStart(bool crossMwmWarmStart) { m_crossMwmWarmStart = crossMwmWarmStart; }
+
+  /// \brief Makes LeapsOnly mode calculate the routes through the mwms of the best leaps path in
+  /// parallel threads before they are stitched together. Every thread uses its own world graph, so
+  /// memory for graph caches grows. It's off by default.
+  void SetUseParallelLeaps(bool useParallelLeaps) { m_useParallelLeaps = useParallelLeaps; }
+
+  /// \brief Makes the router load road geometry through |roadGeometryCache|, which may be shared by
+  /// routers working in different threads. The routers must have equal vehicle models for the
+  /// same vehicle type. nullptr switches it off, then every world graph keeps its own roads.
+  void SetRoadGeometryCache(std::shared_ptr<RoadGeometryCache> roadGeometryCache)
+  {
+    m_roadGeometryCache = std::move(roadGeometryCache);
+  }
+
+  /// \brief Calculates travel times in seconds from every point of |sources| to every point of
+  /// |targets| with one wave per source and one wave per target on a shared world graph, see
+  /// CalculateTravelTimeMatrix(). Pairs without route or with travel time more than |maxTimeSec|
+  /// are TravelTimeMatrix::kNoRoute in |matrix|.
+  RouterResultCode CalculateMatrix(std::vector<m2::PointD> const & sources, std::vector<m2::PointD> const & targets,
+                                   double maxTimeSec, RouterDelegate const & delegate, TravelTimeMatrix & matrix);
+
+  /// \brief Finds segments reachable from |start| within |maxTimeSec| seconds with a bounded wave
+  /// which crosses mwm borders, see CalculateIsochrone(). BuildIsochronePolygons() makes the area
+  /// of the isochrone from |segments|.
+  RouterResultCode CalculateIsochrone(m2::PointD const & start, double maxTimeSec, RouterDelegate const & delegate,
+                                      std::vector<IsochroneSegment> & segments);
+
 private:
+  // |alternatives| are filled with alternative subroutes if it's not nullptr, see FindPathWithAlternatives().
   RouterResultCode CalculateSubrouteJointsMode(IndexGraphStarter & starter, RouterDelegate const & delegate,
                                                std::shared_ptr<AStarProgress> const & progress,
-                                               std::vector<Segment> & subroute);
+                                               std::vector<Segment> & subroute,
+                                               std::vector<std::vector<Segment>> * alternatives);
   RouterResultCode CalculateSubrouteNoLeapsMode(IndexGraphStarter & starter, RouterDelegate const & delegate,
                                                 std::shared_ptr<AStarProgress> const & progress,
-                                                std::vector<Segment> & subroute);
+                                                std::vector<Segment> & subroute,
+                                                std::vector<std::vector<Segment>> * alternatives);
   RouterResultCode CalculateSubrouteLeapsOnlyMode(Checkpoints const & checkpoints, size_t subrouteIdx,
                                                   IndexGraphStarter & starter, RouterDelegate const & delegate,
                                                   std::shared_ptr<AStarProgress> const & progress,
                                                   std::vector<Segment> & subroute);
+  /// \brief Loads cross mwm connectors of the mwms crossed by the straight line from |start| to |finish|.
+  void LoadCrossMwmConnectors(m2::PointD const & start, m2::PointD const & finish, WorldGraph & graph) const;
+  RouterResultCode CalculateSubrouteShortcutsMode(RoutingShortcuts const & shortcuts, IndexGraphStarter & starter,
+                                                  RouterDelegate const & delegate,
+                                                  std::shared_ptr<AStarProgress> const & progress,
+                                                  std::vector<Segment> & subroute);
+  /// \returns shortcuts of the mwm if the subroute is long enough, lies in one mwm and
+  /// the shortcuts are applicable for the current routing settings. Otherwise returns nullptr.
+  RoutingShortcuts const * GetRoutingShortcuts(IndexGraphStarter & starter) const;
+  /// \returns landmarks of the mwm if both subroute endings lie in it. Otherwise returns nullptr.
+  /// \note Routes which leave the mwm may be slightly longer than optimal with landmarks, because
+  /// the lower bounds are calculated inside the mwm only.
+  RoutingLandmarks const * GetRoutingLandmarks(IndexGraphStarter & starter) const;
 
   RouterResultCode DoCalculateRoute(Checkpoints const & checkpoints, m2::PointD const & startDirection,
                                     RouterDelegate const & delegate, Route & route);
   RouterResultCode CalculateSubroute(Checkpoints const & checkpoints, size_t subrouteIdx,
                                      RouterDelegate const & delegate, std::shared_ptr<AStarProgress> const & progress,
                                      IndexGraphStarter & graph, std::vector<Segment> & subroute,
-                                     bool guidesActive = false);
+                                     bool guidesActive = false,
+                                     std::vector<std::vector<Segment>> * alternatives = nullptr);
 
   RouterResultCode AdjustRoute(Checkpoints const & checkpoints, m2::PointD const & startDirection,
                                RouterDelegate const & delegate, Route & route);
 
-  std::unique_ptr<WorldGraph> MakeWorldGraph();
+  std::unique_ptr<WorldGraph> MakeWorldGraph() { return MakeWorldGraph(m_dataSource); }
+  std::unique_ptr<WorldGraph> MakeWorldGraph(MwmDataSource & dataSource);
+  /// \returns a world graph for the backward wave of parallel bidirectional A* in the mode of
+  /// |starter| or nullptr if the waves should be propagated on one thread.
+  std::unique_ptr<WorldGraph> MakeBackwardWaveWorldGraph(IndexGraphStarter const & starter);
+  /// \returns world graphs for the threads which calculate routes through the mwms of leaps in
+  /// parallel with the calling thread, or no graphs if the routes should be calculated on one thread.
+  std::vector<std::unique_ptr<WorldGraph>> MakeLeapsWorldGraphs(IndexGraphStarter const & starter);
 
   using EdgeProjectionT = IRoadGraph::EdgeProjectionT;
   class PointsOnEdgesSnapping
@@ -188,22 +277,48 @@ private:
   using RoutingResultT = RoutingResult<Segment, RouteWeight>;
   class RoutesCalculator
   {
-    std::map<std::pair<Segment, Segment>, RoutingResultT> m_cache;
+  public:
+    using AStarStorage = AStarAlgorithm<JointSegment, JointEdge, RouteWeight>::Storage;
+
+  private:
+    // Routes of time-dependent weights depend on the time when they start, see IndexGraphStarter::SetStartTime().
+    // It's zero for the other routes.
+    using LeapKey = std::tuple<Segment, Segment, double>;
+
+    std::map<LeapKey, RoutingResultT> m_cache;
     IndexGraphStarter & m_starter;
     RouterDelegate const & m_delegate;
+    AStarStorage & m_storage;
+    bool m_timeDependent;
 
   public:
-    RoutesCalculator(IndexGraphStarter & starter, RouterDelegate const & delegate)
+    RoutesCalculator(IndexGraphStarter & starter, RouterDelegate const & delegate, AStarStorage & storage,
+                     bool timeDependent)
       : m_starter(starter)
       , m_delegate(delegate)
+      , m_storage(storage)
+      , m_timeDependent(timeDependent)
     {}
 
     using ProgressPtrT = std::shared_ptr<AStarProgress>;
-    RoutingResultT const * Calc(Segment const & beg, Segment const & end, ProgressPtrT const & progress,
-                                double progressCoef);
+    /// \param startTime is the time from the route start to |beg|, it's used for time-dependent weights.
+    RoutingResultT const * Calc(Segment const & beg, Segment const & end, RouteWeight const & startTime,
+                                ProgressPtrT const & progress, double progressCoef);
     // Makes JointSingleMwm first and Joints then, if first attempt was failed.
-    RoutingResultT const * Calc2Times(Segment const & beg, Segment const & end, ProgressPtrT const & progress,
-                                      double progressCoef);
+    RoutingResultT const * Calc2Times(Segment const & beg, Segment const & end, RouteWeight const & startTime,
+                                      ProgressPtrT const & progress, double progressCoef);
+    /// \brief Calculates routes in JointSingleMwm mode between the pairs of |leaps| which are not cached yet
+    /// and caches the found ones. The pairs are shared between the calling thread and a thread per graph
+    /// of |graphs|. Pairs without route are not cached, Calc2Times() tries them again.
+    /// \note It's used for routes which are not time-dependent only.
+    void CalcParallel(std::vector<std::pair<Segment, Segment>> const & leaps,
+                      std::vector<std::unique_ptr<WorldGraph>> const & graphs);
+
+  private:
+    template <typename Visitor>
+    static bool CalcRoute(IndexGraphStarter & starter, Segment const & beg, Segment const & end,
+                          RouteWeight const & startTime, bool timeDependent, base::Cancellable const & cancellable,
+                          Visitor && visitor, AStarStorage * storage, RoutingResultT & result);
   };
 
   // Input route may contains 'leaps': shortcut edges from mwm border enter to exit.
@@ -214,6 +329,9 @@ private:
 
   RouterResultCode RedressRoute(std::vector<Segment> const & segments, base::Cancellable const & cancellable,
                                 IndexGraphStarter & starter, Route & route);
+  /// \brief Sets routes of |alternativeSegments| as alternatives of |route|.
+  void RedressAlternatives(std::vector<std::vector<Segment>> const & alternativeSegments,
+                           base::Cancellable const & cancellable, IndexGraphStarter & starter, Route & route);
 
   bool AreSpeedCamerasProhibited(NumMwmId mwmID) const;
   bool AreMwmsNear(IndexGraphStarter const & starter) const;
@@ -238,13 +356,46 @@ private:
     UNREACHABLE();
   }
 
+  /// \returns true if segment weights depend on the time when the user is at a segment.
+  bool IsTimeDependent() const { return m_departureTime && m_vehicleType == VehicleType::Car; }
+
+  /// \returns memory of A* waves of IndexRouter for |Vertex|, see AStarAlgorithm::Storage.
+  template <typename Vertex, typename Edge, typename Weight>
+  typename AStarAlgorithm<Vertex, Edge, Weight>::Storage & GetAStarStorage()
+  {
+    if constexpr (std::is_same_v<Vertex, JointSegment>)
+      return m_jointsAStarStorage;
+    else
+      return m_segmentsAStarStorage;
+  }
+
   template <typename Vertex, typename Edge, typename Weight, typename AStarParams>
   RouterResultCode FindPath(AStarParams & params, std::set<NumMwmId> const & mwmIds,
                             RoutingResult<Vertex, Weight> & routingResult)
   {
-    AStarAlgorithm<Vertex, Edge, Weight> algorithm;
-    return ConvertTransitResult(
-        mwmIds, ConvertResult<Vertex, Edge, Weight>(algorithm.FindPathBidirectional(params, routingResult)));
+    AStarAlgorithm<Vertex, Edge, Weight> algorithm(GetAStarStorage<Vertex, Edge, Weight>());
+    auto const result = IsTimeDependent() ? algorithm.FindPath(params, routingResult)
+                                          : algorithm.FindPathBidirectional(params, routingResult);
+    return ConvertTransitResult(mwmIds, ConvertResult<Vertex, Edge, Weight>(result));
+  }
+
+  /// \brief Finds the best path and the alternatives of |m_alternativesParams|, the best path is the first one.
+  template <typename Vertex, typename Edge, typename Weight, typename AStarParams>
+  RouterResultCode FindPathWithAlternatives(AStarParams & params, std::set<NumMwmId> const & mwmIds,
+                                            std::vector<RoutingResult<Vertex, Weight>> & routingResults)
+  {
+    AStarAlgorithm<Vertex, Edge, Weight> algorithm(GetAStarStorage<Vertex, Edge, Weight>());
+    return ConvertTransitResult(mwmIds, ConvertResult<Vertex, Edge, Weight>(algorithm.FindPathBidirectionalAlternatives(
+                                            params, m_alternativesParams, routingResults)));
+  }
+
+  template <typename Vertex, typename Edge, typename Weight, typename AStarParams, typename BackwardAStarParams>
+  RouterResultCode FindPathParallel(AStarParams & params, BackwardAStarParams & backwardParams,
+                                    std::set<NumMwmId> const & mwmIds, RoutingResult<Vertex, Weight> & routingResult)
+  {
+    AStarAlgorithm<Vertex, Edge, Weight> algorithm(GetAStarStorage<Vertex, Edge, Weight>());
+    return ConvertTransitResult(mwmIds, ConvertResult<Vertex, Edge, Weight>(algorithm.FindPathBidirectionalParallel(
+                                            params, backwardParams, routingResult)));
   }
 
   void SetupAlgorithmMode(IndexGraphStarter & starter, bool guidesActive = false) const;
@@ -264,6 +415,10 @@ private:
   bool m_loadAltitudes;
   std::string const m_name;
   MwmDataSource m_dataSource;
+  // Handles for the backward wave thread, see SetUseParallelWaves().
+  MwmDataSource m_backwardDataSource;
+  // Handles for the threads of parallel leaps, see SetUseParallelLeaps().
+  std::vector<std::unique_ptr<MwmDataSource>> m_leapsDataSources;
   std::shared_ptr<VehicleModelFactoryInterface> m_vehicleModelFactory;
 
   TCountryFileFn const m_countryFileFn;
@@ -277,10 +432,29 @@ private:
   std::unique_ptr<DirectionsEngine> m_directionsEngine;
   std::unique_ptr<SegmentedRoute> m_lastRoute;
   std::unique_ptr<FakeEdgesContainer> m_lastFakeEdges;
+  // Backward tree of the subroute |m_lastBackwardTreeSubrouteIdx| of |m_lastRoute|. It's built by
+  // the first AdjustRoute() of the subroute around the part of the route near the user and is reused
+  // by the next ones while the user is near the steps [|m_lastBackwardTreeBeginIdx|, |m_lastBackwardTreeEndIdx|).
+  AStarAlgorithm<Segment, SegmentEdge, RouteWeight>::BackwardTree m_lastBackwardTree;
+  size_t m_lastBackwardTreeSubrouteIdx = 0;
+  size_t m_lastBackwardTreeBeginIdx = 0;
+  size_t m_lastBackwardTreeEndIdx = 0;
+  // Memory of A* waves which is reused by the searches of the router, see GetAStarStorage().
+  AStarAlgorithm<Segment, SegmentEdge, RouteWeight>::Storage m_segmentsAStarStorage;
+  RoutesCalculator::AStarStorage m_jointsAStarStorage;
 
   // If a ckeckpoint is near to the guide track we need to build route through this track.
   GuidesConnections m_guides;
 
+  bool m_useLandmarks = false;
+  bool m_useShortcuts = false;
+  bool m_useParallelWaves = false;
+  bool m_crossMwmWarmStart = false;
+  bool m_useParallelLeaps = false;
+  AlternativesParams m_alternativesParams;
+  std::optional<time_t> m_departureTime;
+  std::shared_ptr<RoadGeometryCache> m_roadGeometryCache;
+
   CountryParentNameGetterFn m_countryParentNameGetterFn;
 };
 }  // namespace routing
@@ -0,0 +1,255 @@
+#include "routing/isochrone.hpp"
+
+#include "routing/base/astar_algorithm.hpp"
+
+#include "routing/travel_time_matrix.hpp"
+#include "routing/world_graph.hpp"
+
+#include "geometry/distance_on_sphere.hpp"
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace routing
+{
+using namespace std;
+
+namespace
+{
+using Algorithm = AStarAlgorithm<Segment, SegmentEdge, RouteWeight>;
+
+uint32_t constexpr kCancelledCheckPeriod = 1024;
+
+// Cells and cell corners are kept as pairs of int32 coordinates packed to uint64.
+using GridPoint = pair<int32_t, int32_t>;
+
+uint64_t ToKey(GridPoint const & point)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(point.first)) << 32) | static_cast<uint32_t>(point.second);
+}
+
+// Directions of cell sides: right, up, left, down. The turn to the left is the next direction.
+array<GridPoint, 4> constexpr kDirections = {{{1, 0}, {0, 1}, {-1, 0}, {0, -1}}};
+// Turns to the left, straight and to the right in order of preference.
+array<size_t, 3> constexpr kTurns = {1, 0, 3};
+
+IsochroneSegment MakeStartSegment(WorldGraph & graph, Projection const & projection, bool reversed,
+                                  RouteWeight const & offroadWeight)
+{
+  auto const & back = projection.m_junction.GetLatLon();
+  auto const & front = reversed ? projection.m_segmentBack.GetLatLon() : projection.m_segmentFront.GetLatLon();
+  auto const segment = reversed ? projection.m_segment.GetReversed() : projection.m_segment;
+
+  double const length = ms::DistanceOnEarth(projection.m_segmentBack.GetLatLon(),
+                                            projection.m_segmentFront.GetLatLon());
+  double const fraction = length == 0.0 ? 0.0 : min(ms::DistanceOnEarth(back, front) / length, 1.0);
+  auto const weight = offroadWeight + fraction * graph.CalcSegmentWeight(segment, EdgeEstimator::Purpose::Weight);
+  return {segment, back, front, offroadWeight.GetWeight(), weight.GetWeight()};
+}
+}  // namespace
+
+RouterResultCode CalculateIsochrone(WorldGraph & graph, FakeEnding const & start, double maxTimeSec,
+                                    base::Cancellable const & cancellable, vector<IsochroneSegment> & segments)
+{
+  segments.clear();
+  if (start.m_projections.empty())
+    return RouterResultCode::StartPointNotFound;
+
+  RouteWeight const maxWeight(maxTimeSec);
+
+  // Segments of the start projections are reached from the projections, not from their backs.
+  unordered_map<Segment, IsochroneSegment> startSegments;
+  MatrixWaveGraph::EdgeListT startEdges;
+  for (auto const & projection : start.m_projections)
+  {
+    auto const offroadWeight = graph.CalcOffroadWeight(start.m_originJunction.GetLatLon(),
+                                                       projection.m_junction.GetLatLon(), EdgeEstimator::Purpose::Weight);
+    for (bool const reversed : {false, true})
+    {
+      if (reversed && projection.m_isOneWay)
+        continue;
+
+      auto const startSegment = MakeStartSegment(graph, projection, reversed, offroadWeight);
+      startEdges.emplace_back(startSegment.m_segment, RouteWeight(startSegment.m_timeToFrontSec));
+      startSegments.emplace(startSegment.m_segment, startSegment);
+    }
+  }
+
+  MatrixWaveGraph waveGraph(graph, true /* forward */);
+  waveGraph.SetEndingEdges(std::move(startEdges));
+  Algorithm::Context context(waveGraph);
+
+  auto const makeSegment = [&](Segment const & segment, RouteWeight const & distance)
+  {
+    // A start segment may be reached around from its back sooner than from the projection.
+    auto const it = startSegments.find(segment);
+    if (it != startSegments.cend() && it->second.m_timeToFrontSec <= distance.GetWeight())
+      return it->second;
+
+    double const weight = graph.CalcSegmentWeight(segment, EdgeEstimator::Purpose::Weight).GetWeight();
+    return IsochroneSegment{segment, graph.GetPoint(segment, false /* front */), graph.GetPoint(segment, true /* front */),
+                            max(0.0, distance.GetWeight() - weight), distance.GetWeight()};
+  };
+
+  uint32_t visitedCount = 0;
+  bool cancelled = false;
+  auto const visitVertex = [&](Segment const & vertex)
+  {
+    if (++visitedCount % kCancelledCheckPeriod == 0 && cancellable.IsCancelled())
+    {
+      cancelled = true;
+      return false;
+    }
+
+    if (vertex != MatrixWaveGraph::kEndingVertex)
+      segments.push_back(makeSegment(vertex, context.GetDistance(vertex)));
+    return true;
+  };
+
+  // Segments which are entered before the time limit but are not passed completely.
+  unordered_map<Segment, RouteWeight> borderSegments;
+  auto const filterStates = [&](auto const & state)
+  {
+    if (state.distance <= maxWeight)
+      return true;
+
+    auto const [it, inserted] = borderSegments.emplace(state.vertex, state.distance);
+    if (!inserted && state.distance < it->second)
+      it->second = state.distance;
+    return false;
+  };
+
+  Algorithm().PropagateWave(
+      waveGraph, MatrixWaveGraph::kEndingVertex, visitVertex,
+      [](Segment const & /* vertex */, SegmentEdge const & edge) { return edge.GetWeight(); }, filterStates,
+      [](auto const & state) { return state.distance; }, context);
+
+  if (cancelled)
+    return RouterResultCode::Cancelled;
+
+  size_t const reachedCount = segments.size();
+  for (auto const & [segment, distance] : borderSegments)
+  {
+    if (context.HasDistance(segment))
+      continue;
+
+    auto borderSegment = makeSegment(segment, distance);
+    if (borderSegment.m_timeToBackSec < maxTimeSec)
+      segments.push_back(borderSegment);
+  }
+  sort(segments.begin() + reachedCount, segments.end(),
+       [](IsochroneSegment const & lhs, IsochroneSegment const & rhs)
+       { return lhs.m_timeToFrontSec < rhs.m_timeToFrontSec; });
+
+  LOG(LDEBUG, ("Isochrone of", maxTimeSec, "seconds, reached segments:", reachedCount,
+               "border segments:", segments.size() - reachedCount));
+  return RouterResultCode::NoError;
+}
+
+vector<IsochronePolygon> BuildIsochronePolygons(vector<IsochroneSegment> const & segments, double maxTimeSec,
+                                                double cellSizeM)
+{
+  vector<IsochronePolygon> polygons;
+  if (segments.empty())
+    return polygons;
+
+  // Cells are squares in meters near the start, so they are squares in mercator too.
+  double const cellSize =
+      mercator::RectByCenterXYAndSizeInMeters(mercator::FromLatLon(segments.front().m_back), cellSizeM).SizeX();
+  auto const toCell = [cellSize](m2::PointD const & point)
+  {
+    return GridPoint(static_cast<int32_t>(floor(point.x / cellSize)), static_cast<int32_t>(floor(point.y / cellSize)));
+  };
+
+  unordered_set<uint64_t> cells;
+  vector<GridPoint> cellsList;
+  auto const addCell = [&](m2::PointD const & point)
+  {
+    auto const cell = toCell(point);
+    if (cells.insert(ToKey(cell)).second)
+      cellsList.push_back(cell);
+  };
+
+  for (auto const & segment : segments)
+  {
+    if (segment.m_timeToBackSec > maxTimeSec)
+      continue;
+
+    double fraction = 1.0;
+    if (segment.m_timeToFrontSec > maxTimeSec)
+      fraction = (maxTimeSec - segment.m_timeToBackSec) / (segment.m_timeToFrontSec - segment.m_timeToBackSec);
+
+    auto const back = mercator::FromLatLon(segment.m_back);
+    auto const end = back + (mercator::FromLatLon(segment.m_front) - back) * fraction;
+    auto const stepsCount = static_cast<size_t>(ceil(back.Length(end) / (cellSize / 2.0)));
+    for (size_t i = 0; i <= stepsCount; ++i)
+      addCell(stepsCount == 0 ? back : back + (end - back) * (static_cast<double>(i) / stepsCount));
+  }
+
+  // Sides of the cells with empty neighbours are directed so that the cell is on the left.
+  auto const isCell = [&cells](int32_t x, int32_t y) { return cells.count(ToKey({x, y})) != 0; };
+  map<GridPoint, array<bool, 4>> sides;
+  auto const addSide = [&sides](int32_t x, int32_t y, size_t direction) { sides[{x, y}][direction] = true; };
+  for (auto const & [x, y] : cellsList)
+  {
+    if (!isCell(x, y - 1))
+      addSide(x, y, 0 /* right */);
+    if (!isCell(x + 1, y))
+      addSide(x + 1, y, 1 /* up */);
+    if (!isCell(x, y + 1))
+      addSide(x + 1, y + 1, 2 /* left */);
+    if (!isCell(x - 1, y))
+      addSide(x, y + 1, 3 /* down */);
+  }
+
+  // Rings are traced turning to the left first, so cells touching by a corner get separate rings.
+  for (auto & [first, firstDirections] : sides)
+  {
+    for (size_t firstDirection = 0; firstDirection < firstDirections.size(); ++firstDirection)
+    {
+      if (!firstDirections[firstDirection])
+        continue;
+
+      IsochronePolygon polygon;
+      GridPoint point = first;
+      size_t direction = firstDirection;
+      // The first corner is added in any case and removed later if the ring is straight there.
+      size_t prevDirection = (firstDirection + 2) % 4;
+      while (true)
+      {
+        sides[point][direction] = false;
+        if (direction != prevDirection)
+          polygon.emplace_back(point.first * cellSize, point.second * cellSize);
+
+        prevDirection = direction;
+        point.first += kDirections[direction].first;
+        point.second += kDirections[direction].second;
+        if (point == first)
+          break;
+
+        auto const it = sides.find(point);
+        CHECK(it != sides.cend(), (point));
+        auto const turnIt = find_if(kTurns.cbegin(), kTurns.cend(),
+                                    [&](size_t turn) { return it->second[(prevDirection + turn) % 4]; });
+        CHECK(turnIt != kTurns.cend(), (point));
+        direction = (prevDirection + *turnIt) % 4;
+      }
+
+      if (prevDirection == firstDirection)
+        polygon.erase(polygon.begin());
+      polygons.push_back(std::move(polygon));
+    }
+  }
+  return polygons;
+}
+}  // namespace routing
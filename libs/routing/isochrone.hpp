@@ -0,0 +1,43 @@
+#pragma once
+
+#include "routing/fake_ending.hpp"
+#include "routing/routing_callbacks.hpp"
+#include "routing/segment.hpp"
+
+#include "geometry/latlon.hpp"
+#include "geometry/point2d.hpp"
+
+#include "base/cancellable.hpp"
+
+#include <vector>
+
+namespace routing
+{
+class WorldGraph;
+
+/// \brief Segment reached by an isochrone wave. Times are route weights from the start to the
+/// segment ends. A segment on the isochrone border is reached partly: |m_timeToFrontSec| is greater
+/// than the time limit for it. For the segments of the start projections |m_back| is the projection.
+struct IsochroneSegment
+{
+  Segment m_segment;
+  ms::LatLon m_back;
+  ms::LatLon m_front;
+  double m_timeToBackSec = 0.0;
+  double m_timeToFrontSec = 0.0;
+};
+
+using IsochronePolygon = std::vector<m2::PointD>;
+
+/// \brief Finds all the segments reachable from |start| within |maxTimeSec| with a bounded
+/// Dijkstra wave. The wave crosses mwm borders if |graph| is in WorldGraphMode::NoLeaps.
+/// \note |segments| are in order of their front times.
+RouterResultCode CalculateIsochrone(WorldGraph & graph, FakeEnding const & start, double maxTimeSec,
+                                    base::Cancellable const & cancellable, std::vector<IsochroneSegment> & segments);
+
+/// \brief Builds polygons in mercator of the area covered by the reached parts of |segments|.
+/// The area is a union of square cells of |cellSizeM| meters which contain reached road points.
+/// \returns outer rings in counterclockwise order and holes in clockwise order.
+std::vector<IsochronePolygon> BuildIsochronePolygons(std::vector<IsochroneSegment> const & segments,
+                                                     double maxTimeSec, double cellSizeM);
+}  // namespace routing
@@ -0,0 +1,125 @@
+#include "routing/road_geometry_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <sstream>
+#include <utility>
+
+namespace routing
+{
+using namespace std;
+
+namespace
+{
+// Approximate overhead of a hash map node and a fifo item per road.
+size_t constexpr kItemOverheadSize = 64;
+
+size_t GetMemorySize(RoadGeometry const & road)
+{
+  // Every point keeps a junction and a distance to the next point.
+  return sizeof(RoadGeometry) + kItemOverheadSize +
+         road.GetPointsCount() * (sizeof(LatLonWithAltitude) + sizeof(double));
+}
+}  // namespace
+
+// RoadGeometryCache::Stats -------------------------------------------------------------------------
+double RoadGeometryCache::Stats::GetHitRate() const
+{
+  uint64_t const requests = m_hits + m_misses;
+  return requests == 0 ? 0.0 : static_cast<double>(m_hits) / requests;
+}
+
+// RoadGeometryCache --------------------------------------------------------------------------------
+RoadGeometryCache::RoadGeometryCache(size_t maxMemorySize, size_t shardsCount)
+  : m_maxShardMemorySize(maxMemorySize / shardsCount)
+{
+  CHECK_GREATER(shardsCount, 0, ());
+
+  m_shards.reserve(shardsCount);
+  for (size_t i = 0; i < shardsCount; ++i)
+    m_shards.push_back(make_unique<Shard>());
+}
+
+uint32_t RoadGeometryCache::GetSourceId(string const & sourceName)
+{
+  lock_guard<mutex> lock(m_sourcesMutex);
+  auto const it = m_sourceIds.emplace(sourceName, static_cast<uint32_t>(m_sourceIds.size())).first;
+  return it->second;
+}
+
+RoadGeometryCache::RoadPtrT RoadGeometryCache::GetRoad(uint32_t sourceId, uint32_t featureId, GeometryLoader & loader)
+{
+  uint64_t const key = (static_cast<uint64_t>(sourceId) << 32) | featureId;
+  Shard & shard = GetShard(key);
+
+  {
+    shared_lock<shared_mutex> lock(shard.m_mutex);
+    auto const it = shard.m_roads.find(key);
+    if (it != shard.m_roads.cend())
+    {
+      shard.m_hits.fetch_add(1, memory_order_relaxed);
+      return it->second;
+    }
+  }
+
+  shard.m_misses.fetch_add(1, memory_order_relaxed);
+
+  // The road is loaded without the lock. If another thread loads it at the same time
+  // the first loaded road is kept.
+  auto road = make_shared<RoadGeometry>();
+  loader.Load(featureId, *road);
+  road->CalcDistances();
+  size_t const memorySize = GetMemorySize(*road);
+
+  unique_lock<shared_mutex> lock(shard.m_mutex);
+  auto const [it, inserted] = shard.m_roads.emplace(key, std::move(road));
+  if (!inserted)
+    return it->second;
+
+  shard.m_fifo.push_back(key);
+  shard.m_memorySize += memorySize;
+  while (shard.m_memorySize > m_maxShardMemorySize && shard.m_fifo.size() > 1)
+  {
+    auto const evictedIt = shard.m_roads.find(shard.m_fifo.front());
+    CHECK(evictedIt != shard.m_roads.cend(), ());
+    shard.m_memorySize -= GetMemorySize(*evictedIt->second);
+    shard.m_roads.erase(evictedIt);
+    shard.m_fifo.pop_front();
+    shard.m_evictions.fetch_add(1, memory_order_relaxed);
+  }
+
+  return it->second;
+}
+
+RoadGeometryCache::Stats RoadGeometryCache::GetStats() const
+{
+  Stats stats;
+  for (auto const & shard : m_shards)
+  {
+    stats.m_hits += shard->m_hits.load(memory_order_relaxed);
+    stats.m_misses += shard->m_misses.load(memory_order_relaxed);
+    stats.m_evictions += shard->m_evictions.load(memory_order_relaxed);
+
+    shared_lock<shared_mutex> lock(shard->m_mutex);
+    stats.m_roadsCount += shard->m_roads.size();
+    stats.m_memorySize += shard->m_memorySize;
+  }
+  return stats;
+}
+
+RoadGeometryCache::Shard & RoadGeometryCache::GetShard(uint64_t key)
+{
+  // Fibonacci hashing spreads consecutive feature ids over shards.
+  uint64_t const hash = key * 0x9E3779B97F4A7C15ULL;
+  return *m_shards[(hash >> 32) % m_shards.size()];
+}
+
+string DebugPrint(RoadGeometryCache::Stats const & stats)
+{
+  ostringstream out;
+  out << "RoadGeometryCache::Stats [ hits: " << stats.m_hits << ", misses: " << stats.m_misses
+      << ", hit rate: " << stats.GetHitRate() << ", evictions: " << stats.m_evictions
+      << ", roads: " << stats.m_roadsCount << ", memory size: " << stats.m_memorySize << " ]";
+  return out.str();
+}
+}  // namespace routing
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "routing/geometry.hpp"
+
+#include "base/macros.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace routing
+{
+/// \brief Process-wide cache of road geometry shared by Geometry instances of several routers,
+/// which may work in different threads. The cache is split into shards by feature, every shard has
+/// its own shared mutex, so lookups of different threads don't wait for each other. Memory used by
+/// roads of a shard is bounded by |maxMemorySize| / |shardsCount|, the roads which were loaded
+/// first are evicted first.
+/// \note Evicted roads stay alive while a Geometry keeps them, so the bound is approximate.
+/// \note Roads are kept by source ids, see GetSourceId(). Geometry instances with the same source
+/// must load equal roads, i.e. read the same mwm with the same vehicle model.
+class RoadGeometryCache final
+{
+public:
+  static size_t constexpr kDefaultMaxMemorySize = 512 * 1024 * 1024;
+  static size_t constexpr kDefaultShardsCount = 64;
+
+  using RoadPtrT = std::shared_ptr<RoadGeometry const>;
+
+  struct Stats
+  {
+    double GetHitRate() const;
+
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+    size_t m_roadsCount = 0;
+    size_t m_memorySize = 0;
+  };
+
+  explicit RoadGeometryCache(size_t maxMemorySize = kDefaultMaxMemorySize, size_t shardsCount = kDefaultShardsCount);
+  DISALLOW_COPY_AND_MOVE(RoadGeometryCache);
+
+  /// \returns id of roads loaded by the source named |sourceName|. The same name gets the same id.
+  uint32_t GetSourceId(std::string const & sourceName);
+
+  /// \brief Returns the road of |featureId| of |sourceId|. If it's not cached it's loaded
+  /// with |loader| in the calling thread.
+  RoadPtrT GetRoad(uint32_t sourceId, uint32_t featureId, GeometryLoader & loader);
+
+  Stats GetStats() const;
+
+private:
+  struct alignas(64) Shard
+  {
+    mutable std::shared_mutex m_mutex;
+    std::unordered_map<uint64_t, RoadPtrT> m_roads;
+    // Keys in order of loading.
+    std::deque<uint64_t> m_fifo;
+    size_t m_memorySize = 0;
+
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+    std::atomic<uint64_t> m_evictions{0};
+  };
+
+  Shard & GetShard(uint64_t key);
+
+  size_t const m_maxShardMemorySize;
+  std::vector<std::unique_ptr<Shard>> m_shards;
+
+  std::mutex m_sourcesMutex;
+  std::unordered_map<std::string, uint32_t> m_sourceIds;
+};
+
+std::string DebugPrint(RoadGeometryCache::Stats const & stats);
+}  // namespace routing
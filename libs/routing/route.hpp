@@ -449,6 +449,7 @@ public:
 
   void GetTurnsForTesting(std::vector<turns::TurnItem> & turns) const;
   bool IsRouteId(uint64_t routeId) const { return routeId == m_routeId; }
+  uint64_t GetRouteId() const { return m_routeId; }
 
   /// \returns Length of the route segment with |segIdx| in meters.
   double GetSegLenMeters(size_t segIdx) const;
@@ -463,6 +464,14 @@ public:
   /// about speed cameras.
   std::vector<platform::CountryFile> const & GetMwmsPartlyProhibitedForSpeedCams() const;
 
+  /// \brief Sets alternative routes between the same checkpoints which are found together with the route,
+  /// see IRouter::SetAlternativesParams(). The alternatives are sorted by weight.
+  void SetAlternatives(std::vector<std::shared_ptr<Route>> && alternatives)
+  {
+    m_alternatives = std::move(alternatives);
+  }
+  std::vector<std::shared_ptr<Route>> const & GetAlternatives() const { return m_alternatives; }
+
   std::string DebugPrintTurns() const;
 
 private:
@@ -494,6 +503,8 @@ private:
 
   // Mwms which are crossed by the route where speed cameras are prohibited.
   std::vector<platform::CountryFile> m_speedCamPartlyProhibitedMwms;
+
+  std::vector<std::shared_ptr<Route>> m_alternatives;
 };
 
 /// \returns true if |turn| is not equal to turns::CarDirection::None or
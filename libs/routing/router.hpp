@@ -1,5 +1,6 @@
 #pragma once
 
+#include "routing/base/alternatives_params.hpp"
 #include "routing/checkpoints.hpp"
 #include "routing/road_graph.hpp"
 #include "routing/router_delegate.hpp"
@@ -12,8 +13,10 @@
 
 #include "base/cancellable.hpp"
 
+#include <ctime>
 #include <functional>
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -63,6 +66,14 @@ public:
 
   virtual void SetGuides(GuidesTracks && guides) = 0;
 
+  /// \brief Sets parameters of alternative routes which are found by next CalculateRoute() calls
+  /// together with the route, see Route::GetAlternatives(). Routers which can't find alternatives ignore it.
+  virtual void SetAlternativesParams(AlternativesParams const & /* params */) {}
+
+  /// \brief Sets departure time in seconds since epoch for next CalculateRoute() calls. Routers which
+  /// support time-dependent weights use it, std::nullopt means departure right now with static weights.
+  virtual void SetDepartureTime(std::optional<time_t> /* departureTime */) {}
+
   /// Override this function with routing implementation.
   /// It will be called in separate thread and only one function will processed in same time.
   /// @warning please support Cancellable interface calls. You must stop processing when it is true.
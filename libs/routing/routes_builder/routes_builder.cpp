@@ -129,20 +129,58 @@ RoutesBuilder::RoutesBuilder(size_t threadsNumber) : m_threadPool(threadsNumber)
 
   for (auto & dataSource : dataSources)
     m_dataSourcesStorage.PushDataSource(std::move(dataSource));
+
+  m_numMwmTree = MakeNumMwmTree(*m_numMwmIds, *m_cig);
+}
+
+std::unique_ptr<RoutesBuilder::Processor> RoutesBuilder::TakeProcessor()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_processorsMutex);
+    if (!m_freeProcessors.empty())
+    {
+      auto processor = std::move(m_freeProcessors.back());
+      m_freeProcessors.pop_back();
+      return processor;
+    }
+  }
+
+  return std::make_unique<Processor>(m_numMwmIds, m_numMwmTree, m_dataSourcesStorage, m_cpg, m_cig,
+                                     m_roadGeometryCache);
+}
+
+void RoutesBuilder::ReturnProcessor(std::unique_ptr<Processor> && processor)
+{
+  std::lock_guard<std::mutex> lock(m_processorsMutex);
+  m_freeProcessors.push_back(std::move(processor));
+}
+
+template <typename Task>
+auto RoutesBuilder::ProcessWithFreeProcessor(Task const & task)
+{
+  auto processor = TakeProcessor();
+  SCOPE_GUARD(returnProcessor, [&]() { ReturnProcessor(std::move(processor)); });
+  return (*processor)(task);
 }
 
 RoutesBuilder::Result RoutesBuilder::ProcessTask(Params const & params)
 {
-  Processor processor(m_numMwmIds, m_dataSourcesStorage, m_cpg, m_cig);
-  return processor(params);
+  return ProcessWithFreeProcessor(params);
+}
+
+RoutesBuilder::MatrixResult RoutesBuilder::ProcessMatrixTask(MatrixParams const & params)
+{
+  return ProcessWithFreeProcessor(params);
 }
 
 std::future<RoutesBuilder::Result> RoutesBuilder::ProcessTaskAsync(Params const & params)
 {
-  // Should be copyable to workaround MSVC bug (https://developercommunity.visualstudio.com/t/108672)
-  auto task = [processor = std::make_shared<Processor>(m_numMwmIds, m_dataSourcesStorage, m_cpg, m_cig)](
-                  Params const & params) -> Result { return (*processor)(params); };
-  return m_threadPool.Submit(std::move(task), params);
+  return m_threadPool.Submit([this](Params const & params) { return ProcessTask(params); }, params);
+}
+
+std::future<RoutesBuilder::MatrixResult> RoutesBuilder::ProcessMatrixTaskAsync(MatrixParams const & params)
+{
+  return m_threadPool.Submit([this](MatrixParams const & params) { return ProcessMatrixTask(params); }, params);
 }
 
 // RoutesBuilder::Result ---------------------------------------------------------------------------
@@ -228,32 +266,35 @@ std::vector<ms::LatLon> RoutesBuilder::Route::GetWaypoints() const
 
 // RoutesBuilder::Processor ------------------------------------------------------------------------
 
-RoutesBuilder::Processor::Processor(std::shared_ptr<NumMwmIds> numMwmIds, DataSourceStorage & dataSourceStorage,
+RoutesBuilder::Processor::Processor(std::shared_ptr<NumMwmIds> numMwmIds,
+                                    std::shared_ptr<m4::Tree<NumMwmId> const> numMwmTree,
+                                    DataSourceStorage & dataSourceStorage,
                                     std::weak_ptr<storage::CountryParentGetter> cpg,
-                                    std::weak_ptr<storage::CountryInfoGetter> cig)
+                                    std::weak_ptr<storage::CountryInfoGetter> cig,
+                                    std::shared_ptr<RoadGeometryCache> roadGeometryCache)
   : m_numMwmIds(std::move(numMwmIds))
+  , m_numMwmTree(std::move(numMwmTree))
   , m_dataSourceStorage(dataSourceStorage)
   , m_cpg(std::move(cpg))
   , m_cig(std::move(cig))
+  , m_roadGeometryCache(std::move(roadGeometryCache))
 {}
 
-RoutesBuilder::Processor::Processor(Processor && rhs) noexcept : m_dataSourceStorage(rhs.m_dataSourceStorage)
+RoutesBuilder::Processor::~Processor()
 {
-  m_start = rhs.m_start;
-  m_finish = rhs.m_finish;
-
-  m_router = std::move(rhs.m_router);
-  m_delegate = std::move(rhs.m_delegate);
-  m_numMwmIds = std::move(rhs.m_numMwmIds);
-  m_trafficCache = std::move(rhs.m_trafficCache);
-  m_cpg = std::move(rhs.m_cpg);
-  m_cig = std::move(rhs.m_cig);
-  m_dataSource = std::move(rhs.m_dataSource);
+  // Routers use the data source, so they are destroyed before it's returned.
+  for (auto & router : m_routers)
+    router.reset();
+
+  if (m_dataSource)
+    m_dataSourceStorage.PushDataSource(std::move(m_dataSource));
 }
 
 void RoutesBuilder::Processor::InitRouter(VehicleType type)
 {
-  if (m_router && m_router->GetVehicleType() == type)
+  auto & router = m_routers[static_cast<size_t>(type)];
+  m_router = router.get();
+  if (m_router)
     return;
 
   auto const & cig = m_cig;
@@ -273,23 +314,24 @@ void RoutesBuilder::Processor::InitRouter(VehicleType type)
   if (!m_dataSource)
     m_dataSource = m_dataSourceStorage.GetDataSource();
 
-  m_router = std::make_unique<IndexRouter>(type, loadAltitudes, *m_cpg.lock(), countryFileGetter, getMwmRectByName,
-                                           m_numMwmIds, MakeNumMwmTree(*m_numMwmIds, *m_cig.lock()), *m_trafficCache,
-                                           *m_dataSource);
+  CHECK(m_dataSource, ());
+
+  router = std::make_unique<IndexRouter>(type, loadAltitudes, *m_cpg.lock(), countryFileGetter, getMwmRectByName,
+                                         m_numMwmIds, std::make_unique<m4::Tree<NumMwmId>>(*m_numMwmTree),
+                                         *m_trafficCache, *m_dataSource);
+  router->SetRoadGeometryCache(m_roadGeometryCache);
+  m_router = router.get();
 }
 
 RoutesBuilder::Result RoutesBuilder::Processor::operator()(Params const & params)
 {
   InitRouter(params.m_type);
-  SCOPE_GUARD(returnDataSource, [&]() { m_dataSourceStorage.PushDataSource(std::move(m_dataSource)); });
 
   LOG(LINFO, ("Start building route, checkpoints:", params.m_checkpoints));
 
   RouterResultCode resultCode = RouterResultCode::RouteNotFound;
   routing::Route route("" /* router */, 0 /* routeId */);
 
-  CHECK(m_dataSource, ());
-
   double timeSum = 0.0;
   for (size_t i = 0; i < params.m_launchesNumber; ++i)
   {
@@ -319,5 +361,30 @@ RoutesBuilder::Result RoutesBuilder::Processor::operator()(Params const & params
 
   return result;
 }
+
+RoutesBuilder::MatrixResult RoutesBuilder::Processor::operator()(MatrixParams const & params)
+{
+  InitRouter(params.m_type);
+
+  LOG(LINFO, ("Start building matrix, sources:", params.m_sources.size(), "targets:", params.m_targets.size()));
+
+  MatrixResult result;
+  double timeSum = 0.0;
+  for (size_t i = 0; i < params.m_launchesNumber; ++i)
+  {
+    m_delegate->SetTimeout(params.m_timeoutSeconds);
+    base::Timer timer;
+    result.m_code = m_router->CalculateMatrix(params.m_sources, params.m_targets, params.m_maxTimeSeconds,
+                                              *m_delegate, result.m_matrix);
+
+    if (result.m_code != RouterResultCode::NoError)
+      break;
+
+    timeSum += timer.ElapsedSeconds();
+  }
+
+  result.m_buildTimeSeconds = timeSum / static_cast<double>(params.m_launchesNumber);
+  return result;
+}
 }  // namespace routes_builder
 }  // namespace routing
@@ -4,9 +4,11 @@
 
 #include "routing/checkpoints.hpp"
 #include "routing/index_router.hpp"
+#include "routing/road_geometry_cache.hpp"
 #include "routing/router_delegate.hpp"
 #include "routing/routing_callbacks.hpp"
 #include "routing/segment.hpp"
+#include "routing/travel_time_matrix.hpp"
 #include "routing/vehicle_mask.hpp"
 
 #include "traffic/traffic_cache.hpp"
@@ -25,14 +27,18 @@
 #include "coding/reader.hpp"
 
 #include "geometry/latlon.hpp"
+#include "geometry/tree4d.hpp"
 
 #include "base/macros.hpp"
 #include "base/thread_pool_computational.hpp"
 
+#include <array>
 #include <cstddef>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace routing
@@ -41,6 +47,10 @@ namespace routes_builder
 {
 // TODO (@gmoryes)
 //  Reuse this class for routing_integration_tests
+/// \brief Builds routes and matrices with routers which are kept warm between tasks: every router
+/// keeps its data source, opened mwms and caches, so a long-lived RoutesBuilder doesn't pay
+/// for initialization per task. ProcessTask() and ProcessMatrixTask() may be called from several
+/// threads at the same time, but not more than |threadsNumber| tasks may be processed at once.
 class RoutesBuilder
 {
 public:
@@ -95,19 +105,57 @@ public:
     double m_buildTimeSeconds = 0.0;
   };
 
+  struct MatrixParams
+  {
+    VehicleType m_type = VehicleType::Car;
+    std::vector<m2::PointD> m_sources;
+    std::vector<m2::PointD> m_targets;
+    double m_maxTimeSeconds = 0.0;
+    uint32_t m_timeoutSeconds = RouterDelegate::kNoTimeout;
+    uint32_t m_launchesNumber = 1;
+  };
+
+  struct MatrixResult
+  {
+    bool IsCodeOK() const { return m_code == RouterResultCode::NoError; }
+
+    RouterResultCode m_code = RouterResultCode::RouteNotFound;
+    TravelTimeMatrix m_matrix;
+    double m_buildTimeSeconds = 0.0;
+  };
+
   Result ProcessTask(Params const & params);
   std::future<Result> ProcessTaskAsync(Params const & params);
 
+  MatrixResult ProcessMatrixTask(MatrixParams const & params);
+  std::future<MatrixResult> ProcessMatrixTaskAsync(MatrixParams const & params);
+
+  /// \brief Runs |task| on the threads of the builder, so a task which calls ProcessTask() or
+  /// ProcessMatrixTask() doesn't need a thread of its own.
+  template <typename Task>
+  void SubmitWork(Task && task)
+  {
+    m_threadPool.SubmitWork(std::forward<Task>(task));
+  }
+
+  /// \brief Waits for all the submitted tasks. No tasks may be submitted after it.
+  void WaitingStop() { m_threadPool.WaitingStop(); }
+
+  /// \brief Counters of the road geometry cache shared by routers of all the threads.
+  RoadGeometryCache::Stats GetRoadGeometryCacheStats() const { return m_roadGeometryCache->GetStats(); }
+
 private:
   class Processor
   {
   public:
-    Processor(std::shared_ptr<NumMwmIds> numMwmIds, DataSourceStorage & dataSourceStorage,
-              std::weak_ptr<storage::CountryParentGetter> cpg, std::weak_ptr<storage::CountryInfoGetter> cig);
-
-    Processor(Processor && rhs) noexcept;
+    Processor(std::shared_ptr<NumMwmIds> numMwmIds, std::shared_ptr<m4::Tree<NumMwmId> const> numMwmTree,
+              DataSourceStorage & dataSourceStorage, std::weak_ptr<storage::CountryParentGetter> cpg,
+              std::weak_ptr<storage::CountryInfoGetter> cig, std::shared_ptr<RoadGeometryCache> roadGeometryCache);
+    DISALLOW_COPY_AND_MOVE(Processor);
+    ~Processor();
 
     Result operator()(Params const & params);
+    MatrixResult operator()(MatrixParams const & params);
 
   private:
     void InitRouter(VehicleType type);
@@ -115,18 +163,28 @@ private:
     ms::LatLon m_start;
     ms::LatLon m_finish;
 
-    std::unique_ptr<IndexRouter> m_router;
+    // Routers are made on demand and kept for every vehicle type, |m_router| is the current one.
+    std::array<std::unique_ptr<IndexRouter>, static_cast<size_t>(VehicleType::Count)> m_routers;
+    IndexRouter * m_router = nullptr;
     std::shared_ptr<RouterDelegate> m_delegate = std::make_shared<RouterDelegate>();
 
     std::shared_ptr<NumMwmIds> m_numMwmIds;
+    std::shared_ptr<m4::Tree<NumMwmId> const> m_numMwmTree;
     std::shared_ptr<traffic::TrafficCache> m_trafficCache = std::make_shared<traffic::TrafficCache>();
     DataSourceStorage & m_dataSourceStorage;
     std::weak_ptr<storage::CountryParentGetter> m_cpg;
     std::weak_ptr<storage::CountryInfoGetter> m_cig;
+    // Taken from |m_dataSourceStorage| on the first task and returned by the destructor.
     std::unique_ptr<FrozenDataSource> m_dataSource;
+    std::shared_ptr<RoadGeometryCache> m_roadGeometryCache;
   };
 
-  base::ComputationalThreadPool m_threadPool;
+  /// \brief Takes a free processor or makes a new one if all the processors are busy.
+  std::unique_ptr<Processor> TakeProcessor();
+  void ReturnProcessor(std::unique_ptr<Processor> && processor);
+
+  template <typename Task>
+  auto ProcessWithFreeProcessor(Task const & task);
 
   std::shared_ptr<storage::CountryParentGetter> m_cpg = std::make_shared<storage::CountryParentGetter>();
 
@@ -134,8 +192,17 @@ private:
       storage::CountryInfoReader::CreateCountryInfoGetter(GetPlatform());
 
   std::shared_ptr<NumMwmIds> m_numMwmIds = std::make_shared<NumMwmIds>();
+  std::shared_ptr<m4::Tree<NumMwmId> const> m_numMwmTree;
 
   DataSourceStorage m_dataSourcesStorage;
+  std::shared_ptr<RoadGeometryCache> m_roadGeometryCache = std::make_shared<RoadGeometryCache>();
+
+  // Processors return their data sources to |m_dataSourcesStorage|, so they are declared after it.
+  std::mutex m_processorsMutex;
+  std::vector<std::unique_ptr<Processor>> m_freeProcessors;
+
+  // Tasks use all the members above, so the pool is destroyed first.
+  base::ComputationalThreadPool m_threadPool;
 };
 }  // namespace routes_builder
 }  // namespace routing
@@ -8,6 +8,7 @@
 #include "base/logging.hpp"
 
 #include <exception>
+#include <iostream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -22,6 +23,16 @@ DEFINE_string(routes_file, "",
               "second_start_lat second_start_lon second_finish_lat second_finish_lon\n\t"
               "...");
 
+DEFINE_string(matrix_sources_file, "",
+              "Path to file with sources of travel time matrix in format: \n\t"
+              "first_lat first_lon\n\t"
+              "second_lat second_lon\n\t"
+              "...");
+DEFINE_string(matrix_targets_file, "", "Path to file with targets of travel time matrix, see --matrix_sources_file.");
+DEFINE_double(matrix_max_time, 2 * 60 * 60,
+              "Max travel time in seconds in the matrix. Pairs with greater time are dumped as no route "
+              "(default: 2 hours).");
+
 DEFINE_string(dump_path, "",
               "Path where routes will be dumped after building."
               "Useful for intermediate results, because routes building "
@@ -44,6 +55,15 @@ DEFINE_bool(verbose, false, "Verbose logging (default: false)");
 DEFINE_int32(launches_number, 1, "Number of launches of routes buildings. Needs for benchmarking (default: 1)");
 DEFINE_string(vehicle_type, "car", "Vehicle type: car|pedestrian|bicycle|transit. (Only for mapsme).");
 
+DEFINE_bool(server, false,
+            "Server mode. Maps are loaded once and requests are read from stdin, one json per line:\n\t"
+            "{\"id\": 1, \"type\": \"route\", \"vehicle\": \"car\", \"points\": [[lat, lon], [lat, lon]]}\n\t"
+            "{\"id\": 2, \"type\": \"matrix\", \"vehicle\": \"car\", \"sources\": [[lat, lon]], "
+            "\"targets\": [[lat, lon]], \"max_time\": 7200}\n"
+            "Optional \"timeout\" overrides --timeout. Requests are processed by --threads threads, responses "
+            "are written to stdout as json lines with the request id and \"latency_ms\" as soon as they are ready. "
+            "Latency stats are logged at the end of stdin.");
+
 using namespace routing;
 using namespace routes_builder;
 using namespace routing_quality;
@@ -55,6 +75,11 @@ bool IsLocalBuild()
   return !FLAGS_routes_file.empty() && FLAGS_api_name.empty() && FLAGS_api_token.empty();
 }
 
+bool IsMatrixBuild()
+{
+  return FLAGS_routes_file.empty() && !FLAGS_matrix_sources_file.empty() && !FLAGS_matrix_targets_file.empty();
+}
+
 bool IsApiBuild()
 {
   return !FLAGS_routes_file.empty() && !FLAGS_api_name.empty() && !FLAGS_api_token.empty();
@@ -73,15 +98,23 @@ int Main(int argc, char ** argv)
 
   CHECK_GREATER_OR_EQUAL(FLAGS_timeout, 0, ("Timeout should be greater than zero."));
 
-  CHECK(!FLAGS_routes_file.empty(), ("\n\n\t--routes_file is required.", "\n\nType --help for usage."));
-
   if (!FLAGS_data_path.empty())
     GetPlatform().SetWritableDirForTests(FLAGS_data_path);
 
   if (!FLAGS_resources_path.empty())
     GetPlatform().SetResourceDir(FLAGS_resources_path);
 
-  CHECK(IsLocalBuild() || IsApiBuild(),
+  if (FLAGS_server)
+  {
+    RunServer(std::cin, std::cout, FLAGS_threads, FLAGS_timeout, FLAGS_verbose);
+    return 0;
+  }
+
+  CHECK(!FLAGS_routes_file.empty() || IsMatrixBuild(),
+        ("\n\n\t--routes_file or --matrix_sources_file and --matrix_targets_file are required.",
+         "\n\nType --help for usage."));
+
+  CHECK(IsLocalBuild() || IsApiBuild() || IsMatrixBuild(),
         ("\n\n\t--routes_file empty is:", FLAGS_routes_file.empty(), "\n\t--api_name empty is:", FLAGS_api_name.empty(),
          "\n\t--api_token empty is:", FLAGS_api_token.empty(), "\n\nType --help for usage."));
 
@@ -106,6 +139,13 @@ int Main(int argc, char ** argv)
                 FLAGS_verbose, launchesNumber);
   }
 
+  if (IsMatrixBuild())
+  {
+    CHECK_GREATER(FLAGS_matrix_max_time, 0.0, ());
+    BuildMatrix(FLAGS_matrix_sources_file, FLAGS_matrix_targets_file, FLAGS_dump_path, FLAGS_matrix_max_time,
+                FLAGS_timeout, FLAGS_vehicle_type, static_cast<uint32_t>(FLAGS_launches_number));
+  }
+
   if (IsApiBuild())
   {
     auto api = CreateRoutingApi(FLAGS_api_name, FLAGS_api_token);
@@ -11,6 +11,8 @@
 #include "geometry/latlon.hpp"
 #include "geometry/mercator.hpp"
 
+#include "cppjansson/cppjansson.hpp"
+
 #include "base/assert.hpp"
 #include "base/file_name_utils.hpp"
 #include "base/logging.hpp"
@@ -19,8 +21,12 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <fstream>
 #include <future>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <optional>
 #include <thread>
 #include <tuple>
@@ -46,7 +52,7 @@ size_t GetNumberOfLines(std::string const & filename)
   return count;
 }
 
-routing::VehicleType ConvertVehicleTypeFromString(std::string const & str)
+std::optional<routing::VehicleType> ParseVehicleType(std::string const & str)
 {
   if (str == "car")
     return routing::VehicleType::Car;
@@ -56,9 +62,36 @@ routing::VehicleType ConvertVehicleTypeFromString(std::string const & str)
     return routing::VehicleType::Bicycle;
   if (str == "transit")
     return routing::VehicleType::Transit;
+  return {};
+}
 
-  CHECK(false, ("Unknown vehicle type:", str));
-  UNREACHABLE();
+routing::VehicleType ConvertVehicleTypeFromString(std::string const & str)
+{
+  auto const type = ParseVehicleType(str);
+  CHECK(type, ("Unknown vehicle type:", str));
+  return *type;
+}
+
+uint64_t GetThreadsNumber(uint64_t threadsNumber)
+{
+  if (threadsNumber != 0)
+    return threadsNumber;
+
+  auto const hardwareConcurrency = std::thread::hardware_concurrency();
+  return hardwareConcurrency > 0 ? hardwareConcurrency : 2;
+}
+
+std::vector<m2::PointD> LoadPoints(std::string const & filename)
+{
+  std::ifstream input(filename);
+  CHECK(input.good(), ("Error during opening:", filename));
+
+  std::vector<m2::PointD> points;
+  ms::LatLon point;
+  while (input >> point.m_lat >> point.m_lon)
+    points.push_back(mercator::FromLatLon(point));
+
+  return points;
 }
 }  // namespace
 
@@ -72,13 +105,7 @@ void BuildRoutes(std::string const & routesPath, std::string const & dumpPath, u
   std::ifstream input(routesPath);
   CHECK(input.good(), ("Error during opening:", routesPath));
 
-  if (!threadsNumber)
-  {
-    auto const hardwareConcurrency = std::thread::hardware_concurrency();
-    threadsNumber = hardwareConcurrency > 0 ? hardwareConcurrency : 2;
-  }
-
-  RoutesBuilder routesBuilder(threadsNumber);
+  RoutesBuilder routesBuilder(GetThreadsNumber(threadsNumber));
 
   std::vector<std::future<RoutesBuilder::Result>> tasks;
   double lastPercent = 0.0;
@@ -135,9 +162,218 @@ void BuildRoutes(std::string const & routesPath, std::string const & dumpPath, u
       }
     }
     LOG_FORCE(LINFO, ("BuildRoutes() took:", timer.ElapsedSeconds(), "seconds."));
+    LOG_FORCE(LINFO, ("Road geometry cache:", routesBuilder.GetRoadGeometryCacheStats()));
   }
 }
 
+void BuildMatrix(std::string const & sourcesPath, std::string const & targetsPath, std::string const & dumpPath,
+                 double maxTimeSeconds, uint32_t timeoutSeconds, std::string const & vehicleTypeStr,
+                 uint32_t launchesNumber)
+{
+  CHECK(!dumpPath.empty(), ("Empty dumpPath."));
+
+  RoutesBuilder::MatrixParams params;
+  params.m_type = ConvertVehicleTypeFromString(vehicleTypeStr);
+  params.m_sources = LoadPoints(sourcesPath);
+  params.m_targets = LoadPoints(targetsPath);
+  params.m_maxTimeSeconds = maxTimeSeconds;
+  params.m_timeoutSeconds = timeoutSeconds;
+  params.m_launchesNumber = launchesNumber;
+
+  LOG_FORCE(LINFO, ("Matrix:", params.m_sources.size(), "x", params.m_targets.size(), "vehicle type:", params.m_type));
+
+  auto const result = RoutesBuilder::GetSimpleRoutesBuilder().ProcessMatrixTask(params);
+  CHECK(result.IsCodeOK(), ("Can't build matrix:", result.m_code));
+  LOG_FORCE(LINFO, ("BuildMatrix() took:", result.m_buildTimeSeconds, "seconds."));
+
+  std::string const fullPath = base::JoinPath(dumpPath, "matrix.csv");
+  std::ofstream output(fullPath);
+  CHECK(output.good(), ("Error during opening:", fullPath));
+
+  output << std::fixed << std::setprecision(1);
+  auto const & matrix = result.m_matrix;
+  for (size_t i = 0; i < matrix.GetSourcesCount(); ++i)
+  {
+    for (size_t j = 0; j < matrix.GetTargetsCount(); ++j)
+      output << (j == 0 ? "" : ",") << matrix.Get(i, j);
+    output << '\n';
+  }
+}
+
+namespace
+{
+std::vector<m2::PointD> ParseJsonPoints(json_t const * root, char const * field)
+{
+  auto const * points = base::GetJSONObligatoryField(root, field);
+  if (!json_is_array(points))
+    MYTHROW(base::Json::Exception, ("Field", field, "must be an array of [lat, lon] pairs."));
+
+  std::vector<m2::PointD> result;
+  result.reserve(json_array_size(points));
+  for (size_t i = 0; i < json_array_size(points); ++i)
+  {
+    auto const * point = json_array_get(points, i);
+    if (!json_is_array(point) || json_array_size(point) != 2)
+      MYTHROW(base::Json::Exception, ("Field", field, "must be an array of [lat, lon] pairs."));
+
+    ms::LatLon const latLon(FromJSON<double>(json_array_get(point, 0)), FromJSON<double>(json_array_get(point, 1)));
+    result.push_back(mercator::FromLatLon(latLon));
+  }
+  return result;
+}
+
+// Latencies of server requests by request type.
+class LatencyStats
+{
+public:
+  void Add(std::string const & type, double latencyMs)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_latencies[type].push_back(latencyMs);
+  }
+
+  void Log()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto & [type, latencies] : m_latencies)
+    {
+      std::sort(latencies.begin(), latencies.end());
+      auto const percentile = [&latencies](double p)
+      { return latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))]; };
+
+      double sum = 0.0;
+      for (auto const latency : latencies)
+        sum += latency;
+
+      LOG_FORCE(LINFO, ("Requests:", type, "count:", latencies.size(), "latency ms avg:", sum / latencies.size(),
+                        "p50:", percentile(0.5), "p95:", percentile(0.95), "p99:", percentile(0.99),
+                        "max:", latencies.back()));
+    }
+  }
+
+private:
+  std::mutex m_mutex;
+  std::map<std::string, std::vector<double>> m_latencies;
+};
+
+// Processes one request of RunServer() and adds the results to |response|.
+void ProcessRequest(RoutesBuilder & routesBuilder, json_t const * request, std::string const & type,
+                    uint32_t defaultTimeoutSeconds, json_t & response)
+{
+  auto const vehicleTypeStr = FromJSONObject<std::string>(request, "vehicle");
+  auto const vehicleType = ParseVehicleType(vehicleTypeStr);
+  if (!vehicleType)
+    MYTHROW(base::Json::Exception, ("Unknown vehicle type:", vehicleTypeStr));
+
+  uint32_t timeoutSeconds = defaultTimeoutSeconds;
+  if (auto const timeout = FromJSONObjectOptional<uint32_t>(request, "timeout"))
+    timeoutSeconds = *timeout;
+
+  if (type == "route")
+  {
+    RoutesBuilder::Params params(*vehicleType, ParseJsonPoints(request, "points"));
+    params.m_timeoutSeconds = timeoutSeconds;
+    if (params.m_checkpoints.GetPoints().size() < 2)
+      MYTHROW(base::Json::Exception, ("Route needs at least two points."));
+
+    auto const result = routesBuilder.ProcessTask(params);
+    ToJSONObject(response, "code", ToString(result.m_code));
+    ToJSONObject(response, "build_time_ms", result.m_buildTimeSeconds * 1000.0);
+    if (result.IsCodeOK())
+    {
+      auto const & route = result.GetRoutes().front();
+      ToJSONObject(response, "eta", route.m_eta);
+      ToJSONObject(response, "distance", route.m_distance);
+    }
+    return;
+  }
+
+  if (type == "matrix")
+  {
+    RoutesBuilder::MatrixParams params;
+    params.m_type = *vehicleType;
+    params.m_sources = ParseJsonPoints(request, "sources");
+    params.m_targets = ParseJsonPoints(request, "targets");
+    params.m_maxTimeSeconds = FromJSONObject<double>(request, "max_time");
+    params.m_timeoutSeconds = timeoutSeconds;
+
+    auto const result = routesBuilder.ProcessMatrixTask(params);
+    ToJSONObject(response, "code", ToString(result.m_code));
+    ToJSONObject(response, "build_time_ms", result.m_buildTimeSeconds * 1000.0);
+    if (result.IsCodeOK())
+    {
+      auto times = base::NewJSONArray();
+      for (size_t i = 0; i < result.m_matrix.GetSourcesCount(); ++i)
+      {
+        auto row = base::NewJSONArray();
+        for (size_t j = 0; j < result.m_matrix.GetTargetsCount(); ++j)
+          ToJSONArray(*row, result.m_matrix.Get(i, j));
+        ToJSONArray(*times, row);
+      }
+      ToJSONObject(response, "times", times);
+    }
+    return;
+  }
+
+  MYTHROW(base::Json::Exception, ("Unknown request type:", type));
+}
+}  // namespace
+
+void RunServer(std::istream & input, std::ostream & output, uint64_t threadsNumber, uint32_t timeoutSeconds,
+               bool verbose)
+{
+  threadsNumber = GetThreadsNumber(threadsNumber);
+  RoutesBuilder routesBuilder(threadsNumber);
+
+  std::mutex outputMutex;
+  LatencyStats stats;
+
+  base::ScopedLogLevelChanger changer(verbose ? base::LogLevel::LINFO : base::LogLevel::LERROR);
+  LOG_FORCE(LINFO, ("Server is ready, threads:", threadsNumber));
+
+  std::string line;
+  while (std::getline(input, line))
+  {
+    if (line.empty())
+      continue;
+
+    // Should be copyable to be a task of the pool.
+    auto const timer = std::make_shared<base::HighResTimer>();
+    auto const request = std::make_shared<std::string>(std::move(line));
+    routesBuilder.SubmitWork([&, timer, request]()
+    {
+      auto response = base::NewJSONObject();
+      std::string type = "bad_request";
+      try
+      {
+        base::Json const json(*request);
+        if (auto const * id = base::GetJSONOptionalField(json.get(), "id"))
+          json_object_set(response.get(), "id", const_cast<json_t *>(id));
+
+        auto const requestType = FromJSONObject<std::string>(json.get(), "type");
+        ProcessRequest(routesBuilder, json.get(), requestType, timeoutSeconds, *response);
+        type = requestType;
+      }
+      catch (RootException const & e)
+      {
+        ToJSONObject(*response, "error", e.Msg());
+      }
+
+      double const latencyMs = timer->ElapsedNanoseconds() / 1e6;
+      ToJSONObject(*response, "latency_ms", latencyMs);
+      stats.Add(type, latencyMs);
+
+      auto const responseStr = base::DumpToString(response, JSON_COMPACT);
+      std::lock_guard<std::mutex> lock(outputMutex);
+      output << responseStr << std::endl;
+    });
+  }
+
+  routesBuilder.WaitingStop();
+  stats.Log();
+  LOG_FORCE(LINFO, ("Road geometry cache:", routesBuilder.GetRoadGeometryCacheStats()));
+}
+
 std::optional<std::tuple<ms::LatLon, ms::LatLon, int32_t>> ParseApiLine(std::ifstream & input)
 {
   std::string line;
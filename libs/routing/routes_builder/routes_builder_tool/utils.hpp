@@ -5,6 +5,7 @@
 #include "routing/routes_builder/routes_builder.hpp"
 
 #include <cstdint>
+#include <iostream>
 #include <memory>
 #include <string>
 #include <vector>
@@ -17,6 +18,19 @@ void BuildRoutes(std::string const & routesPath, std::string const & dumpPath, u
                  uint64_t threadsNumber, uint32_t timeoutPerRouteSeconds, std::string const & vehicleType, bool verbose,
                  uint32_t launchesNumber);
 
+/// \brief Builds travel time matrix from points of |sourcesPath| to points of |targetsPath|
+/// (one "lat lon" pair per line) and dumps it to |dumpPath|/matrix.csv. Every line of the csv is
+/// a source, every column is a target, pairs without route have TravelTimeMatrix::kNoRoute time.
+void BuildMatrix(std::string const & sourcesPath, std::string const & targetsPath, std::string const & dumpPath,
+                 double maxTimeSeconds, uint32_t timeoutSeconds, std::string const & vehicleType,
+                 uint32_t launchesNumber);
+
+/// \brief Builds routes and matrices requested by json lines of |input| until its end and writes
+/// json line responses to |output| in order of readiness. Maps and routers are loaded once, so
+/// requests are processed with warm caches. See --server flag for the format.
+void RunServer(std::istream & input, std::ostream & output, uint64_t threadsNumber, uint32_t timeoutSeconds,
+               bool verbose);
+
 void BuildRoutesWithApi(std::unique_ptr<routing_quality::api::RoutingApi> routingApi, std::string const & routesPath,
                         std::string const & dumpPath, int64_t startFrom);
 
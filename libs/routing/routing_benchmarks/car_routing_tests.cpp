@@ -3,16 +3,25 @@
 #include "routing/routing_benchmarks/helpers.hpp"
 
 #include "routing/car_directions.hpp"
+#include "routing/checkpoints.hpp"
+#include "routing/isochrone.hpp"
 #include "routing/road_graph.hpp"
+#include "routing/route.hpp"
+#include "routing/router_delegate.hpp"
+#include "routing/travel_time_matrix.hpp"
 
 #include "routing_common/car_model.hpp"
 
 #include "geometry/latlon.hpp"
 #include "geometry/mercator.hpp"
 
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -34,6 +43,99 @@ public:
       TestRouter(*router, startMerc, finalMerc, routeFoundByAstarBidirectional);
   }
 
+  // Compares the travel time matrix with routes built for every pair of |points| one by one.
+  void TestMatrix(std::vector<ms::LatLon> const & points)
+  {
+    std::vector<m2::PointD> mercPoints;
+    for (auto const & point : points)
+      mercPoints.push_back(mercator::FromLatLon(point));
+
+    auto router = CreateRouter("test-matrix");
+    routing::RouterDelegate delegate;
+
+    base::Timer timer;
+    routing::TravelTimeMatrix matrix;
+    TEST_EQUAL(router->CalculateMatrix(mercPoints, mercPoints, 24 * 60 * 60 /* maxTimeSec */, delegate, matrix),
+               routing::RouterResultCode::NoError, ());
+    double const matrixSec = timer.ElapsedSeconds();
+
+    timer.Reset();
+    for (size_t i = 0; i < mercPoints.size(); ++i)
+    {
+      for (size_t j = 0; j < mercPoints.size(); ++j)
+      {
+        if (i == j)
+          continue;
+
+        routing::Route route("", 0 /* route id */);
+        auto const code = router->CalculateRoute(routing::Checkpoints(mercPoints[i], mercPoints[j]),
+                                                 m2::PointD::Zero() /* startDirection */, false /* adjust */,
+                                                 delegate, route);
+        TEST_EQUAL(code == routing::RouterResultCode::NoError, matrix.Get(i, j) != routing::TravelTimeMatrix::kNoRoute,
+                   (points[i], points[j], code));
+      }
+    }
+    double const routesSec = timer.ElapsedSeconds();
+
+    LOG(LINFO, ("Matrix", points.size(), "x", points.size(), "took:", matrixSec,
+                "seconds, routes for every pair took:", routesSec, "seconds."));
+  }
+
+  void TestIsochrone(ms::LatLon const & start, double maxTimeSec)
+  {
+    auto router = CreateRouter("test-isochrone");
+    routing::RouterDelegate delegate;
+
+    base::Timer timer;
+    std::vector<routing::IsochroneSegment> segments;
+    TEST_EQUAL(router->CalculateIsochrone(mercator::FromLatLon(start), maxTimeSec, delegate, segments),
+               routing::RouterResultCode::NoError, ());
+    double const isochroneSec = timer.ElapsedSeconds();
+    TEST(!segments.empty(), ());
+
+    timer.Reset();
+    auto const polygons = routing::BuildIsochronePolygons(segments, maxTimeSec, 100.0 /* cellSizeM */);
+    double const polygonsSec = timer.ElapsedSeconds();
+    TEST(!polygons.empty(), ());
+
+    LOG(LINFO, ("Isochrone of", maxTimeSec, "seconds from", start, "has", segments.size(), "segments. It took:",
+                isochroneSec, "seconds,", polygons.size(), "polygons took:", polygonsSec, "seconds."));
+  }
+
+  // Compares the route calculation time with alternatives and without them.
+  void TestAlternatives(ms::LatLon const & start, ms::LatLon const & final, size_t reiterations)
+  {
+    auto router = CreateRouter("test-alternatives");
+    routing::RouterDelegate delegate;
+    routing::Checkpoints const checkpoints(mercator::FromLatLon(start), mercator::FromLatLon(final));
+
+    size_t alternativesCount = 0;
+    auto const calcRoutes = [&]()
+    {
+      base::Timer timer;
+      for (size_t i = 0; i < reiterations; ++i)
+      {
+        routing::Route route("", 0 /* route id */);
+        TEST_EQUAL(router->CalculateRoute(checkpoints, m2::PointD::Zero() /* startDirection */, false /* adjust */,
+                                          delegate, route),
+                   routing::RouterResultCode::NoError, ());
+        alternativesCount = route.GetAlternatives().size();
+      }
+      return timer.ElapsedSeconds();
+    };
+
+    double const routesSec = calcRoutes();
+    TEST_EQUAL(alternativesCount, 0, ());
+
+    routing::AlternativesParams params;
+    params.m_maxAlternatives = 3;
+    router->SetAlternativesParams(params);
+    double const alternativesSec = calcRoutes();
+
+    LOG(LINFO, (reiterations, "routes took:", routesSec, "seconds, routes with", alternativesCount,
+                "alternatives took:", alternativesSec, "seconds, ratio:", alternativesSec / routesSec));
+  }
+
 protected:
   std::unique_ptr<routing::VehicleModelFactoryInterface> CreateModelFactory() override
   {
@@ -61,4 +163,37 @@ UNIT_CLASS_TEST(CarTest, InAirport)
 {
   TestCarRouter(ms::LatLon(55.97285, 37.41275), ms::LatLon(55.96396, 37.41922), 30);
 }
+
+// Route across the center of Moscow with alternatives.
+UNIT_CLASS_TEST(CarTest, Alternatives)
+{
+  TestAlternatives(ms::LatLon(55.80248, 37.53456), ms::LatLon(55.71498, 37.66187), 10);
+}
+
+// Points of 5 x 5 grid over the center of Moscow.
+UNIT_CLASS_TEST(CarTest, Matrix)
+{
+  std::vector<ms::LatLon> points;
+  for (size_t i = 0; i < 5; ++i)
+    for (size_t j = 0; j < 5; ++j)
+      points.emplace_back(55.70 + 0.025 * i, 37.50 + 0.05 * j);
+
+  TestMatrix(points);
+}
+
+// Isochrones in the center of Moscow.
+UNIT_CLASS_TEST(CarTest, Isochrone5Min)
+{
+  TestIsochrone(ms::LatLon(55.75785, 37.58267), 5 * 60);
+}
+
+UNIT_CLASS_TEST(CarTest, Isochrone15Min)
+{
+  TestIsochrone(ms::LatLon(55.75785, 37.58267), 15 * 60);
+}
+
+UNIT_CLASS_TEST(CarTest, Isochrone30Min)
+{
+  TestIsochrone(ms::LatLon(55.75785, 37.58267), 30 * 60);
+}
 }  // namespace
@@ -86,9 +86,10 @@ void RoutingTest::TestRouters(m2::PointD const & startPos, m2::PointD const & fi
 {
   // Find route by A*-bidirectional algorithm.
   routing::Route routeFoundByAstarBidirectional("", 0 /* route id */);
+  size_t pointChecksWithLandmarks = 0;
   {
     auto router = CreateRouter("test-astar-bidirectional");
-    TestRouter(*router, startPos, finalPos, routeFoundByAstarBidirectional);
+    pointChecksWithLandmarks = TestRouter(*router, startPos, finalPos, routeFoundByAstarBidirectional);
   }
 
   // Find route by A* algorithm.
@@ -98,10 +99,28 @@ void RoutingTest::TestRouters(m2::PointD const & startPos, m2::PointD const & fi
     TestRouter(*router, startPos, finalPos, routeFoundByAstar);
   }
 
+  // Find route by A*-bidirectional algorithm without landmarks.
+  routing::Route routeFoundWithoutLandmarks("", 0 /* route id */);
+  size_t pointChecksWithoutLandmarks = 0;
+  {
+    auto router = CreateRouter("test-astar-bidirectional-no-landmarks", false /* useLandmarks */);
+    pointChecksWithoutLandmarks = TestRouter(*router, startPos, finalPos, routeFoundWithoutLandmarks);
+  }
+
   double constexpr kEpsilon = 1e-6;
   TEST(AlmostEqualAbs(routeFoundByAstar.GetTotalDistanceMeters(),
                       routeFoundByAstarBidirectional.GetTotalDistanceMeters(), kEpsilon),
        ());
+
+  LOG(LINFO, ("Point checks with landmarks:", pointChecksWithLandmarks, "without landmarks:",
+              pointChecksWithoutLandmarks));
+  // Routes with landmarks stay in the mwm of the endings, see IndexRouter::CalculateSubroute().
+  if (m_neededMaps.size() == 1)
+  {
+    TEST(AlmostEqualAbs(routeFoundWithoutLandmarks.GetTotalDistanceMeters(),
+                        routeFoundByAstarBidirectional.GetTotalDistanceMeters(), kEpsilon),
+         ());
+  }
 }
 
 void RoutingTest::TestTwoPointsOnFeature(m2::PointD const & startPos, m2::PointD const & finalPos)
@@ -121,7 +140,7 @@ void RoutingTest::TestTwoPointsOnFeature(m2::PointD const & startPos, m2::PointD
   TestRouters(startPosOnFeature, finalPosOnFeature);
 }
 
-std::unique_ptr<routing::IRouter> RoutingTest::CreateRouter(std::string const & name)
+std::unique_ptr<routing::IndexRouter> RoutingTest::CreateRouter(std::string const & name, bool useLandmarks)
 {
   std::vector<platform::LocalCountryFile> neededLocalFiles;
   neededLocalFiles.reserve(m_neededMaps.size());
@@ -129,8 +148,8 @@ std::unique_ptr<routing::IRouter> RoutingTest::CreateRouter(std::string const &
     if (m_neededMaps.count(file.GetCountryName()) != 0)
       neededLocalFiles.push_back(file);
 
-  std::unique_ptr<routing::IRouter> router =
-      integration::CreateVehicleRouter(m_dataSource, *m_cig, m_trafficCache, neededLocalFiles, m_type);
+  auto router = integration::CreateVehicleRouter(m_dataSource, *m_cig, m_trafficCache, neededLocalFiles, m_type);
+  router->SetUseLandmarks(useLandmarks);
   return router;
 }
 
@@ -143,10 +162,12 @@ void RoutingTest::GetNearestEdges(m2::PointD const & pt,
                          1 /* count */, edges);
 }
 
-void TestRouter(routing::IRouter & router, m2::PointD const & startPos, m2::PointD const & finalPos,
-                routing::Route & route)
+size_t TestRouter(routing::IRouter & router, m2::PointD const & startPos, m2::PointD const & finalPos,
+                  routing::Route & route)
 {
+  size_t pointChecks = 0;
   routing::RouterDelegate delegate;
+  delegate.SetPointCheckCallback([&pointChecks](ms::LatLon const &) { ++pointChecks; });
   LOG(LINFO, ("Calculating routing ...", router.GetName()));
   base::Timer timer;
   auto const resultCode =
@@ -162,4 +183,6 @@ void TestRouter(routing::IRouter & router, m2::PointD const & startPos, m2::Poin
   LOG(LINFO, ("Route polyline size:", route.GetPoly().GetSize()));
   LOG(LINFO, ("Route distance, meters:", route.GetTotalDistanceMeters()));
   LOG(LINFO, ("Elapsed, seconds:", elapsedSec));
+  LOG(LINFO, ("Point checks:", pointChecks));
+  return pointChecks;
 }
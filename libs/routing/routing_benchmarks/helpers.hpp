@@ -1,5 +1,6 @@
 #pragma once
 
+#include "routing/index_router.hpp"
 #include "routing/road_graph.hpp"
 #include "routing/route.hpp"
 #include "routing/router.hpp"
@@ -34,7 +35,8 @@ public:
 protected:
   virtual std::unique_ptr<routing::VehicleModelFactoryInterface> CreateModelFactory() = 0;
 
-  std::unique_ptr<routing::IRouter> CreateRouter(std::string const & name);
+  /// \param useLandmarks switches ALT heuristic with ROUTING_LANDMARKS_FILE_TAG section.
+  std::unique_ptr<routing::IndexRouter> CreateRouter(std::string const & name, bool useLandmarks = true);
   void GetNearestEdges(m2::PointD const & pt,
                        std::vector<std::pair<routing::Edge, geometry::PointWithAltitude>> & edges);
 
@@ -92,5 +94,7 @@ private:
   std::shared_ptr<SimplifiedModel> const m_model;
 };
 
-void TestRouter(routing::IRouter & router, m2::PointD const & startPos, m2::PointD const & finalPos,
-                routing::Route & route);
+/// \returns number of point checks during the route calculation. The router checks every 40th
+/// settled vertex, so it's a measure of the search space size.
+size_t TestRouter(routing::IRouter & router, m2::PointD const & startPos, m2::PointD const & finalPos,
+                  routing::Route & route);
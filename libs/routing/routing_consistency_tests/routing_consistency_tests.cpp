@@ -39,6 +39,9 @@ DEFINE_string(data_path, "../../data/", "Working directory, 'path_to_exe/../../d
 DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
 DEFINE_bool(verbose, false, "Output processed lines to log.");
 DEFINE_uint64(confidence, 5, "Maximum test count for each single mwm file.");
+DEFINE_bool(parallel_waves, false, "Propagate forward and backward A* waves on different threads.");
+DEFINE_bool(parallel_leaps, false, "Calculate routes through the mwms of leaps on different threads.");
+DEFINE_bool(shortcuts, false, "Use routing shortcuts for routes inside one mwm.");
 
 // Information about successful user routing.
 struct UserRoutingRecord
@@ -85,7 +88,13 @@ bool ParseUserString(string const & incomeString, UserRoutingRecord & result)
 class RouteTester
 {
 public:
-  RouteTester() : m_components(integration::GetVehicleComponents(VehicleType::Car)) {}
+  RouteTester() : m_components(integration::GetVehicleComponents(VehicleType::Car))
+  {
+    auto & router = static_cast<IndexRouter &>(m_components.GetRouter());
+    router.SetUseParallelWaves(FLAGS_parallel_waves);
+    router.SetUseParallelLeaps(FLAGS_parallel_leaps);
+    router.SetUseShortcuts(FLAGS_shortcuts);
+  }
 
   bool BuildRoute(UserRoutingRecord const & record)
   {
@@ -0,0 +1,98 @@
+#include "routing/routing_geometry.hpp"
+
+#include "coding/endianness.hpp"
+
+#include "base/assert.hpp"
+
+#include <utility>
+
+namespace routing
+{
+using namespace std;
+
+void RoutingGeometry::Road::Clear()
+{
+  m_points.clear();
+  m_altitudes.clear();
+  m_types.clear();
+}
+
+RoutingGeometry::RoutingGeometry(unique_ptr<Reader> reader) : m_reader(std::move(reader))
+{
+  CHECK(m_reader, ());
+
+  if (m_reader->Size() < Header::kSize)
+    MYTHROW(CorruptedDataException, ("Routing geometry section is too small:", m_reader->Size()));
+
+  m_header.m_version = ReadPrimitiveFromPos<uint16_t>(*m_reader, 0);
+  if (m_header.m_version != kVersion)
+    MYTHROW(CorruptedDataException, ("Unknown routing geometry section version:", m_header.m_version));
+
+  m_header.m_flags = ReadPrimitiveFromPos<uint16_t>(*m_reader, 2);
+  m_header.m_featuresCount = ReadPrimitiveFromPos<uint32_t>(*m_reader, 4);
+  m_header.m_pointsCount = ReadPrimitiveFromPos<uint32_t>(*m_reader, 8);
+  m_header.m_typesCount = ReadPrimitiveFromPos<uint32_t>(*m_reader, 12);
+
+  uint64_t expectedSize = m_header.GetAltitudesPos();
+  if (HasAltitudes())
+    expectedSize += m_header.m_pointsCount * sizeof(geometry::Altitude);
+  if (m_reader->Size() != expectedSize)
+    MYTHROW(CorruptedDataException, ("Wrong routing geometry section size:", m_reader->Size(), expectedSize));
+}
+
+bool RoutingGeometry::GetRoad(uint32_t featureId, Road & road) const
+{
+  road.Clear();
+  if (featureId >= m_header.m_featuresCount)
+    return false;
+
+  uint32_t pointsBegin = 0;
+  uint32_t pointsEnd = 0;
+  ReadRange(m_header.GetPointOffsetsPos(), featureId, pointsBegin, pointsEnd);
+  if (pointsBegin == pointsEnd)
+    return false;
+
+  uint32_t const pointsCount = pointsEnd - pointsBegin;
+  ReadUint32s(m_header.GetXsPos() + pointsBegin * sizeof(uint32_t), pointsCount, m_xs);
+  ReadUint32s(m_header.GetYsPos() + pointsBegin * sizeof(uint32_t), pointsCount, m_ys);
+  road.m_points.reserve(pointsCount);
+  for (uint32_t i = 0; i < pointsCount; ++i)
+    road.m_points.push_back(PointUToPointD(m2::PointU(m_xs[i], m_ys[i]), kPointCoordBits));
+
+  uint32_t typesBegin = 0;
+  uint32_t typesEnd = 0;
+  ReadRange(m_header.GetTypeOffsetsPos(), featureId, typesBegin, typesEnd);
+  ReadUint32s(m_header.GetTypesPos() + typesBegin * sizeof(uint32_t), typesEnd - typesBegin, road.m_types);
+
+  if (HasAltitudes())
+  {
+    road.m_altitudes.resize(pointsCount);
+    m_reader->Read(m_header.GetAltitudesPos() + pointsBegin * sizeof(geometry::Altitude), road.m_altitudes.data(),
+                   pointsCount * sizeof(geometry::Altitude));
+    for (auto & altitude : road.m_altitudes)
+      altitude = SwapIfBigEndianMacroBased(altitude);
+  }
+  return true;
+}
+
+void RoutingGeometry::ReadRange(uint64_t pos, uint32_t featureId, uint32_t & begin, uint32_t & end) const
+{
+  uint32_t range[2];
+  m_reader->Read(pos + featureId * sizeof(uint32_t), range, sizeof(range));
+  begin = SwapIfBigEndianMacroBased(range[0]);
+  end = SwapIfBigEndianMacroBased(range[1]);
+  if (begin > end)
+    MYTHROW(CorruptedDataException, ("Wrong offsets of feature", featureId, ":", begin, end));
+}
+
+void RoutingGeometry::ReadUint32s(uint64_t pos, uint32_t count, vector<uint32_t> & values) const
+{
+  values.resize(count);
+  if (count == 0)
+    return;
+
+  m_reader->Read(pos, values.data(), count * sizeof(uint32_t));
+  for (auto & value : values)
+    value = SwapIfBigEndianMacroBased(value);
+}
+}  // namespace routing
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "routing/routing_exceptions.hpp"
+
+#include "coding/point_coding.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/point_with_altitude.hpp"
+
+#include "base/checked_cast.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace routing
+{
+/// \brief Flat geometry of the roads of an mwm, ROUTING_GEOMETRY_FILE_TAG section. It doesn't depend
+/// on vehicle type and keeps everything RoadGeometry needs except metadata, so roads are made
+/// without FeatureType parsing. Roads which need metadata, i.e. ferries and shuttle trains with
+/// duration, are not in the section.
+/// All the arrays are indexed by feature id or by offsets from the feature id indexed arrays, numbers
+/// are little endian:
+/// * header: version, flags, features count, points count and types count;
+/// * uint32 offsets of the first point of every feature id, features count + 1 items,
+///   features which are not in the section have no points;
+/// * uint32 x and then uint32 y of all the points with kPointCoordBits;
+/// * uint32 offsets of the first type of every feature id, features count + 1 items;
+/// * uint32 types of all the features;
+/// * int16 altitudes of all the points if the section has altitudes.
+/// Arrays are read by position, so a road is read with a few reads of adjacent bytes.
+class RoutingGeometry final
+{
+public:
+  static uint16_t constexpr kVersion = 0;
+
+  struct Road
+  {
+    void Clear();
+
+    std::vector<m2::PointD> m_points;
+    /// Empty if the section has no altitudes.
+    geometry::Altitudes m_altitudes;
+    std::vector<uint32_t> m_types;
+  };
+
+  /// \param roads are roads by feature ids. All the roads have altitudes if |hasAltitudes|.
+  template <typename Sink>
+  static void Serialize(Sink & sink, std::map<uint32_t, Road> const & roads, bool hasAltitudes);
+
+  /// \brief Reads the header only, roads are read from |reader| by GetRoad().
+  explicit RoutingGeometry(std::unique_ptr<Reader> reader);
+
+  bool HasAltitudes() const { return (m_header.m_flags & kHasAltitudesFlag) != 0; }
+  uint32_t GetFeaturesCount() const { return m_header.m_featuresCount; }
+  uint32_t GetPointsCount() const { return m_header.m_pointsCount; }
+
+  /// \returns false if |featureId| is not in the section.
+  bool GetRoad(uint32_t featureId, Road & road) const;
+
+private:
+  static uint16_t constexpr kHasAltitudesFlag = 1;
+
+  struct Header
+  {
+    uint64_t GetPointOffsetsPos() const { return kSize; }
+    uint64_t GetXsPos() const { return GetPointOffsetsPos() + (m_featuresCount + 1) * sizeof(uint32_t); }
+    uint64_t GetYsPos() const { return GetXsPos() + m_pointsCount * sizeof(uint32_t); }
+    uint64_t GetTypeOffsetsPos() const { return GetYsPos() + m_pointsCount * sizeof(uint32_t); }
+    uint64_t GetTypesPos() const { return GetTypeOffsetsPos() + (m_featuresCount + 1) * sizeof(uint32_t); }
+    uint64_t GetAltitudesPos() const { return GetTypesPos() + m_typesCount * sizeof(uint32_t); }
+
+    static uint64_t constexpr kSize = 16;
+
+    uint16_t m_version = kVersion;
+    uint16_t m_flags = 0;
+    uint32_t m_featuresCount = 0;
+    uint32_t m_pointsCount = 0;
+    uint32_t m_typesCount = 0;
+  };
+
+  // Reads [begin, end) offsets range of |featureId| from offsets array at |pos|.
+  void ReadRange(uint64_t pos, uint32_t featureId, uint32_t & begin, uint32_t & end) const;
+  void ReadUint32s(uint64_t pos, uint32_t count, std::vector<uint32_t> & values) const;
+
+  std::unique_ptr<Reader> m_reader;
+  Header m_header;
+  // Buffers for reading, RoutingGeometry is used by one thread.
+  mutable std::vector<uint32_t> m_xs;
+  mutable std::vector<uint32_t> m_ys;
+};
+
+template <typename Sink>
+void RoutingGeometry::Serialize(Sink & sink, std::map<uint32_t, Road> const & roads, bool hasAltitudes)
+{
+  Header header;
+  header.m_flags = hasAltitudes ? kHasAltitudesFlag : 0;
+  header.m_featuresCount = roads.empty() ? 0 : roads.crbegin()->first + 1;
+  for (auto const & [featureId, road] : roads)
+  {
+    CHECK(!hasAltitudes || road.m_altitudes.size() == road.m_points.size(), (featureId));
+    header.m_pointsCount += base::checked_cast<uint32_t>(road.m_points.size());
+    header.m_typesCount += base::checked_cast<uint32_t>(road.m_types.size());
+  }
+
+  WriteToSink(sink, header.m_version);
+  WriteToSink(sink, header.m_flags);
+  WriteToSink(sink, header.m_featuresCount);
+  WriteToSink(sink, header.m_pointsCount);
+  WriteToSink(sink, header.m_typesCount);
+
+  auto const writeOffsets = [&](auto const & getCount)
+  {
+    uint32_t offset = 0;
+    auto it = roads.cbegin();
+    for (uint32_t featureId = 0; featureId <= header.m_featuresCount; ++featureId)
+    {
+      WriteToSink(sink, offset);
+      if (it != roads.cend() && it->first == featureId)
+      {
+        offset += base::checked_cast<uint32_t>(getCount(it->second));
+        ++it;
+      }
+    }
+  };
+
+  writeOffsets([](Road const & road) { return road.m_points.size(); });
+  for (auto const & [featureId, road] : roads)
+    for (auto const & point : road.m_points)
+      WriteToSink(sink, PointDToPointU(point, kPointCoordBits).x);
+  for (auto const & [featureId, road] : roads)
+    for (auto const & point : road.m_points)
+      WriteToSink(sink, PointDToPointU(point, kPointCoordBits).y);
+
+  writeOffsets([](Road const & road) { return road.m_types.size(); });
+  for (auto const & [featureId, road] : roads)
+    for (auto const type : road.m_types)
+      WriteToSink(sink, type);
+
+  if (hasAltitudes)
+    for (auto const & [featureId, road] : roads)
+      for (auto const altitude : road.m_altitudes)
+        WriteToSink(sink, altitude);
+}
+}  // namespace routing
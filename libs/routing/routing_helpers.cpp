@@ -181,4 +181,14 @@ bool AdjustLengthChecker::operator()(RouteWeight const & weight) const
   double constexpr kAdjustLimitSec = 5 * 60;
   return weight <= RouteWeight(kAdjustLimitSec) && m_starter.CheckLength(weight);
 }
+
+// BackwardTreeLengthChecker -----------------------------------------------------------------------
+
+bool BackwardTreeLengthChecker::operator()(RouteWeight const & weight) const
+{
+  // Limit of a detour to the previous route in seconds. The tree is built around ten minutes of
+  // the route, so the limit is less than the one of adjust.
+  double constexpr kBackwardTreeLimitSec = 60;
+  return weight <= RouteWeight(kBackwardTreeLimitSec);
+}
 }  // namespace routing
@@ -95,4 +95,11 @@ struct AdjustLengthChecker
   bool operator()(RouteWeight const & weight) const;
   IndexGraphStarter & m_starter;
 };
+
+/// \brief Checks the weight of a detour to the previous route of a backward tree, see
+/// AStarAlgorithm::BuildBackwardTree().
+struct BackwardTreeLengthChecker
+{
+  bool operator()(RouteWeight const & weight) const;
+};
 }  // namespace routing
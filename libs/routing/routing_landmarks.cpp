@@ -0,0 +1,340 @@
+#include "routing/routing_landmarks.hpp"
+
+#include "routing/index_graph.hpp"
+#include "routing/segment.hpp"
+
+#include "base/logging.hpp"
+
+#include <cmath>
+#include <functional>
+#include <queue>
+
+namespace routing
+{
+using namespace std;
+
+namespace
+{
+uint32_t constexpr kInf = numeric_limits<uint32_t>::max();
+// Number of attempts to find a seed point in a big connected component of the graph.
+size_t constexpr kSeedAttempts = 10;
+
+/// \brief Graph of road points without restrictions and turn penalties. Points of a road are
+/// numerated consecutively, points of one joint are connected with zero weight edges. Segment
+/// weights are rounded down to whole seconds.
+class RoadPointsGraph
+{
+public:
+  RoadPointsGraph(IndexGraph & graph, NumMwmId mwmId)
+  {
+    // Roads are sorted by feature id to keep the table sorted.
+    vector<uint32_t> featureIds;
+    graph.ForEachRoad([&featureIds](uint32_t featureId, RoadJointIds const &) { featureIds.push_back(featureId); });
+    sort(featureIds.begin(), featureIds.end());
+
+    vector<pair<Joint::Id, uint32_t>> jointPoints;
+    for (auto const featureId : featureIds)
+    {
+      auto const & road = graph.GetRoadGeometry(featureId);
+      if (!road.IsValid() || road.GetPointsCount() == 0)
+        continue;
+
+      auto const & roadJoints = graph.GetRoad(featureId);
+
+      m_featureIds.push_back(featureId);
+      m_firstPoints.push_back(GetNumPoints());
+      for (uint32_t pointId = 0; pointId < road.GetPointsCount(); ++pointId)
+      {
+        auto const jointId = roadJoints.GetJointId(pointId);
+        if (jointId != Joint::kInvalidId)
+          jointPoints.emplace_back(jointId, GetNumPoints());
+
+        uint32_t forward = kInf;
+        uint32_t backward = kInf;
+        if (pointId + 1 < road.GetPointsCount())
+        {
+          Segment const segment(mwmId, featureId, pointId, true /* forward */);
+          forward = ToSeconds(graph.CalcSegmentWeight(segment, EdgeEstimator::Purpose::Weight));
+          if (!road.IsOneWay())
+            backward = ToSeconds(graph.CalcSegmentWeight(segment.GetReversed(), EdgeEstimator::Purpose::Weight));
+        }
+        m_forward.push_back(forward);
+        m_backward.push_back(backward);
+      }
+    }
+    m_firstPoints.push_back(GetNumPoints());
+
+    sort(jointPoints.begin(), jointPoints.end());
+    m_jointOfPoint.assign(GetNumPoints(), kNoJoint);
+    for (size_t i = 0; i < jointPoints.size(); ++i)
+    {
+      if (i == 0 || jointPoints[i].first != jointPoints[i - 1].first)
+        m_jointFirstPoints.push_back(base::checked_cast<uint32_t>(i));
+      m_jointOfPoint[jointPoints[i].second] = base::checked_cast<uint32_t>(m_jointFirstPoints.size() - 1);
+      m_jointPoints.push_back(jointPoints[i].second);
+    }
+    m_jointFirstPoints.push_back(base::checked_cast<uint32_t>(m_jointPoints.size()));
+  }
+
+  uint32_t GetNumPoints() const { return base::checked_cast<uint32_t>(m_forward.size()); }
+  vector<uint32_t> const & GetFeatureIds() const { return m_featureIds; }
+  vector<uint32_t> const & GetFirstPoints() const { return m_firstPoints; }
+
+  RoadPoint GetRoadPoint(uint32_t point) const
+  {
+    auto const it = upper_bound(m_firstPoints.cbegin(), m_firstPoints.cend(), point);
+    CHECK(it != m_firstPoints.cbegin(), ());
+    auto const roadIdx = static_cast<size_t>(distance(m_firstPoints.cbegin(), it)) - 1;
+    return RoadPoint(m_featureIds[roadIdx], point - m_firstPoints[roadIdx]);
+  }
+
+  /// \brief Calculates weights of the shortest paths from |source| to all the points
+  /// (to |source| from all the points if |isOutgoing| is false).
+  void CalcWeights(uint32_t source, bool isOutgoing, vector<uint32_t> & weights) const
+  {
+    using State = pair<uint32_t, uint32_t>;
+    priority_queue<State, vector<State>, greater<State>> queue;
+
+    weights.assign(GetNumPoints(), kInf);
+    weights[source] = 0;
+    queue.emplace(0, source);
+
+    auto const relax = [&](uint32_t point, uint32_t weight, uint32_t edgeWeight)
+    {
+      if (edgeWeight == kInf)
+        return;
+
+      weight = static_cast<uint32_t>(min(uint64_t{weight} + edgeWeight, uint64_t{kInf} - 1));
+      if (weight < weights[point])
+      {
+        weights[point] = weight;
+        queue.emplace(weight, point);
+      }
+    };
+
+    while (!queue.empty())
+    {
+      auto const [weight, point] = queue.top();
+      queue.pop();
+      if (weight > weights[point])
+        continue;
+
+      // Weights of the last point of a road are infinite, so the neighbours are on the same road.
+      if (point + 1 < GetNumPoints())
+        relax(point + 1, weight, isOutgoing ? m_forward[point] : m_backward[point]);
+      if (point > 0)
+        relax(point - 1, weight, isOutgoing ? m_backward[point - 1] : m_forward[point - 1]);
+
+      auto const joint = m_jointOfPoint[point];
+      if (joint == kNoJoint)
+        continue;
+
+      for (uint32_t i = m_jointFirstPoints[joint]; i < m_jointFirstPoints[joint + 1]; ++i)
+        relax(m_jointPoints[i], weight, 0 /* edgeWeight */);
+    }
+  }
+
+private:
+  static uint32_t constexpr kNoJoint = numeric_limits<uint32_t>::max();
+
+  static uint32_t ToSeconds(RouteWeight const & weight)
+  {
+    return static_cast<uint32_t>(min(floor(weight.GetWeight()), static_cast<double>(kInf - 1)));
+  }
+
+  vector<uint32_t> m_featureIds;
+  // Index of the first point of every road and the total number of points at the end.
+  vector<uint32_t> m_firstPoints;
+  // Weights of segments from a point to the next one and back. Infinite for the last road point
+  // and for the backward direction of oneway roads.
+  vector<uint32_t> m_forward;
+  vector<uint32_t> m_backward;
+  vector<uint32_t> m_jointOfPoint;
+  vector<uint32_t> m_jointFirstPoints;
+  vector<uint32_t> m_jointPoints;
+};
+
+// Saturated weights keep the triangle inequality, so bounds calculated with them are consistent.
+// Unreachable points get the maximal weight too.
+uint16_t ToStoredWeight(uint32_t weight)
+{
+  return static_cast<uint16_t>(min<uint32_t>(weight, RoutingLandmarks::kMaxWeight));
+}
+
+uint32_t FindFarthestPoint(vector<uint32_t> const & weights)
+{
+  uint32_t farthest = 0;
+  uint32_t maxWeight = 0;
+  for (uint32_t point = 0; point < weights.size(); ++point)
+  {
+    if (weights[point] != kInf && weights[point] > maxWeight)
+    {
+      farthest = point;
+      maxWeight = weights[point];
+    }
+  }
+  return farthest;
+}
+}  // namespace
+
+RoutingLandmarks::RoutingLandmarks(vector<RoadPoint> && landmarks, vector<uint32_t> && featureIds,
+                                   vector<uint32_t> && firstPoints, vector<uint16_t> && fromLandmarks,
+                                   vector<uint16_t> && toLandmarks)
+  : m_landmarks(std::move(landmarks))
+  , m_featureIds(std::move(featureIds))
+  , m_firstPoints(std::move(firstPoints))
+  , m_fromLandmarks(std::move(fromLandmarks))
+  , m_toLandmarks(std::move(toLandmarks))
+{
+  CHECK(is_sorted(m_featureIds.cbegin(), m_featureIds.cend()), ());
+  CHECK_EQUAL(m_firstPoints.size(), m_featureIds.size() + 1, ());
+  CHECK_EQUAL(m_fromLandmarks.size(), static_cast<size_t>(m_firstPoints.back()) * m_landmarks.size(), ());
+  CHECK_EQUAL(m_toLandmarks.size(), m_fromLandmarks.size(), ());
+}
+
+LandmarksHeuristic::EndingWeights::EndingWeights(RoutingLandmarks const & landmarks, vector<RoadPoint> const & points)
+  : m_fromMin(landmarks.GetNumLandmarks(), RoutingLandmarks::kMaxWeight)
+  , m_fromMax(landmarks.GetNumLandmarks(), 0)
+  , m_toMin(landmarks.GetNumLandmarks(), RoutingLandmarks::kMaxWeight)
+  , m_toMax(landmarks.GetNumLandmarks(), 0)
+{
+  for (auto const & point : points)
+  {
+    auto const * from = landmarks.GetFromLandmarks(point);
+    auto const * to = landmarks.GetToLandmarks(point);
+    for (size_t i = 0; i < landmarks.GetNumLandmarks(); ++i)
+    {
+      m_fromMin[i] = min<int32_t>(m_fromMin[i], from ? from[i] : 0);
+      m_fromMax[i] = max<int32_t>(m_fromMax[i], from ? from[i] : RoutingLandmarks::kMaxWeight);
+      m_toMin[i] = min<int32_t>(m_toMin[i], to ? to[i] : 0);
+      m_toMax[i] = max<int32_t>(m_toMax[i], to ? to[i] : RoutingLandmarks::kMaxWeight);
+    }
+  }
+
+  // Nothing is known about an ending without points.
+  if (points.empty())
+  {
+    m_fromMin.assign(m_fromMin.size(), 0);
+    m_fromMax.assign(m_fromMax.size(), RoutingLandmarks::kMaxWeight);
+    m_toMin.assign(m_toMin.size(), 0);
+    m_toMax.assign(m_toMax.size(), RoutingLandmarks::kMaxWeight);
+  }
+}
+
+LandmarksHeuristic::LandmarksHeuristic(RoutingLandmarks const & landmarks, NumMwmId mwmId,
+                                       vector<RoadPoint> const & startPoints, vector<RoadPoint> const & finishPoints)
+  : m_landmarks(landmarks)
+  , m_mwmId(mwmId)
+  , m_start(landmarks, startPoints)
+  , m_finish(landmarks, finishPoints)
+{}
+
+double LandmarksHeuristic::CalcWeight(Segment const & segment, bool toFinish) const
+{
+  if (segment.GetMwmId() != m_mwmId)
+    return 0.0;
+
+  RoadPoint const point(segment.GetFeatureId(), segment.GetPointId(true /* front */));
+  auto const * from = m_landmarks.GetFromLandmarks(point);
+  auto const * to = m_landmarks.GetToLandmarks(point);
+  if (!from || !to)
+    return 0.0;
+
+  // The bounds of the point weights are taken over all ending points, so the estimate is not greater
+  // than the weight of a path to any of them.
+  int32_t weight = 0;
+  for (size_t i = 0; i < m_landmarks.GetNumLandmarks(); ++i)
+  {
+    if (toFinish)
+      weight = max({weight, m_finish.m_fromMin[i] - from[i], to[i] - m_finish.m_toMax[i]});
+    else
+      weight = max({weight, from[i] - m_start.m_fromMax[i], m_start.m_toMin[i] - to[i]});
+  }
+  return weight;
+}
+
+RoutingLandmarks BuildRoutingLandmarks(IndexGraph & graph, NumMwmId mwmId, size_t numLandmarks)
+{
+  RoadPointsGraph const pointsGraph(graph, mwmId);
+  auto const numPoints = pointsGraph.GetNumPoints();
+  if (numPoints == 0 || numLandmarks == 0)
+    return {};
+
+  // Landmarks are chosen in the biggest connected component found from a few seed points.
+  vector<uint32_t> weights;
+  vector<uint32_t> minWeights;
+  size_t maxReached = 0;
+  uint32_t seed = 0;
+  for (size_t attempt = 0; attempt < kSeedAttempts && seed < numPoints; ++attempt)
+  {
+    pointsGraph.CalcWeights(seed, true /* isOutgoing */, weights);
+    auto const reached =
+        static_cast<size_t>(count_if(weights.cbegin(), weights.cend(), [](uint32_t w) { return w != kInf; }));
+    if (reached > maxReached)
+    {
+      maxReached = reached;
+      minWeights = weights;
+    }
+
+    if (2 * reached >= numPoints)
+      break;
+
+    auto const it = find(weights.cbegin() + seed, weights.cend(), kInf);
+    seed = static_cast<uint32_t>(distance(weights.cbegin(), it));
+  }
+
+  // Farthest point heuristic: every next landmark is the point with the greatest weight from the
+  // nearest of the chosen landmarks. Weights are stored for all points, landmark by landmark.
+  vector<uint32_t> landmarks;
+  vector<uint16_t> fromLandmarks(numPoints * numLandmarks);
+  vector<uint16_t> toLandmarks(fromLandmarks.size());
+  vector<uint32_t> fromLandmark;
+  vector<uint32_t> toLandmark;
+  for (size_t i = 0; i < numLandmarks; ++i)
+  {
+    auto const landmark = FindFarthestPoint(minWeights);
+    if (find(landmarks.cbegin(), landmarks.cend(), landmark) != landmarks.cend())
+      break;
+
+    landmarks.push_back(landmark);
+    pointsGraph.CalcWeights(landmark, true /* isOutgoing */, fromLandmark);
+    pointsGraph.CalcWeights(landmark, false /* isOutgoing */, toLandmark);
+
+    for (uint32_t point = 0; point < numPoints; ++point)
+    {
+      fromLandmarks[point * numLandmarks + i] = ToStoredWeight(fromLandmark[point]);
+      toLandmarks[point * numLandmarks + i] = ToStoredWeight(toLandmark[point]);
+      minWeights[point] = min(minWeights[point], fromLandmark[point]);
+    }
+  }
+
+  // Fewer landmarks may be found in a small graph.
+  if (landmarks.size() < numLandmarks)
+  {
+    auto const shrink = [&](vector<uint16_t> & weights)
+    {
+      vector<uint16_t> result;
+      result.reserve(numPoints * landmarks.size());
+      for (uint32_t point = 0; point < numPoints; ++point)
+      {
+        auto const row = weights.cbegin() + point * numLandmarks;
+        result.insert(result.end(), row, row + landmarks.size());
+      }
+      weights = std::move(result);
+    };
+    shrink(fromLandmarks);
+    shrink(toLandmarks);
+  }
+
+  vector<RoadPoint> landmarkPoints;
+  for (auto const landmark : landmarks)
+    landmarkPoints.push_back(pointsGraph.GetRoadPoint(landmark));
+
+  LOG(LINFO, ("Points count =", numPoints, "Biggest component points count =", maxReached,
+              "Landmarks =", landmarkPoints));
+  auto featureIds = pointsGraph.GetFeatureIds();
+  auto firstPoints = pointsGraph.GetFirstPoints();
+  return RoutingLandmarks(std::move(landmarkPoints), std::move(featureIds), std::move(firstPoints),
+                          std::move(fromLandmarks), std::move(toLandmarks));
+}
+}  // namespace routing
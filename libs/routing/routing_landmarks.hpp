@@ -0,0 +1,257 @@
+#pragma once
+
+#include "routing/road_point.hpp"
+#include "routing/routing_exceptions.hpp"
+#include "routing/segment.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace routing
+{
+class IndexGraph;
+
+/// \brief Landmark distance table of one mwm for ALT (A*, landmarks, triangle inequality) lower
+/// bounds of route weight. See LandmarksHeuristic for the query side.
+/// Weights are calculated on the road graph of the mwm without restrictions, road access and
+/// penalties. Every segment weight is rounded down to whole seconds before the shortest paths are
+/// found, so the table keeps exact shortest path weights of a graph whose edges are never heavier
+/// than the edges of the routing graph. It makes the bounds consistent, not just admissible.
+/// For every road point and every landmark the table keeps weights from the landmark to the point
+/// and from the point to the landmark.
+class RoutingLandmarks
+{
+public:
+  static uint16_t constexpr kVersion = 1;
+  /// Weights are stored in seconds. Weights of unreachable points and weights which are greater
+  /// than |kMaxWeight| are stored as |kMaxWeight|. Saturated weights keep the bounds consistent.
+  static uint16_t constexpr kMaxWeight = std::numeric_limits<uint16_t>::max();
+
+  RoutingLandmarks() = default;
+  /// \param firstPoints holds the index of the first point of every feature of |featureIds| and
+  /// the number of points at the end. |fromLandmarks| and |toLandmarks| are row-major points x
+  /// landmarks matrices.
+  RoutingLandmarks(std::vector<RoadPoint> && landmarks, std::vector<uint32_t> && featureIds,
+                   std::vector<uint32_t> && firstPoints, std::vector<uint16_t> && fromLandmarks,
+                   std::vector<uint16_t> && toLandmarks);
+
+  size_t GetNumLandmarks() const { return m_landmarks.size(); }
+  std::vector<RoadPoint> const & GetLandmarks() const { return m_landmarks; }
+  size_t GetNumFeatures() const { return m_featureIds.size(); }
+
+  /// \returns GetNumLandmarks() weights from landmarks to |point| or nullptr if the point is not
+  /// in the table.
+  uint16_t const * GetFromLandmarks(RoadPoint const & point) const { return GetRow(m_fromLandmarks, point); }
+  /// \returns GetNumLandmarks() weights from |point| to landmarks or nullptr if the point is not
+  /// in the table.
+  uint16_t const * GetToLandmarks(RoadPoint const & point) const { return GetRow(m_toLandmarks, point); }
+
+  // Weights of neighbouring points of a feature are close, so they are stored as differences.
+  template <typename Sink>
+  void Serialize(Sink & sink) const
+  {
+    WriteVarUint(sink, base::checked_cast<uint32_t>(m_landmarks.size()));
+    for (auto const & landmark : m_landmarks)
+    {
+      WriteVarUint(sink, landmark.GetFeatureId());
+      WriteVarUint(sink, landmark.GetPointId());
+    }
+
+    WriteVarUint(sink, base::checked_cast<uint32_t>(m_featureIds.size()));
+    uint32_t prevFeatureId = 0;
+    for (size_t i = 0; i < m_featureIds.size(); ++i)
+    {
+      WriteVarUint(sink, m_featureIds[i] - prevFeatureId);
+      WriteVarUint(sink, m_firstPoints[i + 1] - m_firstPoints[i]);
+      prevFeatureId = m_featureIds[i];
+    }
+
+    std::vector<uint16_t> prevFrom(m_landmarks.size());
+    std::vector<uint16_t> prevTo(m_landmarks.size());
+    for (size_t i = 0; i < m_featureIds.size(); ++i)
+    {
+      prevFrom.assign(prevFrom.size(), 0);
+      prevTo.assign(prevTo.size(), 0);
+      for (uint32_t point = m_firstPoints[i]; point < m_firstPoints[i + 1]; ++point)
+      {
+        for (size_t j = 0; j < m_landmarks.size(); ++j)
+        {
+          auto const k = point * m_landmarks.size() + j;
+          WriteVarInt(sink, int32_t{m_fromLandmarks[k]} - prevFrom[j]);
+          WriteVarInt(sink, int32_t{m_toLandmarks[k]} - prevTo[j]);
+          prevFrom[j] = m_fromLandmarks[k];
+          prevTo[j] = m_toLandmarks[k];
+        }
+      }
+    }
+  }
+
+  template <typename Source>
+  void Deserialize(Source & src)
+  {
+    m_landmarks.resize(ReadVarUint<uint32_t>(src));
+    for (auto & landmark : m_landmarks)
+    {
+      auto const featureId = ReadVarUint<uint32_t>(src);
+      auto const pointId = ReadVarUint<uint32_t>(src);
+      landmark = RoadPoint(featureId, pointId);
+    }
+
+    m_featureIds.resize(ReadVarUint<uint32_t>(src));
+    m_firstPoints.assign(1, 0);
+    uint32_t prevFeatureId = 0;
+    for (auto & featureId : m_featureIds)
+    {
+      featureId = prevFeatureId + ReadVarUint<uint32_t>(src);
+      m_firstPoints.push_back(m_firstPoints.back() + ReadVarUint<uint32_t>(src));
+      prevFeatureId = featureId;
+    }
+
+    m_fromLandmarks.resize(static_cast<size_t>(m_firstPoints.back()) * m_landmarks.size());
+    m_toLandmarks.resize(m_fromLandmarks.size());
+    std::vector<int32_t> prevFrom(m_landmarks.size());
+    std::vector<int32_t> prevTo(m_landmarks.size());
+    for (size_t i = 0; i < m_featureIds.size(); ++i)
+    {
+      prevFrom.assign(prevFrom.size(), 0);
+      prevTo.assign(prevTo.size(), 0);
+      for (uint32_t point = m_firstPoints[i]; point < m_firstPoints[i + 1]; ++point)
+      {
+        for (size_t j = 0; j < m_landmarks.size(); ++j)
+        {
+          auto const k = point * m_landmarks.size() + j;
+          prevFrom[j] += ReadVarInt<int32_t>(src);
+          prevTo[j] += ReadVarInt<int32_t>(src);
+          m_fromLandmarks[k] = base::checked_cast<uint16_t>(prevFrom[j]);
+          m_toLandmarks[k] = base::checked_cast<uint16_t>(prevTo[j]);
+        }
+      }
+    }
+  }
+
+private:
+  uint16_t const * GetRow(std::vector<uint16_t> const & matrix, RoadPoint const & point) const
+  {
+    auto const it = std::lower_bound(m_featureIds.cbegin(), m_featureIds.cend(), point.GetFeatureId());
+    if (it == m_featureIds.cend() || *it != point.GetFeatureId())
+      return nullptr;
+
+    auto const featureIdx = static_cast<size_t>(std::distance(m_featureIds.cbegin(), it));
+    auto const pointIdx = m_firstPoints[featureIdx] + point.GetPointId();
+    if (pointIdx >= m_firstPoints[featureIdx + 1])
+      return nullptr;
+
+    return matrix.data() + static_cast<size_t>(pointIdx) * m_landmarks.size();
+  }
+
+  std::vector<RoadPoint> m_landmarks;
+  // Sorted ids of road features.
+  std::vector<uint32_t> m_featureIds;
+  // Index of the first point of every feature and the total number of points at the end.
+  std::vector<uint32_t> m_firstPoints = {0};
+  std::vector<uint16_t> m_fromLandmarks;
+  std::vector<uint16_t> m_toLandmarks;
+};
+
+/// \brief ROUTING_LANDMARKS_FILE_TAG section keeps tables for several vehicle types:
+/// version, number of tables and then vehicle type, table size in bytes and the table itself
+/// for every table, so a reader may skip tables of other vehicle types.
+template <typename Sink>
+void SerializeRoutingLandmarksSection(Sink & sink,
+                                      std::vector<std::pair<VehicleType, RoutingLandmarks>> const & tables)
+{
+  WriteToSink(sink, RoutingLandmarks::kVersion);
+  WriteToSink(sink, base::checked_cast<uint8_t>(tables.size()));
+  for (auto const & [vehicleType, landmarks] : tables)
+  {
+    std::vector<uint8_t> buffer;
+    MemWriter<std::vector<uint8_t>> writer(buffer);
+    landmarks.Serialize(writer);
+
+    WriteToSink(sink, static_cast<uint8_t>(vehicleType));
+    WriteToSink(sink, base::checked_cast<uint32_t>(buffer.size()));
+    sink.Write(buffer.data(), buffer.size());
+  }
+}
+
+/// \returns false if the section has no table for |vehicleType|.
+template <typename Source>
+bool DeserializeRoutingLandmarksSection(Source & src, VehicleType vehicleType, RoutingLandmarks & landmarks)
+{
+  auto const version = ReadPrimitiveFromSource<uint16_t>(src);
+  if (version != RoutingLandmarks::kVersion)
+    MYTHROW(CorruptedDataException, ("Unknown routing landmarks section version:", version));
+
+  auto const tablesCount = ReadPrimitiveFromSource<uint8_t>(src);
+  for (uint8_t i = 0; i < tablesCount; ++i)
+  {
+    auto const tableVehicleType = static_cast<VehicleType>(ReadPrimitiveFromSource<uint8_t>(src));
+    auto const tableSize = ReadPrimitiveFromSource<uint32_t>(src);
+    if (tableVehicleType == vehicleType)
+    {
+      landmarks.Deserialize(src);
+      return true;
+    }
+
+    src.Skip(tableSize);
+  }
+  return false;
+}
+
+/// \brief ALT lower bounds of route weight from the route start and to the route finish inside
+/// one mwm. For landmark L and segment v the triangle inequality gives
+/// w(v, t) >= w(L, t) - w(L, v) and w(v, t) >= w(v, L) - w(t, L),
+/// the maximum over all the landmarks is returned. The bounds are consistent on the segments of
+/// the mwm, see RoutingLandmarks.
+class LandmarksHeuristic
+{
+public:
+  /// \param startPoints and |finishPoints| are ends of the segments the route endings are projected to.
+  LandmarksHeuristic(RoutingLandmarks const & landmarks, NumMwmId mwmId, std::vector<RoadPoint> const & startPoints,
+                     std::vector<RoadPoint> const & finishPoints);
+
+  /// \returns lower bound of weight from the front of |segment| to the finish.
+  /// Zero for segments of other mwms and features out of the table.
+  double GetWeightToFinish(Segment const & segment) const { return CalcWeight(segment, true /* toFinish */); }
+  /// \returns lower bound of weight from the start to the front of |segment|.
+  double GetWeightFromStart(Segment const & segment) const { return CalcWeight(segment, false /* toFinish */); }
+
+private:
+  // Bounds of weights between landmarks and all the points of a route ending.
+  // Unknown minimums are zero and unknown maximums are RoutingLandmarks::kMaxWeight.
+  struct EndingWeights
+  {
+    EndingWeights(RoutingLandmarks const & landmarks, std::vector<RoadPoint> const & points);
+
+    std::vector<int32_t> m_fromMin;
+    std::vector<int32_t> m_fromMax;
+    std::vector<int32_t> m_toMin;
+    std::vector<int32_t> m_toMax;
+  };
+
+  double CalcWeight(Segment const & segment, bool toFinish) const;
+
+  RoutingLandmarks const & m_landmarks;
+  NumMwmId const m_mwmId;
+  EndingWeights const m_start;
+  EndingWeights const m_finish;
+};
+
+/// \brief Chooses |numLandmarks| landmarks of |graph| with the farthest point heuristic and
+/// calculates the table. |mwmId| is used for segments passed to the edge estimator only.
+RoutingLandmarks BuildRoutingLandmarks(IndexGraph & graph, NumMwmId mwmId, size_t numLandmarks);
+}  // namespace routing
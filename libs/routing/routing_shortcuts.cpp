@@ -0,0 +1,209 @@
+#include "routing/routing_shortcuts.hpp"
+
+#include "routing/base/astar_algorithm.hpp"
+
+#include "base/logging.hpp"
+#include "base/stl_helpers.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace routing
+{
+using namespace std;
+
+namespace
+{
+double GetCoord(ms::LatLon const & point, RoutingShortcuts::Split::Axis axis)
+{
+  return axis == RoutingShortcuts::Split::Axis::Lat ? point.m_lat : point.m_lon;
+}
+
+void BuildSplitsImpl(size_t nodeIdx, vector<ms::LatLon>::iterator begin, vector<ms::LatLon>::iterator end,
+                     vector<RoutingShortcuts::Split> & splits)
+{
+  using Split = RoutingShortcuts::Split;
+
+  if (nodeIdx >= splits.size())
+    return;
+
+  Split & split = splits[nodeIdx];
+  if (begin != end)
+  {
+    auto const [minLat, maxLat] = minmax_element(begin, end, base::LessBy(&ms::LatLon::m_lat));
+    auto const [minLon, maxLon] = minmax_element(begin, end, base::LessBy(&ms::LatLon::m_lon));
+    split.m_axis = maxLat->m_lat - minLat->m_lat >= maxLon->m_lon - minLon->m_lon ? Split::Axis::Lat : Split::Axis::Lon;
+
+    auto const median = begin + distance(begin, end) / 2;
+    nth_element(begin, median, end, [axis = split.m_axis](ms::LatLon const & lhs, ms::LatLon const & rhs)
+    { return GetCoord(lhs, axis) < GetCoord(rhs, axis); });
+    split.m_value = static_cast<int32_t>(lround(GetCoord(*median, split.m_axis) * RoutingShortcuts::kCoordScale));
+  }
+
+  // Points are distributed with the same rule as GetCell() uses, not by the median position,
+  // because of the split value rounding.
+  auto const middle = partition(begin, end, [&split](ms::LatLon const & point)
+  { return GetCoord(point, split.m_axis) < split.GetValue(); });
+
+  BuildSplitsImpl(2 * nodeIdx + 1, begin, middle, splits);
+  BuildSplitsImpl(2 * nodeIdx + 2, middle, end, splits);
+}
+}  // namespace
+
+RoutingShortcuts::RoutingShortcuts(vector<Split> && splits, vector<Cell> && cells)
+  : m_splits(std::move(splits))
+  , m_cells(std::move(cells))
+{
+  CHECK_EQUAL(m_cells.size(), m_splits.size() + 1, ());
+  BuildIndex();
+}
+
+// static
+vector<RoutingShortcuts::Split> RoutingShortcuts::BuildSplits(vector<ms::LatLon> & points, size_t maxPointsInCell)
+{
+  CHECK_GREATER(maxPointsInCell, 0, ());
+
+  size_t depth = 0;
+  while ((points.size() >> depth) > maxPointsInCell)
+    ++depth;
+
+  vector<Split> splits((size_t{1} << depth) - 1);
+  BuildSplitsImpl(0 /* nodeIdx */, points.begin(), points.end(), splits);
+  return splits;
+}
+
+// static
+RoutingShortcuts::CellId RoutingShortcuts::GetCell(vector<Split> const & splits, ms::LatLon const & point)
+{
+  size_t nodeIdx = 0;
+  while (nodeIdx < splits.size())
+  {
+    Split const & split = splits[nodeIdx];
+    nodeIdx = GetCoord(point, split.m_axis) < split.GetValue() ? 2 * nodeIdx + 1 : 2 * nodeIdx + 2;
+  }
+  return base::asserted_cast<CellId>(nodeIdx - splits.size());
+}
+
+void RoutingShortcuts::BuildIndex()
+{
+  m_enters.clear();
+  m_exits.clear();
+  for (CellId cellId = 0; cellId < m_cells.size(); ++cellId)
+  {
+    Cell const & cell = m_cells[cellId];
+    for (uint32_t i = 0; i < cell.GetNumEnters(); ++i)
+      CHECK(m_enters.emplace(cell.m_enters[i], Position{cellId, i}).second, ("Duplicated enter", cell.m_enters[i]));
+    for (uint32_t i = 0; i < cell.GetNumExits(); ++i)
+      CHECK(m_exits.emplace(cell.m_exits[i], Position{cellId, i}).second, ("Duplicated exit", cell.m_exits[i]));
+  }
+}
+
+RoutingShortcuts BuildRoutingShortcuts(IndexGraph & graph, NumMwmId mwmId, size_t maxPointsInCell)
+{
+  vector<ms::LatLon> points;
+  graph.ForEachRoad([&](uint32_t featureId, RoadJointIds const &)
+  {
+    auto const & road = graph.GetRoadGeometry(featureId);
+    for (uint32_t i = 0; i < road.GetPointsCount(); ++i)
+      points.push_back(road.GetPoint(i));
+  });
+
+  using CellId = RoutingShortcuts::CellId;
+  auto splits = RoutingShortcuts::BuildSplits(points, maxPointsInCell);
+  vector<RoutingShortcuts::Cell> cells(splits.size() + 1);
+
+  // A segment with ends in different cells is an exit of the cell of its back point
+  // and an enter of the cell of its front point.
+  graph.ForEachRoad([&](uint32_t featureId, RoadJointIds const &)
+  {
+    auto const & road = graph.GetRoadGeometry(featureId);
+    if (!road.IsValid())
+      return;
+
+    for (uint32_t i = 0; i + 1 < road.GetPointsCount(); ++i)
+    {
+      CellId const cell0 = RoutingShortcuts::GetCell(splits, road.GetPoint(i));
+      CellId const cell1 = RoutingShortcuts::GetCell(splits, road.GetPoint(i + 1));
+      if (cell0 == cell1)
+        continue;
+
+      Segment const forward(mwmId, featureId, i, true /* forward */);
+      cells[cell0].m_exits.push_back(forward);
+      cells[cell1].m_enters.push_back(forward);
+      if (road.IsOneWay())
+        continue;
+
+      cells[cell1].m_exits.push_back(forward.GetReversed());
+      cells[cell0].m_enters.push_back(forward.GetReversed());
+    }
+  });
+
+  using Algorithm = AStarAlgorithm<Segment, SegmentEdge, RouteWeight>;
+  Algorithm const astar;
+  size_t shortcutsCount = 0;
+  size_t badWeightsCount = 0;
+  for (CellId cellId = 0; cellId < cells.size(); ++cellId)
+  {
+    auto & cell = cells[cellId];
+    base::SortUnique(cell.m_enters);
+    base::SortUnique(cell.m_exits);
+    cell.m_weights.assign(static_cast<size_t>(cell.GetNumEnters()) * cell.GetNumExits(), connector::kNoRouteStored);
+
+    ShortcutCellGraph cellGraph(graph, splits, cellId);
+    Algorithm::Context context(cellGraph);
+    for (uint32_t enterIdx = 0; enterIdx < cell.GetNumEnters(); ++enterIdx)
+    {
+      astar.PropagateWave(cellGraph, cell.m_enters[enterIdx], [](Segment const &) { return true; }, context);
+
+      for (uint32_t exitIdx = 0; exitIdx < cell.GetNumExits(); ++exitIdx)
+      {
+        Segment const & exit = cell.m_exits[exitIdx];
+        if (!context.HasDistance(exit))
+          continue;
+
+        // Shortcuts through a change of road access or pass-through type are not stored.
+        double const weight = context.GetDistance(exit).ToCrossMwmWeight();
+        if (weight == connector::kNoRoute)
+        {
+          ++badWeightsCount;
+          continue;
+        }
+
+        cell.m_weights[static_cast<size_t>(enterIdx) * cell.GetNumExits() + exitIdx] =
+            RoutingShortcuts::ToStoredWeight(weight);
+        ++shortcutsCount;
+      }
+    }
+
+    if (cellId % 100 == 0)
+      LOG(LINFO, ("Building shortcuts:", cellId, "/", cells.size(), "cells passed"));
+  }
+
+  LOG(LINFO, ("Points count =", points.size(), "Cells count =", cells.size(), "Shortcuts count =", shortcutsCount,
+              "Bad weights count =", badWeightsCount));
+  return RoutingShortcuts(std::move(splits), std::move(cells));
+}
+
+void ShortcutCellGraph::GetOutgoingEdgesList(astar::VertexData<Vertex, Weight> const & vertexData, EdgeListT & edges)
+{
+  GetEdgesList(vertexData, true /* isOutgoing */, edges);
+}
+
+void ShortcutCellGraph::GetIngoingEdgesList(astar::VertexData<Vertex, Weight> const & vertexData, EdgeListT & edges)
+{
+  GetEdgesList(vertexData, false /* isOutgoing */, edges);
+}
+
+void ShortcutCellGraph::GetEdgesList(astar::VertexData<Vertex, Weight> const & vertexData, bool isOutgoing,
+                                     EdgeListT & edges)
+{
+  edges.clear();
+
+  // The wave leaves the cell through an exit (an enter for the ingoing wave) and stops there.
+  if (!IsInCell(vertexData.m_vertex, isOutgoing /* front */))
+    return;
+
+  CHECK(m_AStarParents, ());
+  m_graph.GetEdgeList(vertexData.m_vertex, isOutgoing, true /* useRoutingOptions */, edges, *m_AStarParents);
+}
+}  // namespace routing
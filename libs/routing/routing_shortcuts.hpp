@@ -0,0 +1,287 @@
+#pragma once
+
+#include "routing/base/astar_graph.hpp"
+#include "routing/base/astar_vertex_data.hpp"
+#include "routing/cross_mwm_connector.hpp"
+#include "routing/index_graph.hpp"
+#include "routing/route_weight.hpp"
+#include "routing/routing_exceptions.hpp"
+#include "routing/segment.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "geometry/latlon.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace routing
+{
+/// \brief Overlay of precomputed shortcuts for car routing inside one mwm
+/// (ROUTING_SHORTCUTS_FILE_TAG section).
+/// Road points of the mwm are split into cells by a kd-tree of median cuts. Segments with ends in
+/// different cells are cut segments: such a segment is an exit of the cell of its back point and
+/// an enter of the cell of its front point. Every cell keeps the weights of the best paths inside
+/// the cell from each of its enters to each of its exits, so a route may jump over a cell which
+/// contains none of the route endings. See ShortcutsGraph for the query side.
+class RoutingShortcuts
+{
+public:
+  using CellId = uint32_t;
+
+  static uint16_t constexpr kVersion = 0;
+  static CellId constexpr kInvalidCellId = std::numeric_limits<CellId>::max();
+  // Split coordinates are stored in 1e-6 degree units.
+  static double constexpr kCoordScale = 1e6;
+  // Weights are stored in tenths of a second and are rounded up, so shortcuts never look shorter
+  // than the paths they stand for and A* heuristic stays consistent.
+  static double constexpr kWeightScale = 10.0;
+
+  struct Split
+  {
+    enum class Axis : uint8_t
+    {
+      Lat = 0,
+      Lon = 1,
+    };
+
+    double GetValue() const { return static_cast<double>(m_value) / kCoordScale; }
+
+    Axis m_axis = Axis::Lat;
+    int32_t m_value = 0;
+  };
+
+  struct Cell
+  {
+    uint32_t GetNumEnters() const { return base::asserted_cast<uint32_t>(m_enters.size()); }
+    uint32_t GetNumExits() const { return base::asserted_cast<uint32_t>(m_exits.size()); }
+
+    connector::Weight GetWeight(uint32_t enterIdx, uint32_t exitIdx) const
+    {
+      ASSERT_LESS(enterIdx, m_enters.size(), ());
+      ASSERT_LESS(exitIdx, m_exits.size(), ());
+      return m_weights[static_cast<size_t>(enterIdx) * m_exits.size() + exitIdx];
+    }
+
+    std::vector<Segment> m_enters;
+    std::vector<Segment> m_exits;
+    // Row-major |m_enters| x |m_exits| matrix. connector::kNoRouteStored if there is no path inside
+    // the cell or the path changes road access or pass-through type.
+    std::vector<connector::Weight> m_weights;
+  };
+
+  RoutingShortcuts() = default;
+  RoutingShortcuts(std::vector<Split> && splits, std::vector<Cell> && cells);
+
+  /// \brief Builds a kd-tree which splits |points| into cells with no more than |maxPointsInCell|
+  /// points each. The tree is stored as an implicit complete binary tree: children of node |i|
+  /// are |2 * i + 1| and |2 * i + 2|, leaves are cells.
+  /// \note |points| are reordered.
+  static std::vector<Split> BuildSplits(std::vector<ms::LatLon> & points, size_t maxPointsInCell);
+  /// \returns cell of |point| according to |splits| built with BuildSplits().
+  static CellId GetCell(std::vector<Split> const & splits, ms::LatLon const & point);
+
+  static connector::Weight ToStoredWeight(double weight)
+  {
+    ASSERT_GREATER_OR_EQUAL(weight, 0.0, ());
+    // Zero is reserved for connector::kNoRouteStored.
+    return base::asserted_cast<connector::Weight>(static_cast<uint64_t>(std::ceil(weight * kWeightScale))) + 1;
+  }
+
+  static double FromStoredWeight(connector::Weight weight)
+  {
+    ASSERT_NOT_EQUAL(weight, connector::kNoRouteStored, ());
+    return static_cast<double>(weight - 1) / kWeightScale;
+  }
+
+  CellId GetCell(ms::LatLon const & point) const { return GetCell(m_splits, point); }
+  size_t GetNumCells() const { return m_cells.size(); }
+  Cell const & GetCellData(CellId cellId) const
+  {
+    ASSERT_LESS(cellId, m_cells.size(), ());
+    return m_cells[cellId];
+  }
+
+  std::vector<Split> const & GetSplits() const { return m_splits; }
+
+  bool IsEnter(Segment const & segment) const { return m_enters.count(segment) != 0; }
+  bool IsExit(Segment const & segment) const { return m_exits.count(segment) != 0; }
+
+  /// \brief Calls |fn(exit, weight)| for every shortcut from cut segment |enter| through its cell.
+  template <typename Fn>
+  void ForEachShortcutFrom(Segment const & enter, Fn && fn) const
+  {
+    auto const it = m_enters.find(enter);
+    if (it == m_enters.cend())
+      return;
+
+    Cell const & cell = m_cells[it->second.m_cellId];
+    for (uint32_t exitIdx = 0; exitIdx < cell.GetNumExits(); ++exitIdx)
+    {
+      auto const weight = cell.GetWeight(it->second.m_idx, exitIdx);
+      if (weight != connector::kNoRouteStored)
+        fn(cell.m_exits[exitIdx], RouteWeight(FromStoredWeight(weight)));
+    }
+  }
+
+  /// \brief Calls |fn(enter, weight)| for every shortcut to cut segment |exit| through its cell.
+  template <typename Fn>
+  void ForEachShortcutTo(Segment const & exit, Fn && fn) const
+  {
+    auto const it = m_exits.find(exit);
+    if (it == m_exits.cend())
+      return;
+
+    Cell const & cell = m_cells[it->second.m_cellId];
+    for (uint32_t enterIdx = 0; enterIdx < cell.GetNumEnters(); ++enterIdx)
+    {
+      auto const weight = cell.GetWeight(enterIdx, it->second.m_idx);
+      if (weight != connector::kNoRouteStored)
+        fn(cell.m_enters[enterIdx], RouteWeight(FromStoredWeight(weight)));
+    }
+  }
+
+  template <typename Sink>
+  void Serialize(Sink & sink) const
+  {
+    WriteToSink(sink, kVersion);
+    WriteToSink(sink, base::checked_cast<uint32_t>(m_splits.size()));
+    for (auto const & split : m_splits)
+    {
+      WriteToSink(sink, static_cast<uint8_t>(split.m_axis));
+      WriteToSink(sink, split.m_value);
+    }
+
+    CHECK_EQUAL(m_cells.size(), m_splits.size() + 1, ());
+    for (auto const & cell : m_cells)
+    {
+      WriteVarUint(sink, cell.GetNumEnters());
+      WriteVarUint(sink, cell.GetNumExits());
+      for (auto const & segment : cell.m_enters)
+        SerializeSegment(sink, segment);
+      for (auto const & segment : cell.m_exits)
+        SerializeSegment(sink, segment);
+
+      CHECK_EQUAL(cell.m_weights.size(), static_cast<size_t>(cell.GetNumEnters()) * cell.GetNumExits(), ());
+      for (auto const weight : cell.m_weights)
+        WriteVarUint(sink, weight);
+    }
+  }
+
+  template <typename Source>
+  void Deserialize(Source & src, NumMwmId numMwmId)
+  {
+    auto const version = ReadPrimitiveFromSource<uint16_t>(src);
+    if (version != kVersion)
+      MYTHROW(CorruptedDataException, ("Unknown routing shortcuts section version:", version));
+
+    m_splits.resize(ReadPrimitiveFromSource<uint32_t>(src));
+    for (auto & split : m_splits)
+    {
+      split.m_axis = static_cast<Split::Axis>(ReadPrimitiveFromSource<uint8_t>(src));
+      split.m_value = ReadPrimitiveFromSource<int32_t>(src);
+    }
+
+    m_cells.resize(m_splits.size() + 1);
+    for (auto & cell : m_cells)
+    {
+      cell.m_enters.resize(ReadVarUint<uint32_t>(src));
+      cell.m_exits.resize(ReadVarUint<uint32_t>(src));
+      for (auto & segment : cell.m_enters)
+        segment = DeserializeSegment(src, numMwmId);
+      for (auto & segment : cell.m_exits)
+        segment = DeserializeSegment(src, numMwmId);
+
+      cell.m_weights.resize(static_cast<size_t>(cell.GetNumEnters()) * cell.GetNumExits());
+      for (auto & weight : cell.m_weights)
+        weight = ReadVarUint<connector::Weight>(src);
+    }
+
+    BuildIndex();
+  }
+
+private:
+  struct Position
+  {
+    CellId m_cellId = kInvalidCellId;
+    // Index of the segment in |Cell::m_enters| or |Cell::m_exits|.
+    uint32_t m_idx = 0;
+  };
+
+  template <typename Sink>
+  static void SerializeSegment(Sink & sink, Segment const & segment)
+  {
+    WriteVarUint(sink, segment.GetFeatureId());
+    WriteVarUint(sink, (static_cast<uint64_t>(segment.GetSegmentIdx()) << 1) | (segment.IsForward() ? 1 : 0));
+  }
+
+  template <typename Source>
+  static Segment DeserializeSegment(Source & src, NumMwmId numMwmId)
+  {
+    auto const featureId = ReadVarUint<uint32_t>(src);
+    auto const segmentData = ReadVarUint<uint64_t>(src);
+    return {numMwmId, featureId, base::checked_cast<uint32_t>(segmentData >> 1), (segmentData & 1) != 0};
+  }
+
+  void BuildIndex();
+
+  std::vector<Split> m_splits;
+  std::vector<Cell> m_cells;
+  std::unordered_map<Segment, Position> m_enters;
+  std::unordered_map<Segment, Position> m_exits;
+};
+
+/// \brief Calculates shortcuts for all the roads of |graph|. Cells contain no more than
+/// |maxPointsInCell| road points. Segments of the result belong to |mwmId|.
+RoutingShortcuts BuildRoutingShortcuts(IndexGraph & graph, NumMwmId mwmId, size_t maxPointsInCell);
+
+/// \brief IndexGraph restricted to one cell of RoutingShortcuts: a wave stops at exits of the cell.
+/// It's used to calculate shortcut weights in generator and to unpack shortcuts of a found route.
+/// Edges are calculated without access:conditional, the same way in both places.
+class ShortcutCellGraph : public AStarGraph<Segment, SegmentEdge, RouteWeight>
+{
+public:
+  ShortcutCellGraph(IndexGraph & graph, std::vector<RoutingShortcuts::Split> const & splits,
+                    RoutingShortcuts::CellId cellId)
+    : m_graph(graph)
+    , m_splits(splits)
+    , m_cellId(cellId)
+  {}
+
+  // AStarGraph overrides:
+  // @{
+  void GetOutgoingEdgesList(astar::VertexData<Vertex, Weight> const & vertexData, EdgeListT & edges) override;
+  void GetIngoingEdgesList(astar::VertexData<Vertex, Weight> const & vertexData, EdgeListT & edges) override;
+  RouteWeight HeuristicCostEstimate(Segment const & /* from */, Segment const & /* to */) override
+  {
+    return GetAStarWeightZero<RouteWeight>();
+  }
+  void SetAStarParents(bool /* forward */, Parents & parents) override { m_AStarParents = &parents; }
+  void DropAStarParents() override { m_AStarParents = nullptr; }
+  RouteWeight GetAStarWeightEpsilon() override { return RouteWeight(0.0); }
+  // @}
+
+  bool IsInCell(Segment const & segment, bool front) const
+  {
+    return RoutingShortcuts::GetCell(m_splits, m_graph.GetPoint(segment, front)) == m_cellId;
+  }
+
+private:
+  void GetEdgesList(astar::VertexData<Vertex, Weight> const & vertexData, bool isOutgoing, EdgeListT & edges);
+
+  IndexGraph & m_graph;
+  std::vector<RoutingShortcuts::Split> const & m_splits;
+  RoutingShortcuts::CellId const m_cellId;
+  Parents * m_AStarParents = nullptr;
+};
+}  // namespace routing
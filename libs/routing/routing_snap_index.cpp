@@ -0,0 +1,125 @@
+#include "routing/routing_snap_index.hpp"
+
+#include "coding/endianness.hpp"
+
+#include "base/assert.hpp"
+
+#include <utility>
+
+namespace routing
+{
+using namespace std;
+
+RoutingSnapIndex::RoutingSnapIndex(unique_ptr<Reader> reader) : m_reader(std::move(reader))
+{
+  CHECK(m_reader, ());
+
+  if (m_reader->Size() < Header::kSize)
+    MYTHROW(CorruptedDataException, ("Routing snap section is too small:", m_reader->Size()));
+
+  m_header.m_version = ReadPrimitiveFromPos<uint16_t>(*m_reader, 0);
+  if (m_header.m_version != kVersion)
+    MYTHROW(CorruptedDataException, ("Unknown routing snap section version:", m_header.m_version));
+
+  m_header.m_cellBits = ReadPrimitiveFromPos<uint16_t>(*m_reader, 2);
+  m_header.m_featuresCount = ReadPrimitiveFromPos<uint32_t>(*m_reader, 4);
+  m_header.m_cellsCount = ReadPrimitiveFromPos<uint32_t>(*m_reader, 8);
+  m_header.m_entriesCount = ReadPrimitiveFromPos<uint32_t>(*m_reader, 12);
+
+  if (m_header.m_cellBits == 0 || m_header.m_cellBits >= kPointCoordBits)
+    MYTHROW(CorruptedDataException, ("Wrong cell bits of routing snap section:", m_header.m_cellBits));
+  if (m_reader->Size() != m_header.GetSize())
+    MYTHROW(CorruptedDataException, ("Wrong routing snap section size:", m_reader->Size(), m_header.GetSize()));
+}
+
+bool RoutingSnapIndex::IsOneWay(uint32_t featureId, VehicleType vehicleType) const
+{
+  if (featureId >= m_header.m_featuresCount)
+    return false;
+  return (ReadMask(m_header.GetOneWayMasksPos(), featureId) & GetMask(vehicleType)) != 0;
+}
+
+// static
+VehicleMask RoutingSnapIndex::GetMask(VehicleType vehicleType)
+{
+  // Transit routes go by pedestrian roads, see IndexRouter.
+  return GetVehicleMask(vehicleType == VehicleType::Transit ? VehicleType::Pedestrian : vehicleType);
+}
+
+void RoutingSnapIndex::FindRoads(m2::RectD const & rect, VehicleType vehicleType, vector<uint32_t> & featureIds) const
+{
+  featureIds.clear();
+  if (m_header.m_cellsCount == 0)
+    return;
+
+  auto const cellBits = m_header.m_cellBits;
+  auto const leftBottom = PointDToPointU(rect.LeftBottom(), kPointCoordBits);
+  auto const rightTop = PointDToPointU(rect.RightTop(), kPointCoordBits);
+
+  for (uint32_t x = leftBottom.x >> cellBits; x <= rightTop.x >> cellBits; ++x)
+  {
+    // Cells of a column are adjacent because x is the high part of a cell key.
+    uint64_t const lastKey = GetCellKey(x, rightTop.y >> cellBits);
+    uint32_t cell = LowerBoundCell(GetCellKey(x, leftBottom.y >> cellBits));
+    if (cell == m_header.m_cellsCount || ReadPrimitiveFromPos<uint64_t>(
+                                             *m_reader, m_header.GetCellKeysPos() + cell * sizeof(uint64_t)) > lastKey)
+    {
+      continue;
+    }
+
+    uint32_t const firstCell = cell;
+    while (cell < m_header.m_cellsCount &&
+           ReadPrimitiveFromPos<uint64_t>(*m_reader, m_header.GetCellKeysPos() + cell * sizeof(uint64_t)) <= lastKey)
+    {
+      ++cell;
+    }
+
+    auto const entriesBegin =
+        ReadPrimitiveFromPos<uint32_t>(*m_reader, m_header.GetEntryOffsetsPos() + firstCell * sizeof(uint32_t));
+    auto const entriesEnd =
+        ReadPrimitiveFromPos<uint32_t>(*m_reader, m_header.GetEntryOffsetsPos() + cell * sizeof(uint32_t));
+    if (entriesBegin > entriesEnd || entriesEnd > m_header.m_entriesCount)
+      MYTHROW(CorruptedDataException, ("Wrong entry offsets of cells", firstCell, cell, ":", entriesBegin, entriesEnd));
+
+    m_entries.resize(entriesEnd - entriesBegin);
+    if (!m_entries.empty())
+    {
+      m_reader->Read(m_header.GetEntriesPos() + entriesBegin * sizeof(uint32_t), m_entries.data(),
+                     m_entries.size() * sizeof(uint32_t));
+    }
+    for (auto const entry : m_entries)
+      featureIds.push_back(SwapIfBigEndianMacroBased(entry));
+  }
+
+  sort(featureIds.begin(), featureIds.end());
+  featureIds.erase(unique(featureIds.begin(), featureIds.end()), featureIds.end());
+
+  auto const mask = GetMask(vehicleType);
+  featureIds.erase(remove_if(featureIds.begin(), featureIds.end(), [&](uint32_t featureId)
+  {
+    if (featureId >= m_header.m_featuresCount)
+      MYTHROW(CorruptedDataException, ("Wrong feature id in routing snap section:", featureId));
+    return (ReadMask(m_header.GetRoadMasksPos(), featureId) & mask) == 0;
+  }), featureIds.end());
+}
+
+uint32_t RoutingSnapIndex::LowerBoundCell(uint64_t key) const
+{
+  uint32_t begin = 0;
+  uint32_t end = m_header.m_cellsCount;
+  while (begin < end)
+  {
+    uint32_t const middle = begin + (end - begin) / 2;
+    if (ReadPrimitiveFromPos<uint64_t>(*m_reader, m_header.GetCellKeysPos() + middle * sizeof(uint64_t)) < key)
+      begin = middle + 1;
+    else
+      end = middle;
+  }
+  return begin;
+}
+
+uint8_t RoutingSnapIndex::ReadMask(uint64_t pos, uint32_t featureId) const
+{
+  return ReadPrimitiveFromPos<uint8_t>(*m_reader, pos + featureId);
+}
+}  // namespace routing
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "routing/routing_exceptions.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "coding/point_coding.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace routing
+{
+/// \brief Spatial index of the roads of an mwm for snapping of route points to roads,
+/// ROUTING_SNAP_FILE_TAG section. Roads of a rect are found by a uniform grid over road segments
+/// instead of the feature covering. The index keeps no geometry: points of the found roads are
+/// read from ROUTING_GEOMETRY_FILE_TAG section, see RoutingGeometry.
+/// A cell is a square of 2^cellBits point coordinates, a road is in every cell its segments may cross.
+/// Cells are sorted by keys, so the cells of a grid column are found with one binary search.
+/// Numbers are little endian, the section consists of:
+/// * header: version, cell bits, features count, cells count and entries count;
+/// * uint8 road masks and then uint8 one way masks of every feature id, see VehicleMask;
+/// * uint64 sorted keys of the cells which have roads, see GetCellKey();
+/// * uint32 offsets of the first entry of every cell, cells count + 1 items;
+/// * uint32 sorted feature ids of the roads of every cell.
+class RoutingSnapIndex final
+{
+public:
+  static uint16_t constexpr kVersion = 0;
+  // 2^13 point coordinates are about 300 meters along the equator.
+  static uint16_t constexpr kDefaultCellBits = 13;
+
+  struct Road
+  {
+    VehicleMask m_roadMask = 0;
+    VehicleMask m_oneWayMask = 0;
+    std::vector<m2::PointD> m_points;
+  };
+
+  /// \param roads are roads by feature ids, every road has two points at least. The points are
+  /// used to find the cells of the roads and are not stored.
+  template <typename Sink>
+  static void Serialize(Sink & sink, std::map<uint32_t, Road> const & roads, uint16_t cellBits = kDefaultCellBits);
+
+  /// \brief Reads the header only, everything else is read from |reader| on queries.
+  explicit RoutingSnapIndex(std::unique_ptr<Reader> reader);
+
+  uint32_t GetFeaturesCount() const { return m_header.m_featuresCount; }
+  uint32_t GetCellsCount() const { return m_header.m_cellsCount; }
+
+  /// \brief Calls |fn(featureId)| once for every road of |vehicleType| which may cross |rect|.
+  /// \note Transit uses pedestrian roads.
+  template <typename Fn>
+  void ForEachRoadInRect(m2::RectD const & rect, VehicleType vehicleType, Fn && fn) const
+  {
+    FindRoads(rect, vehicleType, m_featureIds);
+    for (auto const featureId : m_featureIds)
+      fn(featureId);
+  }
+
+  bool IsOneWay(uint32_t featureId, VehicleType vehicleType) const;
+
+private:
+  struct Header
+  {
+    uint64_t GetRoadMasksPos() const { return kSize; }
+    uint64_t GetOneWayMasksPos() const { return GetRoadMasksPos() + m_featuresCount; }
+    uint64_t GetCellKeysPos() const { return GetOneWayMasksPos() + m_featuresCount; }
+    uint64_t GetEntryOffsetsPos() const { return GetCellKeysPos() + m_cellsCount * sizeof(uint64_t); }
+    uint64_t GetEntriesPos() const { return GetEntryOffsetsPos() + (m_cellsCount + 1) * sizeof(uint32_t); }
+    uint64_t GetSize() const { return GetEntriesPos() + m_entriesCount * sizeof(uint32_t); }
+
+    static uint64_t constexpr kSize = 16;
+
+    uint16_t m_version = kVersion;
+    uint16_t m_cellBits = kDefaultCellBits;
+    uint32_t m_featuresCount = 0;
+    uint32_t m_cellsCount = 0;
+    uint32_t m_entriesCount = 0;
+  };
+
+  static uint64_t GetCellKey(uint32_t cellX, uint32_t cellY) { return (static_cast<uint64_t>(cellX) << 32) | cellY; }
+
+  // Calls |fn(cellX, cellY)| for all the cells which segment [p1, p2] may cross.
+  template <typename Fn>
+  static void ForEachSegmentCell(m2::PointU const & p1, m2::PointU const & p2, uint16_t cellBits, Fn && fn);
+
+  static VehicleMask GetMask(VehicleType vehicleType);
+
+  void FindRoads(m2::RectD const & rect, VehicleType vehicleType, std::vector<uint32_t> & featureIds) const;
+  // Returns index of the first cell with key not less than |key|.
+  uint32_t LowerBoundCell(uint64_t key) const;
+  uint8_t ReadMask(uint64_t pos, uint32_t featureId) const;
+
+  std::unique_ptr<Reader> m_reader;
+  Header m_header;
+  // Buffers for reading, RoutingSnapIndex is used by one thread.
+  mutable std::vector<uint32_t> m_featureIds;
+  mutable std::vector<uint32_t> m_entries;
+};
+
+template <typename Fn>
+void RoutingSnapIndex::ForEachSegmentCell(m2::PointU const & p1, m2::PointU const & p2, uint16_t cellBits, Fn && fn)
+{
+  // A long segment is split into parts which are not longer than a cell, so the cells of the bounding
+  // rects of the parts are not far from the segment.
+  uint64_t const cellSize = uint64_t{1} << cellBits;
+  uint64_t const length = std::max(p1.x > p2.x ? p1.x - p2.x : p2.x - p1.x, p1.y > p2.y ? p1.y - p2.y : p2.y - p1.y);
+  uint64_t const partsCount = length / cellSize + 1;
+
+  auto const getPoint = [&](uint64_t part)
+  {
+    auto const interpolate = [&](uint32_t a, uint32_t b)
+    {
+      int64_t const delta = static_cast<int64_t>(b) - static_cast<int64_t>(a);
+      return static_cast<uint32_t>(a + delta * static_cast<int64_t>(part) / static_cast<int64_t>(partsCount));
+    };
+    return m2::PointU(interpolate(p1.x, p2.x), interpolate(p1.y, p2.y));
+  };
+
+  for (uint64_t part = 0; part < partsCount; ++part)
+  {
+    auto const begin = getPoint(part);
+    auto const end = getPoint(part + 1);
+    for (uint32_t x = std::min(begin.x, end.x) >> cellBits; x <= std::max(begin.x, end.x) >> cellBits; ++x)
+      for (uint32_t y = std::min(begin.y, end.y) >> cellBits; y <= std::max(begin.y, end.y) >> cellBits; ++y)
+        fn(x, y);
+  }
+}
+
+template <typename Sink>
+void RoutingSnapIndex::Serialize(Sink & sink, std::map<uint32_t, Road> const & roads, uint16_t cellBits)
+{
+  CHECK_GREATER(cellBits, 0, ());
+  CHECK_LESS(cellBits, kPointCoordBits, ());
+
+  std::map<uint64_t, std::vector<uint32_t>> cells;
+  Header header;
+  header.m_cellBits = cellBits;
+  header.m_featuresCount = roads.empty() ? 0 : roads.crbegin()->first + 1;
+  for (auto const & [featureId, road] : roads)
+  {
+    CHECK_GREATER_OR_EQUAL(road.m_points.size(), 2, (featureId));
+    CHECK_LESS_OR_EQUAL(road.m_roadMask | road.m_oneWayMask, 0xFF, (featureId));
+
+    for (size_t i = 1; i < road.m_points.size(); ++i)
+    {
+      ForEachSegmentCell(PointDToPointU(road.m_points[i - 1], kPointCoordBits),
+                         PointDToPointU(road.m_points[i], kPointCoordBits), cellBits, [&](uint32_t x, uint32_t y)
+      {
+        auto & cell = cells[GetCellKey(x, y)];
+        if (cell.empty() || cell.back() != featureId)
+          cell.push_back(featureId);
+      });
+    }
+  }
+
+  header.m_cellsCount = base::checked_cast<uint32_t>(cells.size());
+  for (auto const & [key, featureIds] : cells)
+    header.m_entriesCount += base::checked_cast<uint32_t>(featureIds.size());
+
+  WriteToSink(sink, header.m_version);
+  WriteToSink(sink, header.m_cellBits);
+  WriteToSink(sink, header.m_featuresCount);
+  WriteToSink(sink, header.m_cellsCount);
+  WriteToSink(sink, header.m_entriesCount);
+
+  auto const writeMasks = [&](auto const & getMask)
+  {
+    auto it = roads.cbegin();
+    for (uint32_t featureId = 0; featureId < header.m_featuresCount; ++featureId)
+    {
+      uint8_t mask = 0;
+      if (it != roads.cend() && it->first == featureId)
+      {
+        mask = static_cast<uint8_t>(getMask(it->second));
+        ++it;
+      }
+      WriteToSink(sink, mask);
+    }
+  };
+  writeMasks([](Road const & road) { return road.m_roadMask; });
+  writeMasks([](Road const & road) { return road.m_oneWayMask; });
+
+  for (auto const & [key, featureIds] : cells)
+    WriteToSink(sink, key);
+
+  uint32_t offset = 0;
+  for (auto const & [key, featureIds] : cells)
+  {
+    WriteToSink(sink, offset);
+    offset += base::checked_cast<uint32_t>(featureIds.size());
+  }
+  WriteToSink(sink, offset);
+
+  // Feature ids of a cell are sorted because |roads| are iterated by feature ids.
+  for (auto const & [key, featureIds] : cells)
+    for (auto const featureId : featureIds)
+      WriteToSink(sink, featureId);
+}
+}  // namespace routing
@@ -34,6 +34,13 @@ void TestAStar(UndirectedGraph & graph, vector<unsigned> const & expectedRoute,
   TEST_EQUAL(Algorithm::Result::OK, algo.FindPathBidirectional(params, actualRoute), ());
   TEST_EQUAL(expectedRoute, actualRoute.m_path, ());
   TEST_ALMOST_EQUAL_ULPS(expectedDistance, actualRoute.m_distance, ());
+
+  UndirectedGraph backwardGraph = graph;
+  Algorithm::ParamsForTests<> backwardParams(backwardGraph, 0u /* startVertex */, 4u /* finishVertex */);
+  actualRoute.m_path.clear();
+  TEST_EQUAL(Algorithm::Result::OK, algo.FindPathBidirectionalParallel(params, backwardParams, actualRoute), ());
+  TEST_EQUAL(expectedRoute, actualRoute.m_path, ());
+  TEST_ALMOST_EQUAL_ULPS(expectedDistance, actualRoute.m_distance, ());
 }
 
 UNIT_TEST(AStarAlgorithm_Sample)
@@ -79,6 +86,247 @@ UNIT_TEST(AStarAlgorithm_CheckLength)
   TEST_EQUAL(result, Algorithm::Result::NoPath, ());
 }
 
+UNIT_TEST(AStarAlgorithm_BidirectionalParallel)
+{
+  // Grid of |kSize| x |kSize| vertices with pseudo random weights of edges.
+  uint32_t constexpr kSize = 20;
+  UndirectedGraph graph;
+  uint32_t weight = 1;
+  for (uint32_t i = 0; i < kSize; ++i)
+  {
+    for (uint32_t j = 0; j < kSize; ++j)
+    {
+      weight = (weight * 37 + 11) % 23;
+      if (j + 1 < kSize)
+        graph.AddEdge(i * kSize + j, i * kSize + j + 1, 1 + weight);
+      weight = (weight * 37 + 11) % 23;
+      if (i + 1 < kSize)
+        graph.AddEdge(i * kSize + j, (i + 1) * kSize + j, 1 + weight);
+    }
+  }
+  UndirectedGraph backwardGraph = graph;
+
+  Algorithm algo;
+  uint32_t constexpr kVerticesCount = kSize * kSize;
+  for (uint32_t start = 0; start < kVerticesCount; start += 37)
+  {
+    for (uint32_t finish = 0; finish < kVerticesCount; finish += 41)
+    {
+      if (start == finish)
+        continue;
+
+      Algorithm::ParamsForTests<> params(graph, start, finish);
+      RoutingResult<uint32_t /* Vertex */, double /* Weight */> expected;
+      TEST_EQUAL(algo.FindPathBidirectional(params, expected), Algorithm::Result::OK, ());
+
+      Algorithm::ParamsForTests<> backwardParams(backwardGraph, start, finish);
+      RoutingResult<uint32_t /* Vertex */, double /* Weight */> actual;
+      TEST_EQUAL(algo.FindPathBidirectionalParallel(params, backwardParams, actual), Algorithm::Result::OK, ());
+
+      // Paths of the same weight may differ.
+      TEST_ALMOST_EQUAL_ULPS(actual.m_distance, expected.m_distance, (start, finish));
+      TEST_EQUAL(actual.m_path.front(), start, ());
+      TEST_EQUAL(actual.m_path.back(), finish, ());
+    }
+  }
+}
+
+UNIT_TEST(AStarAlgorithm_Storage)
+{
+  // Grid of |kSize| x |kSize| vertices with pseudo random weights of edges.
+  uint32_t constexpr kSize = 20;
+  UndirectedGraph graph;
+  uint32_t weight = 1;
+  for (uint32_t i = 0; i < kSize; ++i)
+  {
+    for (uint32_t j = 0; j < kSize; ++j)
+    {
+      weight = (weight * 37 + 11) % 23;
+      if (j + 1 < kSize)
+        graph.AddEdge(i * kSize + j, i * kSize + j + 1, 1 + weight);
+      weight = (weight * 37 + 11) % 23;
+      if (i + 1 < kSize)
+        graph.AddEdge(i * kSize + j, (i + 1) * kSize + j, 1 + weight);
+    }
+  }
+
+  Algorithm::Storage storage;
+  Algorithm::Storage smallStorage(0 /* maxKeptVertices */);
+  Algorithm algo;
+  Algorithm storageAlgo(storage);
+  Algorithm smallStorageAlgo(smallStorage);
+  uint32_t constexpr kVerticesCount = kSize * kSize;
+  for (uint32_t start = 0; start < kVerticesCount; start += 37)
+  {
+    for (uint32_t finish = 0; finish < kVerticesCount; finish += 41)
+    {
+      if (start == finish)
+        continue;
+
+      Algorithm::ParamsForTests<> params(graph, start, finish);
+      RoutingResult<uint32_t /* Vertex */, double /* Weight */> expected;
+      TEST_EQUAL(algo.FindPathBidirectional(params, expected), Algorithm::Result::OK, ());
+
+      // Waves of the previous searches are cleared.
+      RoutingResult<uint32_t /* Vertex */, double /* Weight */> actual;
+      TEST_EQUAL(storageAlgo.FindPathBidirectional(params, actual), Algorithm::Result::OK, ());
+      TEST_EQUAL(actual.m_path, expected.m_path, (start, finish));
+      TEST_ALMOST_EQUAL_ULPS(actual.m_distance, expected.m_distance, (start, finish));
+      TEST_GREATER(storage.GetQueueCapacity(true /* forward */), 0, ());
+
+      TEST_EQUAL(smallStorageAlgo.FindPathBidirectional(params, actual), Algorithm::Result::OK, ());
+      TEST_EQUAL(actual.m_path, expected.m_path, (start, finish));
+      // Memory of the waves which have reached any vertices is released.
+      TEST_EQUAL(smallStorage.GetQueueCapacity(true /* forward */), 0, ());
+      TEST_EQUAL(smallStorage.GetQueueCapacity(false /* forward */), 0, ());
+    }
+  }
+}
+
+UNIT_TEST(AStarAlgorithm_Alternatives)
+{
+  UndirectedGraph graph;
+
+  // Three routes from 0 to 5 of weights 30, 33 and 50.
+  graph.AddEdge(0, 1, 10);
+  graph.AddEdge(1, 2, 10);
+  graph.AddEdge(2, 5, 10);
+  graph.AddEdge(0, 3, 11);
+  graph.AddEdge(3, 4, 11);
+  graph.AddEdge(4, 5, 11);
+  graph.AddEdge(0, 6, 25);
+  graph.AddEdge(6, 5, 25);
+
+  Algorithm algo;
+  Algorithm::ParamsForTests<> params(graph, 0u /* startVertex */, 5u /* finishVertex */);
+
+  AlternativesParams alternativesParams;
+  alternativesParams.m_maxAlternatives = 2;
+  alternativesParams.m_maxExtraSearch = 10.0;
+
+  vector<RoutingResult<uint32_t /* Vertex */, double /* Weight */>> results;
+  TEST_EQUAL(algo.FindPathBidirectionalAlternatives(params, alternativesParams, results), Algorithm::Result::OK, ());
+  TEST_EQUAL(results.size(), 2, ());
+  TEST_EQUAL(results[0].m_path, vector<uint32_t>({0, 1, 2, 5}), ());
+  TEST_ALMOST_EQUAL_ULPS(results[0].m_distance, 30.0, ());
+  TEST_EQUAL(results[1].m_path, vector<uint32_t>({0, 3, 4, 5}), ());
+  TEST_ALMOST_EQUAL_ULPS(results[1].m_distance, 33.0, ());
+
+  // The route of weight 50 meets the weaker quality bound.
+  alternativesParams.m_maxStretch = 1.0;
+  TEST_EQUAL(algo.FindPathBidirectionalAlternatives(params, alternativesParams, results), Algorithm::Result::OK, ());
+  TEST_EQUAL(results.size(), 3, ());
+  TEST_EQUAL(results[2].m_path, vector<uint32_t>({0, 6, 5}), ());
+  TEST_ALMOST_EQUAL_ULPS(results[2].m_distance, 50.0, ());
+
+  // Only the best route is found if alternatives are switched off.
+  alternativesParams.m_maxAlternatives = 0;
+  TEST_EQUAL(algo.FindPathBidirectionalAlternatives(params, alternativesParams, results), Algorithm::Result::OK, ());
+  TEST_EQUAL(results.size(), 1, ());
+  TEST_EQUAL(results[0].m_path, vector<uint32_t>({0, 1, 2, 5}), ());
+}
+
+UNIT_TEST(AStarAlgorithm_AlternativesSharing)
+{
+  UndirectedGraph graph;
+
+  // The route through 4 differs from the best one by a short detour only.
+  graph.AddEdge(0, 1, 10);
+  graph.AddEdge(1, 2, 1);
+  graph.AddEdge(1, 4, 1);
+  graph.AddEdge(4, 2, 1);
+  graph.AddEdge(2, 3, 10);
+
+  Algorithm algo;
+  Algorithm::ParamsForTests<> params(graph, 0u /* startVertex */, 3u /* finishVertex */);
+
+  AlternativesParams alternativesParams;
+  alternativesParams.m_maxAlternatives = 2;
+  alternativesParams.m_maxExtraSearch = 10.0;
+
+  vector<RoutingResult<uint32_t /* Vertex */, double /* Weight */>> results;
+  TEST_EQUAL(algo.FindPathBidirectionalAlternatives(params, alternativesParams, results), Algorithm::Result::OK, ());
+  TEST_EQUAL(results.size(), 1, ());
+  TEST_EQUAL(results[0].m_path, vector<uint32_t>({0, 1, 2, 3}), ());
+
+  alternativesParams.m_maxSharing = 1.0;
+  TEST_EQUAL(algo.FindPathBidirectionalAlternatives(params, alternativesParams, results), Algorithm::Result::OK, ());
+  TEST_EQUAL(results.size(), 2, ());
+  TEST_EQUAL(results[1].m_path, vector<uint32_t>({0, 1, 4, 2, 3}), ());
+  TEST_ALMOST_EQUAL_ULPS(results[1].m_distance, 22.0, ());
+}
+
+UNIT_TEST(AStarAlgorithm_AlternativesGrid)
+{
+  uint32_t constexpr kSize = 20;
+  UndirectedGraph graph;
+  map<pair<uint32_t, uint32_t>, double> weights;
+  auto const addEdge = [&](uint32_t u, uint32_t v, double w)
+  {
+    graph.AddEdge(u, v, w);
+    weights[{u, v}] = w;
+    weights[{v, u}] = w;
+  };
+
+  uint32_t weight = 1;
+  for (uint32_t i = 0; i < kSize; ++i)
+  {
+    for (uint32_t j = 0; j < kSize; ++j)
+    {
+      weight = (weight * 37 + 11) % 23;
+      if (j + 1 < kSize)
+        addEdge(i * kSize + j, i * kSize + j + 1, 1 + weight);
+      weight = (weight * 37 + 11) % 23;
+      if (i + 1 < kSize)
+        addEdge(i * kSize + j, (i + 1) * kSize + j, 1 + weight);
+    }
+  }
+
+  AlternativesParams alternativesParams;
+  alternativesParams.m_maxAlternatives = 3;
+
+  Algorithm algo;
+  uint32_t constexpr kVerticesCount = kSize * kSize;
+  size_t alternativesCount = 0;
+  for (uint32_t start = 0; start < kVerticesCount; start += 37)
+  {
+    for (uint32_t finish = 0; finish < kVerticesCount; finish += 41)
+    {
+      if (start == finish)
+        continue;
+
+      Algorithm::ParamsForTests<> params(graph, start, finish);
+      RoutingResult<uint32_t /* Vertex */, double /* Weight */> expected;
+      TEST_EQUAL(algo.FindPathBidirectional(params, expected), Algorithm::Result::OK, ());
+
+      vector<RoutingResult<uint32_t /* Vertex */, double /* Weight */>> results;
+      TEST_EQUAL(algo.FindPathBidirectionalAlternatives(params, alternativesParams, results), Algorithm::Result::OK,
+                 ());
+      TEST_GREATER(results.size(), 0, ());
+      TEST_LESS_OR_EQUAL(results.size(), alternativesParams.m_maxAlternatives + 1, ());
+      TEST_ALMOST_EQUAL_ULPS(results[0].m_distance, expected.m_distance, (start, finish));
+
+      for (auto const & result : results)
+      {
+        TEST_EQUAL(result.m_path.front(), start, ());
+        TEST_EQUAL(result.m_path.back(), finish, ());
+        TEST_LESS_OR_EQUAL(result.m_distance, (1.0 + alternativesParams.m_maxStretch) * expected.m_distance, ());
+
+        double pathWeight = 0.0;
+        for (size_t i = 1; i < result.m_path.size(); ++i)
+        {
+          auto const it = weights.find({result.m_path[i - 1], result.m_path[i]});
+          TEST(it != weights.cend(), (start, finish, result.m_path));
+          pathWeight += it->second;
+        }
+        TEST_ALMOST_EQUAL_ABS(pathWeight, result.m_distance, 1e-6, (start, finish));
+      }
+      alternativesCount += results.size() - 1;
+    }
+  }
+  TEST_GREATER(alternativesCount, 0, ());
+}
+
 UNIT_TEST(AdjustRoute)
 {
   UndirectedGraph graph;
@@ -151,4 +399,119 @@ UNIT_TEST(AdjustRouteOutOfLimit)
   TEST_EQUAL(code, Algorithm::Result::NoPath, ());
   TEST(result.m_path.empty(), ());
 }
+
+size_t constexpr kMaxTreeSize = 100;
+
+UNIT_TEST(AdjustRouteBackwardTree)
+{
+  UndirectedGraph graph;
+
+  for (unsigned int i = 0; i < 5; ++i)
+    graph.AddEdge(i /* from */, i + 1 /* to */, 1 /* weight */);
+
+  graph.AddEdge(6, 3, 1);
+  graph.AddEdge(7, 6, 1);
+
+  // Each edge contains {vertexId, weight}.
+  vector<SimpleEdge> const prevRoute = {{0, 0}, {1, 1}, {2, 1}, {3, 1}, {4, 1}, {5, 1}};
+
+  auto checkLength = [](double weight) { return weight <= 1.0; };
+  Algorithm algo;
+  Algorithm::ParamsForTests<decltype(checkLength)> params(graph, 7 /* startVertex */, {} /* finishVertex */,
+                                                          std::move(checkLength));
+
+  // The route is out of the limit from the start, but the backward tree is not.
+  RoutingResult<unsigned /* Vertex */, double /* Weight */> result;
+  TEST_EQUAL(algo.AdjustRoute(params, prevRoute, result), Algorithm::Result::NoPath, ());
+
+  Algorithm::BackwardTree tree;
+  TEST_EQUAL(algo.BuildBackwardTree(params, prevRoute, 0 /* waveBeginIdx */, prevRoute.size() /* waveEndIdx */,
+                                    kMaxTreeSize, tree),
+             Algorithm::Result::OK, ());
+  TEST_EQUAL(tree.GetSize(), 7, ());
+  TEST_EQUAL(tree.GetDistance(6), 3.0, ());
+  TEST(!tree.GetDistance(7), ());
+
+  TEST_EQUAL(algo.AdjustRoute(params, tree, result), Algorithm::Result::OK, ());
+  vector<unsigned> const expectedRoute = {7, 6, 3, 4, 5};
+  TEST_EQUAL(result.m_path, expectedRoute, ());
+  TEST_EQUAL(result.m_distance, 4.0, ());
+
+  // The vertices which go to the finish through a removed one are removed too.
+  tree.RemoveIf([](unsigned vertex) { return vertex == 3; });
+  TEST_EQUAL(tree.GetSize(), 2, ());
+  TEST_EQUAL(tree.GetDistance(4), 1.0, ());
+}
+
+UNIT_TEST(AdjustRouteBackwardTreeShortcut)
+{
+  UndirectedGraph graph;
+
+  for (unsigned int i = 0; i < 5; ++i)
+    graph.AddEdge(i /* from */, i + 1 /* to */, 1 /* weight */);
+
+  graph.AddEdge(6, 1, 1);
+  graph.AddEdge(6, 5, 1);
+
+  // Each edge contains {vertexId, weight}.
+  vector<SimpleEdge> const prevRoute = {{0, 0}, {1, 1}, {2, 1}, {3, 1}, {4, 1}, {5, 1}};
+
+  auto checkLength = [](double weight) { return weight <= 2.0; };
+  Algorithm algo;
+  Algorithm::ParamsForTests<decltype(checkLength)> params(graph, 0 /* startVertex */, {} /* finishVertex */,
+                                                          std::move(checkLength));
+
+  // The backward tree finds a shorter way to the finish than the previous route.
+  Algorithm::BackwardTree tree;
+  TEST_EQUAL(algo.BuildBackwardTree(params, prevRoute, 0 /* waveBeginIdx */, prevRoute.size() /* waveEndIdx */,
+                                    kMaxTreeSize, tree),
+             Algorithm::Result::OK, ());
+  TEST_EQUAL(tree.GetDistance(1), 2.0, ());
+
+  RoutingResult<unsigned /* Vertex */, double /* Weight */> result;
+  TEST_EQUAL(algo.AdjustRoute(params, tree, result), Algorithm::Result::OK, ());
+  vector<unsigned> const expectedRoute = {0, 1, 6, 5};
+  TEST_EQUAL(result.m_path, expectedRoute, ());
+  TEST_EQUAL(result.m_distance, 3.0, ());
+}
+
+UNIT_TEST(AdjustRouteBackwardTreeLimits)
+{
+  UndirectedGraph graph;
+
+  for (unsigned int i = 0; i < 5; ++i)
+    graph.AddEdge(i /* from */, i + 1 /* to */, 1 /* weight */);
+
+  graph.AddEdge(6, 1, 1);
+  graph.AddEdge(7, 4, 1);
+  graph.AddEdge(8, 7, 1);
+
+  // Each edge contains {vertexId, weight}.
+  vector<SimpleEdge> const prevRoute = {{0, 0}, {1, 1}, {2, 1}, {3, 1}, {4, 1}, {5, 1}};
+
+  auto checkLength = [](double weight) { return weight <= 2.0; };
+  Algorithm algo;
+  Algorithm::ParamsForTests<decltype(checkLength)> params(graph, 8 /* startVertex */, {} /* finishVertex */,
+                                                          std::move(checkLength));
+
+  // The wave is propagated from vertices 3, 4 and 5 only, but the tree keeps all the route.
+  Algorithm::BackwardTree tree;
+  TEST_EQUAL(algo.BuildBackwardTree(params, prevRoute, 3 /* waveBeginIdx */, 6 /* waveEndIdx */, kMaxTreeSize, tree),
+             Algorithm::Result::OK, ());
+  TEST_EQUAL(tree.GetSize(), 8, ());
+  TEST(!tree.GetDistance(6), ());
+  TEST_EQUAL(tree.GetDistance(8), 3.0, ());
+
+  RoutingResult<unsigned /* Vertex */, double /* Weight */> result;
+  TEST_EQUAL(algo.AdjustRoute(params, tree, result), Algorithm::Result::OK, ());
+  vector<unsigned> const expectedRoute = {8, 7, 4, 5};
+  TEST_EQUAL(result.m_path, expectedRoute, ());
+
+  // The wave stops when the tree is full.
+  TEST_EQUAL(algo.BuildBackwardTree(params, prevRoute, 0 /* waveBeginIdx */, prevRoute.size() /* waveEndIdx */,
+                                    7 /* maxTreeSize */, tree),
+             Algorithm::Result::OK, ());
+  TEST_EQUAL(tree.GetSize(), 7, ());
+  TEST(!tree.GetDistance(8), ());
+}
 }  // namespace astar_algorithm_test
@@ -292,6 +292,71 @@ void TestWeightsSerialization()
     TestOutgoingEdges(test.connector, enter, expectedEdges);
   }
 }
+
+template <typename CrossMwmId>
+void TestTransitionsByCrossMwmId(CrossMwmConnector<CrossMwmId> const & connector, vector<uint32_t> const & featureIds)
+{
+  uint32_t constexpr segmentIdx = 1;
+  for (uint32_t featureId : featureIds)
+  {
+    CrossMwmId id;
+    GetCrossMwmId(featureId, id);
+
+    auto const enter = connector.GetTransition(id, segmentIdx, true /* isEnter */);
+    TEST(enter, (featureId));
+    TEST_EQUAL(*enter, Segment(kTestMwmId, featureId, segmentIdx, true /* forward */), ());
+    TEST(connector.GetCrossMwmId(*enter) == id, (featureId));
+
+    auto const exit = connector.GetTransition(id, segmentIdx, false /* isEnter */);
+    TEST(exit, (featureId));
+    TEST_EQUAL(*exit, Segment(kTestMwmId, featureId, segmentIdx, false /* forward */), ());
+  }
+
+  CrossMwmId unknownId;
+  GetCrossMwmId(100 /* i */, unknownId);
+  TEST(!connector.GetTransition(unknownId, segmentIdx, true /* isEnter */), ());
+}
+
+template <typename CrossMwmId>
+void TestCrossMwmIds()
+{
+  vector<uint32_t> const featureIds = {3, 1, 4, 0, 2};
+  uint32_t constexpr segmentIdx = 1;
+
+  {
+    CrossMwmBuilderTestFixture<CrossMwmId> test;
+    for (uint32_t featureId : featureIds)
+    {
+      CrossMwmId id;
+      GetCrossMwmId(featureId, id);
+      test.builder.AddTransition(id, featureId, segmentIdx, false /* oneWay */, true /* forwardIsEnter */);
+    }
+
+    // The first feature is kept for a duplicated id.
+    CrossMwmId id;
+    GetCrossMwmId(1 /* i */, id);
+    test.builder.AddTransition(id, 9 /* featureId */, segmentIdx, false /* oneWay */, true /* forwardIsEnter */);
+
+    TestTransitionsByCrossMwmId(test.connector, featureIds);
+  }
+
+  CrossMwmConnectorBuilderEx<CrossMwmId> builder;
+  for (uint32_t featureId : featureIds)
+  {
+    CrossMwmId id;
+    GetCrossMwmId(featureId, id);
+    builder.AddTransition(id, featureId, segmentIdx, kCarMask, 0 /* oneWayMask */, true /* forwardIsEnter */);
+  }
+
+  vector<uint8_t> buffer;
+  MemWriter<vector<uint8_t>> writer(buffer);
+  builder.Serialize(writer);
+
+  MemReader reader(buffer.data(), buffer.size());
+  CrossMwmBuilderTestFixture<CrossMwmId> test;
+  test.builder.DeserializeTransitions(VehicleType::Car, reader);
+  TestTransitionsByCrossMwmId(test.connector, featureIds);
+}
 }  // namespace
 
 UNIT_TEST(CMWMC_OneWayEnter)
@@ -345,4 +410,10 @@ UNIT_TEST(CMWMC_WeightsSerialization)
   TestWeightsSerialization<base::GeoObjectId>();
   TestWeightsSerialization<TransitId>();
 }
+
+UNIT_TEST(CMWMC_CrossMwmIds)
+{
+  TestCrossMwmIds<base::GeoObjectId>();
+  TestCrossMwmIds<TransitId>();
+}
 }  // namespace cross_mwm_connector_test
@@ -2,8 +2,17 @@
 
 #include "routing/base/followed_polyline.hpp"
 
+#include "geometry/parametrized_segment.hpp"
 #include "geometry/polyline2d.hpp"
 
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
 namespace routing_test
 {
 using namespace routing;
@@ -12,6 +21,40 @@ namespace
 {
 static m2::PolylineD const kTestDirectedPolyline1(std::vector<m2::PointD>{{0.0, 0.0}, {3.0, 0.0}, {5.0, 0.0}});
 static m2::PolylineD const kTestDirectedPolyline2(std::vector<m2::PointD>{{6.0, 0.0}, {7.0, 0.0}});
+
+// Zigzag route there and back, so the most of places are passed twice.
+std::vector<m2::PointD> MakeLongRoute(size_t pointsCount)
+{
+  std::vector<m2::PointD> points;
+  points.reserve(pointsCount);
+  for (size_t i = 0; i < pointsCount / 2; ++i)
+    points.emplace_back(i * 1e-4, (i % 2) * 1e-4);
+  for (size_t i = pointsCount / 2; i < pointsCount; ++i)
+    points.emplace_back((pointsCount - i) * 1e-4 + 5e-5, 2e-5 + (i % 3) * 5e-5);
+  return points;
+}
+
+// Linear scan of all segments of |points| which is done by FollowedPolyline without a segment index.
+FollowedPolyline::Iter GetClosestProjectionLinear(std::vector<m2::PointD> const & points, m2::RectD const & posRect)
+{
+  FollowedPolyline::Iter res;
+  double minDist = std::numeric_limits<double>::max();
+  for (size_t i = 0; i + 1 < points.size(); ++i)
+  {
+    m2::ParametrizedSegment<m2::PointD> const segment(points[i], points[i + 1]);
+    m2::PointD const pt = segment.ClosestPointTo(posRect.Center());
+    if (!posRect.IsPointInside(pt))
+      continue;
+
+    double const dp = mercator::DistanceOnEarth(pt, posRect.Center());
+    if (dp < minDist)
+    {
+      res = FollowedPolyline::Iter(pt, i);
+      minDist = dp;
+    }
+  }
+  return res;
+}
 }  // namespace
 
 UNIT_TEST(FollowedPolylineAppend)
@@ -121,4 +164,74 @@ UNIT_TEST(FollowedPolylineGetDistanceFromBeginM)
   double const masterDistance = mercator::DistanceOnEarth(kTestDirectedPolyline1.Front(), point);
   TEST_ALMOST_EQUAL_ULPS(distance, masterDistance, ());
 }
+
+UNIT_TEST(FollowedPolylineIndexedProjection)
+{
+  auto const points = MakeLongRoute(10 * FollowedPolyline::kMinSegmentsForIndex + 3);
+  FollowedPolyline polyline(points.begin(), points.end());
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> x(-0.01, points.size() * 1e-4 / 2 + 0.01);
+  std::uniform_real_distribution<double> y(-0.01, 0.01);
+  std::uniform_real_distribution<double> size(1, 100);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    auto const posRect = mercator::RectByCenterXYAndSizeInMeters({x(rng), y(rng)}, size(rng));
+    auto const expected = GetClosestProjectionLinear(points, posRect);
+    auto const distFn = [&](FollowedPolyline::Iter const & it)
+    { return mercator::DistanceOnEarth(it.m_pt, posRect.Center()); };
+    auto const res =
+        polyline.GetClosestProjectionInInterval(posRect, distFn, 0 /* startIdx */, points.size() - 1 /* endIdx */);
+    TEST_EQUAL(res.IsValid(), expected.IsValid(), (i));
+    TEST_EQUAL(res.m_ind, expected.m_ind, (i));
+
+    auto const matchingRes = polyline.GetClosestMatchingProjectionInInterval(posRect, 0, points.size() - 1);
+    TEST_EQUAL(matchingRes.m_ind, expected.m_ind, (i));
+  }
+}
+
+UNIT_TEST(FollowedPolyline_Benchmark)
+{
+  // Off-route positions near a long route. Each of them makes FollowedPolyline check the whole route.
+  auto const points = MakeLongRoute(200000);
+  FollowedPolyline polyline(points.begin(), points.end());
+
+  // The baseline is the route split into polylines which are too short to be indexed.
+  std::vector<FollowedPolyline> parts;
+  size_t const partPointsCount = FollowedPolyline::kMinSegmentsForIndex;
+  for (size_t begin = 0; begin + 1 < points.size(); begin += partPointsCount - 1)
+  {
+    auto const end = std::min(begin + partPointsCount, points.size());
+    parts.emplace_back(points.begin() + begin, points.begin() + end);
+  }
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> x(0, points.size() * 1e-4 / 2);
+  std::vector<m2::RectD> positions;
+  for (size_t i = 0; i < 200; ++i)
+    positions.push_back(mercator::RectByCenterXYAndSizeInMeters({x(rng), 0.001}, 50));
+
+  size_t found1 = 0, found2 = 0;
+  uint64_t t1, t2;
+  {
+    base::HighResTimer timer;
+    for (auto const & posRect : positions)
+    {
+      bool found = false;
+      for (auto & part : parts)
+        found = part.UpdateProjection(posRect).IsValid() || found;
+      found1 += found ? 1 : 0;
+    }
+    t1 = timer.ElapsedMilliseconds();
+  }
+  {
+    base::HighResTimer timer;
+    for (auto const & posRect : positions)
+      found2 += polyline.UpdateProjection(posRect).IsValid() ? 1 : 0;
+    t2 = timer.ElapsedMilliseconds();
+  }
+
+  TEST_EQUAL(found1, found2, ());
+  LOG(LINFO, ("Not indexed projection time =", t1, "Indexed projection time =", t2));
+}
 }  // namespace routing_test
@@ -4,6 +4,7 @@
 
 #include "routing/base/astar_algorithm.hpp"
 #include "routing/base/astar_graph.hpp"
+#include "routing/base/routing_result.hpp"
 
 #include "routing/edge_estimator.hpp"
 #include "routing/fake_ending.hpp"
@@ -501,6 +502,56 @@ UNIT_TEST(FakeEndingAStarInvariant)
   TestRoute(start, finish, expectedRoute.size(), &expectedRoute, expectedWeight, *worldGraph);
 }
 
+//                 R1
+//                 * 3
+//                 |
+//                 * 2
+//                 |
+//                 * 1
+//        R0       |
+//    * - - * - - -*
+//    0     1      2
+//
+// The finish is in the middle of a segment of R1. Forward and bidirectional A* should find routes
+// of the same weight, whichever vertex the waves meet at.
+UNIT_TEST(FinishInMiddleOfSegment_Bidirectional)
+{
+  unique_ptr<TestGeometryLoader> loader = make_unique<TestGeometryLoader>();
+  loader->AddRoad(0 /* featureId */, false, 1.0 /* speed */,
+                  RoadGeometry::Points({{0.0, 0.0}, {1.0, 0.0}, {2.0, 0.0}}));
+  loader->AddRoad(1 /* featureId */, false, 1.0 /* speed */,
+                  RoadGeometry::Points({{2.0, 0.0}, {2.0, 1.0}, {2.0, 2.0}, {2.0, 3.0}}));
+
+  vector<Joint> joints;
+  joints.emplace_back(MakeJoint({{0 /* featureId */, 2 /* pointId */}, {1, 0}}));
+
+  traffic::TrafficCache const trafficCache;
+  unique_ptr<WorldGraph> worldGraph = BuildWorldGraph(std::move(loader), CreateEstimatorForCar(trafficCache), joints);
+
+  auto const start = MakeFakeEnding(0 /* featureId */, 0 /* segmentIdx */, m2::PointD(0.5, 0.0), *worldGraph);
+  for (uint32_t segmentIdx = 0; segmentIdx < 3; ++segmentIdx)
+  {
+    auto const finish = MakeFakeEnding(1 /* featureId */, segmentIdx, m2::PointD(2.0, segmentIdx + 0.3), *worldGraph);
+
+    double forwardTimeSec = 0.0;
+    {
+      auto starter = MakeStarter(start, finish, *worldGraph);
+      AlgorithmForIndexGraphStarter::ParamsForTests<> params(*starter, starter->GetStartSegment(),
+                                                             starter->GetFinishSegment());
+      RoutingResult<Segment, RouteWeight> result;
+      TEST_EQUAL(AlgorithmForIndexGraphStarter().FindPath(params, result), AlgorithmForIndexGraphStarter::Result::OK,
+                 ());
+      forwardTimeSec = result.m_distance.GetWeight();
+    }
+
+    auto starter = MakeStarter(start, finish, *worldGraph);
+    vector<Segment> route;
+    double timeSec = 0.0;
+    TEST_EQUAL(CalculateRoute(*starter, route, timeSec), AlgorithmForIndexGraphStarter::Result::OK, ());
+    TEST(AlmostEqualAbs(timeSec, forwardTimeSec, 1e-6), (segmentIdx, timeSec, forwardTimeSec));
+  }
+}
+
 //
 //  Road       R0 (ped)       R1 (car)       R2 (car)
 //           0----------1 * 0----------1 * 0----------1
@@ -4,6 +4,7 @@
 
 #include "routing/base/routing_result.hpp"
 #include "routing/geometry.hpp"
+#include "routing/routing_exceptions.hpp"
 #include "routing/routing_helpers.hpp"
 
 #include "transit/transit_version.hpp"
@@ -443,6 +444,35 @@ unique_ptr<SingleVehicleWorldGraph> BuildWorldGraph(unique_ptr<ZeroGeometryLoade
                                               MwmHierarchyHandler());
 }
 
+unique_ptr<SingleVehicleWorldGraph> BuildManhattan(traffic::TrafficCache const & trafficCache, uint32_t citySize,
+                                                   double blockSize, bool oneWay, WorldGraphMode mode,
+                                                   vector<double> const & speeds)
+{
+  CHECK(!speeds.empty(), ());
+  auto loader = make_unique<TestGeometryLoader>();
+  for (uint32_t i = 0; i < citySize; ++i)
+  {
+    RoadGeometry::Points street;
+    RoadGeometry::Points avenue;
+    for (uint32_t j = 0; j < citySize; ++j)
+    {
+      street.emplace_back(j * blockSize, i * blockSize);
+      avenue.emplace_back(i * blockSize, j * blockSize);
+    }
+    loader->AddRoad(i, oneWay && i % 2 == 1 /* oneWay */, speeds[i % speeds.size()], street);
+    loader->AddRoad(i + citySize, false /* oneWay */, speeds[(i + citySize) % speeds.size()], avenue);
+  }
+
+  vector<Joint> joints;
+  for (uint32_t i = 0; i < citySize; ++i)
+    for (uint32_t j = 0; j < citySize; ++j)
+      joints.emplace_back(MakeJoint({{i, j}, {j + citySize, i}}));
+
+  auto graph = BuildWorldGraph(std::move(loader), CreateEstimatorForCar(trafficCache), joints);
+  graph->SetMode(mode);
+  return graph;
+}
+
 unique_ptr<TransitWorldGraph> BuildWorldGraph(unique_ptr<TestGeometryLoader> geometryLoader,
                                               shared_ptr<EdgeEstimator> estimator, vector<Joint> const & joints,
                                               routing::transit::GraphData const & transitData)
@@ -604,6 +634,34 @@ unique_ptr<IndexGraphStarter> MakeStarter(FakeEnding const & start, FakeEnding c
   return make_unique<IndexGraphStarter>(start, finish, 0 /* fakeNumerationStart */, false /* strictForward */, graph);
 }
 
+bool IsSectionCorrupted(vector<uint8_t> const & buffer, LoadSectionFn const & load)
+{
+  try
+  {
+    load(buffer);
+  }
+  catch (CorruptedDataException const &)
+  {
+    return true;
+  }
+  return false;
+}
+
+void TestSectionCorruption(vector<uint8_t> const & buffer, LoadSectionFn const & load)
+{
+  TEST_GREATER(buffer.size(), 2, ());
+  TEST(!IsSectionCorrupted(buffer, load), ());
+  TEST(IsSectionCorrupted({}, load), ());
+
+  auto truncated = buffer;
+  truncated.pop_back();
+  TEST(IsSectionCorrupted(truncated, load), ());
+
+  auto wrongVersion = buffer;
+  ++wrongVersion[0];
+  TEST(IsSectionCorrupted(wrongVersion, load), ());
+}
+
 time_t GetUnixtimeByDate(uint16_t year, Month month, uint8_t monthDay, uint8_t hours, uint8_t minutes)
 {
   std::tm t{};
@@ -31,6 +31,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <ctime>
+#include <functional>
 #include <map>
 #include <memory>
 #include <unordered_map>
@@ -274,6 +275,13 @@ std::unique_ptr<SingleVehicleWorldGraph> BuildWorldGraph(std::unique_ptr<ZeroGeo
                                                          std::shared_ptr<EdgeEstimator> estimator,
                                                          std::vector<Joint> const & joints);
 
+/// \brief Builds a car graph of |citySize| streets along the x axis (features [0, citySize)) and
+/// |citySize| two-way avenues along the y axis (features [citySize, 2 * citySize)) with |blockSize|
+/// between them. Odd streets are oneway if |oneWay| is true. Feature |i| has speed |speeds[i % speeds.size()]|.
+std::unique_ptr<SingleVehicleWorldGraph> BuildManhattan(traffic::TrafficCache const & trafficCache, uint32_t citySize,
+                                                        double blockSize, bool oneWay, WorldGraphMode mode,
+                                                        std::vector<double> const & speeds = {1.0});
+
 AStarAlgorithm<Segment, SegmentEdge, RouteWeight>::Result CalculateRoute(IndexGraphStarter & starter,
                                                                          std::vector<Segment> & roadPoints,
                                                                          double & timeSec);
@@ -313,6 +321,15 @@ FakeEnding MakeFakeEnding(uint32_t featureId, uint32_t segmentIdx, m2::PointD co
 
 std::unique_ptr<IndexGraphStarter> MakeStarter(FakeEnding const & start, FakeEnding const & finish, WorldGraph & graph);
 
+using LoadSectionFn = std::function<void(std::vector<uint8_t> const & buffer)>;
+
+/// \returns true if |load| throws CorruptedDataException for |buffer|.
+bool IsSectionCorrupted(std::vector<uint8_t> const & buffer, LoadSectionFn const & load);
+
+/// \brief Checks that a routing section in |buffer| is loaded and that a truncated section, an empty
+/// one and a section of another version are corrupted. The version is the first uint16 of a section.
+void TestSectionCorruption(std::vector<uint8_t> const & buffer, LoadSectionFn const & load);
+
 using Month = osmoh::MonthDay::Month;
 using Weekday = osmoh::Weekday;
 
@@ -0,0 +1,206 @@
+#include "testing/testing.hpp"
+
+#include "routing/routing_tests/index_graph_tools.hpp"
+
+#include "routing/base/astar_algorithm.hpp"
+#include "routing/fake_ending.hpp"
+#include "routing/index_graph_starter.hpp"
+#include "routing/isochrone.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/polygon.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/cancellable.hpp"
+#include "base/math.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace isochrone_test
+{
+using namespace routing;
+using namespace routing_test;
+using namespace std;
+
+uint32_t constexpr kCitySize = 6;
+double constexpr kBlockSize = 0.01;
+double constexpr kEpsilon = 1e-6;
+
+double CalcTimeSec(FakeEnding const & start, FakeEnding const & finish, WorldGraph & graph)
+{
+  auto starter = MakeStarter(start, finish, graph);
+  AlgorithmForWorldGraph::ParamsForTests<AStarLengthChecker> params(
+      *starter, starter->GetStartSegment(), starter->GetFinishSegment(), AStarLengthChecker(*starter));
+
+  RoutingResult<Segment, RouteWeight> result;
+  TEST_EQUAL(AlgorithmForWorldGraph().FindPath(params, result), AlgorithmForWorldGraph::Result::OK, ());
+  return result.m_distance.GetWeight();
+}
+
+// Time of a route along one block.
+double CalcBlockTimeSec(WorldGraph & graph)
+{
+  return CalcTimeSec(MakeFakeEnding(kCitySize, 0, m2::PointD(0.0, 0.0), graph),
+                     MakeFakeEnding(kCitySize, 0, m2::PointD(0.0, kBlockSize), graph), graph);
+}
+
+IsochroneSegment MakeSegment(double backX, double backY, double frontX, double frontY, double timeToBackSec,
+                             double timeToFrontSec)
+{
+  return {Segment(), mercator::ToLatLon({backX, backY}), mercator::ToLatLon({frontX, frontY}), timeToBackSec,
+          timeToFrontSec};
+}
+
+m2::RectD GetLimitRect(IsochronePolygon const & polygon)
+{
+  m2::RectD rect;
+  for (auto const & point : polygon)
+    rect.Add(point);
+  return rect;
+}
+
+// Times of the reached segments should be equal to distances of a Dijkstra wave over the starter.
+UNIT_TEST(Isochrone_Manhattan)
+{
+  traffic::TrafficCache const trafficCache;
+  auto worldGraph = BuildManhattan(trafficCache, kCitySize, kBlockSize, true /* oneWay */, WorldGraphMode::NoLeaps);
+  auto const start = MakeFakeEnding(kCitySize + 2, 2, m2::PointD(2 * kBlockSize, 2.3 * kBlockSize), *worldGraph);
+  double const maxTimeSec = CalcBlockTimeSec(*worldGraph) * 3.5;
+
+  vector<IsochroneSegment> segments;
+  TEST_EQUAL(CalculateIsochrone(*worldGraph, start, maxTimeSec, base::Cancellable(), segments),
+             RouterResultCode::NoError, ());
+  TEST(!segments.empty(), ());
+
+  auto starter = MakeStarter(start, MakeFakeEnding(kCitySize, 0, m2::PointD(0.0, 0.0), *worldGraph), *worldGraph);
+  AlgorithmForWorldGraph::Context context(*starter);
+  AlgorithmForWorldGraph().PropagateWave(*starter, starter->GetStartSegment(),
+                                         [](Segment const & /* vertex */) { return true; }, context);
+
+  size_t reachedCount = 0;
+  for (auto const & segment : segments)
+  {
+    // Real start segments are reached by the starter around only.
+    if (segment.m_segment.GetFeatureId() == kCitySize + 2 && segment.m_segment.GetSegmentIdx() == 2)
+      continue;
+
+    TEST(context.HasDistance(segment.m_segment), (segment.m_segment));
+    double const expectedTimeSec = context.GetDistance(segment.m_segment).GetWeight();
+    TEST(AlmostEqualAbsOrRel(segment.m_timeToFrontSec, expectedTimeSec, kEpsilon),
+         (segment.m_segment, segment.m_timeToFrontSec, expectedTimeSec));
+    if (segment.m_timeToFrontSec <= maxTimeSec)
+      ++reachedCount;
+  }
+  TEST_GREATER(reachedCount, 0, ());
+
+  // All the segments within the time limit are found.
+  size_t expectedCount = 0;
+  for (uint32_t featureId = 0; featureId < 2 * kCitySize; ++featureId)
+  {
+    for (uint32_t segmentIdx = 0; segmentIdx + 1 < kCitySize; ++segmentIdx)
+    {
+      if (featureId == kCitySize + 2 && segmentIdx == 2)
+        continue;
+
+      for (bool const forward : {true, false})
+      {
+        Segment const segment(kTestNumMwmId, featureId, segmentIdx, forward);
+        if (context.HasDistance(segment) && context.GetDistance(segment).GetWeight() <= maxTimeSec)
+          ++expectedCount;
+      }
+    }
+  }
+  TEST_EQUAL(reachedCount, expectedCount, ());
+}
+
+UNIT_TEST(Isochrone_MaxTime)
+{
+  traffic::TrafficCache const trafficCache;
+  auto worldGraph = BuildManhattan(trafficCache, kCitySize, kBlockSize, true /* oneWay */, WorldGraphMode::NoLeaps);
+  auto const start = MakeFakeEnding(kCitySize + 2, 2, m2::PointD(2 * kBlockSize, 2.3 * kBlockSize), *worldGraph);
+  double const blockTimeSec = CalcBlockTimeSec(*worldGraph);
+
+  vector<IsochroneSegment> nearSegments;
+  TEST_EQUAL(CalculateIsochrone(*worldGraph, start, blockTimeSec * 1.5, base::Cancellable(), nearSegments),
+             RouterResultCode::NoError, ());
+  vector<IsochroneSegment> farSegments;
+  TEST_EQUAL(CalculateIsochrone(*worldGraph, start, blockTimeSec * 3.5, base::Cancellable(), farSegments),
+             RouterResultCode::NoError, ());
+  TEST_LESS(nearSegments.size(), farSegments.size(), ());
+
+  size_t borderCount = 0;
+  for (size_t i = 0; i < nearSegments.size(); ++i)
+  {
+    auto const & segment = nearSegments[i];
+    TEST_LESS(segment.m_timeToBackSec, blockTimeSec * 1.5, (segment.m_segment));
+    TEST_LESS_OR_EQUAL(segment.m_timeToBackSec, segment.m_timeToFrontSec, (segment.m_segment));
+    if (i != 0)
+      TEST_LESS_OR_EQUAL(nearSegments[i - 1].m_timeToFrontSec, segment.m_timeToFrontSec, (i));
+    if (segment.m_timeToFrontSec > blockTimeSec * 1.5)
+      ++borderCount;
+  }
+  TEST_GREATER(borderCount, 0, ());
+}
+
+UNIT_TEST(Isochrone_NoProjections)
+{
+  traffic::TrafficCache const trafficCache;
+  auto worldGraph = BuildManhattan(trafficCache, kCitySize, kBlockSize, true /* oneWay */, WorldGraphMode::NoLeaps);
+
+  vector<IsochroneSegment> segments;
+  TEST_EQUAL(CalculateIsochrone(*worldGraph, FakeEnding(), 1e9 /* maxTimeSec */, base::Cancellable(), segments),
+             RouterResultCode::StartPointNotFound, ());
+  TEST(segments.empty(), ());
+}
+
+UNIT_TEST(IsochronePolygons_Rings)
+{
+  double const size = mercator::MetersToMercator(1000.0);
+  // Two distant segments, the second one is reached half way.
+  vector<IsochroneSegment> segments = {MakeSegment(0.0, 0.0, size, 0.0, 0.0, 10.0),
+                                       MakeSegment(0.0, 3 * size, size, 3 * size, 10.0, 30.0)};
+
+  auto polygons = BuildIsochronePolygons(segments, 20.0 /* maxTimeSec */, 100.0 /* cellSizeM */);
+  TEST_EQUAL(polygons.size(), 2, ());
+  sort(polygons.begin(), polygons.end(), [](IsochronePolygon const & lhs, IsochronePolygon const & rhs)
+       { return GetLimitRect(lhs).minY() < GetLimitRect(rhs).minY(); });
+
+  for (auto const & polygon : polygons)
+  {
+    // Rectangles of cells along the segments.
+    TEST_EQUAL(polygon.size(), 4, (polygon));
+    TEST(IsPolygonCCW(polygon.cbegin(), polygon.cend()), (polygon));
+  }
+
+  double const cellSize = mercator::MetersToMercator(100.0);
+  TEST_LESS(GetLimitRect(polygons[0]).SizeX(), size + 2 * cellSize, ());
+  TEST_GREATER(GetLimitRect(polygons[0]).SizeX(), size, ());
+  TEST_LESS(GetLimitRect(polygons[1]).SizeX(), size / 2 + 2 * cellSize, ());
+  TEST_GREATER(GetLimitRect(polygons[1]).SizeX(), size / 2, ());
+
+  TEST(BuildIsochronePolygons({}, 20.0 /* maxTimeSec */, 100.0 /* cellSizeM */).empty(), ());
+}
+
+UNIT_TEST(IsochronePolygons_Hole)
+{
+  double const size = mercator::MetersToMercator(1000.0);
+  vector<IsochroneSegment> const segments = {
+      MakeSegment(0.0, 0.0, size, 0.0, 0.0, 10.0), MakeSegment(size, 0.0, size, size, 10.0, 20.0),
+      MakeSegment(size, size, 0.0, size, 20.0, 30.0), MakeSegment(0.0, size, 0.0, 0.0, 30.0, 40.0)};
+
+  auto const polygons = BuildIsochronePolygons(segments, 100.0 /* maxTimeSec */, 100.0 /* cellSizeM */);
+  TEST_EQUAL(polygons.size(), 2, ());
+
+  size_t outerCount = 0;
+  for (auto const & polygon : polygons)
+  {
+    TEST_EQUAL(polygon.size(), 4, (polygon));
+    if (IsPolygonCCW(polygon.cbegin(), polygon.cend()))
+      ++outerCount;
+  }
+  TEST_EQUAL(outerCount, 1, ());
+}
+}  // namespace isochrone_test
@@ -0,0 +1,124 @@
+#include "testing/testing.hpp"
+
+#include "routing/geometry.hpp"
+#include "routing/road_geometry_cache.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace road_geometry_cache_test
+{
+using namespace routing;
+using namespace std;
+
+// Makes roads of two points, the first point of |featureId| road is (featureId, 0).
+class TestLoader final : public GeometryLoader
+{
+public:
+  explicit TestLoader(atomic<uint32_t> & loadsCount) : m_loadsCount(loadsCount) {}
+
+  // GeometryLoader overrides:
+  void Load(uint32_t featureId, RoadGeometry & road) override
+  {
+    ++m_loadsCount;
+    road = RoadGeometry(false /* oneWay */, 1.0 /* weightSpeedKMpH */, 1.0 /* etaSpeedKMpH */,
+                        {m2::PointD(featureId, 0.0), m2::PointD(featureId, 1.0)});
+  }
+
+private:
+  atomic<uint32_t> & m_loadsCount;
+};
+
+void TestRoad(RoadGeometry const & road, uint32_t featureId)
+{
+  TEST_EQUAL(road.GetPointsCount(), 2, ());
+  TEST_EQUAL(road.GetPoint(0), mercator::ToLatLon(m2::PointD(featureId, 0.0)), (featureId));
+}
+
+UNIT_TEST(RoadGeometryCache_HitsAndSources)
+{
+  atomic<uint32_t> loadsCount = 0;
+  TestLoader loader(loadsCount);
+  RoadGeometryCache cache;
+
+  auto const sourceId = cache.GetSourceId("Moscow:1:Car");
+  auto const otherSourceId = cache.GetSourceId("Moscow:1:Pedestrian");
+  TEST_NOT_EQUAL(sourceId, otherSourceId, ());
+  TEST_EQUAL(cache.GetSourceId("Moscow:1:Car"), sourceId, ());
+
+  auto const road = cache.GetRoad(sourceId, 5 /* featureId */, loader);
+  TestRoad(*road, 5);
+  TEST_EQUAL(cache.GetRoad(sourceId, 5 /* featureId */, loader), road, ());
+  TEST_NOT_EQUAL(cache.GetRoad(otherSourceId, 5 /* featureId */, loader), road, ());
+  TEST_EQUAL(loadsCount.load(), 2, ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 1, ());
+  TEST_EQUAL(stats.m_misses, 2, ());
+  TEST_EQUAL(stats.m_evictions, 0, ());
+  TEST_EQUAL(stats.m_roadsCount, 2, ());
+  TEST_GREATER(stats.m_memorySize, 0, ());
+}
+
+UNIT_TEST(RoadGeometryCache_Eviction)
+{
+  atomic<uint32_t> loadsCount = 0;
+  TestLoader loader(loadsCount);
+  size_t constexpr kMaxMemorySize = 10 * 1024;
+  RoadGeometryCache cache(kMaxMemorySize, 1 /* shardsCount */);
+
+  uint32_t constexpr kRoadsCount = 1000;
+  for (uint32_t featureId = 0; featureId < kRoadsCount; ++featureId)
+    TestRoad(*cache.GetRoad(0 /* sourceId */, featureId, loader), featureId);
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_misses, kRoadsCount, ());
+  TEST_GREATER(stats.m_evictions, 0, ());
+  TEST_EQUAL(stats.m_roadsCount + stats.m_evictions, kRoadsCount, ());
+  TEST_LESS_OR_EQUAL(stats.m_memorySize, kMaxMemorySize, ());
+
+  // The last loaded road is kept and the first one is evicted.
+  cache.GetRoad(0 /* sourceId */, kRoadsCount - 1, loader);
+  TEST_EQUAL(cache.GetStats().m_hits, 1, ());
+  TestRoad(*cache.GetRoad(0 /* sourceId */, 0 /* featureId */, loader), 0);
+  TEST_EQUAL(loadsCount.load(), kRoadsCount + 1, ());
+}
+
+// Geometry instances of different threads load every road once.
+UNIT_TEST(RoadGeometryCache_SharedGeometry)
+{
+  atomic<uint32_t> loadsCount = 0;
+  auto cache = make_shared<RoadGeometryCache>();
+  auto const sourceId = cache->GetSourceId("Moscow:1:Car");
+
+  size_t constexpr kThreadsCount = 4;
+  uint32_t constexpr kRoadsCount = 2000;
+  vector<thread> threads;
+  for (size_t i = 0; i < kThreadsCount; ++i)
+  {
+    threads.emplace_back([&]()
+    {
+      Geometry geometry(make_unique<TestLoader>(loadsCount), cache, sourceId, 100 /* roadsCacheSize */);
+      for (uint32_t featureId = 0; featureId < kRoadsCount; ++featureId)
+      {
+        TestRoad(geometry.GetRoad(featureId), featureId);
+        TEST_EQUAL(geometry.GetPoint(RoadPoint(featureId, 1)), mercator::ToLatLon(m2::PointD(featureId, 1.0)), ());
+      }
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  auto const stats = cache->GetStats();
+  TEST_EQUAL(stats.m_roadsCount, kRoadsCount, ());
+  TEST_EQUAL(stats.m_hits + stats.m_misses, kThreadsCount * kRoadsCount, ());
+  // Threads may load the same road at the same time, but only one copy is kept.
+  TEST_GREATER_OR_EQUAL(loadsCount.load(), kRoadsCount, ());
+  TEST_EQUAL(loadsCount.load(), stats.m_misses, ());
+}
+}  // namespace road_geometry_cache_test
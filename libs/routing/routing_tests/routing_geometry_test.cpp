@@ -0,0 +1,127 @@
+#include "testing/testing.hpp"
+
+#include "routing/routing_tests/index_graph_tools.hpp"
+
+#include "routing/routing_geometry.hpp"
+
+#include "coding/point_coding.hpp"
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace routing_geometry_test
+{
+using namespace routing;
+using namespace routing_test;
+using namespace std;
+
+RoutingGeometry::Road MakeRoad(vector<m2::PointD> const & points, vector<uint32_t> const & types,
+                               geometry::Altitudes const & altitudes = {})
+{
+  RoutingGeometry::Road road;
+  // Points are stored with kPointCoordBits, so the test points are quantized beforehand.
+  for (auto const & point : points)
+    road.m_points.push_back(PointUToPointD(PointDToPointU(point, kPointCoordBits), kPointCoordBits));
+  road.m_types = types;
+  road.m_altitudes = altitudes;
+  return road;
+}
+
+unique_ptr<RoutingGeometry> Serialize(map<uint32_t, RoutingGeometry::Road> const & roads, bool hasAltitudes,
+                                      vector<uint8_t> & buffer)
+{
+  buffer.clear();
+  MemWriter<vector<uint8_t>> writer(buffer);
+  RoutingGeometry::Serialize(writer, roads, hasAltitudes);
+  return make_unique<RoutingGeometry>(make_unique<MemReader>(buffer.data(), buffer.size()));
+}
+
+void TestRoadsEqual(RoutingGeometry const & geometry, map<uint32_t, RoutingGeometry::Road> const & roads)
+{
+  RoutingGeometry::Road road;
+  for (uint32_t featureId = 0; featureId < geometry.GetFeaturesCount() + 2; ++featureId)
+  {
+    auto const it = roads.find(featureId);
+    TEST_EQUAL(geometry.GetRoad(featureId, road), it != roads.cend(), (featureId));
+    if (it == roads.cend())
+    {
+      TEST(road.m_points.empty(), (featureId));
+      continue;
+    }
+
+    TEST_EQUAL(road.m_points, it->second.m_points, (featureId));
+    TEST_EQUAL(road.m_types, it->second.m_types, (featureId));
+    TEST_EQUAL(road.m_altitudes, it->second.m_altitudes, (featureId));
+  }
+}
+
+// Reads all the roads because offsets are checked only when a road is read.
+void Load(vector<uint8_t> const & buffer)
+{
+  RoutingGeometry const geometry(make_unique<MemReader>(buffer.data(), buffer.size()));
+  RoutingGeometry::Road road;
+  for (uint32_t featureId = 0; featureId < geometry.GetFeaturesCount(); ++featureId)
+    geometry.GetRoad(featureId, road);
+}
+
+UNIT_TEST(RoutingGeometry_SerializationWithoutAltitudes)
+{
+  map<uint32_t, RoutingGeometry::Road> const roads = {
+      {1, MakeRoad({{0.0, 0.0}, {0.001, 0.002}, {0.003, 0.001}}, {10, 20})},
+      {2, MakeRoad({{-10.5, 20.25}, {-10.4, 20.3}}, {30})},
+      // Features 3 and 4 are not roads or need metadata.
+      {5, MakeRoad({{179.0, -80.0}, {179.5, -80.5}}, {})}};
+
+  vector<uint8_t> buffer;
+  auto const geometry = Serialize(roads, false /* hasAltitudes */, buffer);
+  TEST(!geometry->HasAltitudes(), ());
+  TEST_EQUAL(geometry->GetFeaturesCount(), 6, ());
+  TEST_EQUAL(geometry->GetPointsCount(), 7, ());
+  TestRoadsEqual(*geometry, roads);
+}
+
+UNIT_TEST(RoutingGeometry_SerializationWithAltitudes)
+{
+  map<uint32_t, RoutingGeometry::Road> const roads = {
+      {0, MakeRoad({{0.0, 0.0}, {0.001, 0.002}}, {10}, {100, 101})},
+      {3, MakeRoad({{1.0, 1.0}, {1.001, 1.0}, {1.002, 1.0}}, {20, 30}, {-5, 0, 8848})}};
+
+  vector<uint8_t> buffer;
+  auto const geometry = Serialize(roads, true /* hasAltitudes */, buffer);
+  TEST(geometry->HasAltitudes(), ());
+  TEST_EQUAL(geometry->GetFeaturesCount(), 4, ());
+  TEST_EQUAL(geometry->GetPointsCount(), 5, ());
+  TestRoadsEqual(*geometry, roads);
+}
+
+UNIT_TEST(RoutingGeometry_Empty)
+{
+  vector<uint8_t> buffer;
+  auto const geometry = Serialize({}, false /* hasAltitudes */, buffer);
+  TEST_EQUAL(geometry->GetFeaturesCount(), 0, ());
+
+  RoutingGeometry::Road road;
+  TEST(!geometry->GetRoad(0 /* featureId */, road), ());
+}
+
+UNIT_TEST(RoutingGeometry_Corrupted)
+{
+  map<uint32_t, RoutingGeometry::Road> const roads = {{0, MakeRoad({{0.0, 0.0}, {0.001, 0.002}}, {10})}};
+
+  vector<uint8_t> buffer;
+  Serialize(roads, false /* hasAltitudes */, buffer);
+  TestSectionCorruption(buffer, Load);
+
+  // Point offsets of the features follow the 16 bytes header. The first point of feature 0 is after
+  // its last point.
+  auto wrongOffsets = buffer;
+  wrongOffsets[16] = 3;
+  TEST(IsSectionCorrupted(wrongOffsets, Load), ());
+}
+}  // namespace routing_geometry_test
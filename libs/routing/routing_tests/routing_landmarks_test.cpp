@@ -0,0 +1,261 @@
+#include "testing/testing.hpp"
+
+#include "routing/routing_tests/index_graph_tools.hpp"
+
+#include "routing/base/astar_algorithm.hpp"
+#include "routing/base/routing_result.hpp"
+
+#include "routing/fake_ending.hpp"
+#include "routing/index_graph_starter.hpp"
+#include "routing/routing_landmarks.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/math.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace routing_landmarks_test
+{
+using namespace routing;
+using namespace routing_test;
+using namespace std;
+
+uint32_t constexpr kCitySize = 8;
+double constexpr kBlockSize = 0.01;
+size_t constexpr kLandmarksCount = 4;
+
+// Speeds of the features in km/h. Different speeds make the shortest paths differ from the
+// straight lines.
+vector<double> const kSpeeds = {5.0, 60.0, 20.0, 40.0, 10.0};
+
+using Algorithm = AStarAlgorithm<Segment, SegmentEdge, RouteWeight>;
+
+template <typename Fn>
+void ForEachRoadPoint(RoutingLandmarks const & landmarks, Fn && fn)
+{
+  for (uint32_t featureId = 0; featureId < 2 * kCitySize; ++featureId)
+  {
+    for (uint32_t pointId = 0; pointId < kCitySize; ++pointId)
+      fn(RoadPoint(featureId, pointId));
+  }
+}
+
+UNIT_TEST(RoutingLandmarks_Build)
+{
+  traffic::TrafficCache const trafficCache;
+  auto worldGraph =
+      BuildManhattan(trafficCache, kCitySize, kBlockSize, true /* oneWay */, WorldGraphMode::NoLeaps, kSpeeds);
+  auto const landmarks =
+      BuildRoutingLandmarks(worldGraph->GetIndexGraphForTests(kTestNumMwmId), kTestNumMwmId, kLandmarksCount);
+
+  TEST_EQUAL(landmarks.GetNumLandmarks(), kLandmarksCount, ());
+  TEST_EQUAL(landmarks.GetNumFeatures(), 2 * kCitySize, ());
+  TEST(!landmarks.GetFromLandmarks(RoadPoint(2 * kCitySize, 0)), ());
+  TEST(!landmarks.GetFromLandmarks(RoadPoint(0, kCitySize)), ());
+
+  auto const & points = landmarks.GetLandmarks();
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    TEST_EQUAL(landmarks.GetFromLandmarks(points[i])[i], 0, (points[i]));
+    TEST_EQUAL(landmarks.GetToLandmarks(points[i])[i], 0, (points[i]));
+
+    for (size_t j = 0; j < i; ++j)
+      TEST_NOT_EQUAL(points[i], points[j], ());
+  }
+
+  // The grid is strongly connected and small, so all the weights are known.
+  ForEachRoadPoint(landmarks, [&](RoadPoint const & point)
+  {
+    for (size_t i = 0; i < kLandmarksCount; ++i)
+    {
+      TEST_LESS(landmarks.GetFromLandmarks(point)[i], RoutingLandmarks::kMaxWeight, (point, i));
+      TEST_LESS(landmarks.GetToLandmarks(point)[i], RoutingLandmarks::kMaxWeight, (point, i));
+    }
+  });
+}
+
+UNIT_TEST(RoutingLandmarks_Serialization)
+{
+  traffic::TrafficCache const trafficCache;
+  auto worldGraph =
+      BuildManhattan(trafficCache, kCitySize, kBlockSize, true /* oneWay */, WorldGraphMode::NoLeaps, kSpeeds);
+  vector<pair<VehicleType, RoutingLandmarks>> tables;
+  tables.emplace_back(VehicleType::Pedestrian, RoutingLandmarks());
+  tables.emplace_back(VehicleType::Bicycle, BuildRoutingLandmarks(worldGraph->GetIndexGraphForTests(kTestNumMwmId),
+                                                                  kTestNumMwmId, kLandmarksCount));
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    SerializeRoutingLandmarksSection(writer, tables);
+  }
+
+  auto const deserialize = [&buffer](VehicleType vehicleType, RoutingLandmarks & landmarks)
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> src(reader);
+    return DeserializeRoutingLandmarksSection(src, vehicleType, landmarks);
+  };
+
+  RoutingLandmarks landmarks;
+  TEST(!deserialize(VehicleType::Car, landmarks), ());
+
+  TEST(deserialize(VehicleType::Pedestrian, landmarks), ());
+  TEST_EQUAL(landmarks.GetNumLandmarks(), 0, ());
+
+  TEST(deserialize(VehicleType::Bicycle, landmarks), ());
+  auto const & expected = tables.back().second;
+  TEST_EQUAL(landmarks.GetLandmarks(), expected.GetLandmarks(), ());
+  TEST_EQUAL(landmarks.GetNumFeatures(), expected.GetNumFeatures(), ());
+  ForEachRoadPoint(expected, [&](RoadPoint const & point)
+  {
+    for (size_t i = 0; i < kLandmarksCount; ++i)
+    {
+      TEST_EQUAL(landmarks.GetFromLandmarks(point)[i], expected.GetFromLandmarks(point)[i], (point, i));
+      TEST_EQUAL(landmarks.GetToLandmarks(point)[i], expected.GetToLandmarks(point)[i], (point, i));
+    }
+  });
+}
+
+// Routes found with landmarks should be as good as routes found with the straight line heuristic.
+UNIT_TEST(RoutingLandmarks_RouteManhattan)
+{
+  traffic::TrafficCache const trafficCache;
+  auto worldGraph = BuildManhattan(trafficCache, kCitySize, kBlockSize, true /* oneWay */, WorldGraphMode::NoLeaps);
+  auto const landmarks =
+      BuildRoutingLandmarks(worldGraph->GetIndexGraphForTests(kTestNumMwmId), kTestNumMwmId, kLandmarksCount);
+
+  vector<FakeEnding> endPoints;
+  for (uint32_t featureId = 0; featureId < kCitySize; featureId += 3)
+  {
+    for (uint32_t segmentIdx = 0; segmentIdx < kCitySize - 1; segmentIdx += 3)
+    {
+      endPoints.push_back(MakeFakeEnding(featureId, segmentIdx,
+                                         m2::PointD((0.5 + segmentIdx) * kBlockSize, featureId * kBlockSize),
+                                         *worldGraph));
+      endPoints.push_back(MakeFakeEnding(featureId + kCitySize, segmentIdx,
+                                         m2::PointD(featureId * kBlockSize, (0.5 + segmentIdx) * kBlockSize),
+                                         *worldGraph));
+    }
+  }
+
+  for (auto const & start : endPoints)
+  {
+    for (auto const & finish : endPoints)
+    {
+      double expectedTimeSec = 0.0;
+      {
+        auto starter = MakeStarter(start, finish, *worldGraph);
+        vector<Segment> route;
+        TEST_EQUAL(CalculateRoute(*starter, route, expectedTimeSec), AlgorithmForWorldGraph::Result::OK, ());
+      }
+
+      auto starter = MakeStarter(start, finish, *worldGraph);
+      starter->SetLandmarks(landmarks, kTestNumMwmId);
+      vector<Segment> route;
+      double timeSec = 0.0;
+      TEST_EQUAL(CalculateRoute(*starter, route, timeSec), AlgorithmForWorldGraph::Result::OK, ());
+      // The bidirectional search stops when the waves meet within the A* epsilon.
+      TEST(AlmostEqualAbs(timeSec, expectedTimeSec, starter->GetAStarWeightEpsilon().GetWeight()),
+           (timeSec, expectedTimeSec));
+    }
+  }
+}
+
+// Landmark bounds should be consistent, otherwise the bidirectional search may return a longer
+// route than the plain A*. Oneway streets and different speeds make the weights from and to the
+// landmarks differ.
+UNIT_TEST(RoutingLandmarks_Consistency)
+{
+  traffic::TrafficCache const trafficCache;
+  auto worldGraph =
+      BuildManhattan(trafficCache, kCitySize, kBlockSize, true /* oneWay */, WorldGraphMode::NoLeaps, kSpeeds);
+  auto const landmarks =
+      BuildRoutingLandmarks(worldGraph->GetIndexGraphForTests(kTestNumMwmId), kTestNumMwmId, kLandmarksCount);
+
+  vector<FakeEnding> endPoints;
+  for (uint32_t featureId = 0; featureId < kCitySize; featureId += 2)
+  {
+    for (uint32_t segmentIdx = 1; segmentIdx < kCitySize - 1; segmentIdx += 3)
+    {
+      endPoints.push_back(MakeFakeEnding(featureId, segmentIdx,
+                                         m2::PointD((0.5 + segmentIdx) * kBlockSize, featureId * kBlockSize),
+                                         *worldGraph));
+      endPoints.push_back(MakeFakeEnding(featureId + kCitySize + 1, segmentIdx,
+                                         m2::PointD((featureId + 1) * kBlockSize, (0.5 + segmentIdx) * kBlockSize),
+                                         *worldGraph));
+    }
+  }
+
+  double constexpr kEpsilon = 1e-6;
+  for (auto const & start : endPoints)
+  {
+    for (auto const & finish : endPoints)
+    {
+      double expectedTimeSec = 0.0;
+      {
+        auto starter = MakeStarter(start, finish, *worldGraph);
+        Algorithm::ParamsForTests<> params(*starter, starter->GetStartSegment(), starter->GetFinishSegment());
+        RoutingResult<Segment, RouteWeight> result;
+        TEST_EQUAL(Algorithm().FindPath(params, result), Algorithm::Result::OK, ());
+        expectedTimeSec = result.m_distance.GetWeight();
+      }
+
+      auto starter = MakeStarter(start, finish, *worldGraph);
+      starter->SetLandmarks(landmarks, kTestNumMwmId);
+
+      // Reduced weights of all the edges of real segments are not negative for both waves.
+      for (uint32_t featureId = 0; featureId < 2 * kCitySize; ++featureId)
+      {
+        bool const oneWay = worldGraph->GetIndexGraphForTests(kTestNumMwmId).GetRoadGeometry(featureId).IsOneWay();
+        for (uint32_t segmentIdx = 0; segmentIdx + 1 < kCitySize; ++segmentIdx)
+        {
+          for (bool const forward : {true, false})
+          {
+            if (oneWay && !forward)
+              continue;
+
+            Segment const segment(kTestNumMwmId, featureId, segmentIdx, forward);
+            IndexGraphStarter::EdgeListT edges;
+            starter->GetEdgesList(segment, true /* isOutgoing */, edges);
+            auto const toFinish = starter->HeuristicCostEstimate(segment, starter->GetFinishSegment());
+            for (auto const & edge : edges)
+            {
+              auto const next = starter->HeuristicCostEstimate(edge.GetTarget(), starter->GetFinishSegment());
+              TEST_LESS_OR_EQUAL(toFinish.GetWeight(), edge.GetWeight().GetWeight() + next.GetWeight() + kEpsilon,
+                                 (segment, edge.GetTarget()));
+            }
+
+            edges.clear();
+            starter->GetEdgesList(segment, false /* isOutgoing */, edges);
+            auto const fromStart = starter->HeuristicCostEstimate(segment, starter->GetStartSegment());
+            for (auto const & edge : edges)
+            {
+              auto const prev = starter->HeuristicCostEstimate(edge.GetTarget(), starter->GetStartSegment());
+              TEST_LESS_OR_EQUAL(fromStart.GetWeight(), edge.GetWeight().GetWeight() + prev.GetWeight() + kEpsilon,
+                                 (edge.GetTarget(), segment));
+            }
+          }
+        }
+      }
+
+      vector<Segment> route;
+      double timeSec = 0.0;
+      TEST_EQUAL(CalculateRoute(*starter, route, timeSec), AlgorithmForWorldGraph::Result::OK, ());
+      TEST(AlmostEqualAbs(timeSec, expectedTimeSec, starter->GetAStarWeightEpsilon().GetWeight()),
+           (timeSec, expectedTimeSec));
+
+      Algorithm::ParamsForTests<> params(*starter, starter->GetStartSegment(), starter->GetFinishSegment());
+      RoutingResult<Segment, RouteWeight> result;
+      TEST_EQUAL(Algorithm().FindPath(params, result), Algorithm::Result::OK, ());
+      TEST(AlmostEqualAbs(result.m_distance.GetWeight(), expectedTimeSec, kEpsilon),
+           (result.m_distance.GetWeight(), expectedTimeSec));
+    }
+  }
+}
+}  // namespace routing_landmarks_test
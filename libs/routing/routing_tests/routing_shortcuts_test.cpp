@@ -0,0 +1,169 @@
+#include "testing/testing.hpp"
+
+#include "routing/routing_tests/index_graph_tools.hpp"
+
+#include "routing/base/astar_algorithm.hpp"
+#include "routing/base/routing_result.hpp"
+
+#include "routing/fake_ending.hpp"
+#include "routing/index_graph_starter.hpp"
+#include "routing/routing_shortcuts.hpp"
+#include "routing/shortcuts_graph.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/cancellable.hpp"
+#include "base/math.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace routing_shortcuts_test
+{
+using namespace routing;
+using namespace routing_test;
+using namespace std;
+
+using Algorithm = AStarAlgorithm<Segment, SegmentEdge, RouteWeight>;
+
+uint32_t constexpr kCitySize = 10;
+double constexpr kBlockSize = 0.01;
+size_t constexpr kMaxPointsInCell = 20;
+
+UNIT_TEST(RoutingShortcuts_BuildSplits)
+{
+  vector<ms::LatLon> points;
+  for (uint32_t i = 0; i < 16; ++i)
+    for (uint32_t j = 0; j < 4; ++j)
+      points.emplace_back(i * 0.1 + 0.05, j * 0.1 + 0.05);
+
+  auto const splits = RoutingShortcuts::BuildSplits(points, 8 /* maxPointsInCell */);
+  TEST_EQUAL(splits.size(), 7, ());
+  // The first split is across the longer side of the bbox.
+  TEST(splits[0].m_axis == RoutingShortcuts::Split::Axis::Lat, ());
+
+  vector<size_t> pointsInCell(splits.size() + 1);
+  for (auto const & point : points)
+    ++pointsInCell[RoutingShortcuts::GetCell(splits, point)];
+
+  for (auto const count : pointsInCell)
+    TEST_EQUAL(count, 8, (pointsInCell));
+}
+
+UNIT_TEST(RoutingShortcuts_StoredWeight)
+{
+  TEST_NOT_EQUAL(RoutingShortcuts::ToStoredWeight(0.0), connector::kNoRouteStored, ());
+  TEST_EQUAL(RoutingShortcuts::FromStoredWeight(RoutingShortcuts::ToStoredWeight(0.0)), 0.0, ());
+
+  for (double const weight : {0.05, 1.0, 12.34, 1000.01})
+  {
+    double const restored = RoutingShortcuts::FromStoredWeight(RoutingShortcuts::ToStoredWeight(weight));
+    TEST_GREATER_OR_EQUAL(restored, weight, ());
+    TEST_LESS(restored, weight + 1.0 / RoutingShortcuts::kWeightScale + 1e-9, ());
+  }
+}
+
+UNIT_TEST(RoutingShortcuts_Serialization)
+{
+  traffic::TrafficCache const trafficCache;
+  auto worldGraph = BuildManhattan(trafficCache, kCitySize, kBlockSize, false /* oneWay */, WorldGraphMode::NoLeaps);
+  auto const shortcuts =
+      BuildRoutingShortcuts(worldGraph->GetIndexGraphForTests(kTestNumMwmId), kTestNumMwmId, kMaxPointsInCell);
+  TEST_GREATER(shortcuts.GetNumCells(), 1, ());
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    shortcuts.Serialize(writer);
+  }
+
+  RoutingShortcuts deserialized;
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> src(reader);
+    deserialized.Deserialize(src, kTestNumMwmId);
+    TEST_EQUAL(src.Size(), 0, ());
+  }
+
+  TEST_EQUAL(deserialized.GetSplits().size(), shortcuts.GetSplits().size(), ());
+  TEST_EQUAL(deserialized.GetNumCells(), shortcuts.GetNumCells(), ());
+  for (RoutingShortcuts::CellId cellId = 0; cellId < shortcuts.GetNumCells(); ++cellId)
+  {
+    auto const & expected = shortcuts.GetCellData(cellId);
+    auto const & cell = deserialized.GetCellData(cellId);
+    TEST_EQUAL(cell.m_enters, expected.m_enters, ());
+    TEST_EQUAL(cell.m_exits, expected.m_exits, ());
+    TEST_EQUAL(cell.m_weights, expected.m_weights, ());
+
+    for (auto const & enter : cell.m_enters)
+      TEST(deserialized.IsEnter(enter), (enter));
+    for (auto const & exit : cell.m_exits)
+      TEST(deserialized.IsExit(exit), (exit));
+  }
+}
+
+// Routes found with shortcuts and unpacked should be as good as routes found segment by segment.
+UNIT_TEST(RoutingShortcuts_RouteManhattan)
+{
+  traffic::TrafficCache const trafficCache;
+  auto worldGraph = BuildManhattan(trafficCache, kCitySize, kBlockSize, false /* oneWay */, WorldGraphMode::NoLeaps);
+  auto const shortcuts =
+      BuildRoutingShortcuts(worldGraph->GetIndexGraphForTests(kTestNumMwmId), kTestNumMwmId, kMaxPointsInCell);
+
+  vector<FakeEnding> endPoints;
+  for (uint32_t featureId = 0; featureId < kCitySize; featureId += 3)
+  {
+    for (uint32_t segmentId = 0; segmentId < kCitySize - 1; segmentId += 4)
+    {
+      endPoints.push_back(MakeFakeEnding(featureId, segmentId,
+                                         m2::PointD((0.5 + segmentId) * kBlockSize, featureId * kBlockSize),
+                                         *worldGraph));
+      endPoints.push_back(MakeFakeEnding(featureId + kCitySize, segmentId,
+                                         m2::PointD(featureId * kBlockSize, (0.5 + segmentId) * kBlockSize),
+                                         *worldGraph));
+    }
+  }
+
+  base::Cancellable const cancellable;
+  for (auto const & start : endPoints)
+  {
+    for (auto const & finish : endPoints)
+    {
+      double expectedTimeSec = 0.0;
+      {
+        worldGraph->SetMode(WorldGraphMode::NoLeaps);
+        auto starter = MakeStarter(start, finish, *worldGraph);
+        vector<Segment> route;
+        TEST_EQUAL(CalculateRoute(*starter, route, expectedTimeSec), Algorithm::Result::OK, ());
+      }
+
+      worldGraph->SetMode(WorldGraphMode::SingleMwm);
+      auto starter = MakeStarter(start, finish, *worldGraph);
+      ShortcutsGraph graph(*starter, shortcuts);
+
+      Algorithm::ParamsForTests<> params(graph, graph.GetStartSegment(), graph.GetFinishSegment());
+      RoutingResult<Segment, RouteWeight> result;
+      TEST_EQUAL(Algorithm().FindPathBidirectional(params, result), Algorithm::Result::OK, ());
+
+      // Shortcut weights are rounded up to 0.1 second.
+      double const timeSec = result.m_distance.GetWeight();
+      TEST_GREATER_OR_EQUAL(timeSec + 1e-6, expectedTimeSec, ());
+      TEST_LESS_OR_EQUAL(timeSec, expectedTimeSec + result.m_path.size() / RoutingShortcuts::kWeightScale, ());
+
+      vector<Segment> unpacked;
+      TEST(graph.UnpackPath(result.m_path, cancellable, unpacked), ());
+      TEST_GREATER_OR_EQUAL(unpacked.size(), result.m_path.size(), ());
+      TEST_EQUAL(unpacked.front(), starter->GetStartSegment(), ());
+      TEST_EQUAL(unpacked.back(), starter->GetFinishSegment(), ());
+      for (size_t i = 0; i + 1 < unpacked.size(); ++i)
+      {
+        TEST(AlmostEqualAbs(starter->GetPoint(unpacked[i], true /* front */),
+                            starter->GetPoint(unpacked[i + 1], false /* front */), 1e-9),
+             (unpacked[i], unpacked[i + 1]));
+      }
+    }
+  }
+}
+}  // namespace routing_shortcuts_test
@@ -0,0 +1,123 @@
+#include "testing/testing.hpp"
+
+#include "routing/routing_tests/index_graph_tools.hpp"
+
+#include "routing/routing_snap_index.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace routing_snap_index_test
+{
+using namespace routing;
+using namespace routing_test;
+using namespace std;
+
+RoutingSnapIndex::Road MakeRoad(vector<m2::PointD> const & points, VehicleMask roadMask, VehicleMask oneWayMask = 0)
+{
+  RoutingSnapIndex::Road road;
+  road.m_roadMask = roadMask;
+  road.m_oneWayMask = oneWayMask;
+  road.m_points = points;
+  return road;
+}
+
+unique_ptr<RoutingSnapIndex> Serialize(map<uint32_t, RoutingSnapIndex::Road> const & roads, vector<uint8_t> & buffer)
+{
+  buffer.clear();
+  MemWriter<vector<uint8_t>> writer(buffer);
+  RoutingSnapIndex::Serialize(writer, roads);
+  return make_unique<RoutingSnapIndex>(make_unique<MemReader>(buffer.data(), buffer.size()));
+}
+
+vector<uint32_t> FindRoads(RoutingSnapIndex const & index, m2::RectD const & rect, VehicleType vehicleType)
+{
+  vector<uint32_t> featureIds;
+  index.ForEachRoadInRect(rect, vehicleType, [&](uint32_t featureId) { featureIds.push_back(featureId); });
+  return featureIds;
+}
+
+void Load(vector<uint8_t> const & buffer)
+{
+  RoutingSnapIndex const index(make_unique<MemReader>(buffer.data(), buffer.size()));
+}
+
+UNIT_TEST(RoutingSnapIndex_FindRoads)
+{
+  map<uint32_t, RoutingSnapIndex::Road> const roads = {
+      {1, MakeRoad({{0.0, 0.0}, {0.001, 0.0}, {0.002, 0.001}}, kCarMask | kPedestrianMask, kCarMask)},
+      {2, MakeRoad({{0.0005, -0.001}, {0.0005, 0.001}}, kPedestrianMask)},
+      // Far from the others.
+      {4, MakeRoad({{1.0, 1.0}, {1.001, 1.0}}, kAllVehiclesMask)}};
+
+  vector<uint8_t> buffer;
+  auto const index = Serialize(roads, buffer);
+  TEST_EQUAL(index->GetFeaturesCount(), 5, ());
+
+  m2::RectD const rect(-0.0001, -0.0001, 0.0011, 0.0001);
+  TEST_EQUAL(FindRoads(*index, rect, VehicleType::Car), vector<uint32_t>({1}), ());
+  TEST_EQUAL(FindRoads(*index, rect, VehicleType::Pedestrian), vector<uint32_t>({1, 2}), ());
+  // Transit uses pedestrian roads.
+  TEST_EQUAL(FindRoads(*index, rect, VehicleType::Transit), vector<uint32_t>({1, 2}), ());
+  TEST(FindRoads(*index, rect, VehicleType::Bicycle).empty(), ());
+
+  TEST_EQUAL(FindRoads(*index, m2::RectD(0.999, 0.999, 1.0001, 1.0001), VehicleType::Bicycle), vector<uint32_t>({4}),
+             ());
+  TEST(FindRoads(*index, m2::RectD(10.0, 10.0, 10.1, 10.1), VehicleType::Car).empty(), ());
+
+  TEST(index->IsOneWay(1, VehicleType::Car), ());
+  TEST(!index->IsOneWay(1, VehicleType::Pedestrian), ());
+  TEST(!index->IsOneWay(4, VehicleType::Car), ());
+  TEST(!index->IsOneWay(index->GetFeaturesCount(), VehicleType::Car), ());
+}
+
+// A long segment is found in every cell along it, but not in the cells far from it.
+UNIT_TEST(RoutingSnapIndex_LongSegment)
+{
+  map<uint32_t, RoutingSnapIndex::Road> const roads = {{0, MakeRoad({{0.0, 0.0}, {1.0, 1.0}}, kCarMask)}};
+
+  vector<uint8_t> buffer;
+  auto const index = Serialize(roads, buffer);
+  TEST_GREATER(index->GetCellsCount(), 100, ());
+
+  for (double d = 0.0; d <= 1.0; d += 0.05)
+  {
+    auto const rect = m2::RectD(d - 0.0001, d - 0.0001, d + 0.0001, d + 0.0001);
+    TEST_EQUAL(FindRoads(*index, rect, VehicleType::Car), vector<uint32_t>({0}), (d));
+  }
+
+  TEST(FindRoads(*index, m2::RectD(0.0, 0.9, 0.1, 1.0), VehicleType::Car).empty(), ());
+  TEST(FindRoads(*index, m2::RectD(0.9, 0.0, 1.0, 0.1), VehicleType::Car).empty(), ());
+}
+
+UNIT_TEST(RoutingSnapIndex_Empty)
+{
+  vector<uint8_t> buffer;
+  auto const index = Serialize({}, buffer);
+  TEST_EQUAL(index->GetFeaturesCount(), 0, ());
+  TEST(FindRoads(*index, m2::RectD(-1.0, -1.0, 1.0, 1.0), VehicleType::Car).empty(), ());
+  TEST(!index->IsOneWay(0 /* featureId */, VehicleType::Car), ());
+}
+
+UNIT_TEST(RoutingSnapIndex_Corrupted)
+{
+  map<uint32_t, RoutingSnapIndex::Road> const roads = {{0, MakeRoad({{0.0, 0.0}, {0.001, 0.002}}, kCarMask)}};
+
+  vector<uint8_t> buffer;
+  Serialize(roads, buffer);
+  TestSectionCorruption(buffer, Load);
+
+  // Cell bits follow the version.
+  auto wrongCellBits = buffer;
+  wrongCellBits[2] = 0;
+  TEST(IsSectionCorrupted(wrongCellBits, Load), ());
+}
+}  // namespace routing_snap_index_test
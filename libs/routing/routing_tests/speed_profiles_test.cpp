@@ -0,0 +1,333 @@
+#include "testing/testing.hpp"
+
+#include "generator/generator_tests_support/routing_helpers.hpp"
+
+#include "routing/routing_tests/index_graph_tools.hpp"
+
+#include "routing/base/astar_algorithm.hpp"
+#include "routing/base/routing_result.hpp"
+
+#include "routing/fake_ending.hpp"
+#include "routing/geometry.hpp"
+#include "routing/index_graph.hpp"
+#include "routing/index_graph_starter.hpp"
+#include "routing/index_graph_starter_joints.hpp"
+#include "routing/joint_segment.hpp"
+#include "routing/routing_helpers.hpp"
+#include "routing/single_vehicle_world_graph.hpp"
+#include "routing/speed_profiles.hpp"
+
+#include "traffic/traffic_cache.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace speed_profiles_test
+{
+using namespace routing;
+using namespace routing_test;
+using namespace std;
+
+// Monday, 1 January 2024, 00:00 UTC.
+time_t constexpr kMonday = 1704067200;
+time_t constexpr kHour = 60 * 60;
+
+SpeedProfiles::Profile MakeProfile(uint8_t factor)
+{
+  SpeedProfiles::Profile profile;
+  profile.fill(factor);
+  return profile;
+}
+
+// The profile is slow on Monday from |fromHour| till |toHour|.
+SpeedProfiles::Profile MakeRushHourProfile(uint32_t fromHour, uint32_t toHour, double factor)
+{
+  auto profile = MakeProfile(SpeedProfiles::kMaxQuantizedFactor);
+  uint32_t const bucketsPerHour = 60 / SpeedProfiles::kBucketMinutes;
+  for (uint32_t bucket = fromHour * bucketsPerHour; bucket < toHour * bucketsPerHour; ++bucket)
+    profile[bucket] = SpeedProfiles::QuantizeFactor(factor);
+  return profile;
+}
+
+shared_ptr<SpeedProfiles> Serialize(map<SpeedProfiles::SegmentKey, SpeedProfiles::Profile> const & profiles,
+                                    vector<uint8_t> & buffer)
+{
+  buffer.clear();
+  MemWriter<vector<uint8_t>> writer(buffer);
+  SpeedProfiles::Serialize(writer, profiles);
+
+  auto speedProfiles = make_shared<SpeedProfiles>();
+  speedProfiles->Deserialize(MemReader(buffer.data(), buffer.size()));
+  return speedProfiles;
+}
+
+void Load(vector<uint8_t> const & buffer)
+{
+  SpeedProfiles speedProfiles;
+  speedProfiles.Deserialize(MemReader(buffer.data(), buffer.size()));
+}
+
+UNIT_TEST(SpeedProfiles_Bucket)
+{
+  TEST_EQUAL(SpeedProfiles::GetBucket(kMonday), 0, ());
+  TEST_EQUAL(SpeedProfiles::GetBucket(kMonday + 15 * 60 - 1), 0, ());
+  TEST_EQUAL(SpeedProfiles::GetBucket(kMonday + 15 * 60), 1, ());
+  TEST_EQUAL(SpeedProfiles::GetBucket(kMonday + 7 * 24 * kHour - 1), SpeedProfiles::kBucketsCount - 1, ());
+  TEST_EQUAL(SpeedProfiles::GetBucket(kMonday + 7 * 24 * kHour), 0, ());
+  // 1 January 1970 was Thursday.
+  TEST_EQUAL(SpeedProfiles::GetBucket(0), 3 * 24 * 4, ());
+}
+
+UNIT_TEST(SpeedProfiles_QuantizeFactor)
+{
+  TEST_EQUAL(SpeedProfiles::QuantizeFactor(1.0), SpeedProfiles::kMaxQuantizedFactor, ());
+  TEST_EQUAL(SpeedProfiles::QuantizeFactor(2.0), SpeedProfiles::kMaxQuantizedFactor, ());
+  TEST_EQUAL(SpeedProfiles::QuantizeFactor(0.5), 128, ());
+  // A factor is never zero.
+  TEST_EQUAL(SpeedProfiles::QuantizeFactor(0.0), 1, ());
+}
+
+UNIT_TEST(SpeedProfiles_Serialization)
+{
+  auto const rushHour = MakeRushHourProfile(8 /* fromHour */, 9 /* toHour */, 0.5 /* factor */);
+  map<SpeedProfiles::SegmentKey, SpeedProfiles::Profile> const profiles = {
+      {{2 /* featureId */, 1 /* segmentIdx */, true /* forward */}, rushHour},
+      {{2 /* featureId */, 1 /* segmentIdx */, false /* forward */}, MakeProfile(51)},
+      {{5 /* featureId */, 0 /* segmentIdx */, true /* forward */}, rushHour},
+  };
+
+  vector<uint8_t> buffer;
+  auto const speedProfiles = Serialize(profiles, buffer);
+  // Equal profiles are stored once.
+  TEST_EQUAL(speedProfiles->GetProfilesCount(), 2, ());
+
+  uint32_t const morning = SpeedProfiles::GetBucket(kMonday + 8 * kHour);
+  uint32_t const noon = SpeedProfiles::GetBucket(kMonday + 12 * kHour);
+  auto const getFactor = [&](uint32_t featureId, uint32_t segmentIdx, bool forward, uint32_t bucket)
+  { return speedProfiles->GetFactor(Segment(kTestNumMwmId, featureId, segmentIdx, forward), bucket); };
+
+  TEST_ALMOST_EQUAL_ABS(getFactor(2, 1, true, morning), 128.0 / 255.0, 1e-9, ());
+  TEST_ALMOST_EQUAL_ABS(getFactor(2, 1, true, noon), 1.0, 1e-9, ());
+  TEST_ALMOST_EQUAL_ABS(getFactor(2, 1, false, noon), 0.2, 1e-9, ());
+  TEST_ALMOST_EQUAL_ABS(getFactor(5, 0, true, morning), 128.0 / 255.0, 1e-9, ());
+
+  // Segments without profiles.
+  TEST_EQUAL(getFactor(2, 0, true, morning), 1.0, ());
+  TEST_EQUAL(getFactor(2, 2, true, morning), 1.0, ());
+  TEST_EQUAL(getFactor(5, 0, false, morning), 1.0, ());
+  TEST_EQUAL(getFactor(0, 0, true, morning), 1.0, ());
+  TEST_EQUAL(getFactor(3, 0, true, morning), 1.0, ());
+  TEST_EQUAL(getFactor(100, 0, true, morning), 1.0, ());
+
+  // Empty section.
+  auto const empty = Serialize({}, buffer);
+  TEST_EQUAL(empty->GetProfilesCount(), 0, ());
+  TEST_EQUAL(empty->GetFactor(Segment(kTestNumMwmId, 0, 0, true), morning), 1.0, ());
+}
+
+UNIT_TEST(SpeedProfiles_Corrupted)
+{
+  map<SpeedProfiles::SegmentKey, SpeedProfiles::Profile> const profiles = {
+      {{1 /* featureId */, 0 /* segmentIdx */, true /* forward */}, MakeProfile(100)}};
+
+  vector<uint8_t> buffer;
+  Serialize(profiles, buffer);
+  TestSectionCorruption(buffer, Load);
+
+  // Forward and backward profile ids of the segment are the last two uint16.
+  auto wrongProfileId = buffer;
+  wrongProfileId[wrongProfileId.size() - 4] = 7;
+  wrongProfileId[wrongProfileId.size() - 3] = 0;
+  TEST(IsSectionCorrupted(wrongProfileId, Load), ());
+}
+
+// Start F2 goes from (0, 0) to (0, 2), roads F0 and F1 go from (0, 2) to (0, 4) and F3 goes from (0, 4)
+// to the finish at (0, 6), the unit is 0.001. F0 is straight and F1 makes a detour, all the roads are one way.
+// The roads are short, so the route takes minutes and is inside of a rush hour if it starts there.
+unique_ptr<IndexGraph> BuildRoadsGraph(shared_ptr<EdgeEstimator> estimator)
+{
+  auto loader = make_unique<TestGeometryLoader>();
+  loader->AddRoad(0 /* featureId */, true /* oneWay */, 1.0 /* speed */,
+                  RoadGeometry::Points({{0.0, 0.002}, {0.0, 0.003}, {0.0, 0.004}}));
+  loader->AddRoad(1 /* featureId */, true /* oneWay */, 1.0 /* speed */,
+                  RoadGeometry::Points({{0.0, 0.002}, {0.001, 0.002}, {0.001, 0.004}, {0.0, 0.004}}));
+  loader->AddRoad(2 /* featureId */, true /* oneWay */, 1.0 /* speed */,
+                  RoadGeometry::Points({{0.0, 0.0}, {0.0, 0.001}, {0.0, 0.002}}));
+  loader->AddRoad(3 /* featureId */, true /* oneWay */, 1.0 /* speed */,
+                  RoadGeometry::Points({{0.0, 0.004}, {0.0, 0.005}, {0.0, 0.006}}));
+
+  vector<Joint> const joints = {
+      MakeJoint({{2, 2}, {0, 0}, {1, 0}}), /* joint at point (0, 2) */
+      MakeJoint({{0, 2}, {1, 3}, {3, 0}}), /* joint at point (0, 4) */
+      MakeJoint({{2, 0}}),                 /* joint at point (0, 0) */
+      MakeJoint({{3, 2}}),                 /* joint at point (0, 6) */
+  };
+
+  return BuildIndexGraph(std::move(loader), estimator, joints);
+}
+
+unique_ptr<SingleVehicleWorldGraph> BuildGraph()
+{
+  traffic::TrafficCache const trafficCache;
+  shared_ptr<EdgeEstimator> estimator = CreateEstimatorForCar(trafficCache);
+  auto indexLoader = make_unique<TestIndexGraphLoader>();
+  indexLoader->AddGraph(kTestNumMwmId, BuildRoadsGraph(estimator));
+  return make_unique<SingleVehicleWorldGraph>(nullptr /* crossMwmGraph */, std::move(indexLoader), estimator,
+                                              MwmHierarchyHandler());
+}
+
+NumMwmId constexpr kFirstMwmId = kTestNumMwmId + 1;
+
+// The roads of BuildRoadsGraph() are in kTestNumMwmId. F0 of kFirstMwmId goes from (0, -0.009) to (0, 0.001)
+// and its last segment is the twin of the first segment of F2 of kTestNumMwmId.
+unique_ptr<SingleVehicleWorldGraph> BuildTwoMwmsGraph()
+{
+  auto loader = make_unique<TestGeometryLoader>();
+  RoadGeometry::Points points;
+  for (int32_t i = -9; i <= 1; ++i)
+    points.emplace_back(0.0, i * 0.001);
+  loader->AddRoad(0 /* featureId */, true /* oneWay */, 1.0 /* speed */, points);
+
+  vector<Joint> const joints = {
+      MakeJoint({{0, 0}}),  /* joint at point (0, -0.009) */
+      MakeJoint({{0, 10}}), /* joint at point (0, 0.001) */
+  };
+
+  traffic::TrafficCache const trafficCache;
+  shared_ptr<EdgeEstimator> estimator = CreateEstimatorForCar(trafficCache);
+  auto indexLoader = make_unique<TestIndexGraphLoader>();
+  indexLoader->AddGraph(kFirstMwmId, BuildIndexGraph(std::move(loader), estimator, joints));
+  indexLoader->AddGraph(kTestNumMwmId, BuildRoadsGraph(estimator));
+  return make_unique<SingleVehicleWorldGraph>(nullptr /* crossMwmGraph */, std::move(indexLoader), estimator,
+                                              MwmHierarchyHandler());
+}
+
+vector<uint32_t> FindRouteFeatures(SingleVehicleWorldGraph & graph)
+{
+  auto const start = MakeFakeEnding(2 /* featureId */, 0 /* segmentIdx */, m2::PointD(0.0, 0.0), graph);
+  auto const finish = MakeFakeEnding(3 /* featureId */, 1 /* segmentIdx */, m2::PointD(0.0, 0.006), graph);
+  auto starter = MakeStarter(start, finish, graph);
+
+  // Time-dependent weights are correct for the forward wave only.
+  AlgorithmForWorldGraph::ParamsForTests<AStarLengthChecker> params(
+      *starter, starter->GetStartSegment(), starter->GetFinishSegment(), AStarLengthChecker(*starter));
+  RoutingResult<Segment, RouteWeight> routingResult;
+  TEST_EQUAL(AlgorithmForWorldGraph().FindPath(params, routingResult), AlgorithmForWorldGraph::Result::OK, ());
+
+  vector<uint32_t> featureIds;
+  for (auto const & segment : routingResult.m_path)
+  {
+    if (!starter->IsFakeSegment(segment) && (featureIds.empty() || featureIds.back() != segment.GetFeatureId()))
+      featureIds.push_back(segment.GetFeatureId());
+  }
+  return featureIds;
+}
+
+UNIT_TEST(SpeedProfiles_TimeDependentRoute)
+{
+  auto graph = BuildGraph();
+  vector<uint32_t> const straight = {2, 0, 3};
+  vector<uint32_t> const detour = {2, 1, 3};
+  TEST_EQUAL(FindRouteFeatures(*graph), straight, ());
+
+  auto const rushHour = MakeRushHourProfile(8 /* fromHour */, 10 /* toHour */, 0.1 /* factor */);
+  map<SpeedProfiles::SegmentKey, SpeedProfiles::Profile> const profiles = {
+      {{0 /* featureId */, 0 /* segmentIdx */, true /* forward */}, rushHour},
+      {{0 /* featureId */, 1 /* segmentIdx */, true /* forward */}, rushHour}};
+  vector<uint8_t> buffer;
+  auto const speedProfiles = Serialize(profiles, buffer);
+
+  auto & indexGraph = graph->GetIndexGraphForTests(kTestNumMwmId);
+  indexGraph.SetSpeedProfiles(speedProfiles, kMonday + 8 * kHour);
+  TEST_EQUAL(FindRouteFeatures(*graph), detour, ());
+
+  indexGraph.SetSpeedProfiles(speedProfiles, kMonday + 12 * kHour);
+  TEST_EQUAL(FindRouteFeatures(*graph), straight, ());
+
+  // Weight of the segment is multiplied in the forward direction with time to the segment only.
+  Segment const from(kTestNumMwmId, 2, 1, true /* forward */);
+  Segment const to(kTestNumMwmId, 0, 0, true /* forward */);
+  indexGraph.SetSpeedProfiles(speedProfiles, kMonday + 8 * kHour);
+  double const staticWeight =
+      indexGraph.CalculateEdgeWeight(EdgeEstimator::Purpose::Weight, true /* isOutgoing */, from, to).GetWeight();
+  double const rushHourWeight = indexGraph
+                                    .CalculateEdgeWeight(EdgeEstimator::Purpose::Weight, true /* isOutgoing */, from,
+                                                         to, RouteWeight(10.0))
+                                    .GetWeight();
+  TEST_ALMOST_EQUAL_ABS(rushHourWeight, staticWeight * 255.0 / 26.0, 1e-6, ());
+  double const backwardWeight = indexGraph
+                                    .CalculateEdgeWeight(EdgeEstimator::Purpose::Weight, false /* isOutgoing */, to,
+                                                         from, RouteWeight(10.0))
+                                    .GetWeight();
+  TEST_ALMOST_EQUAL_ABS(backwardWeight, staticWeight, 1e-6, ());
+}
+
+// Finds the route from |beg| to |end| like IndexRouter finds a leap of LeapsOnly mode.
+RoutingResult<JointSegment, RouteWeight> FindLeap(IndexGraphStarter & starter, Segment const & beg,
+                                                  Segment const & end, RouteWeight const & startTime)
+{
+  starter.SetStartTime(startTime);
+  IndexGraphStarterJoints<IndexGraphStarter> jointStarter(starter);
+  jointStarter.Init(beg, end);
+
+  using Algorithm = AStarAlgorithm<JointSegment, JointEdge, RouteWeight>;
+  Algorithm::ParamsForTests<AStarLengthChecker> params(jointStarter, jointStarter.GetStartJoint(),
+                                                       jointStarter.GetFinishJoint(), AStarLengthChecker(starter));
+  RoutingResult<JointSegment, RouteWeight> routingResult;
+  TEST_EQUAL(Algorithm().FindPath(params, routingResult), Algorithm::Result::OK, ());
+  return routingResult;
+}
+
+vector<uint32_t> GetFeatures(RoutingResult<JointSegment, RouteWeight> const & routingResult)
+{
+  vector<uint32_t> featureIds;
+  for (auto const & joint : routingResult.m_path)
+    if (!joint.IsFake() && (featureIds.empty() || featureIds.back() != joint.GetFeatureId()))
+      featureIds.push_back(joint.GetFeatureId());
+  return featureIds;
+}
+
+// The second leap of the route starts in the rush hour, though the route departs before it.
+UNIT_TEST(SpeedProfiles_LeapStartTime)
+{
+  auto graph = BuildTwoMwmsGraph();
+  graph->SetMode(WorldGraphMode::JointSingleMwm);
+  auto const start =
+      MakeFakeEnding({Segment(kFirstMwmId, 0, 0, true /* forward */)}, m2::PointD(0.0, -0.009), *graph);
+  auto const finish =
+      MakeFakeEnding({Segment(kTestNumMwmId, 3, 1, true /* forward */)}, m2::PointD(0.0, 0.006), *graph);
+  auto starter = MakeStarter(start, finish, *graph);
+
+  Segment const exit(kFirstMwmId, 0, 9, true /* forward */);
+  Segment const enter(kTestNumMwmId, 2, 0, true /* forward */);
+  auto const firstLeap = FindLeap(*starter, starter->GetStartSegment(), exit, GetAStarWeightZero<RouteWeight>());
+  TEST_GREATER(firstLeap.m_distance.GetWeight(), 0.0, ());
+
+  auto const rushHour = MakeRushHourProfile(8 /* fromHour */, 10 /* toHour */, 0.1 /* factor */);
+  map<SpeedProfiles::SegmentKey, SpeedProfiles::Profile> const profiles = {
+      {{0 /* featureId */, 0 /* segmentIdx */, true /* forward */}, rushHour},
+      {{0 /* featureId */, 1 /* segmentIdx */, true /* forward */}, rushHour}};
+  vector<uint8_t> buffer;
+  auto const speedProfiles = Serialize(profiles, buffer);
+
+  // The rush hour starts in the middle of the first leap.
+  time_t const departureTime = kMonday + 8 * kHour - static_cast<time_t>(firstLeap.m_distance.GetWeight() / 2);
+  graph->GetIndexGraphForTests(kTestNumMwmId).SetSpeedProfiles(speedProfiles, departureTime);
+
+  // The parts of F2 and F3 of the leap are fake joints.
+  vector<uint32_t> const straight = {0};
+  vector<uint32_t> const detour = {1};
+  TEST_EQUAL(GetFeatures(FindLeap(*starter, enter, starter->GetFinishSegment(), firstLeap.m_distance)), detour, ());
+  // The same leap at the departure time is before the rush hour.
+  TEST_EQUAL(GetFeatures(FindLeap(*starter, enter, starter->GetFinishSegment(), GetAStarWeightZero<RouteWeight>())),
+             straight, ());
+}
+}  // namespace speed_profiles_test
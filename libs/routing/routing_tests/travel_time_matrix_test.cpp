@@ -0,0 +1,132 @@
+#include "testing/testing.hpp"
+
+#include "routing/routing_tests/index_graph_tools.hpp"
+
+#include "routing/base/astar_algorithm.hpp"
+#include "routing/fake_ending.hpp"
+#include "routing/index_graph_starter.hpp"
+#include "routing/travel_time_matrix.hpp"
+
+#include "base/cancellable.hpp"
+#include "base/math.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace travel_time_matrix_test
+{
+using namespace routing;
+using namespace routing_test;
+using namespace std;
+
+uint32_t constexpr kCitySize = 6;
+double constexpr kBlockSize = 0.01;
+double constexpr kEpsilon = 1e-6;
+
+vector<FakeEnding> MakeEndings(WorldGraph & graph)
+{
+  vector<FakeEnding> endings;
+  for (uint32_t featureId = 0; featureId < kCitySize; featureId += 2)
+  {
+    for (uint32_t segmentIdx = 0; segmentIdx < kCitySize - 1; segmentIdx += 2)
+    {
+      endings.push_back(MakeFakeEnding(featureId + 1, segmentIdx,
+                                       m2::PointD((0.3 + segmentIdx) * kBlockSize, (featureId + 1) * kBlockSize),
+                                       graph));
+      endings.push_back(MakeFakeEnding(featureId + kCitySize, segmentIdx,
+                                       m2::PointD(featureId * kBlockSize, (0.6 + segmentIdx) * kBlockSize), graph));
+    }
+  }
+  return endings;
+}
+
+double CalcTimeSec(FakeEnding const & start, FakeEnding const & finish, WorldGraph & graph)
+{
+  auto starter = MakeStarter(start, finish, graph);
+  AlgorithmForWorldGraph::ParamsForTests<AStarLengthChecker> params(
+      *starter, starter->GetStartSegment(), starter->GetFinishSegment(), AStarLengthChecker(*starter));
+
+  RoutingResult<Segment, RouteWeight> result;
+  TEST_EQUAL(AlgorithmForWorldGraph().FindPath(params, result), AlgorithmForWorldGraph::Result::OK, ());
+  return result.m_distance.GetWeight();
+}
+
+// Matrix times should be equal to times of routes found by A* for every pair.
+UNIT_TEST(TravelTimeMatrix_Manhattan)
+{
+  traffic::TrafficCache const trafficCache;
+  auto worldGraph = BuildManhattan(trafficCache, kCitySize, kBlockSize, true /* oneWay */, WorldGraphMode::NoLeaps);
+  auto const endings = MakeEndings(*worldGraph);
+
+  TravelTimeMatrix matrix;
+  TEST_EQUAL(CalculateTravelTimeMatrix(*worldGraph, endings, endings, 1e9 /* maxTimeSec */, base::Cancellable(),
+                                       matrix),
+             RouterResultCode::NoError, ());
+  TEST_EQUAL(matrix.GetSourcesCount(), endings.size(), ());
+  TEST_EQUAL(matrix.GetTargetsCount(), endings.size(), ());
+
+  for (size_t i = 0; i < endings.size(); ++i)
+  {
+    for (size_t j = 0; j < endings.size(); ++j)
+    {
+      double const expectedTimeSec = CalcTimeSec(endings[i], endings[j], *worldGraph);
+      TEST(AlmostEqualAbsOrRel(matrix.Get(i, j), expectedTimeSec, kEpsilon), (i, j, matrix.Get(i, j), expectedTimeSec));
+    }
+  }
+}
+
+UNIT_TEST(TravelTimeMatrix_MaxTime)
+{
+  traffic::TrafficCache const trafficCache;
+  auto worldGraph = BuildManhattan(trafficCache, kCitySize, kBlockSize, true /* oneWay */, WorldGraphMode::NoLeaps);
+  auto const endings = MakeEndings(*worldGraph);
+  vector<FakeEnding> const sources(endings.begin(), endings.begin() + 3);
+
+  // Time of a route along one block.
+  double const maxTimeSec = CalcTimeSec(MakeFakeEnding(kCitySize, 0, m2::PointD(0.0, 0.0), *worldGraph),
+                                        MakeFakeEnding(kCitySize, 0, m2::PointD(0.0, kBlockSize), *worldGraph),
+                                        *worldGraph) * 2.5;
+
+  TravelTimeMatrix matrix;
+  TEST_EQUAL(CalculateTravelTimeMatrix(*worldGraph, sources, endings, maxTimeSec, base::Cancellable(), matrix),
+             RouterResultCode::NoError, ());
+
+  size_t unreachableCount = 0;
+  for (size_t i = 0; i < sources.size(); ++i)
+  {
+    for (size_t j = 0; j < endings.size(); ++j)
+    {
+      double const expectedTimeSec = CalcTimeSec(sources[i], endings[j], *worldGraph);
+      if (expectedTimeSec > maxTimeSec)
+      {
+        TEST_EQUAL(matrix.Get(i, j), TravelTimeMatrix::kNoRoute, (i, j, expectedTimeSec));
+        ++unreachableCount;
+      }
+      else
+      {
+        TEST(AlmostEqualAbsOrRel(matrix.Get(i, j), expectedTimeSec, kEpsilon), (i, j, matrix.Get(i, j), expectedTimeSec));
+      }
+    }
+  }
+  TEST_GREATER(unreachableCount, 0, ());
+}
+
+UNIT_TEST(TravelTimeMatrix_NoProjections)
+{
+  traffic::TrafficCache const trafficCache;
+  auto worldGraph = BuildManhattan(trafficCache, kCitySize, kBlockSize, true /* oneWay */, WorldGraphMode::NoLeaps);
+  auto const endings = MakeEndings(*worldGraph);
+  vector<FakeEnding> const targets = {endings.front(), FakeEnding()};
+
+  TravelTimeMatrix matrix;
+  TEST_EQUAL(CalculateTravelTimeMatrix(*worldGraph, {FakeEnding(), endings.back()}, targets, 1e9 /* maxTimeSec */,
+                                       base::Cancellable(), matrix),
+             RouterResultCode::NoError, ());
+  TEST_EQUAL(matrix.Get(0, 0), TravelTimeMatrix::kNoRoute, ());
+  TEST_EQUAL(matrix.Get(0, 1), TravelTimeMatrix::kNoRoute, ());
+  TEST_EQUAL(matrix.Get(1, 1), TravelTimeMatrix::kNoRoute, ());
+  double const expectedTimeSec = CalcTimeSec(endings.back(), endings.front(), *worldGraph);
+  TEST(AlmostEqualAbsOrRel(matrix.Get(1, 0), expectedTimeSec, kEpsilon), (matrix.Get(1, 0), expectedTimeSec));
+}
+}  // namespace travel_time_matrix_test
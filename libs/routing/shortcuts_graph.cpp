@@ -0,0 +1,157 @@
+#include "routing/shortcuts_graph.hpp"
+
+#include "routing/base/astar_algorithm.hpp"
+#include "routing/base/routing_result.hpp"
+#include "routing/index_graph_starter.hpp"
+
+#include "base/assert.hpp"
+#include "base/stl_helpers.hpp"
+
+#include <algorithm>
+#include <set>
+
+namespace routing
+{
+using namespace std;
+
+ShortcutsGraph::ShortcutsGraph(IndexGraphStarter & starter, RoutingShortcuts const & shortcuts)
+  : m_starter(starter)
+  , m_shortcuts(shortcuts)
+{
+  CHECK_EQUAL(m_starter.GetMode(), WorldGraphMode::SingleMwm, ());
+
+  AddEndingCells(m_starter.GetStartSegment(), true /* isOutgoing */);
+  AddEndingCells(m_starter.GetFinishSegment(), false /* isOutgoing */);
+  base::SortUnique(m_endingCells);
+}
+
+void ShortcutsGraph::GetOutgoingEdgesList(astar::VertexData<Vertex, Weight> const & vertexData, EdgeListT & edges)
+{
+  auto const & segment = vertexData.m_vertex;
+  if (IsInEndingCell(segment, true /* front */))
+    return m_starter.GetOutgoingEdgesList(vertexData, edges);
+
+  edges.clear();
+  m_shortcuts.ForEachShortcutFrom(segment, [&edges](Segment const & exit, RouteWeight const & weight)
+  { edges.emplace_back(exit, weight); });
+}
+
+void ShortcutsGraph::GetIngoingEdgesList(astar::VertexData<Vertex, Weight> const & vertexData, EdgeListT & edges)
+{
+  auto const & segment = vertexData.m_vertex;
+  if (IsInEndingCell(segment, false /* front */))
+    return m_starter.GetIngoingEdgesList(vertexData, edges);
+
+  edges.clear();
+  m_shortcuts.ForEachShortcutTo(segment, [&edges](Segment const & enter, RouteWeight const & weight)
+  { edges.emplace_back(enter, weight); });
+}
+
+RouteWeight ShortcutsGraph::HeuristicCostEstimate(Segment const & from, Segment const & to)
+{
+  return m_starter.HeuristicCostEstimate(from, to);
+}
+
+void ShortcutsGraph::SetAStarParents(bool forward, Parents & parents)
+{
+  m_starter.SetAStarParents(forward, parents);
+}
+
+void ShortcutsGraph::DropAStarParents()
+{
+  m_starter.DropAStarParents();
+}
+
+bool ShortcutsGraph::AreWavesConnectible(Parents & forwardParents, Vertex const & commonVertex,
+                                         Parents & backwardParents)
+{
+  return m_starter.AreWavesConnectible(forwardParents, commonVertex, backwardParents);
+}
+
+RouteWeight ShortcutsGraph::GetAStarWeightEpsilon()
+{
+  return m_starter.GetAStarWeightEpsilon();
+}
+
+Segment ShortcutsGraph::GetStartSegment() const
+{
+  return m_starter.GetStartSegment();
+}
+
+Segment ShortcutsGraph::GetFinishSegment() const
+{
+  return m_starter.GetFinishSegment();
+}
+
+ms::LatLon const & ShortcutsGraph::GetPoint(Segment const & segment, bool front) const
+{
+  return m_starter.GetPoint(segment, front);
+}
+
+bool ShortcutsGraph::UnpackPath(vector<Segment> const & path, base::Cancellable const & cancellable,
+                                vector<Segment> & result) const
+{
+  using Algorithm = AStarAlgorithm<Segment, SegmentEdge, RouteWeight>;
+
+  result.clear();
+  result.reserve(path.size());
+  for (size_t i = 0; i < path.size(); ++i)
+  {
+    result.push_back(path[i]);
+    if (i + 1 == path.size() || IsInEndingCell(path[i], true /* front */))
+      continue;
+
+    // |path[i]| is an enter of a cell without route endings and |path[i + 1]| is an exit of the cell.
+    Segment const & enter = path[i];
+    Segment const & exit = path[i + 1];
+    auto const cellId = m_shortcuts.GetCell(GetPoint(enter, true /* front */));
+    ShortcutCellGraph cellGraph(m_starter.GetGraph().GetIndexGraph(enter.GetMwmId()), m_shortcuts.GetSplits(), cellId);
+
+    Algorithm::Params<> params(cellGraph, enter, exit, cancellable);
+    RoutingResult<Segment, RouteWeight> cellResult;
+    if (Algorithm().FindPath(params, cellResult) != Algorithm::Result::OK)
+      return false;
+
+    CHECK_GREATER_OR_EQUAL(cellResult.m_path.size(), 2, ());
+    result.insert(result.end(), cellResult.m_path.cbegin() + 1, cellResult.m_path.cend() - 1);
+  }
+  return true;
+}
+
+void ShortcutsGraph::AddEndingCells(Segment const & ending, bool isOutgoing)
+{
+  // Ending is connected to real segments through a few fake ones. Cells of both ends of every
+  // real segment the ending is projected to are searched without shortcuts.
+  set<Segment> visited = {ending};
+  vector<Segment> queue = {ending};
+  IndexGraphStarter::EdgeListT edges;
+  while (!queue.empty())
+  {
+    Segment segment = queue.back();
+    queue.pop_back();
+
+    if (m_starter.ConvertToReal(segment))
+    {
+      m_endingCells.push_back(m_shortcuts.GetCell(m_starter.GetPoint(segment, true /* front */)));
+      m_endingCells.push_back(m_shortcuts.GetCell(m_starter.GetPoint(segment, false /* front */)));
+      continue;
+    }
+
+    m_starter.GetEdgesList(segment, isOutgoing, edges);
+    for (auto const & edge : edges)
+    {
+      if (visited.insert(edge.GetTarget()).second)
+        queue.push_back(edge.GetTarget());
+    }
+  }
+}
+
+bool ShortcutsGraph::IsInEndingCell(Segment const & segment, bool front) const
+{
+  if (IndexGraphStarter::IsFakeSegment(segment))
+    return true;
+
+  auto const cellId = m_shortcuts.GetCell(GetPoint(segment, front));
+  return binary_search(m_endingCells.cbegin(), m_endingCells.cend(), cellId);
+}
+}  // namespace routing
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "routing/base/astar_graph.hpp"
+#include "routing/base/astar_vertex_data.hpp"
+#include "routing/route_weight.hpp"
+#include "routing/routing_shortcuts.hpp"
+#include "routing/segment.hpp"
+
+#include "geometry/latlon.hpp"
+
+#include "base/cancellable.hpp"
+
+#include <vector>
+
+namespace routing
+{
+class IndexGraphStarter;
+
+/// \brief Graph for car routing between two points of one mwm with RoutingShortcuts.
+/// Cells which contain the route endings are passed segment by segment as in IndexGraphStarter.
+/// Other cells are passed by shortcuts from their enters directly to their exits. Outgoing edges of
+/// an enter of such a cell are shortcuts to the cell exits and ingoing edges of an exit are
+/// shortcuts from the cell enters, so the forward and backward graphs stay transposed and
+/// AStarAlgorithm::FindPathBidirectional() may be used as is. The starter should be in
+/// WorldGraphMode::SingleMwm.
+/// \note Shortcuts are built without traffic and avoid routing options, so the graph should not be
+/// used when any of them is on.
+/// \note Restrictions with via ways crossing a cell enter are not checked inside shortcuts and
+/// access:conditional is not applied inside shortcuts.
+class ShortcutsGraph : public AStarGraph<Segment, SegmentEdge, RouteWeight>
+{
+public:
+  ShortcutsGraph(IndexGraphStarter & starter, RoutingShortcuts const & shortcuts);
+
+  // AStarGraph overrides:
+  // @{
+  void GetOutgoingEdgesList(astar::VertexData<Vertex, Weight> const & vertexData, EdgeListT & edges) override;
+  void GetIngoingEdgesList(astar::VertexData<Vertex, Weight> const & vertexData, EdgeListT & edges) override;
+  RouteWeight HeuristicCostEstimate(Segment const & from, Segment const & to) override;
+  void SetAStarParents(bool forward, Parents & parents) override;
+  void DropAStarParents() override;
+  bool AreWavesConnectible(Parents & forwardParents, Vertex const & commonVertex, Parents & backwardParents) override;
+  RouteWeight GetAStarWeightEpsilon() override;
+  // @}
+
+  Segment GetStartSegment() const;
+  Segment GetFinishSegment() const;
+  ms::LatLon const & GetPoint(Segment const & segment, bool front) const;
+
+  /// \brief Replaces every shortcut of |path| with the segments it stands for.
+  /// \returns false if the unpacking was cancelled or some shortcut has no path inside its cell.
+  bool UnpackPath(std::vector<Segment> const & path, base::Cancellable const & cancellable,
+                  std::vector<Segment> & result) const;
+
+private:
+  void AddEndingCells(Segment const & ending, bool isOutgoing);
+  // Fake segments are considered to be in ending cells.
+  bool IsInEndingCell(Segment const & segment, bool front) const;
+
+  IndexGraphStarter & m_starter;
+  RoutingShortcuts const & m_shortcuts;
+  // Cells which are passed without shortcuts. There are just a few of them, so a vector is used.
+  std::vector<RoutingShortcuts::CellId> m_endingCells;
+};
+}  // namespace routing
@@ -154,14 +154,16 @@ RouteWeight SingleVehicleWorldGraph::CalcOffroadWeight(ms::LatLon const & from,
   return RouteWeight(m_estimator->CalcOffroad(from, to, purpose));
 }
 
-double SingleVehicleWorldGraph::CalculateETA(Segment const & from, Segment const & to)
+double SingleVehicleWorldGraph::CalculateETA(Segment const & from, Segment const & to,
+                                             optional<RouteWeight const> const & timeToFrom)
 {
   /// @todo Crutch, for example we can loose ferry penalty here (no twin segments), @see Russia_CrossMwm_Ferry.
   if (from.GetMwmId() != to.GetMwmId())
     return CalculateETAWithoutPenalty(to);
 
   auto & indexGraph = m_loader->GetIndexGraph(from.GetMwmId());
-  return indexGraph.CalculateEdgeWeight(EdgeEstimator::Purpose::ETA, true /* isOutgoing */, from, to).GetWeight();
+  return indexGraph.CalculateEdgeWeight(EdgeEstimator::Purpose::ETA, true /* isOutgoing */, from, to, timeToFrom)
+      .GetWeight();
 }
 
 double SingleVehicleWorldGraph::CalculateETAWithoutPenalty(Segment const & segment)
@@ -56,12 +56,14 @@ public:
   RouteWeight CalcLeapWeight(ms::LatLon const & from, ms::LatLon const & to, NumMwmId mwmId) const override;
   RouteWeight CalcOffroadWeight(ms::LatLon const & from, ms::LatLon const & to,
                                 EdgeEstimator::Purpose purpose) const override;
-  double CalculateETA(Segment const & from, Segment const & to) override;
+  double CalculateETA(Segment const & from, Segment const & to,
+                      std::optional<RouteWeight const> const & timeToFrom) override;
   double CalculateETAWithoutPenalty(Segment const & segment) override;
 
   void ForEachTransition(NumMwmId numMwmId, bool isEnter, TransitionFnT const & fn) override;
 
   void SetRoutingOptions(RoutingOptions routingOptions) override { m_avoidRoutingOptions = routingOptions; }
+  RoutingOptions GetAvoidRoutingOptions() const override { return m_avoidRoutingOptions; }
   /// \returns true if feature, associated with segment satisfies users conditions.
   bool IsRoutingOptionsGood(Segment const & segment) override;
   RoutingOptions GetRoutingOptions(Segment const & segment) override;
@@ -70,6 +72,14 @@ public:
   SpeedInUnits GetSpeedLimit(Segment const & segment) override;
 
   IndexGraph & GetIndexGraph(NumMwmId numMwmId) override { return m_loader->GetIndexGraph(numMwmId); }
+  RoutingShortcuts const * GetRoutingShortcuts(NumMwmId numMwmId) override
+  {
+    return m_loader->GetRoutingShortcuts(numMwmId);
+  }
+  RoutingLandmarks const * GetRoutingLandmarks(NumMwmId numMwmId) override
+  {
+    return m_loader->GetRoutingLandmarks(numMwmId);
+  }
 
   void SetAStarParents(bool forward, Parents<Segment> & parents) override;
   void SetAStarParents(bool forward, Parents<JointSegment> & parents) override;
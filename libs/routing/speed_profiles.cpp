@@ -0,0 +1,64 @@
+#include "routing/speed_profiles.hpp"
+
+#include "coding/endianness.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace routing
+{
+using namespace std;
+
+// static
+uint8_t SpeedProfiles::QuantizeFactor(double factor)
+{
+  double const quantized = round(clamp(factor, 0.0, 1.0) * kMaxQuantizedFactor);
+  return static_cast<uint8_t>(max(quantized, 1.0));
+}
+
+void SpeedProfiles::Deserialize(Reader const & reader)
+{
+  if (reader.Size() < Header::kSize)
+    MYTHROW(CorruptedDataException, ("Speed profiles section is too small:", reader.Size()));
+
+  Header header;
+  header.m_version = ReadPrimitiveFromPos<uint16_t>(reader, 0);
+  if (header.m_version != kVersion)
+    MYTHROW(CorruptedDataException, ("Unknown speed profiles section version:", header.m_version));
+
+  header.m_bucketMinutes = ReadPrimitiveFromPos<uint16_t>(reader, 2);
+  header.m_profilesCount = ReadPrimitiveFromPos<uint32_t>(reader, 4);
+  header.m_featuresCount = ReadPrimitiveFromPos<uint32_t>(reader, 8);
+  header.m_entriesCount = ReadPrimitiveFromPos<uint32_t>(reader, 12);
+
+  if (header.m_bucketMinutes != kBucketMinutes)
+    MYTHROW(CorruptedDataException, ("Wrong bucket of speed profiles section:", header.m_bucketMinutes));
+  if (reader.Size() != header.GetSize())
+    MYTHROW(CorruptedDataException, ("Wrong speed profiles section size:", reader.Size(), header.GetSize()));
+
+  m_factors.resize(size_t{header.m_profilesCount} * kBucketsCount);
+  reader.Read(header.GetFactorsPos(), m_factors.data(), m_factors.size());
+
+  m_offsets.resize(size_t{header.m_featuresCount} + 1);
+  reader.Read(header.GetOffsetsPos(), m_offsets.data(), m_offsets.size() * sizeof(uint32_t));
+  for (auto & offset : m_offsets)
+    offset = SwapIfBigEndianMacroBased(offset);
+
+  m_profileIds.resize(header.m_entriesCount);
+  reader.Read(header.GetProfileIdsPos(), m_profileIds.data(), m_profileIds.size() * sizeof(uint16_t));
+  for (auto & profileId : m_profileIds)
+    profileId = SwapIfBigEndianMacroBased(profileId);
+
+  if (m_offsets.front() != 0 || m_offsets.back() != header.m_entriesCount ||
+      !is_sorted(m_offsets.cbegin(), m_offsets.cend()))
+  {
+    MYTHROW(CorruptedDataException, ("Wrong feature offsets of speed profiles section."));
+  }
+
+  for (auto const profileId : m_profileIds)
+  {
+    if (profileId != kNoProfile && profileId >= header.m_profilesCount)
+      MYTHROW(CorruptedDataException, ("Wrong speed profile id:", profileId, "of", header.m_profilesCount, "profiles"));
+  }
+}
+}  // namespace routing
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "routing/routing_exceptions.hpp"
+#include "routing/segment.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace routing
+{
+/// \brief Historical speed profiles of road segments, ROUTING_SPEED_PROFILES_FILE_TAG section.
+/// A profile is a week of 15 minutes buckets in UTC, the week starts on Monday. Every bucket keeps
+/// a speed factor quantized to uint8: the segment weight of the vehicle model is divided by
+/// the factor. Factors are not greater than one, so time-dependent weights are not less than
+/// the static ones and A* heuristics stay admissible.
+/// Equal profiles are stored once in a profile dictionary and segments refer to them by ids.
+/// The dictionary goes first and the ids of segments follow it, numbers are little endian:
+/// * header: version, bucket minutes, profiles count, features count and entries count;
+/// * uint8 quantized factors of all the buckets of every profile;
+/// * uint32 offsets of the first entry of every feature id, features count + 1 items;
+/// * uint16 profile ids of forward and then backward direction of every segment of a feature,
+///   kNoProfile for a direction without profile.
+/// The section is loaded to memory, so a factor is found by a few array lookups.
+class SpeedProfiles final
+{
+public:
+  static uint16_t constexpr kVersion = 0;
+  static uint16_t constexpr kBucketMinutes = 15;
+  static uint32_t constexpr kBucketsCount = 7 * 24 * 60 / kBucketMinutes;
+  static uint16_t constexpr kNoProfile = std::numeric_limits<uint16_t>::max();
+  static uint8_t constexpr kMaxQuantizedFactor = std::numeric_limits<uint8_t>::max();
+
+  using Profile = std::array<uint8_t, kBucketsCount>;
+  // Feature id, segment idx and forward direction flag.
+  using SegmentKey = std::tuple<uint32_t, uint32_t, bool>;
+
+  /// \returns bucket of a week for |time| in seconds since epoch.
+  static uint32_t GetBucket(time_t time)
+  {
+    // 1 January 1970 was Thursday, the week starts 3 days before.
+    int64_t constexpr kBucketSeconds = kBucketMinutes * 60;
+    int64_t constexpr kEpochOffset = 3 * 24 * 60 / kBucketMinutes;
+    int64_t const bucket = (static_cast<int64_t>(time) / kBucketSeconds + kEpochOffset) % kBucketsCount;
+    return static_cast<uint32_t>(bucket < 0 ? bucket + kBucketsCount : bucket);
+  }
+
+  /// \returns quantized |factor| which is clamped to (0, 1].
+  static uint8_t QuantizeFactor(double factor);
+
+  template <typename Sink>
+  static void Serialize(Sink & sink, std::map<SegmentKey, Profile> const & profiles);
+
+  /// \brief Reads the whole section from |reader| to memory.
+  void Deserialize(Reader const & reader);
+
+  uint32_t GetProfilesCount() const { return static_cast<uint32_t>(m_factors.size() / kBucketsCount); }
+
+  /// \returns speed factor of |segment| in |bucket| or one if there's no profile for the segment.
+  double GetFactor(Segment const & segment, uint32_t bucket) const
+  {
+    ASSERT_LESS(bucket, kBucketsCount, ());
+    uint32_t const featureId = segment.GetFeatureId();
+    if (featureId + size_t{1} >= m_offsets.size())
+      return 1.0;
+
+    size_t const pos = m_offsets[featureId] + 2 * size_t{segment.GetSegmentIdx()} + (segment.IsForward() ? 0 : 1);
+    if (pos >= m_offsets[featureId + 1])
+      return 1.0;
+
+    uint16_t const profileId = m_profileIds[pos];
+    if (profileId == kNoProfile)
+      return 1.0;
+
+    return m_factors[size_t{profileId} * kBucketsCount + bucket] / static_cast<double>(kMaxQuantizedFactor);
+  }
+
+private:
+  struct Header
+  {
+    static uint64_t constexpr kSize = 16;
+
+    uint64_t GetFactorsPos() const { return kSize; }
+    uint64_t GetOffsetsPos() const { return GetFactorsPos() + uint64_t{m_profilesCount} * kBucketsCount; }
+    uint64_t GetProfileIdsPos() const { return GetOffsetsPos() + (m_featuresCount + uint64_t{1}) * sizeof(uint32_t); }
+    uint64_t GetSize() const { return GetProfileIdsPos() + uint64_t{m_entriesCount} * sizeof(uint16_t); }
+
+    uint16_t m_version = kVersion;
+    uint16_t m_bucketMinutes = kBucketMinutes;
+    uint32_t m_profilesCount = 0;
+    uint32_t m_featuresCount = 0;
+    uint32_t m_entriesCount = 0;
+  };
+
+  std::vector<uint8_t> m_factors;
+  std::vector<uint32_t> m_offsets = {0};
+  std::vector<uint16_t> m_profileIds;
+};
+
+template <typename Sink>
+void SpeedProfiles::Serialize(Sink & sink, std::map<SegmentKey, Profile> const & profiles)
+{
+  std::map<Profile, uint16_t> dictionary;
+  std::vector<Profile const *> dictionaryProfiles;
+  // Number of segments of every feature id with profiles.
+  std::map<uint32_t, uint32_t> featureSegments;
+  for (auto const & [key, profile] : profiles)
+  {
+    auto const [featureId, segmentIdx, forward] = key;
+    auto const it = dictionary.emplace(profile, static_cast<uint16_t>(dictionary.size())).first;
+    if (it->second == dictionaryProfiles.size())
+      dictionaryProfiles.push_back(&it->first);
+    CHECK_LESS(dictionary.size(), kNoProfile, ("Too many different speed profiles."));
+
+    auto & segmentsCount = featureSegments[featureId];
+    segmentsCount = std::max(segmentsCount, segmentIdx + 1);
+  }
+
+  Header header;
+  header.m_profilesCount = base::checked_cast<uint32_t>(dictionaryProfiles.size());
+  header.m_featuresCount = featureSegments.empty() ? 0 : featureSegments.crbegin()->first + 1;
+  for (auto const & [featureId, segmentsCount] : featureSegments)
+    header.m_entriesCount += 2 * segmentsCount;
+
+  WriteToSink(sink, header.m_version);
+  WriteToSink(sink, header.m_bucketMinutes);
+  WriteToSink(sink, header.m_profilesCount);
+  WriteToSink(sink, header.m_featuresCount);
+  WriteToSink(sink, header.m_entriesCount);
+
+  for (auto const * profile : dictionaryProfiles)
+    sink.Write(profile->data(), profile->size());
+
+  uint32_t offset = 0;
+  auto it = featureSegments.cbegin();
+  for (uint32_t featureId = 0; featureId <= header.m_featuresCount; ++featureId)
+  {
+    WriteToSink(sink, offset);
+    if (it != featureSegments.cend() && it->first == featureId)
+    {
+      offset += 2 * it->second;
+      ++it;
+    }
+  }
+
+  for (auto const & [featureId, segmentsCount] : featureSegments)
+  {
+    for (uint32_t segmentIdx = 0; segmentIdx < segmentsCount; ++segmentIdx)
+    {
+      for (bool const forward : {true, false})
+      {
+        auto const profileIt = profiles.find(SegmentKey(featureId, segmentIdx, forward));
+        WriteToSink(sink, profileIt == profiles.cend() ? kNoProfile : dictionary.at(profileIt->second));
+      }
+    }
+  }
+}
+}  // namespace routing
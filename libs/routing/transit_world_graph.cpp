@@ -134,7 +134,8 @@ RouteWeight TransitWorldGraph::CalcOffroadWeight(ms::LatLon const & from, ms::La
   return RouteWeight(m_estimator->CalcOffroad(from, to, purpose));
 }
 
-double TransitWorldGraph::CalculateETA(Segment const & from, Segment const & to)
+double TransitWorldGraph::CalculateETA(Segment const & from, Segment const & to,
+                                       optional<RouteWeight const> const & /* timeToFrom */)
 {
   if (TransitGraph::IsTransitSegment(from))
     return CalcSegmentWeight(to, EdgeEstimator::Purpose::ETA).GetWeight();
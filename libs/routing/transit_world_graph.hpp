@@ -61,7 +61,8 @@ public:
   RouteWeight CalcLeapWeight(ms::LatLon const & from, ms::LatLon const & to, NumMwmId mwmId) const override;
   RouteWeight CalcOffroadWeight(ms::LatLon const & from, ms::LatLon const & to,
                                 EdgeEstimator::Purpose purpose) const override;
-  double CalculateETA(Segment const & from, Segment const & to) override;
+  double CalculateETA(Segment const & from, Segment const & to,
+                      std::optional<RouteWeight const> const & timeToFrom) override;
   double CalculateETAWithoutPenalty(Segment const & segment) override;
 
   std::unique_ptr<TransitInfo> GetTransitInfo(Segment const & segment) override;
@@ -0,0 +1,332 @@
+#include "routing/travel_time_matrix.hpp"
+
+#include "routing/base/astar_algorithm.hpp"
+
+#include "routing/fake_feature_ids.hpp"
+#include "routing/world_graph.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+
+#include "geometry/distance_on_sphere.hpp"
+
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+namespace routing
+{
+using namespace std;
+
+namespace
+{
+using Algorithm = AStarAlgorithm<Segment, SegmentEdge, RouteWeight>;
+
+uint32_t constexpr kCancelledCheckPeriod = 1024;
+
+// Segment of a route ending projection. |m_fractionToFront| is the part of the segment between
+// the projection and the segment front.
+struct EndingPart
+{
+  Segment m_segment;
+  double m_fractionToFront = 0.0;
+  RouteWeight m_offroadWeight;
+};
+
+struct BucketEntry
+{
+  uint32_t m_targetIdx = 0;
+  RouteWeight m_weight;
+};
+
+double CalcFractionToFront(Projection const & projection)
+{
+  double const length =
+      ms::DistanceOnEarth(projection.m_segmentBack.GetLatLon(), projection.m_segmentFront.GetLatLon());
+  if (length == 0.0)
+    return 0.0;
+
+  double const toFront = ms::DistanceOnEarth(projection.m_junction.GetLatLon(), projection.m_segmentFront.GetLatLon());
+  return min(toFront / length, 1.0);
+}
+
+vector<EndingPart> GetEndingParts(WorldGraph & graph, FakeEnding const & ending, bool isSource)
+{
+  vector<EndingPart> parts;
+  for (auto const & projection : ending.m_projections)
+  {
+    auto const & origin = ending.m_originJunction.GetLatLon();
+    auto const & junction = projection.m_junction.GetLatLon();
+    RouteWeight const offroadWeight =
+        isSource ? graph.CalcOffroadWeight(origin, junction, EdgeEstimator::Purpose::Weight)
+                 : graph.CalcOffroadWeight(junction, origin, EdgeEstimator::Purpose::Weight);
+
+    double const fractionToFront = CalcFractionToFront(projection);
+    parts.push_back({projection.m_segment, fractionToFront, offroadWeight});
+    if (!projection.m_isOneWay)
+      parts.push_back({projection.m_segment.GetReversed(), 1.0 - fractionToFront, offroadWeight});
+  }
+  return parts;
+}
+
+RouteWeight CalcPartialWeight(WorldGraph & graph, Segment const & segment, double fraction)
+{
+  return fraction * graph.CalcSegmentWeight(segment, EdgeEstimator::Purpose::Weight);
+}
+
+// Forward wave distance of a segment is the weight from the source to the segment front.
+MatrixWaveGraph::EdgeListT MakeSourceEdges(WorldGraph & graph, vector<EndingPart> const & parts)
+{
+  MatrixWaveGraph::EdgeListT edges;
+  for (auto const & part : parts)
+  {
+    edges.emplace_back(part.m_segment,
+                       part.m_offroadWeight + CalcPartialWeight(graph, part.m_segment, part.m_fractionToFront));
+  }
+  return edges;
+}
+
+// Backward wave distance of a segment is the weight from the segment front to the target.
+// So the wave starts from the segments which lead to the target segments.
+MatrixWaveGraph::EdgeListT MakeTargetEdges(WorldGraph & graph, vector<EndingPart> const & parts)
+{
+  MatrixWaveGraph::EdgeListT edges;
+  WorldGraph::SegmentEdgeListT ingoing;
+  for (auto const & part : parts)
+  {
+    // As in IndexGraphStarter, the part of the target segment is entered without penalties.
+    auto const weight = part.m_offroadWeight + CalcPartialWeight(graph, part.m_segment, 1.0 - part.m_fractionToFront);
+    ingoing.clear();
+    graph.GetEdgeList(part.m_segment, false /* isOutgoing */, true /* useRoutingOptions */, ingoing);
+    for (auto const & edge : ingoing)
+      edges.emplace_back(edge.GetTarget(), weight);
+  }
+  return edges;
+}
+
+// A source and a target on the same segment may be connected without leaving the segment.
+bool CalcOnSegmentWeight(vector<EndingPart> const & sourceParts, vector<EndingPart> const & targetParts,
+                         WorldGraph & graph, RouteWeight & weight)
+{
+  bool found = false;
+  for (auto const & source : sourceParts)
+  {
+    for (auto const & target : targetParts)
+    {
+      if (source.m_segment != target.m_segment || source.m_fractionToFront < target.m_fractionToFront)
+        continue;
+
+      auto const candidate =
+          source.m_offroadWeight + target.m_offroadWeight +
+          CalcPartialWeight(graph, source.m_segment, source.m_fractionToFront - target.m_fractionToFront);
+      if (!found || candidate < weight)
+        weight = candidate;
+      found = true;
+    }
+  }
+  return found;
+}
+}  // namespace
+
+// static
+Segment const MatrixWaveGraph::kEndingVertex(kFakeNumMwmId, FakeFeatureIds::kIndexGraphStarterId, 0 /* segmentIdx */,
+                                             true /* forward */);
+
+void MatrixWaveGraph::GetOutgoingEdgesList(astar::VertexData<Vertex, Weight> const & vertexData, EdgeListT & edges)
+{
+  GetEdgesList(vertexData, m_forward /* isOutgoing */, edges);
+}
+
+void MatrixWaveGraph::GetIngoingEdgesList(astar::VertexData<Vertex, Weight> const & vertexData, EdgeListT & edges)
+{
+  GetEdgesList(vertexData, !m_forward /* isOutgoing */, edges);
+}
+
+void MatrixWaveGraph::SetAStarParents(bool /* forward */, Parents & parents)
+{
+  m_graph.SetAStarParents(m_forward, parents);
+}
+
+void MatrixWaveGraph::DropAStarParents()
+{
+  m_graph.DropAStarParents();
+}
+
+void MatrixWaveGraph::GetEdgesList(astar::VertexData<Vertex, Weight> const & vertexData, bool isOutgoing,
+                                   EdgeListT & edges)
+{
+  edges.clear();
+  if (vertexData.m_vertex == kEndingVertex)
+  {
+    if (isOutgoing == m_forward)
+      edges = m_endingEdges;
+    return;
+  }
+
+  m_graph.GetEdgeList(vertexData, isOutgoing, true /* useRoutingOptions */, true /* useAccessConditional */, edges);
+}
+
+RouterResultCode CalculateTravelTimeMatrix(WorldGraph & graph, vector<FakeEnding> const & sources,
+                                           vector<FakeEnding> const & targets, double maxTimeSec,
+                                           base::Cancellable const & cancellable, TravelTimeMatrix & matrix)
+{
+  matrix = TravelTimeMatrix(sources.size(), targets.size());
+  if (sources.empty() || targets.empty())
+    return RouterResultCode::NoError;
+
+  auto constexpr kInfinity = GetAStarWeightMax<RouteWeight>();
+  RouteWeight const maxWeight(maxTimeSec);
+
+  vector<vector<EndingPart>> sourceParts;
+  sourceParts.reserve(sources.size());
+  for (auto const & source : sources)
+    sourceParts.push_back(GetEndingParts(graph, source, true /* isSource */));
+
+  vector<vector<EndingPart>> targetParts;
+  targetParts.reserve(targets.size());
+  for (auto const & target : targets)
+    targetParts.push_back(GetEndingParts(graph, target, false /* isSource */));
+
+  Algorithm const astar;
+  uint32_t visitedCount = 0;
+  bool cancelled = false;
+  auto const isCancelled = [&]()
+  {
+    if (++visitedCount % kCancelledCheckPeriod == 0 && cancellable.IsCancelled())
+      cancelled = true;
+    return cancelled;
+  };
+
+  // Backward waves. The radius of a wave is the distance of the first segment which is not settled,
+  // all the segments with less weight to the target are in the buckets.
+  unordered_map<Segment, vector<BucketEntry>> buckets;
+  vector<RouteWeight> radiuses(targets.size(), kInfinity);
+  {
+    MatrixWaveGraph backwardGraph(graph, false /* forward */);
+    Algorithm::Context context(backwardGraph);
+    for (uint32_t targetIdx = 0; targetIdx < targets.size(); ++targetIdx)
+    {
+      // The radius limit balances the work of the backward and the forward waves: a route is found
+      // when the forward wave reaches the area of the backward one.
+      RouteWeight radiusLimit = GetAStarWeightZero<RouteWeight>();
+      for (auto const & source : sources)
+      {
+        if (source.m_projections.empty())
+          continue;
+
+        radiusLimit = max(radiusLimit, graph.HeuristicCostEstimate(source.m_originJunction.GetLatLon(),
+                                                                   targets[targetIdx].m_originJunction.GetLatLon()));
+      }
+      radiusLimit = min(radiusLimit, maxWeight);
+
+      // Parents of the previous wave shouldn't affect restrictions of the target edges.
+      context.Clear();
+      auto targetEdges = MakeTargetEdges(graph, targetParts[targetIdx]);
+      backwardGraph.SetEndingEdges(MatrixWaveGraph::EdgeListT(targetEdges));
+      astar.PropagateWave(backwardGraph, MatrixWaveGraph::kEndingVertex, [&](Segment const & vertex)
+      {
+        if (isCancelled())
+          return false;
+
+        auto const distance = context.GetDistance(vertex);
+        if (distance > radiusLimit)
+        {
+          radiuses[targetIdx] = distance;
+          return false;
+        }
+
+        if (vertex != MatrixWaveGraph::kEndingVertex)
+          buckets[vertex].push_back({targetIdx, distance});
+        return true;
+      }, context);
+
+      if (cancelled)
+        return RouterResultCode::Cancelled;
+
+      // Segments which lead to the target are kept in the buckets even out of the radius, otherwise
+      // a route which reaches such a segment by the forward wave only would be missed.
+      for (auto const & edge : targetEdges)
+      {
+        if (context.GetDistance(edge.GetTarget()) >= radiuses[targetIdx])
+          buckets[edge.GetTarget()].push_back({targetIdx, edge.GetWeight()});
+      }
+    }
+  }
+
+  // Forward waves.
+  MatrixWaveGraph forwardGraph(graph, true /* forward */);
+  Algorithm::Context context(forwardGraph);
+  vector<RouteWeight> best(targets.size());
+  for (size_t sourceIdx = 0; sourceIdx < sources.size(); ++sourceIdx)
+  {
+    for (size_t targetIdx = 0; targetIdx < targets.size(); ++targetIdx)
+    {
+      if (!CalcOnSegmentWeight(sourceParts[sourceIdx], targetParts[targetIdx], graph, best[targetIdx]))
+        best[targetIdx] = kInfinity;
+    }
+
+    // Any path shorter than the best candidate to a target has an edge from a segment settled by
+    // the forward wave to a segment in the buckets of the target. So the candidate is the best one
+    // when the sum of the wave radiuses is not less than the candidate weight.
+    auto const areAllFound = [&](RouteWeight const & forwardRadius)
+    {
+      if (forwardRadius > maxWeight)
+        return true;
+
+      for (size_t targetIdx = 0; targetIdx < targets.size(); ++targetIdx)
+      {
+        if (radiuses[targetIdx] != kInfinity && best[targetIdx] > forwardRadius + radiuses[targetIdx])
+          return false;
+      }
+      return true;
+    };
+
+    // Edges of the source are relaxed in any case.
+    auto const visitVertex = [&](Segment const & vertex)
+    {
+      if (vertex == MatrixWaveGraph::kEndingVertex)
+        return true;
+      return !isCancelled() && !areAllFound(context.GetDistance(vertex));
+    };
+
+    // Buckets are checked for all the reached segments, not only for the settled ones.
+    auto const checkBuckets = [&](auto const & state)
+    {
+      if (state.distance > maxWeight)
+        return false;
+
+      auto const it = buckets.find(state.vertex);
+      if (it == buckets.cend())
+        return true;
+
+      for (auto const & entry : it->second)
+      {
+        auto const candidate = state.distance + entry.m_weight;
+        if (candidate < best[entry.m_targetIdx])
+          best[entry.m_targetIdx] = candidate;
+      }
+      return true;
+    };
+
+    forwardGraph.SetEndingEdges(MakeSourceEdges(graph, sourceParts[sourceIdx]));
+    astar.PropagateWave(
+        forwardGraph, MatrixWaveGraph::kEndingVertex, visitVertex,
+        [](Segment const & /* vertex */, SegmentEdge const & edge) { return edge.GetWeight(); }, checkBuckets,
+        [](auto const & state) { return state.distance; }, context);
+
+    if (cancelled)
+      return RouterResultCode::Cancelled;
+
+    for (size_t targetIdx = 0; targetIdx < targets.size(); ++targetIdx)
+    {
+      if (best[targetIdx] <= maxWeight)
+        matrix.Set(sourceIdx, targetIdx, best[targetIdx].GetWeight());
+    }
+  }
+
+  LOG(LDEBUG, ("Travel time matrix", sources.size(), "x", targets.size(), "visited segments:", visitedCount,
+               "buckets:", buckets.size()));
+  return RouterResultCode::NoError;
+}
+}  // namespace routing
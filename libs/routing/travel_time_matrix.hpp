@@ -0,0 +1,98 @@
+#pragma once
+
+#include "routing/base/astar_graph.hpp"
+#include "routing/base/astar_vertex_data.hpp"
+#include "routing/fake_ending.hpp"
+#include "routing/route_weight.hpp"
+#include "routing/routing_callbacks.hpp"
+#include "routing/segment.hpp"
+
+#include "base/assert.hpp"
+#include "base/cancellable.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace routing
+{
+class WorldGraph;
+
+/// \brief Travel times in seconds from every source to every target.
+class TravelTimeMatrix
+{
+public:
+  /// Time for pairs without a route.
+  static double constexpr kNoRoute = -1.0;
+
+  TravelTimeMatrix() = default;
+  TravelTimeMatrix(size_t sourcesCount, size_t targetsCount)
+    : m_targetsCount(targetsCount)
+    , m_times(sourcesCount * targetsCount, kNoRoute)
+  {}
+
+  size_t GetSourcesCount() const { return m_targetsCount == 0 ? 0 : m_times.size() / m_targetsCount; }
+  size_t GetTargetsCount() const { return m_targetsCount; }
+
+  double Get(size_t sourceIdx, size_t targetIdx) const { return m_times[GetIndex(sourceIdx, targetIdx)]; }
+  void Set(size_t sourceIdx, size_t targetIdx, double timeSec) { m_times[GetIndex(sourceIdx, targetIdx)] = timeSec; }
+
+private:
+  size_t GetIndex(size_t sourceIdx, size_t targetIdx) const
+  {
+    ASSERT_LESS(targetIdx, m_targetsCount, ());
+    ASSERT_LESS(sourceIdx * m_targetsCount + targetIdx, m_times.size(), ());
+    return sourceIdx * m_targetsCount + targetIdx;
+  }
+
+  size_t m_targetsCount = 0;
+  std::vector<double> m_times;
+};
+
+/// \brief WorldGraph wave of one direction started from a route ending. The ending is a fake vertex
+/// which is connected with the segments the ending is projected to.
+class MatrixWaveGraph : public AStarGraph<Segment, SegmentEdge, RouteWeight>
+{
+public:
+  static Segment const kEndingVertex;
+
+  MatrixWaveGraph(WorldGraph & graph, bool forward) : m_graph(graph), m_forward(forward) {}
+
+  /// \param edges of kEndingVertex. Edge weights of the backward wave are weights from the edge
+  /// targets to the ending.
+  void SetEndingEdges(EdgeListT && edges) { m_endingEdges = std::move(edges); }
+
+  // AStarGraph overrides:
+  // @{
+  void GetOutgoingEdgesList(astar::VertexData<Vertex, Weight> const & vertexData, EdgeListT & edges) override;
+  void GetIngoingEdgesList(astar::VertexData<Vertex, Weight> const & vertexData, EdgeListT & edges) override;
+  RouteWeight HeuristicCostEstimate(Segment const & /* from */, Segment const & /* to */) override
+  {
+    return GetAStarWeightZero<RouteWeight>();
+  }
+  void SetAStarParents(bool forward, Parents & parents) override;
+  void DropAStarParents() override;
+  RouteWeight GetAStarWeightEpsilon() override { return RouteWeight(0.0); }
+  // @}
+
+private:
+  void GetEdgesList(astar::VertexData<Vertex, Weight> const & vertexData, bool isOutgoing, EdgeListT & edges);
+
+  WorldGraph & m_graph;
+  bool const m_forward;
+  EdgeListT m_endingEdges;
+};
+
+/// \brief Calculates travel times with the bucket-based many-to-many search. A backward wave is
+/// propagated from every target up to a radius and all the settled segments keep weights to the
+/// target in their buckets. Then a forward wave is propagated from every source, buckets of the
+/// segments it reaches give candidate routes to the targets. The forward wave stops as soon as
+/// the best candidates are proved to be optimal, so it's much less than a full search per pair.
+/// \param maxTimeSec routes with greater weight are not searched for.
+/// \note Times are route weights, the same ones which are minimized by the router. |matrix| is
+/// filled with TravelTimeMatrix::kNoRoute for pairs without route and for endings without
+/// projections.
+RouterResultCode CalculateTravelTimeMatrix(WorldGraph & graph, std::vector<FakeEnding> const & sources,
+                                           std::vector<FakeEnding> const & targets, double maxTimeSec,
+                                           base::Cancellable const & cancellable, TravelTimeMatrix & matrix);
+}  // namespace routing
@@ -67,6 +67,11 @@ bool WorldGraph::AreWavesConnectible(Parents<JointSegment> & forwardParents, Joi
 
 void WorldGraph::SetRoutingOptions(RoutingOptions /* routingOption */) {}
 
+RoutingOptions WorldGraph::GetAvoidRoutingOptions() const
+{
+  return {};
+}
+
 void WorldGraph::ForEachTransition(NumMwmId numMwmId, bool isEnter, TransitionFnT const & fn) {}
 
 CrossMwmGraph & WorldGraph::GetCrossMwmGraph()
@@ -74,6 +79,16 @@ CrossMwmGraph & WorldGraph::GetCrossMwmGraph()
   UNREACHABLE();
 }
 
+RoutingShortcuts const * WorldGraph::GetRoutingShortcuts(NumMwmId /* numMwmId */)
+{
+  return nullptr;
+}
+
+RoutingLandmarks const * WorldGraph::GetRoutingLandmarks(NumMwmId /* numMwmId */)
+{
+  return nullptr;
+}
+
 RouteWeight WorldGraph::GetCrossBorderPenalty(NumMwmId mwmId1, NumMwmId mwmId2)
 {
   return RouteWeight(0);
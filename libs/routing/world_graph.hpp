@@ -15,12 +15,15 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 namespace routing
 {
 class CrossMwmGraph;
+class RoutingLandmarks;
+class RoutingShortcuts;
 
 enum class WorldGraphMode
 {
@@ -85,7 +88,9 @@ public:
   virtual RouteWeight CalcOffroadWeight(ms::LatLon const & from, ms::LatLon const & to,
                                         EdgeEstimator::Purpose purpose) const = 0;
 
-  virtual double CalculateETA(Segment const & from, Segment const & to) = 0;
+  /// \param timeToFrom is time to the end of |from| for time-dependent weights, see IndexGraph::CalculateEdgeWeight().
+  virtual double CalculateETA(Segment const & from, Segment const & to,
+                              std::optional<RouteWeight const> const & timeToFrom) = 0;
   virtual double CalculateETAWithoutPenalty(Segment const & segment) = 0;
 
   using TransitionFnT = std::function<void(Segment const &)>;
@@ -94,6 +99,8 @@ public:
   virtual bool IsRoutingOptionsGood(Segment const & /* segment */);
   virtual RoutingOptions GetRoutingOptions(Segment const & /* segment */);
   virtual void SetRoutingOptions(RoutingOptions /* routingOptions */);
+  /// \returns the roads which are avoided by the routes of the graph.
+  virtual RoutingOptions GetAvoidRoutingOptions() const;
 
   virtual void SetAStarParents(bool forward, Parents<Segment> & parents);
   virtual void SetAStarParents(bool forward, Parents<JointSegment> & parents);
@@ -115,6 +122,10 @@ public:
 
   virtual IndexGraph & GetIndexGraph(NumMwmId numMwmId) = 0;
   virtual CrossMwmGraph & GetCrossMwmGraph();
+  /// \returns nullptr if the mwm has no routing shortcuts section for the vehicle type.
+  virtual RoutingShortcuts const * GetRoutingShortcuts(NumMwmId numMwmId);
+  /// \returns nullptr if the mwm has no routing landmarks table for the vehicle type.
+  virtual RoutingLandmarks const * GetRoutingLandmarks(NumMwmId numMwmId);
   virtual void GetTwinsInner(Segment const & segment, bool isOutgoing, std::vector<Segment> & twins) = 0;
 
   virtual RouteWeight GetCrossBorderPenalty(NumMwmId mwmId1, NumMwmId mwmId2);
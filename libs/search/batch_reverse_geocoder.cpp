@@ -0,0 +1,393 @@
+#include "search/batch_reverse_geocoder.hpp"
+
+#include "indexer/data_source.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/feature_algo.hpp"
+#include "indexer/scales.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/parametrized_segment.hpp"
+#include "geometry/triangle2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/thread_pool_computational.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <future>
+#include <limits>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <utility>
+
+namespace search
+{
+using namespace std;
+
+namespace
+{
+int constexpr kQueryScale = scales::GetUpperScale();
+
+// Order of the Hilbert curve which is used to sort points, the cell size is ~40m at the equator.
+uint8_t constexpr kHilbertOrder = 20;
+
+// Buildings are loaded for cells of this size (~550m at the equator), so consecutive points
+// of a track usually share the loaded buildings.
+double constexpr kCellSize = 0.005;
+size_t constexpr kMaxCachedCells = 8;
+size_t constexpr kMaxCachedStreets = 100000;
+
+// Each thread processes several ranges of the curve, so that threads are loaded evenly
+// when points are distributed unevenly.
+size_t constexpr kRangesPerThread = 4;
+
+uint32_t ToHilbertCoord(double coord, double minCoord, double maxCoord)
+{
+  uint32_t const maxValue = (uint32_t{1} << kHilbertOrder) - 1;
+  double const ratio = (coord - minCoord) / (maxCoord - minCoord);
+  return static_cast<uint32_t>(clamp(ratio, 0.0, 1.0) * maxValue);
+}
+
+m2::PointD GetClosestPoint(m2::RectD const & rect, m2::PointD const & point)
+{
+  return {clamp(point.x, rect.minX(), rect.maxX()), clamp(point.y, rect.minY(), rect.maxY())};
+}
+
+pair<int64_t, int64_t> GetCell(m2::PointD const & point)
+{
+  return {static_cast<int64_t>(floor(point.x / kCellSize)), static_cast<int64_t>(floor(point.y / kCellSize))};
+}
+}  // namespace
+
+// BatchReverseGeocoder::Worker --------------------------------------------------------------------
+// Processes a range of points, it's not thread-safe.
+class BatchReverseGeocoder::Worker
+{
+public:
+  Worker(DataSource const & dataSource, ReverseGeocoder const & coder, double maxDistanceM)
+    : m_dataSource(dataSource)
+    , m_coder(coder)
+    , m_maxDistanceM(maxDistanceM)
+    , m_table(dataSource)
+  {}
+
+  void GetNearbyAddress(m2::PointD const & point, Address & addr)
+  {
+    auto const & buildings = GetBuildings(point);
+
+    // Distance to the limit rect of a building is a lower bound of the distance to the building,
+    // so the exact distance is calculated only for buildings which may be among the nearest ones.
+    m_candidates.clear();
+    for (size_t i = 0; i < buildings.size(); ++i)
+    {
+      double const bound = mercator::DistanceOnEarth(point, GetClosestPoint(buildings[i].m_rect, point));
+      if (bound <= m_maxDistanceM)
+        m_candidates.emplace_back(bound, i);
+    }
+    sort(m_candidates.begin(), m_candidates.end());
+
+    // The same number of the nearest buildings is checked as in ReverseGeocoder::GetNearbyAddress().
+    auto const numTries = ReverseGeocoder::kMaxNumTriesToApproxAddress;
+    auto const less = [&buildings](pair<double, size_t> const & lhs, pair<double, size_t> const & rhs)
+    {
+      if (lhs.first != rhs.first)
+        return lhs.first < rhs.first;
+      return buildings[lhs.second].m_id < buildings[rhs.second].m_id;
+    };
+
+    m_nearest.clear();
+    for (auto const & [bound, index] : m_candidates)
+    {
+      if (m_nearest.size() == numTries && bound > m_nearest.back().first)
+        break;
+
+      double const distance = buildings[index].GetDistanceMeters(point);
+      if (distance > m_maxDistanceM)
+        continue;
+
+      pair<double, size_t> const candidate(distance, index);
+      m_nearest.insert(upper_bound(m_nearest.begin(), m_nearest.end(), candidate, less), candidate);
+      if (m_nearest.size() > numTries)
+        m_nearest.pop_back();
+    }
+
+    for (auto const & [distance, index] : m_nearest)
+    {
+      auto const & building = buildings[index];
+      auto const * street = GetStreet(building);
+      if (!street)
+        continue;
+
+      addr.m_building = ReverseGeocoder::Building(building.m_id, distance, building.m_houseNumber, building.m_center);
+      addr.m_street = *street;
+      return;
+    }
+  }
+
+  size_t GetNumLoadedCells() const { return m_numLoadedCells; }
+
+private:
+  // Building with its geometry which is enough to calculate the same distance as
+  // feature::GetMinDistanceMeters() does.
+  struct Building
+  {
+    double GetDistanceMeters(m2::PointD const & point) const
+    {
+      double res = numeric_limits<double>::max();
+      auto const update = [&](m2::PointD const & p) { res = min(res, mercator::DistanceOnEarth(p, point)); };
+      auto const updateBySegment = [&](m2::PointD const & p1, m2::PointD const & p2)
+      { update(m2::ParametrizedSegment<m2::PointD>(p1, p2).ClosestPointTo(point)); };
+
+      switch (m_geomType)
+      {
+      case feature::GeomType::Point: update(m_center); break;
+      case feature::GeomType::Line:
+        for (size_t i = 1; i < m_points.size(); ++i)
+          updateBySegment(m_points[i - 1], m_points[i]);
+        break;
+      default:
+        ASSERT_EQUAL(m_geomType, feature::GeomType::Area, ());
+        // Triangles are stored as triples of points.
+        for (size_t i = 0; i + 2 < m_points.size(); i += 3)
+        {
+          auto const & p1 = m_points[i];
+          auto const & p2 = m_points[i + 1];
+          auto const & p3 = m_points[i + 2];
+          if (m2::IsPointInsideTriangle(point, p1, p2, p3))
+            return 0.0;
+
+          updateBySegment(p1, p2);
+          updateBySegment(p2, p3);
+          updateBySegment(p3, p1);
+        }
+        break;
+      }
+      return res;
+    }
+
+    FeatureID m_id;
+    string m_houseNumber;
+    m2::PointD m_center;
+    m2::RectD m_rect;
+    feature::GeomType m_geomType = feature::GeomType::Undefined;
+    vector<m2::PointD> m_points;
+  };
+
+  struct Cell
+  {
+    pair<int64_t, int64_t> m_cell;
+    vector<Building> m_buildings;
+  };
+
+  vector<Building> const & GetBuildings(m2::PointD const & point)
+  {
+    auto const cell = GetCell(point);
+    auto const it = find_if(m_cells.begin(), m_cells.end(), [&cell](Cell const & c) { return c.m_cell == cell; });
+    if (it != m_cells.end())
+      return it->m_buildings;
+
+    if (m_cells.size() == kMaxCachedCells)
+      m_cells.pop_back();
+    m_cells.push_front({cell, LoadBuildings(cell)});
+    ++m_numLoadedCells;
+    return m_cells.front().m_buildings;
+  }
+
+  vector<Building> LoadBuildings(pair<int64_t, int64_t> const & cell) const
+  {
+    m2::RectD const cellRect(cell.first * kCellSize, cell.second * kCellSize, (cell.first + 1) * kCellSize,
+                             (cell.second + 1) * kCellSize);
+
+    // Mercator size of a lookup rect depends only on the latitude and changes monotonically
+    // inside a cell, so lookup rects of all points of the cell are inside the union of
+    // lookup rects of its corners.
+    m2::RectD rect = cellRect;
+    auto const corners = {cellRect.LeftBottom(), cellRect.LeftTop(), cellRect.RightTop(), cellRect.RightBottom()};
+    for (auto const & corner : corners)
+      rect.Add(mercator::RectByCenterXYAndSizeInMeters(corner, m_maxDistanceM));
+
+    vector<Building> buildings;
+    m_dataSource.ForEachInRect([&](FeatureType & ft)
+    {
+      auto const & houseNumber = ReverseGeocoder::GetHouseNumber(ft);
+      if (houseNumber.empty())
+        return;
+
+      Building building;
+      building.m_id = ft.GetID();
+      building.m_houseNumber = houseNumber;
+      building.m_center = feature::GetCenter(ft);
+      building.m_geomType = ft.GetGeomType();
+      switch (building.m_geomType)
+      {
+      case feature::GeomType::Point: building.m_rect.Add(building.m_center); break;
+      case feature::GeomType::Line:
+        ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+        building.m_points.reserve(ft.GetPointsCount());
+        for (size_t i = 0; i < ft.GetPointsCount(); ++i)
+        {
+          building.m_points.push_back(ft.GetPoint(i));
+          building.m_rect.Add(building.m_points.back());
+        }
+        break;
+      default:
+        ft.ForEachTriangle([&building](m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3)
+        {
+          building.m_points.insert(building.m_points.end(), {p1, p2, p3});
+          building.m_rect.Add(p1);
+          building.m_rect.Add(p2);
+          building.m_rect.Add(p3);
+        }, FeatureType::BEST_GEOMETRY);
+        break;
+      }
+      buildings.push_back(std::move(building));
+    }, rect, kQueryScale);
+    return buildings;
+  }
+
+  // Returns nullptr if the building has no street.
+  ReverseGeocoder::Street const * GetStreet(Building const & building)
+  {
+    auto it = m_streets.find(building.m_id);
+    if (it == m_streets.end())
+    {
+      if (m_streets.size() == kMaxCachedStreets)
+        m_streets.clear();
+
+      // Distance to the street is measured from the center of the building, so it's
+      // the same for all points.
+      Address addr;
+      ReverseGeocoder::Building const bld(building.m_id, 0.0 /* distMeters */, building.m_houseNumber,
+                                          building.m_center);
+      optional<ReverseGeocoder::Street> street;
+      if (m_coder.GetNearbyAddress(m_table, bld, false /* ignoreEdits */, addr))
+        street = std::move(addr.m_street);
+      it = m_streets.emplace(building.m_id, std::move(street)).first;
+    }
+    return it->second ? &*it->second : nullptr;
+  }
+
+  DataSource const & m_dataSource;
+  ReverseGeocoder const & m_coder;
+  double const m_maxDistanceM;
+
+  ReverseGeocoder::HouseTable m_table;
+  // Most recently loaded cells are at the front.
+  deque<Cell> m_cells;
+  map<FeatureID, optional<ReverseGeocoder::Street>> m_streets;
+  vector<pair<double, size_t>> m_candidates;
+  vector<pair<double, size_t>> m_nearest;
+  size_t m_numLoadedCells = 0;
+};
+
+// BatchReverseGeocoder::Stats ---------------------------------------------------------------------
+double BatchReverseGeocoder::Stats::GetPointsPerSecond() const
+{
+  return m_seconds > 0.0 ? m_numPoints / m_seconds : 0.0;
+}
+
+// BatchReverseGeocoder ----------------------------------------------------------------------------
+BatchReverseGeocoder::BatchReverseGeocoder(DataSource const & dataSource, size_t numThreads)
+  : m_dataSource(dataSource)
+  , m_coder(dataSource)
+  , m_numThreads(max(numThreads, size_t{1}))
+{}
+
+vector<BatchReverseGeocoder::Address> BatchReverseGeocoder::GetNearbyAddresses(vector<m2::PointD> const & points,
+                                                                               double maxDistanceM,
+                                                                               Stats * stats) const
+{
+  base::Timer timer;
+
+  vector<pair<uint64_t, size_t>> order;
+  order.reserve(points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    auto const & p = points[i];
+    uint32_t const x = ToHilbertCoord(p.x, mercator::Bounds::kMinX, mercator::Bounds::kMaxX);
+    uint32_t const y = ToHilbertCoord(p.y, mercator::Bounds::kMinY, mercator::Bounds::kMaxY);
+    order.emplace_back(GetHilbertIndex(x, y, kHilbertOrder), i);
+  }
+  sort(order.begin(), order.end());
+
+  vector<Address> addresses(points.size());
+  atomic<size_t> numLoadedCells = 0;
+  auto const processRange = [&](size_t begin, size_t end)
+  {
+    Worker worker(m_dataSource, m_coder, maxDistanceM);
+    for (size_t i = begin; i < end; ++i)
+      worker.GetNearbyAddress(points[order[i].second], addresses[order[i].second]);
+    numLoadedCells += worker.GetNumLoadedCells();
+  };
+
+  if (m_numThreads == 1)
+  {
+    processRange(0, points.size());
+  }
+  else
+  {
+    size_t const numRanges = m_numThreads * kRangesPerThread;
+    size_t const rangeSize = (points.size() + numRanges - 1) / numRanges;
+
+    base::ComputationalThreadPool pool(m_numThreads);
+    vector<future<void>> results;
+    for (size_t begin = 0; begin < points.size(); begin += rangeSize)
+      results.push_back(pool.Submit(processRange, begin, min(begin + rangeSize, points.size())));
+
+    // Rethrows an exception of a range, if any.
+    for (auto & result : results)
+      result.get();
+  }
+
+  if (stats)
+  {
+    stats->m_numPoints = points.size();
+    stats->m_numAddresses = count_if(addresses.begin(), addresses.end(), [](Address const & a) { return a.IsValid(); });
+    stats->m_numLoadedCells = numLoadedCells;
+    stats->m_seconds = timer.ElapsedSeconds();
+  }
+  return addresses;
+}
+
+// static
+uint64_t BatchReverseGeocoder::GetHilbertIndex(uint32_t x, uint32_t y, uint8_t order)
+{
+  ASSERT_GREATER(order, 0, ());
+  ASSERT_LESS_OR_EQUAL(order, 32, ());
+
+  uint64_t const n = uint64_t{1} << order;
+  uint64_t index = 0;
+  for (uint64_t s = n / 2; s > 0; s /= 2)
+  {
+    uint64_t const rx = (x & s) > 0 ? 1 : 0;
+    uint64_t const ry = (y & s) > 0 ? 1 : 0;
+    index += s * s * ((3 * rx) ^ ry);
+
+    // Rotates the quadrant, so that the curve inside it starts at its origin.
+    if (ry == 0)
+    {
+      if (rx == 1)
+      {
+        x = static_cast<uint32_t>(n - 1 - x);
+        y = static_cast<uint32_t>(n - 1 - y);
+      }
+      swap(x, y);
+    }
+  }
+  return index;
+}
+
+string DebugPrint(BatchReverseGeocoder::Stats const & stats)
+{
+  ostringstream os;
+  os << "BatchReverseGeocoder::Stats [ points: " << stats.m_numPoints << ", addresses: " << stats.m_numAddresses
+     << ", loaded cells: " << stats.m_numLoadedCells << ", seconds: " << stats.m_seconds
+     << ", points per second: " << stats.GetPointsPerSecond() << " ]";
+  return os.str();
+}
+}  // namespace search
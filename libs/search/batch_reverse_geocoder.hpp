@@ -0,0 +1,59 @@
+#pragma once
+
+#include "search/reverse_geocoder.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class DataSource;
+
+namespace search
+{
+// Reverse geocoder for large sets of points, e.g. points of GPS tracks. Points are processed
+// in the order of the Hilbert curve, so close points are processed one after another. Buildings
+// around the points are loaded once per cell of a grid, and streets are looked up once per building.
+// Points are split into contiguous ranges of the curve which are processed in parallel.
+class BatchReverseGeocoder
+{
+public:
+  using Address = ReverseGeocoder::Address;
+
+  struct Stats
+  {
+    double GetPointsPerSecond() const;
+
+    size_t m_numPoints = 0;
+    size_t m_numAddresses = 0;
+    // Number of times the buildings of a grid cell were loaded.
+    size_t m_numLoadedCells = 0;
+    double m_seconds = 0.0;
+  };
+
+  // Doesn't take ownership of |dataSource|.
+  BatchReverseGeocoder(DataSource const & dataSource, size_t numThreads);
+
+  // Returns addresses of |points| in the same order. As ReverseGeocoder::GetNearbyAddress(), it
+  // returns the address of the nearest building in |maxDistanceM| which has a house number and
+  // a street, but checks only a few nearest buildings. Address of a point without it is invalid.
+  std::vector<Address> GetNearbyAddresses(std::vector<m2::PointD> const & points,
+                                          double maxDistanceM = ReverseGeocoder::kLookupRadiusM,
+                                          Stats * stats = nullptr) const;
+
+  // Returns the position of the cell (|x|, |y|) on the Hilbert curve which fills
+  // the 2^|order| x 2^|order| grid.
+  static uint64_t GetHilbertIndex(uint32_t x, uint32_t y, uint8_t order);
+
+private:
+  class Worker;
+
+  DataSource const & m_dataSource;
+  ReverseGeocoder const m_coder;
+  size_t const m_numThreads;
+};
+
+std::string DebugPrint(BatchReverseGeocoder::Stats const & stats);
+}  // namespace search
@@ -5,6 +5,7 @@
 #include "storage/country_info_getter.hpp"
 
 #include "indexer/categories_holder.hpp"
+#include "indexer/data_source.hpp"
 #include "indexer/search_string_utils.hpp"
 
 #include "base/scope_guard.hpp"
@@ -12,6 +13,7 @@
 
 #include <algorithm>
 #include <map>
+#include <optional>
 #include <vector>
 
 namespace search
@@ -79,17 +81,28 @@ Engine::Params::Params(string const & locale, size_t numThreads) : m_locale(loca
 // Engine ------------------------------------------------------------------------------------------
 Engine::Engine(DataSource & dataSource, CategoriesHolder const & categories,
                storage::CountryInfoGetter const & infoGetter, Params const & params)
-  : m_shutdown(false)
+  : m_dataSource(dataSource)
+  , m_shutdown(false)
 {
   InitSuggestions doInit;
   categories.ForEachName(doInit);
   doInit.GetSuggests(m_suggests);
 
+  if (params.m_resultsCache.m_maxNumResults > 0)
+  {
+    m_resultsCache = make_unique<ResultsCache>(params.m_resultsCache);
+    m_dataSource.AddObserver(*m_resultsCache);
+  }
+
+  if (params.m_numRetrievalThreads > 0)
+    m_retrievalThreadPool = make_unique<base::ComputationalThreadPool>(params.m_numRetrievalThreads);
+
   m_contexts.resize(params.m_numThreads);
   for (size_t i = 0; i < params.m_numThreads; ++i)
   {
-    auto processor = make_unique<Processor>(dataSource, categories, m_suggests, infoGetter);
+    auto processor = make_unique<Processor>(dataSource, categories, m_suggests, infoGetter, m_dfaCache);
     processor->SetPreferredLocale(params.m_locale);
+    processor->SetRetrievalThreadPool(m_retrievalThreadPool.get());
     m_contexts[i].m_processor = std::move(processor);
   }
 
@@ -112,6 +125,9 @@ Engine::~Engine()
 
   for (auto & thread : m_threads)
     thread.join();
+
+  if (m_resultsCache)
+    m_dataSource.RemoveObserver(*m_resultsCache);
 }
 
 weak_ptr<ProcessorHandle> Engine::Search(SearchParams params)
@@ -124,6 +140,8 @@ weak_ptr<ProcessorHandle> Engine::Search(SearchParams params)
 
 void Engine::SetLocale(string const & locale)
 {
+  // Names in the cached results are in the previous locale.
+  ClearResultsCache();
   PostMessage(Message::TYPE_BROADCAST, [locale](Processor & processor) { processor.SetPreferredLocale(locale); });
 }
 
@@ -134,9 +152,17 @@ size_t Engine::GetNumThreads() const
 
 void Engine::ClearCaches()
 {
+  ClearResultsCache();
+  m_dfaCache.Clear();
   PostMessage(Message::TYPE_BROADCAST, [](Processor & processor) { processor.ClearCaches(); });
 }
 
+void Engine::ClearResultsCache()
+{
+  if (m_resultsCache)
+    m_resultsCache->Clear();
+}
+
 void Engine::CacheWorldLocalities()
 {
   PostMessage(Message::TYPE_BROADCAST, [](Processor & processor) { processor.CacheWorldLocalities(); });
@@ -269,6 +295,41 @@ void Engine::DoSearch(SearchParams params, shared_ptr<ProcessorHandle> handle, P
   handle->Attach(processor);
   SCOPE_GUARD(detach, [&handle] { handle->Detach(); });
 
+  optional<ResultsCache::Key> cacheKey;
+  if (m_resultsCache)
+    cacheKey = ResultsCache::MakeKey(params);
+
+  if (!cacheKey)
+  {
+    processor.Search(std::move(params));
+    return;
+  }
+
+  if (processor.CancellationStatus() == base::Cancellable::Status::Active)
+  {
+    if (auto const results = m_resultsCache->Get(*cacheKey))
+    {
+      LOG(LINFO, ("Search results are taken from the cache."));
+      if (params.m_onStarted)
+        params.m_onStarted();
+      params.m_onResults(*results);
+      return;
+    }
+  }
+
+  auto const generation = m_resultsCache->GetGeneration();
+  Results finalResults;
+  params.m_onResults = [&finalResults, onResults = std::move(params.m_onResults)](Results const & results)
+  {
+    if (results.IsEndedNormal())
+      finalResults = results;
+    onResults(results);
+  };
+
   processor.Search(std::move(params));
+
+  // Results of a search which was stopped by timeout are not complete.
+  if (finalResults.IsEndedNormal() && processor.CancellationStatus() == base::Cancellable::Status::Active)
+    m_resultsCache->Put(*cacheKey, generation, finalResults);
 }
 }  // namespace search
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "search/levenshtein_dfa_cache.hpp"
+#include "search/results_cache.hpp"
 #include "search/search_params.hpp"
 #include "search/suggest.hpp"
 
@@ -7,6 +9,7 @@
 
 #include "base/macros.hpp"
 #include "base/thread.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <condition_variable>
 #include <functional>
@@ -80,6 +83,15 @@ public:
     // to process queries. Use this field wisely as large values may
     // negatively affect performance due to false sharing.
     size_t m_numThreads;
+
+    // Number of threads which are shared by the queries to retrieve features of query tokens
+    // from several mwms at once, see Geocoder::SetThreadPool(). Zero means that every query is
+    // processed on its own thread only. These threads are not attached to JVM.
+    size_t m_numRetrievalThreads = 0;
+
+    // Final results of repeated queries are taken from the cache, see ResultsCache.
+    // The cache is disabled by default.
+    ResultsCache::Params m_resultsCache;
   };
 
   // Doesn't take ownership of dataSource and categories.
@@ -96,9 +108,12 @@ public:
   // Returns the number of request-processing threads.
   size_t GetNumThreads() const;
 
-  // Posts request to clear caches to the queue.
+  // Posts request to clear caches to the queue. Clears the results cache immediately.
   void ClearCaches();
 
+  // Clears the results cache, must be called when features are edited.
+  void ClearResultsCache();
+
   // Posts requests to load and cache localities from World.mwm.
   void CacheWorldLocalities();
 
@@ -168,13 +183,20 @@ private:
 
   void DoSearch(SearchParams params, std::shared_ptr<ProcessorHandle> handle, Processor & processor);
 
+  DataSource & m_dataSource;
+
   std::vector<Suggest> m_suggests;
+  std::unique_ptr<ResultsCache> m_resultsCache;
+  // DFAs of query tokens which are shared by the processors.
+  LevenshteinDFACache m_dfaCache;
 
   bool m_shutdown;
   std::mutex m_mu;
   std::condition_variable m_cv;
 
   std::queue<Message> m_messages;
+  // It's declared before |m_contexts|, so it's destroyed after the processors which use it.
+  std::unique_ptr<base::ComputationalThreadPool> m_retrievalThreadPool;
   std::vector<Context> m_contexts;
   std::vector<threads::SimpleThread> m_threads;
 };
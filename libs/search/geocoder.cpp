@@ -36,8 +36,11 @@
 #include "base/macros.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <algorithm>
+#include <deque>
+#include <future>
 
 #include "defines.hpp"
 
@@ -286,6 +289,20 @@ double GetDistanceMeters(m2::PointD const & pivot, m2::RectD const & rect)
   return distance;
 }
 
+// Cancels the retrievals which are not needed anymore, e.g. after the early break of
+// Geocoder::ForEachCountry(). They are cancelled together with the query too.
+class RetrievalCancellable : public base::Cancellable
+{
+public:
+  explicit RetrievalCancellable(base::Cancellable const & query) : m_query(query) {}
+
+  // base::Cancellable overrides:
+  bool IsCancelled() const override { return base::Cancellable::IsCancelled() || m_query.IsCancelled(); }
+
+private:
+  base::Cancellable const & m_query;
+};
+
 unique_ptr<MwmContext> GetWorldContext(DataSource const & dataSource)
 {
   vector<shared_ptr<MwmInfo>> infos;
@@ -320,7 +337,8 @@ void Geocoder::LocalitiesCaches::Clear()
 // Geocoder::Geocoder ------------------------------------------------------------------------------
 Geocoder::Geocoder(DataSource const & dataSource, storage::CountryInfoGetter const & infoGetter,
                    CategoriesHolder const & categories, CitiesBoundariesTable const & citiesBoundaries,
-                   PreRanker & preRanker, LocalitiesCaches & localitiesCaches, base::Cancellable const & cancellable)
+                   PreRanker & preRanker, LocalitiesCaches & localitiesCaches, LevenshteinDFACache & dfaCache,
+                   base::Cancellable const & cancellable)
   : m_dataSource(dataSource)
   , m_infoGetter(infoGetter)
   , m_categories(categories)
@@ -330,6 +348,7 @@ Geocoder::Geocoder(DataSource const & dataSource, storage::CountryInfoGetter con
   , m_hotelsCache(cancellable)
   , m_foodCache(cancellable)
   , m_cuisineFilter(m_foodCache)
+  , m_dfaCache(dfaCache)
   , m_cancellable(cancellable)
   , m_citiesBoundaries(citiesBoundaries)
   , m_pivotRectsCache(kPivotRectsCacheSize, m_cancellable, kMaxViewportRadiusM)
@@ -356,7 +375,7 @@ void Geocoder::SetParams(Params const & params)
 
   auto const MakeRequest = [this](size_t i, auto & request)
   {
-    FillRequestFromToken(m_params.GetToken(i), request);
+    FillRequestFromToken(m_params.GetToken(i), m_dfaCache, request);
     for (auto const & index : m_params.GetTypeIndices(i))
       request.m_categories.emplace_back(FeatureTypeToString(index));
     request.SetLangs(m_params.GetLangs());
@@ -564,7 +583,7 @@ void Geocoder::GoImpl(vector<MwmInfoPtr> const & infos, bool inViewport)
 
   // MatchAroundPivot() should always be matched in mwms
   // intersecting with position and viewport.
-  auto processCountry = [&](unique_ptr<MwmContext> context, bool updatePreranker)
+  auto processCountry = [&](unique_ptr<MwmContext> context, TokensFeatures && features, bool updatePreranker)
   {
     ASSERT(context, ());
     m_context = std::move(context);
@@ -589,7 +608,7 @@ void Geocoder::GoImpl(vector<MwmInfoPtr> const & infos, bool inViewport)
     m_matcher->SetContext(m_context.get());
 
     BaseContext ctx;
-    InitBaseContext(ctx);
+    InitBaseContext(ctx, std::move(features));
 
     if (inViewport)
     {
@@ -634,31 +653,45 @@ void Geocoder::GoImpl(vector<MwmInfoPtr> const & infos, bool inViewport)
 
 void Geocoder::InitBaseContext(BaseContext & ctx)
 {
-  Retrieval retrieval(*m_context, m_cancellable);
+  InitBaseContext(ctx, RetrieveTokensFeatures(*m_context, m_cancellable));
+}
 
+void Geocoder::InitBaseContext(BaseContext & ctx, TokensFeatures && features)
+{
   size_t const numTokens = m_params.GetNumTokens();
+  CHECK_EQUAL(features.size(), numTokens, ());
   ctx.m_tokens.assign(numTokens, BaseContext::TOKEN_TYPE_COUNT);
-  ctx.m_features.resize(numTokens);
+  ctx.m_features = std::move(features);
+
+  ctx.m_cuisineFilter = m_cuisineFilter.MakeScopedFilter(*m_context, m_params.m_cuisineTypes);
+}
+
+Geocoder::TokensFeatures Geocoder::RetrieveTokensFeatures(MwmContext & context,
+                                                          base::Cancellable const & cancellable) const
+{
+  Retrieval retrieval(context, cancellable);
+
+  size_t const numTokens = m_params.GetNumTokens();
+  TokensFeatures features(numTokens);
   for (size_t i = 0; i < numTokens; ++i)
   {
     if (m_params.IsCategorialRequest())
     {
       // Implementation-wise, the simplest way to match a feature by
       // its category bypassing the matching by name is by using a CategoriesCache.
-      CategoriesCache cache(m_params.m_preferredTypes, m_cancellable);
-      ctx.m_features[i] = Retrieval::ExtendedFeatures(cache.Get(*m_context));
+      CategoriesCache cache(m_params.m_preferredTypes, cancellable);
+      features[i] = Retrieval::ExtendedFeatures(cache.Get(context));
     }
     else if (m_params.IsPrefixToken(i))
     {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_prefixTokenRequest);
+      features[i] = retrieval.RetrieveAddressFeatures(m_prefixTokenRequest);
     }
     else
     {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_tokenRequests[i]);
+      features[i] = retrieval.RetrieveAddressFeatures(m_tokenRequests[i]);
     }
   }
-
-  ctx.m_cuisineFilter = m_cuisineFilter.MakeScopedFilter(*m_context, m_params.m_cuisineTypes);
+  return features;
 }
 
 void Geocoder::InitLayer(Model::Type type, TokenRange const & tokenRange, FeaturesLayer & layer)
@@ -870,23 +903,89 @@ bool Geocoder::CityHasPostcode(BaseContext const & ctx) const
 template <typename Fn>
 void Geocoder::ForEachCountry(ExtendedMwmInfos const & extendedInfos, Fn && fn)
 {
-  for (size_t i = 0; i < extendedInfos.m_infos.size(); ++i)
+  struct Country
   {
-    auto const & info = extendedInfos.m_infos[i].m_info;
-    if (info->GetType() != MwmInfo::COUNTRY && info->GetType() != MwmInfo::WORLD)
-      continue;
-    if (info->GetType() == MwmInfo::COUNTRY && m_params.m_mode == Mode::Downloader)
-      continue;
+    unique_ptr<MwmContext> m_context;
+    bool m_updatePreranker = false;
+    // Features of the tokens which are retrieved on |m_threadPool|.
+    future<TokensFeatures> m_features;
+  };
 
-    auto handle = m_dataSource.GetMwmHandleById(MwmSet::MwmId(info));
-    if (!handle.IsAlive())
-      continue;
-    auto & value = *handle.GetValue();
-    if (!value.HasSearchIndex() || !value.HasGeometryIndex())
-      continue;
-    bool const updatePreranker = i + 1 >= extendedInfos.m_firstBatchSize;
-    auto const & mwmType = extendedInfos.m_infos[i].m_type;
-    if (fn(make_unique<MwmContext>(std::move(handle), mwmType), updatePreranker) == base::ControlFlow::Break)
+  // Countries which are taken from |extendedInfos| but are not processed yet. Their features are
+  // retrieved in parallel, but they are processed one by one in the order of |extendedInfos|,
+  // so the results don't depend on the number of threads.
+  deque<Country> countries;
+  RetrievalCancellable retrievalCancellable(m_cancellable);
+  // The retrievals which are in flight after the break or an exception are not needed.
+  SCOPE_GUARD(waitRetrieval, [&]()
+  {
+    retrievalCancellable.Cancel();
+    for (auto & country : countries)
+      if (country.m_features.valid())
+        country.m_features.wait();
+  });
+
+  // Time of the query thread, it shows how much the retrieval takes in comparison with matching.
+  double retrievalSec = 0.0;
+  double matchingSec = 0.0;
+  size_t processedCount = 0;
+  SCOPE_GUARD(printTimes, [&]()
+  {
+    LOG(LDEBUG, ("Mwms:", processedCount, "retrieval wait time:", retrievalSec, "matching time:", matchingSec,
+                 "seconds, retrieval threads:", m_threadPool ? m_threadPool->GetThreadsCount() : 0));
+  });
+
+  size_t const maxRetrievedCountries = m_threadPool ? m_threadPool->GetThreadsCount() : 0;
+  size_t i = 0;
+  auto const takeCountries = [&]()
+  {
+    for (; i < extendedInfos.m_infos.size() && countries.size() <= maxRetrievedCountries; ++i)
+    {
+      auto const & info = extendedInfos.m_infos[i].m_info;
+      if (info->GetType() != MwmInfo::COUNTRY && info->GetType() != MwmInfo::WORLD)
+        continue;
+      if (info->GetType() == MwmInfo::COUNTRY && m_params.m_mode == Mode::Downloader)
+        continue;
+
+      auto handle = m_dataSource.GetMwmHandleById(MwmSet::MwmId(info));
+      if (!handle.IsAlive())
+        continue;
+      auto & value = *handle.GetValue();
+      if (!value.HasSearchIndex() || !value.HasGeometryIndex())
+        continue;
+
+      auto & country = countries.emplace_back();
+      country.m_context = make_unique<MwmContext>(std::move(handle), extendedInfos.m_infos[i].m_type);
+      country.m_updatePreranker = i + 1 >= extendedInfos.m_firstBatchSize;
+      if (m_threadPool)
+      {
+        country.m_features = m_threadPool->Submit([this, &context = *country.m_context, &retrievalCancellable]()
+        { return RetrieveTokensFeatures(context, retrievalCancellable); });
+      }
+    }
+  };
+
+  while (true)
+  {
+    takeCountries();
+    if (countries.empty())
+      break;
+
+    auto & country = countries.front();
+    base::Timer timer;
+    // Rethrows CancelException of the retrieval.
+    auto features = country.m_features.valid() ? country.m_features.get()
+                                               : RetrieveTokensFeatures(*country.m_context, m_cancellable);
+    retrievalSec += timer.ElapsedSeconds();
+    auto context = std::move(country.m_context);
+    bool const updatePreranker = country.m_updatePreranker;
+    countries.pop_front();
+
+    timer.Reset();
+    auto const flow = fn(std::move(context), std::move(features), updatePreranker);
+    matchingSec += timer.ElapsedSeconds();
+    ++processedCount;
+    if (flow == base::ControlFlow::Break)
       break;
   }
 }
@@ -12,6 +12,7 @@
 #include "search/geocoder_context.hpp"
 #include "search/geocoder_locality.hpp"
 #include "search/geometry_cache.hpp"
+#include "search/levenshtein_dfa_cache.hpp"
 #include "search/mode.hpp"
 #include "search/model.hpp"
 #include "search/mwm_context.hpp"
@@ -39,6 +40,11 @@ class CategoriesHolder;
 class DataSource;
 class MwmValue;
 
+namespace base
+{
+class ComputationalThreadPool;
+}  // namespace base
+
 namespace storage
 {
 class CountryInfoGetter;
@@ -99,7 +105,7 @@ public:
 
   Geocoder(DataSource const & dataSource, storage::CountryInfoGetter const & infoGetter,
            CategoriesHolder const & categories, CitiesBoundariesTable const & citiesBoundaries, PreRanker & preRanker,
-           LocalitiesCaches & localitiesCaches, base::Cancellable const & cancellable);
+           LocalitiesCaches & localitiesCaches, LevenshteinDFACache & dfaCache, base::Cancellable const & cancellable);
   ~Geocoder();
 
   // Sets search query params.
@@ -126,6 +132,10 @@ public:
   void CacheWorldLocalities();
   void ClearCaches();
 
+  // Features of the query tokens are retrieved from the next mwms on |threadPool| while the
+  // current mwm is matched. nullptr means that all the mwms are processed on the calling thread.
+  void SetThreadPool(base::ComputationalThreadPool * threadPool) { m_threadPool = threadPool; }
+
 private:
   enum class RectId
   {
@@ -188,9 +198,17 @@ private:
 
   QueryParams::Token const & GetTokens(size_t i) const;
 
+  using TokensFeatures = std::vector<Retrieval::ExtendedFeatures>;
+
   // Creates a cache of posting lists corresponding to features in m_context
   // for each token and saves it to m_addressFeatures.
   void InitBaseContext(BaseContext & ctx);
+  // Same as above, but the posting lists are already retrieved.
+  void InitBaseContext(BaseContext & ctx, TokensFeatures && features);
+
+  // Retrieves posting lists of the query tokens from |context|. It may be called on any thread,
+  // since it reads the immutable state of the query only.
+  TokensFeatures RetrieveTokensFeatures(MwmContext & context, base::Cancellable const & cancellable) const;
 
   void InitLayer(Model::Type type, TokenRange const & tokenRange, FeaturesLayer & layer);
 
@@ -316,6 +334,7 @@ private:
   HotelsCache m_hotelsCache;
   FoodCache m_foodCache;
   cuisine_filter::CuisineFilter m_cuisineFilter;
+  LevenshteinDFACache & m_dfaCache;
 
   base::Cancellable const & m_cancellable;
 
@@ -334,6 +353,8 @@ private:
   // Context of the currently processed mwm.
   std::unique_ptr<MwmContext> m_context;
 
+  base::ComputationalThreadPool * m_threadPool = nullptr;
+
   // m_cities stores both big cities that are visible at World.mwm
   // and small villages and hamlets that are not.
   TokenToLocalities<City> m_cities;
@@ -364,8 +385,8 @@ private:
   FeaturesLayerPathFinder m_finder;
 
   // Search query params prepared for retrieval.
-  std::vector<SearchTrieRequest<strings::LevenshteinDFA>> m_tokenRequests;
-  SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> m_prefixTokenRequest;
+  std::vector<SearchTrieRequest<SharedLevenshteinDFA>> m_tokenRequests;
+  SearchTrieRequest<strings::PrefixDFAModifier<SharedLevenshteinDFA>> m_prefixTokenRequest;
 
   ResultTracer m_resultTracer;
 
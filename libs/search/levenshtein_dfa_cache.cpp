@@ -0,0 +1,51 @@
+#include "search/levenshtein_dfa_cache.hpp"
+
+#include "indexer/search_string_utils.hpp"
+
+namespace search
+{
+using namespace std;
+
+LevenshteinDFACache::LevenshteinDFACache(size_t maxNumDFAs) : m_fuzzy(maxNumDFAs), m_exact(maxNumDFAs) {}
+
+SharedLevenshteinDFA LevenshteinDFACache::GetFuzzy(strings::UniString const & s)
+{
+  return Get(m_fuzzy, s, [&s]() { return BuildLevenshteinDFA(s); });
+}
+
+SharedLevenshteinDFA LevenshteinDFACache::GetExact(strings::UniString const & s)
+{
+  return Get(m_exact, s, [&s]() { return strings::LevenshteinDFA(s, 0 /* maxErrors */); });
+}
+
+void LevenshteinDFACache::Clear()
+{
+  lock_guard<mutex> lock(m_mu);
+  m_fuzzy.Clear();
+  m_exact.Clear();
+}
+
+template <typename Build>
+SharedLevenshteinDFA LevenshteinDFACache::Get(Cache & cache, strings::UniString const & s, Build && build)
+{
+  // DFAs of query tokens are built fast enough to build them under the lock.
+  lock_guard<mutex> lock(m_mu);
+  auto const key = strings::ToUtf8(s);
+  bool found = false;
+  auto & dfa = cache.Find(key, found);
+  if (!found)
+  {
+    // Find() has inserted an empty entry, it must not be left if the build fails.
+    try
+    {
+      dfa = make_shared<strings::LevenshteinDFA const>(build());
+    }
+    catch (...)
+    {
+      cache.Erase(key);
+      throw;
+    }
+  }
+  return SharedLevenshteinDFA(dfa);
+}
+}  // namespace search
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "base/assert.hpp"
+#include "base/levenshtein_dfa.hpp"
+#include "base/lru_cache.hpp"
+#include "base/string_utils.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace search
+{
+// Compiled LevenshteinDFA which may be shared by several requests and threads. It's cheap to copy
+// and it's used as a DFA in SearchTrieRequest.
+class SharedLevenshteinDFA
+{
+public:
+  using Iterator = strings::LevenshteinDFA::Iterator;
+
+  explicit SharedLevenshteinDFA(std::shared_ptr<strings::LevenshteinDFA const> dfa) : m_dfa(std::move(dfa))
+  {
+    ASSERT(m_dfa, ());
+  }
+
+  Iterator Begin() const { return m_dfa->Begin(); }
+
+  strings::LevenshteinDFA const & Get() const { return *m_dfa; }
+
+private:
+  std::shared_ptr<strings::LevenshteinDFA const> m_dfa;
+};
+
+// Cache of DFAs of query tokens. When a user types a query, it's sent on each keystroke and
+// all tokens except the last one are the same as in the previous query, so their DFAs are
+// not built again. Least recently used DFAs are evicted.
+//
+// NOTE: this class is thread-safe.
+class LevenshteinDFACache
+{
+public:
+  static size_t constexpr kDefaultMaxNumDFAs = 128;
+
+  // |maxNumDFAs| bounds the number of both fuzzy and exact DFAs.
+  explicit LevenshteinDFACache(size_t maxNumDFAs = kDefaultMaxNumDFAs);
+
+  // Returns the same DFA as BuildLevenshteinDFA(|s|).
+  SharedLevenshteinDFA GetFuzzy(strings::UniString const & s);
+
+  // Returns the DFA which accepts |s| only.
+  SharedLevenshteinDFA GetExact(strings::UniString const & s);
+
+  void Clear();
+
+private:
+  using Cache = LruCache<std::string, std::shared_ptr<strings::LevenshteinDFA const>>;
+
+  template <typename Build>
+  SharedLevenshteinDFA Get(Cache & cache, strings::UniString const & s, Build && build);
+
+  std::mutex m_mu;
+  Cache m_fuzzy;
+  Cache m_exact;
+};
+}  // namespace search
@@ -157,7 +157,8 @@ bool EatVersion(string & s, uint32_t & version)
 }  // namespace
 
 Processor::Processor(DataSource const & dataSource, CategoriesHolder const & categories,
-                     vector<Suggest> const & suggests, storage::CountryInfoGetter const & infoGetter)
+                     vector<Suggest> const & suggests, storage::CountryInfoGetter const & infoGetter,
+                     LevenshteinDFACache & dfaCache)
   : m_categories(categories)
   , m_infoGetter(infoGetter)
   , m_dataSource(dataSource)
@@ -167,7 +168,7 @@ Processor::Processor(DataSource const & dataSource, CategoriesHolder const & cat
   , m_ranker(m_dataSource, m_citiesBoundaries, infoGetter, m_keywordsScorer, m_emitter, categories, suggests,
              m_localitiesCaches.m_villages, static_cast<base::Cancellable const &>(*this))
   , m_preRanker(m_dataSource, m_ranker)
-  , m_geocoder(m_dataSource, infoGetter, categories, m_citiesBoundaries, m_preRanker, m_localitiesCaches,
+  , m_geocoder(m_dataSource, infoGetter, categories, m_citiesBoundaries, m_preRanker, m_localitiesCaches, dfaCache,
                static_cast<base::Cancellable const &>(*this))
   , m_bookmarksProcessor(m_emitter, static_cast<base::Cancellable const &>(*this))
 {
@@ -57,10 +57,12 @@ public:
   static size_t const kPreResultsCount;
 
   Processor(DataSource const & dataSource, CategoriesHolder const & categories, std::vector<Suggest> const & suggests,
-            storage::CountryInfoGetter const & infoGetter);
+            storage::CountryInfoGetter const & infoGetter, LevenshteinDFACache & dfaCache);
 
   void SetViewport(m2::RectD const & viewport);
   void SetPreferredLocale(std::string const & locale);
+  // See Geocoder::SetThreadPool().
+  void SetRetrievalThreadPool(base::ComputationalThreadPool * threadPool) { m_geocoder.SetThreadPool(threadPool); }
   void SetInputLocale(std::string const & locale);
   void SetQuery(std::string const & query, bool categorialRequest = false);
 
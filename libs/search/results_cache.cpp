@@ -0,0 +1,204 @@
+#include "search/results_cache.hpp"
+
+#include "base/assert.hpp"
+#include "base/string_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <tuple>
+
+namespace search
+{
+using namespace std;
+
+namespace
+{
+// Each side of the viewport covers at most this number of cells.
+double constexpr kCellsPerViewportSide = 8.0;
+int constexpr kMinViewportLevel = -30;
+
+// ~1km in mercator, it's enough to not change the ranking of results by distance.
+double constexpr kPositionCellSize = 0.01;
+
+auto Tie(ResultsCache::Key const & key)
+{
+  return tie(key.m_query, key.m_inputLocale, key.m_mode, key.m_viewportLevel, key.m_viewportX, key.m_viewportY,
+             key.m_hasPosition, key.m_positionX, key.m_positionY, key.m_maxNumResults, key.m_streetSearchRadiusM,
+             key.m_maxStreetsCount, key.m_streetClusterRadiusMercator, key.m_suggestsEnabled, key.m_needAddress,
+             key.m_needHighlighting, key.m_categorialRequest, key.m_useDebugInfo);
+}
+
+string CollapseWhitespaces(string const & query)
+{
+  string result;
+  result.reserve(query.size());
+  for (char const c : query)
+  {
+    if (!strings::IsASCIISpace(c))
+      result.push_back(c);
+    else if (!result.empty() && result.back() != ' ')
+      result.push_back(' ');
+  }
+  return result;
+}
+
+int64_t Quantize(double coord, double cellSize)
+{
+  return static_cast<int64_t>(floor(coord / cellSize));
+}
+}  // namespace
+
+// ResultsCache::Key -------------------------------------------------------------------------------
+bool ResultsCache::Key::operator<(Key const & rhs) const
+{
+  return Tie(*this) < Tie(rhs);
+}
+
+bool ResultsCache::Key::operator==(Key const & rhs) const
+{
+  return Tie(*this) == Tie(rhs);
+}
+
+// ResultsCache ------------------------------------------------------------------------------------
+ResultsCache::ResultsCache(Params const & params) : m_params(params) {}
+
+// static
+optional<ResultsCache::Key> ResultsCache::MakeKey(SearchParams const & params)
+{
+  // Results of the search in viewport must be exactly inside the viewport and bookmarks may be
+  // changed at any moment. Tracer needs a real search.
+  if (params.m_mode != Mode::Everywhere && params.m_mode != Mode::Downloader)
+    return {};
+  if (params.m_tracer || !params.m_viewport.IsValid())
+    return {};
+
+  Key key;
+  key.m_query = CollapseWhitespaces(params.m_query);
+  key.m_inputLocale = params.m_inputLocale;
+  key.m_mode = params.m_mode;
+
+  auto const & viewport = params.m_viewport;
+  double const side = max(viewport.SizeX(), viewport.SizeY());
+  key.m_viewportLevel = side > 0 ? max(static_cast<int>(ceil(log2(side))), kMinViewportLevel) : kMinViewportLevel;
+  double const cellSize = ldexp(1.0, key.m_viewportLevel) / kCellsPerViewportSide;
+  auto const center = viewport.Center();
+  key.m_viewportX = Quantize(center.x, cellSize);
+  key.m_viewportY = Quantize(center.y, cellSize);
+
+  if (params.m_position)
+  {
+    key.m_hasPosition = true;
+    key.m_positionX = Quantize(params.m_position->x, kPositionCellSize);
+    key.m_positionY = Quantize(params.m_position->y, kPositionCellSize);
+  }
+
+  key.m_maxNumResults = params.m_maxNumResults;
+
+  auto const & filteringParams = params.m_filteringParams;
+  key.m_streetSearchRadiusM = filteringParams.m_streetSearchRadiusM;
+  key.m_maxStreetsCount = filteringParams.m_maxStreetsCount;
+  key.m_streetClusterRadiusMercator = filteringParams.m_streetClusterRadiusMercator;
+
+  key.m_suggestsEnabled = params.m_suggestsEnabled;
+  key.m_needAddress = params.m_needAddress;
+  key.m_needHighlighting = params.m_needHighlighting;
+  key.m_categorialRequest = params.m_categorialRequest;
+  key.m_useDebugInfo = params.m_useDebugInfo;
+  return key;
+}
+
+uint64_t ResultsCache::GetGeneration() const
+{
+  lock_guard<mutex> lock(m_mu);
+  return m_generation;
+}
+
+shared_ptr<Results const> ResultsCache::Get(Key const & key)
+{
+  lock_guard<mutex> lock(m_mu);
+  auto const it = m_index.find(key);
+  if (it == m_index.end())
+    return {};
+
+  auto const entryIt = it->second;
+  if (entryIt->m_expiration <= Clock::now())
+  {
+    Erase(entryIt);
+    return {};
+  }
+
+  m_entries.splice(m_entries.begin(), m_entries, entryIt);
+  return entryIt->m_results;
+}
+
+void ResultsCache::Put(Key const & key, uint64_t generation, Results const & results)
+{
+  ASSERT(results.IsEndedNormal(), ());
+
+  size_t const cost = GetCost(results);
+  if (cost > m_params.m_maxNumResults)
+    return;
+
+  auto cached = make_shared<Results const>(results);
+
+  lock_guard<mutex> lock(m_mu);
+  if (generation != m_generation)
+    return;
+
+  if (auto const it = m_index.find(key); it != m_index.end())
+    Erase(it->second);
+
+  while (!m_entries.empty() && m_numResults + cost > m_params.m_maxNumResults)
+    Erase(prev(m_entries.end()));
+
+  m_entries.push_front({key, std::move(cached), Clock::now() + m_params.m_ttl});
+  m_index.emplace(key, m_entries.begin());
+  m_numResults += cost;
+}
+
+void ResultsCache::Clear()
+{
+  lock_guard<mutex> lock(m_mu);
+  ++m_generation;
+  m_entries.clear();
+  m_index.clear();
+  m_numResults = 0;
+}
+
+size_t ResultsCache::GetNumResults() const
+{
+  lock_guard<mutex> lock(m_mu);
+  return m_numResults;
+}
+
+void ResultsCache::OnMapRegistered(platform::LocalCountryFile const & /* localFile */)
+{
+  Clear();
+}
+
+void ResultsCache::OnMapDeregistered(platform::LocalCountryFile const & /* localFile */)
+{
+  Clear();
+}
+
+void ResultsCache::Erase(Entries::iterator it)
+{
+  size_t const cost = GetCost(*it->m_results);
+  ASSERT_GREATER_OR_EQUAL(m_numResults, cost, ());
+  m_numResults -= cost;
+  m_index.erase(it->m_key);
+  m_entries.erase(it);
+}
+
+string DebugPrint(ResultsCache::Key const & key)
+{
+  ostringstream os;
+  os << "ResultsCache::Key [ " << key.m_query << ", " << key.m_inputLocale << ", " << DebugPrint(key.m_mode)
+     << ", viewport: " << key.m_viewportLevel << " " << key.m_viewportX << " " << key.m_viewportY;
+  if (key.m_hasPosition)
+    os << ", position: " << key.m_positionX << " " << key.m_positionY;
+  os << ", maxNumResults: " << key.m_maxNumResults << " ]";
+  return os.str();
+}
+}  // namespace search
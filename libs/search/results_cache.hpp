@@ -0,0 +1,122 @@
+#pragma once
+
+#include "search/mode.hpp"
+#include "search/result.hpp"
+#include "search/search_params.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace search
+{
+// Cache of the final results of search queries. Popular queries are repeated often with almost
+// the same viewport and position, so their results may be returned without search at all.
+// The cache is dropped when any mwm is registered or deregistered and must be cleared
+// explicitly on edits of features.
+//
+// NOTE: this class is thread-safe.
+class ResultsCache : public MwmSet::Observer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Params
+  {
+    // Max total number of results of all cached queries, it bounds the memory used by the cache.
+    // Zero disables the cache.
+    size_t m_maxNumResults = 0;
+
+    // Cached results are not used after this time.
+    Clock::duration m_ttl = std::chrono::minutes(10);
+  };
+
+  struct Key
+  {
+    bool operator<(Key const & rhs) const;
+    bool operator==(Key const & rhs) const;
+
+    // Query with collapsed whitespaces. Case and punctuation are kept because coordinates
+    // and codes are matched against the raw query.
+    std::string m_query;
+    std::string m_inputLocale;
+    Mode m_mode = Mode::Everywhere;
+
+    // Viewport is quantized to cells of the size which is proportional to the viewport size.
+    int m_viewportLevel = 0;
+    int64_t m_viewportX = 0;
+    int64_t m_viewportY = 0;
+
+    bool m_hasPosition = false;
+    int64_t m_positionX = 0;
+    int64_t m_positionY = 0;
+
+    size_t m_maxNumResults = 0;
+
+    // SearchParams::m_filteringParams, they change the set of matched streets.
+    double m_streetSearchRadiusM = 0.0;
+    size_t m_maxStreetsCount = 0;
+    double m_streetClusterRadiusMercator = 0.0;
+
+    bool m_suggestsEnabled = false;
+    bool m_needAddress = false;
+    bool m_needHighlighting = false;
+    bool m_categorialRequest = false;
+    bool m_useDebugInfo = false;
+  };
+
+  explicit ResultsCache(Params const & params);
+
+  // Returns std::nullopt when results of the search with |params| must not be cached.
+  static std::optional<Key> MakeKey(SearchParams const & params);
+
+  // Returns the generation which is passed to Put() when the search is finished. Results of
+  // a search which was started before the last Clear() are not cached.
+  uint64_t GetGeneration() const;
+
+  // Returns nullptr if there are no actual results for |key|.
+  std::shared_ptr<Results const> Get(Key const & key);
+  void Put(Key const & key, uint64_t generation, Results const & results);
+
+  void Clear();
+
+  size_t GetNumResults() const;
+
+  // MwmSet::Observer overrides:
+  void OnMapRegistered(platform::LocalCountryFile const & localFile) override;
+  void OnMapDeregistered(platform::LocalCountryFile const & localFile) override;
+
+private:
+  struct Entry
+  {
+    Key m_key;
+    std::shared_ptr<Results const> m_results;
+    Clock::time_point m_expiration;
+  };
+
+  using Entries = std::list<Entry>;
+
+  static size_t GetCost(Results const & results) { return results.GetCount() + 1; }
+
+  void Erase(Entries::iterator it);
+
+  Params const m_params;
+
+  mutable std::mutex m_mu;
+  // Most recently used entries are at the front.
+  Entries m_entries;
+  std::map<Key, Entries::iterator> m_index;
+  size_t m_numResults = 0;
+  uint64_t m_generation = 0;
+};
+
+std::string DebugPrint(ResultsCache::Key const & key);
+}  // namespace search
@@ -381,13 +381,14 @@ Retrieval::ExtendedFeatures Retrieval::RetrieveAddressFeatures(
   return Retrieve<RetrieveAddressFeaturesAdaptor>(request);
 }
 
-Retrieval::ExtendedFeatures Retrieval::RetrieveAddressFeatures(SearchTrieRequest<LevenshteinDFA> const & request) const
+Retrieval::ExtendedFeatures Retrieval::RetrieveAddressFeatures(
+    SearchTrieRequest<SharedLevenshteinDFA> const & request) const
 {
   return Retrieve<RetrieveAddressFeaturesAdaptor>(request);
 }
 
 Retrieval::ExtendedFeatures Retrieval::RetrieveAddressFeatures(
-    SearchTrieRequest<PrefixDFAModifier<LevenshteinDFA>> const & request) const
+    SearchTrieRequest<PrefixDFAModifier<SharedLevenshteinDFA>> const & request) const
 {
   return Retrieve<RetrieveAddressFeaturesAdaptor>(request);
 }
@@ -2,6 +2,7 @@
 
 #include "search/cbv.hpp"
 #include "search/feature_offset_match.hpp"
+#include "search/levenshtein_dfa_cache.hpp"
 #include "search/query_params.hpp"
 
 #include "platform/mwm_traits.hpp"
@@ -13,7 +14,6 @@
 #include "base/cancellable.hpp"
 #include "base/checked_cast.hpp"
 #include "base/dfa_helpers.hpp"
-#include "base/levenshtein_dfa.hpp"
 
 #include <cstdint>
 #include <functional>
@@ -90,10 +90,10 @@ public:
   ExtendedFeatures RetrieveAddressFeatures(
       SearchTrieRequest<strings::PrefixDFAModifier<strings::UniStringDFA>> const & request) const;
 
-  ExtendedFeatures RetrieveAddressFeatures(SearchTrieRequest<strings::LevenshteinDFA> const & request) const;
+  ExtendedFeatures RetrieveAddressFeatures(SearchTrieRequest<SharedLevenshteinDFA> const & request) const;
 
   ExtendedFeatures RetrieveAddressFeatures(
-      SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> const & request) const;
+      SearchTrieRequest<strings::PrefixDFAModifier<SharedLevenshteinDFA>> const & request) const;
 
   // Retrieves all postcodes matching to |slice| from the search index.
   Features RetrievePostcodeFeatures(TokenSlice const & slice) const;
@@ -29,8 +29,6 @@ using namespace std;
 namespace
 {
 int constexpr kQueryScale = scales::GetUpperScale();
-/// Max number of tries (nearest houses with housenumber) to check when getting point address.
-size_t constexpr kMaxNumTriesToApproxAddress = 10;
 
 using AppendStreet = function<void(FeatureType & ft)>;
 using FillStreets = function<void(MwmSet::MwmHandle && handle, m2::RectD const & rect, AppendStreet && addStreet)>;
@@ -62,15 +60,6 @@ ReverseGeocoder::Building FromFeatureImpl(FeatureType & ft, std::string const &
 {
   return {ft.GetID(), distMeters, hn, feature::GetCenter(ft)};
 }
-
-std::string const & GetHouseNumber(FeatureType & ft)
-{
-  std::string const & hn = ft.GetHouseNumber();
-  if (hn.empty() && ftypes::IsAddressInterpolChecker::Instance()(ft))
-    return ft.GetRef();
-  return hn;
-}
-
 }  // namespace
 
 ReverseGeocoder::ReverseGeocoder(DataSource const & dataSource) : m_dataSource(dataSource) {}
@@ -324,6 +313,15 @@ ReverseGeocoder::Building ReverseGeocoder::FromFeature(FeatureType & ft, double
   return FromFeatureImpl(ft, ft.GetHouseNumber(), distMeters);
 }
 
+// static
+std::string const & ReverseGeocoder::GetHouseNumber(FeatureType & ft)
+{
+  std::string const & hn = ft.GetHouseNumber();
+  if (hn.empty() && ftypes::IsAddressInterpolChecker::Instance()(ft))
+    return ft.GetRef();
+  return hn;
+}
+
 std::optional<HouseToStreetTable::Result> ReverseGeocoder::HouseTable::Get(FeatureID const & fid)
 {
   if (feature::FakeFeatureIds::IsEditorCreatedFeature(fid.m_index))
@@ -28,6 +28,8 @@ class RegionInfoGetter;
 
 class ReverseGeocoder
 {
+  friend class BatchReverseGeocoder;
+
   DataSource const & m_dataSource;
 
   struct Object
@@ -152,6 +154,9 @@ public:
   std::string GetLocalizedRegionAddress(RegionAddress const & addr, RegionInfoGetter const & nameGetter) const;
 
 private:
+  /// Max number of tries (nearest houses with housenumber) to check when getting point address.
+  static size_t constexpr kMaxNumTriesToApproxAddress = 10;
+
   /// Helper class to incapsulate house 2 street table reloading.
   class HouseTable
   {
@@ -175,6 +180,9 @@ private:
   void GetNearbyBuildings(m2::PointD const & center, double maxDistanceM, std::vector<Building> & buildings) const;
 
   static Building FromFeature(FeatureType & ft, double distMeters);
+
+  /// @return House number of a building or a number range of an address interpolation line.
+  static std::string const & GetHouseNumber(FeatureType & ft);
 };
 
 }  // namespace search
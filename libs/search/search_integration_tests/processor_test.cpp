@@ -16,6 +16,8 @@
 #include "search/token_range.hpp"
 #include "search/token_slice.hpp"
 
+#include "storage/country_info_getter.hpp"
+
 #include "indexer/feature_impl.hpp"
 
 #include "geometry/mercator.hpp"
@@ -3650,4 +3652,46 @@ UNIT_CLASS_TEST(ProcessorTest, Numeric_POI_Name)
   }
 }
 
+UNIT_CLASS_TEST(ProcessorTest, ParallelRetrieval)
+{
+  vector<TestCafe> cafes;
+  vector<MwmSet::MwmId> ids;
+  cafes.reserve(5);
+  for (size_t i = 0; i < 5; ++i)
+  {
+    double const x = static_cast<double>(i);
+    cafes.emplace_back(m2::PointD(x, 0.0), "Cafe " + strings::to_string(i), "en");
+    ids.push_back(BuildCountry("Wonderland" + strings::to_string(i), [&](TestMwmBuilder & builder)
+    {
+      builder.Add(cafes.back());
+    }));
+  }
+
+  SetViewport(m2::RectD(-0.5, -0.5, 0.5, 0.5));
+
+  Engine::Params engineParams;
+  engineParams.m_numRetrievalThreads = 2;
+  TestSearchEngine engine(m_dataSource, engineParams, true /* mockCountryInfo */);
+  auto & infoGetter = dynamic_cast<storage::CountryInfoGetterForTesting &>(engine.GetCountryInfoGetter());
+  for (auto const & id : ids)
+    infoGetter.AddCountry(storage::CountryDef(id.GetInfo()->GetCountryName(), id.GetInfo()->m_bordersRect));
+
+  Rules rules;
+  for (size_t i = 0; i < cafes.size(); ++i)
+    rules.push_back(ExactMatch(ids[i], cafes[i]));
+
+  auto const params = GetDefaultSearchParams("cafe");
+  auto const request = MakeRequest(params);
+  TEST(ResultsMatch(request->Results(), rules), ());
+
+  // Features are retrieved from several mwms at once, but the results and their order are the same.
+  TestSearchRequest parallelRequest(engine, params);
+  parallelRequest.Run();
+  auto const & expected = request->Results();
+  auto const & actual = parallelRequest.Results();
+  TEST_EQUAL(actual.size(), expected.size(), ());
+  for (size_t i = 0; i < expected.size(); ++i)
+    TEST_EQUAL(actual[i].GetFeatureID(), expected[i].GetFeatureID(), (i));
+}
+
 }  // namespace processor_test
@@ -0,0 +1,148 @@
+#include "search/search_quality/helpers.hpp"
+
+#include "search/batch_reverse_geocoder.hpp"
+#include "search/reverse_geocoder.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/data_source.hpp"
+
+#include "platform/platform_tests_support/helpers.hpp"
+
+#include "geometry/latlon.hpp"
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+
+#include <fstream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+using namespace search::search_quality;
+using namespace search;
+using namespace std;
+
+DEFINE_string(data_path, "", "Path to data directory (resources dir).");
+DEFINE_string(mwm_path, "", "Path to mwm files (writable dir).");
+DEFINE_string(mwm_list_path, "", "Path to a file containing the names of available mwms, one per line.");
+DEFINE_string(in, "", "Path to the input csv file. The first two columns are latitude and longitude.");
+DEFINE_string(out, "", "Path to the output csv file. Street, house number and distance to the house are "
+                       "appended to the columns of the input.");
+DEFINE_uint64(num_threads, thread::hardware_concurrency(), "Number of threads.");
+DEFINE_double(max_distance, ReverseGeocoder::kLookupRadiusM, "Max distance from a point to its house (meters).");
+
+namespace
+{
+// Returns false for a header or a malformed line.
+bool ParsePoint(string_view line, m2::PointD & point)
+{
+  auto const columns = strings::Tokenize(line, ",");
+  if (columns.size() < 2)
+    return false;
+
+  auto lat = columns[0];
+  auto lon = columns[1];
+  strings::Trim(lat);
+  strings::Trim(lon);
+
+  ms::LatLon ll;
+  if (!strings::to_double(lat, ll.m_lat) || !strings::to_double(lon, ll.m_lon))
+    return false;
+
+  if (!mercator::ValidLat(ll.m_lat) || !mercator::ValidLon(ll.m_lon))
+    return false;
+
+  point = mercator::FromLatLon(ll);
+  return true;
+}
+
+string EscapeCsv(string const & s)
+{
+  if (s.find_first_of(",\"\n") == string::npos)
+    return s;
+
+  string res = "\"";
+  for (char const c : s)
+  {
+    if (c == '"')
+      res.push_back('"');
+    res.push_back(c);
+  }
+  res.push_back('"');
+  return res;
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  platform::tests_support::ChangeMaxNumberOfOpenFiles(kMaxOpenFiles);
+
+  gflags::SetUsageMessage("Reverse geocoding of the points of a csv file.");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  SetPlatformDirs(FLAGS_data_path, FLAGS_mwm_path);
+
+  ifstream in(FLAGS_in);
+  CHECK(in.is_open(), ("Can't open input file", FLAGS_in));
+
+  vector<string> lines;
+  vector<m2::PointD> points;
+  // Indices of |points| by lines, max size_t for lines without a point.
+  vector<size_t> lineToPoint;
+  for (string line; getline(in, line);)
+  {
+    m2::PointD point;
+    if (ParsePoint(line, point))
+    {
+      lineToPoint.push_back(points.size());
+      points.push_back(point);
+    }
+    else
+    {
+      lineToPoint.push_back(numeric_limits<size_t>::max());
+    }
+    lines.push_back(std::move(line));
+  }
+  LOG(LINFO, ("Read", points.size(), "points of", lines.size(), "lines."));
+
+  classificator::Load();
+  FrozenDataSource dataSource;
+  InitDataSource(dataSource, FLAGS_mwm_list_path);
+
+  BatchReverseGeocoder const coder(dataSource, FLAGS_num_threads);
+  BatchReverseGeocoder::Stats stats;
+  auto const addresses = coder.GetNearbyAddresses(points, FLAGS_max_distance, &stats);
+  LOG(LINFO, (stats));
+
+  ofstream out(FLAGS_out);
+  CHECK(out.is_open(), ("Can't open output file", FLAGS_out));
+  for (size_t i = 0; i < lines.size(); ++i)
+  {
+    out << lines[i];
+    if (lineToPoint[i] == numeric_limits<size_t>::max())
+    {
+      // Header of the input or a line without a point.
+      out << (i == 0 ? ",street,house_number,distance" : ",,,") << '\n';
+      continue;
+    }
+
+    auto const & address = addresses[lineToPoint[i]];
+    if (address.IsValid())
+    {
+      out << ',' << EscapeCsv(address.GetStreetName()) << ',' << EscapeCsv(address.GetHouseNumber()) << ','
+          << address.GetDistance() << '\n';
+    }
+    else
+    {
+      out << ",,,\n";
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,47 @@
+#include "testing/testing.hpp"
+
+#include "search/batch_reverse_geocoder.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace batch_reverse_geocoder_test
+{
+using search::BatchReverseGeocoder;
+using namespace std;
+
+UNIT_TEST(BatchReverseGeocoder_HilbertIndex)
+{
+  TEST_EQUAL(BatchReverseGeocoder::GetHilbertIndex(0, 0, 1), 0, ());
+  TEST_EQUAL(BatchReverseGeocoder::GetHilbertIndex(0, 1, 1), 1, ());
+  TEST_EQUAL(BatchReverseGeocoder::GetHilbertIndex(1, 1, 1), 2, ());
+  TEST_EQUAL(BatchReverseGeocoder::GetHilbertIndex(1, 0, 1), 3, ());
+
+  // The curve visits every cell of the grid once and consecutive cells are neighbours.
+  uint8_t constexpr kOrder = 5;
+  uint32_t constexpr kSize = 1 << kOrder;
+  vector<pair<uint64_t, pair<uint32_t, uint32_t>>> cells;
+  for (uint32_t x = 0; x < kSize; ++x)
+  {
+    for (uint32_t y = 0; y < kSize; ++y)
+      cells.emplace_back(BatchReverseGeocoder::GetHilbertIndex(x, y, kOrder), make_pair(x, y));
+  }
+  sort(cells.begin(), cells.end());
+
+  for (size_t i = 0; i < cells.size(); ++i)
+  {
+    TEST_EQUAL(cells[i].first, i, ());
+    if (i == 0)
+      continue;
+
+    auto const & [x1, y1] = cells[i - 1].second;
+    auto const & [x2, y2] = cells[i].second;
+    auto const dx = abs(static_cast<int>(x1) - static_cast<int>(x2));
+    auto const dy = abs(static_cast<int>(y1) - static_cast<int>(y2));
+    TEST_EQUAL(dx + dy, 1, (cells[i - 1], cells[i]));
+  }
+}
+}  // namespace batch_reverse_geocoder_test
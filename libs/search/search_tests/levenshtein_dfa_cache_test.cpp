@@ -0,0 +1,61 @@
+#include "testing/testing.hpp"
+
+#include "search/levenshtein_dfa_cache.hpp"
+
+#include "base/dfa_helpers.hpp"
+#include "base/string_utils.hpp"
+
+#include <string>
+
+namespace levenshtein_dfa_cache_test
+{
+using namespace search;
+using namespace std;
+using namespace strings;
+
+bool Accepts(SharedLevenshteinDFA const & dfa, string const & s)
+{
+  auto it = dfa.Begin();
+  DFAMove(it, s);
+  return it.Accepts();
+}
+
+UNIT_TEST(LevenshteinDFACache_Smoke)
+{
+  LevenshteinDFACache cache;
+  auto const token = MakeUniString("moscow");
+
+  auto const fuzzy = cache.GetFuzzy(token);
+  TEST(Accepts(fuzzy, "moscow"), ());
+  TEST(Accepts(fuzzy, "mascow"), ());
+  TEST(!Accepts(fuzzy, "london"), ());
+
+  auto const exact = cache.GetExact(token);
+  TEST(Accepts(exact, "moscow"), ());
+  TEST(!Accepts(exact, "mascow"), ());
+
+  // The same DFAs are returned for the same tokens.
+  TEST_EQUAL(&cache.GetFuzzy(token).Get(), &fuzzy.Get(), ());
+  TEST_EQUAL(&cache.GetExact(token).Get(), &exact.Get(), ());
+  TEST_NOT_EQUAL(&cache.GetFuzzy(MakeUniString("moscoww")).Get(), &fuzzy.Get(), ());
+}
+
+UNIT_TEST(LevenshteinDFACache_Eviction)
+{
+  LevenshteinDFACache cache(2 /* maxNumDFAs */);
+  auto const a = cache.GetFuzzy(MakeUniString("aaaa"));
+  auto const b = cache.GetFuzzy(MakeUniString("bbbb"));
+
+  // |a| is used recently, so |b| is evicted.
+  TEST_EQUAL(&cache.GetFuzzy(MakeUniString("aaaa")).Get(), &a.Get(), ());
+  cache.GetFuzzy(MakeUniString("cccc"));
+  TEST_EQUAL(&cache.GetFuzzy(MakeUniString("aaaa")).Get(), &a.Get(), ());
+  TEST_NOT_EQUAL(&cache.GetFuzzy(MakeUniString("bbbb")).Get(), &b.Get(), ());
+
+  // Evicted DFAs are still valid for their users.
+  TEST(Accepts(b, "bbbb"), ());
+
+  cache.Clear();
+  TEST_NOT_EQUAL(&cache.GetFuzzy(MakeUniString("aaaa")).Get(), &a.Get(), ());
+}
+}  // namespace levenshtein_dfa_cache_test
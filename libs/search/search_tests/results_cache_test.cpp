@@ -0,0 +1,192 @@
+#include "testing/testing.hpp"
+
+#include "search/result.hpp"
+#include "search/results_cache.hpp"
+#include "search/search_params.hpp"
+
+#include "platform/local_country_file.hpp"
+
+#include "base/string_utils.hpp"
+
+#include <chrono>
+#include <cstddef>
+
+namespace results_cache_test
+{
+using namespace search;
+using namespace std;
+
+SearchParams MakeParams(string const & query)
+{
+  SearchParams params;
+  params.m_query = query;
+  params.m_inputLocale = "en";
+  params.m_viewport = m2::RectD(0.0, 0.0, 1.0, 1.0);
+  params.m_mode = Mode::Everywhere;
+  return params;
+}
+
+Results MakeResults(size_t count)
+{
+  Results results;
+  for (size_t i = 0; i < count; ++i)
+    results.AddResultNoChecks(Result(m2::PointD::Zero(), "Cafe " + strings::to_string(i)));
+  results.SetEndMarker(false /* cancelled */);
+  return results;
+}
+
+ResultsCache::Key MakeKey(SearchParams const & params)
+{
+  auto const key = ResultsCache::MakeKey(params);
+  TEST(key, (params));
+  return *key;
+}
+
+UNIT_TEST(ResultsCache_Key)
+{
+  auto const params = MakeParams("cafe");
+  auto const key = MakeKey(params);
+
+  {
+    auto other = params;
+    other.m_query = "  cafe";
+    TEST_EQUAL(MakeKey(other), key, ());
+  }
+  {
+    // The last token is not a prefix anymore.
+    auto other = params;
+    other.m_query = "cafe  ";
+    TEST_NOT_EQUAL(MakeKey(other), key, ());
+  }
+  {
+    auto other = params;
+    other.m_query = "Cafe";
+    TEST_NOT_EQUAL(MakeKey(other), key, ());
+  }
+  {
+    auto other = params;
+    other.m_inputLocale = "ru";
+    TEST_NOT_EQUAL(MakeKey(other), key, ());
+  }
+  {
+    // Slightly moved viewport of the same size.
+    auto other = params;
+    other.m_viewport = m2::RectD(0.01, 0.01, 1.01, 1.01);
+    TEST_EQUAL(MakeKey(other), key, ());
+  }
+  {
+    auto other = params;
+    other.m_viewport = m2::RectD(0.0, 0.0, 0.1, 0.1);
+    TEST_NOT_EQUAL(MakeKey(other), key, ());
+  }
+  {
+    auto other = params;
+    other.m_viewport = m2::RectD(5.0, 5.0, 6.0, 6.0);
+    TEST_NOT_EQUAL(MakeKey(other), key, ());
+  }
+  {
+    auto other = params;
+    other.m_position = m2::PointD(0.505, 0.505);
+    auto const withPosition = MakeKey(other);
+    TEST_NOT_EQUAL(withPosition, key, ());
+
+    other.m_position = m2::PointD(0.506, 0.506);
+    TEST_EQUAL(MakeKey(other), withPosition, ());
+
+    other.m_position = m2::PointD(0.6, 0.6);
+    TEST_NOT_EQUAL(MakeKey(other), withPosition, ());
+  }
+  {
+    auto other = params;
+    other.m_filteringParams.m_streetSearchRadiusM /= 2;
+    TEST_NOT_EQUAL(MakeKey(other), key, ());
+  }
+  {
+    auto other = params;
+    other.m_filteringParams.m_maxStreetsCount += 1;
+    TEST_NOT_EQUAL(MakeKey(other), key, ());
+  }
+  {
+    auto other = params;
+    other.m_filteringParams.m_streetClusterRadiusMercator *= 2;
+    TEST_NOT_EQUAL(MakeKey(other), key, ());
+  }
+  {
+    auto other = params;
+    other.m_mode = Mode::Viewport;
+    TEST(!ResultsCache::MakeKey(other), ());
+    other.m_mode = Mode::Bookmarks;
+    TEST(!ResultsCache::MakeKey(other), ());
+  }
+}
+
+UNIT_TEST(ResultsCache_Smoke)
+{
+  ResultsCache cache({100 /* maxNumResults */, chrono::minutes(1) /* ttl */});
+  auto const key = MakeKey(MakeParams("cafe"));
+  TEST(!cache.Get(key), ());
+
+  cache.Put(key, cache.GetGeneration(), MakeResults(3));
+  auto const results = cache.Get(key);
+  TEST(results, ());
+  TEST_EQUAL(results->GetCount(), 3, ());
+  TEST(results->IsEndedNormal(), ());
+  TEST_EQUAL((*results)[2].GetString(), "Cafe 2", ());
+
+  TEST(!cache.Get(MakeKey(MakeParams("bar"))), ());
+
+  cache.OnMapRegistered(platform::LocalCountryFile::MakeForTesting("Wonderland"));
+  TEST(!cache.Get(key), ());
+  TEST_EQUAL(cache.GetNumResults(), 0, ());
+}
+
+UNIT_TEST(ResultsCache_Generation)
+{
+  ResultsCache cache({100 /* maxNumResults */, chrono::minutes(1) /* ttl */});
+  auto const key = MakeKey(MakeParams("cafe"));
+
+  // Results of the search which was started before invalidation are not cached.
+  auto const generation = cache.GetGeneration();
+  cache.Clear();
+  cache.Put(key, generation, MakeResults(3));
+  TEST(!cache.Get(key), ());
+
+  cache.Put(key, cache.GetGeneration(), MakeResults(3));
+  TEST(cache.Get(key), ());
+}
+
+UNIT_TEST(ResultsCache_Ttl)
+{
+  ResultsCache cache({100 /* maxNumResults */, chrono::seconds(0) /* ttl */});
+  auto const key = MakeKey(MakeParams("cafe"));
+  cache.Put(key, cache.GetGeneration(), MakeResults(3));
+  TEST(!cache.Get(key), ());
+  TEST_EQUAL(cache.GetNumResults(), 0, ());
+}
+
+UNIT_TEST(ResultsCache_Eviction)
+{
+  // Each entry costs the number of its results plus one.
+  ResultsCache cache({10 /* maxNumResults */, chrono::minutes(1) /* ttl */});
+  auto const a = MakeKey(MakeParams("a"));
+  auto const b = MakeKey(MakeParams("b"));
+  auto const c = MakeKey(MakeParams("c"));
+
+  cache.Put(a, cache.GetGeneration(), MakeResults(3));
+  cache.Put(b, cache.GetGeneration(), MakeResults(3));
+  TEST_EQUAL(cache.GetNumResults(), 8, ());
+
+  // |a| is used recently, so |b| is evicted.
+  TEST(cache.Get(a), ());
+  cache.Put(c, cache.GetGeneration(), MakeResults(2));
+  TEST(cache.Get(a), ());
+  TEST(!cache.Get(b), ());
+  TEST(cache.Get(c), ());
+  TEST_EQUAL(cache.GetNumResults(), 7, ());
+
+  // Results which are larger than the whole cache are not stored.
+  cache.Put(b, cache.GetGeneration(), MakeResults(10));
+  TEST(!cache.Get(b), ());
+  TEST_EQUAL(cache.GetNumResults(), 7, ());
+}
+}  // namespace results_cache_test
@@ -2,6 +2,7 @@
 
 #include "search/common.hpp"
 #include "search/feature_offset_match.hpp"
+#include "search/levenshtein_dfa_cache.hpp"
 #include "search/token_slice.hpp"
 
 #include "indexer/categories_holder.hpp"
@@ -124,4 +125,13 @@ void FillRequestFromToken(QueryParams::Token const & token, SearchTrieRequest<DF
   token.ForEachSynonym([&request](strings::UniString const & s)
   { request.m_names.emplace_back(strings::LevenshteinDFA(s, 0 /* maxErrors */)); });
 }
+
+// Same as above, but DFAs are taken from |dfaCache|.
+template <typename DFA>
+void FillRequestFromToken(QueryParams::Token const & token, LevenshteinDFACache & dfaCache,
+                          SearchTrieRequest<DFA> & request)
+{
+  request.m_names.emplace_back(dfaCache.GetFuzzy(token.GetOriginal()));
+  token.ForEachSynonym([&](strings::UniString const & s) { request.m_names.emplace_back(dfaCache.GetExact(s)); });
+}
 }  // namespace search
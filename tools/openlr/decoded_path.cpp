@@ -86,31 +86,34 @@ void WriteAsMappingForSpark(std::string const & fileName, std::vector<DecodedPat
 
 void WriteAsMappingForSpark(std::ostream & ost, std::vector<DecodedPath> const & paths)
 {
+  for (auto const & p : paths)
+    WriteAsMappingForSpark(ost, p);
+}
+
+void WriteAsMappingForSpark(std::ostream & ost, DecodedPath const & path)
+{
+  if (path.m_path.empty())
+    return;
+
   auto const flags = ost.flags();
   ost << std::fixed;  // Avoid scientific notation cause '-' is used as fields separator.
   SCOPE_GUARD(guard, ([&ost, &flags] { ost.flags(flags); }));
 
-  for (auto const & p : paths)
-  {
-    if (p.m_path.empty())
-      continue;
-
-    ost << p.m_segmentId.Get() << '\t';
+  ost << path.m_segmentId.Get() << '\t';
 
-    auto const kFieldSep = '-';
-    auto const kSegmentSep = '=';
-    for (auto it = std::begin(p.m_path); it != std::end(p.m_path); ++it)
-    {
-      auto const & fid = it->GetFeatureId();
-      ost << fid.m_mwmId.GetInfo()->GetCountryName() << kFieldSep << fid.m_index << kFieldSep << it->GetSegId()
-          << kFieldSep << (it->IsForward() ? "fwd" : "bwd") << kFieldSep
-          << mercator::DistanceOnEarth(GetStart(*it), GetEnd(*it));
+  auto const kFieldSep = '-';
+  auto const kSegmentSep = '=';
+  for (auto it = std::begin(path.m_path); it != std::end(path.m_path); ++it)
+  {
+    auto const & fid = it->GetFeatureId();
+    ost << fid.m_mwmId.GetInfo()->GetCountryName() << kFieldSep << fid.m_index << kFieldSep << it->GetSegId()
+        << kFieldSep << (it->IsForward() ? "fwd" : "bwd") << kFieldSep
+        << mercator::DistanceOnEarth(GetStart(*it), GetEnd(*it));
 
-      if (std::next(it) != std::end(p.m_path))
-        ost << kSegmentSep;
-    }
-    ost << std::endl;
+    if (std::next(it) != std::end(path.m_path))
+      ost << kSegmentSep;
   }
+  ost << std::endl;
 }
 
 void PathFromXML(pugi::xml_node const & node, DataSource const & dataSource, Path & p)
@@ -35,6 +35,8 @@ uint32_t UintValueFromXML(pugi::xml_node const & node);
 
 void WriteAsMappingForSpark(std::string const & fileName, std::vector<DecodedPath> const & paths);
 void WriteAsMappingForSpark(std::ostream & ost, std::vector<DecodedPath> const & paths);
+// Writes one line of |path| if it's not empty, so paths may be written one by one as they are decoded.
+void WriteAsMappingForSpark(std::ostream & ost, DecodedPath const & path);
 
 void PathFromXML(pugi::xml_node const & node, DataSource const & dataSource, Path & path);
 void PathToXML(Path const & path, pugi::xml_node & node);
@@ -33,11 +33,25 @@ void GetRegularEdges(geometry::PointWithAltitude const & junction, IRoadGraph co
     edges.append(begin(es), end(es));
   }
 }
+
+void GetRegularEdges(geometry::PointWithAltitude const & junction, IRoadGraph const & graph,
+                     EdgeGetter const edgeGetter, bool isOutgoing, SharedEdgeCache & cache, Graph::EdgeListT & edges)
+{
+  if (cache.GetEdges(junction, isOutgoing, edges))
+    return;
+
+  Graph::EdgeListT es;
+  (graph.*edgeGetter)(junction, es);
+  cache.AddEdges(junction, isOutgoing, es);
+  edges.append(begin(es), end(es));
+}
 }  // namespace
 
-Graph::Graph(DataSource & dataSource, shared_ptr<CarModelFactory> carModelFactory)
+Graph::Graph(DataSource & dataSource, shared_ptr<CarModelFactory> carModelFactory,
+             shared_ptr<SharedEdgeCache> edgeCache)
   : m_dataSource(dataSource, nullptr /* numMwmIDs */)
   , m_graph(m_dataSource, IRoadGraph::Mode::ObeyOnewayTag, carModelFactory)
+  , m_sharedCache(std::move(edgeCache))
 {}
 
 void Graph::GetOutgoingEdges(Junction const & junction, EdgeListT & edges)
@@ -54,12 +68,20 @@ void Graph::GetIngoingEdges(Junction const & junction, EdgeListT & edges)
 
 void Graph::GetRegularOutgoingEdges(Junction const & junction, EdgeListT & edges)
 {
-  GetRegularEdges(junction, m_graph, &IRoadGraph::GetRegularOutgoingEdges, m_outgoingCache, edges);
+  if (m_sharedCache)
+    GetRegularEdges(junction, m_graph, &IRoadGraph::GetRegularOutgoingEdges, true /* isOutgoing */, *m_sharedCache,
+                    edges);
+  else
+    GetRegularEdges(junction, m_graph, &IRoadGraph::GetRegularOutgoingEdges, m_outgoingCache, edges);
 }
 
 void Graph::GetRegularIngoingEdges(Junction const & junction, EdgeListT & edges)
 {
-  GetRegularEdges(junction, m_graph, &IRoadGraph::GetRegularIngoingEdges, m_ingoingCache, edges);
+  if (m_sharedCache)
+    GetRegularEdges(junction, m_graph, &IRoadGraph::GetRegularIngoingEdges, false /* isOutgoing */, *m_sharedCache,
+                    edges);
+  else
+    GetRegularEdges(junction, m_graph, &IRoadGraph::GetRegularIngoingEdges, m_ingoingCache, edges);
 }
 
 void Graph::FindClosestEdges(m2::PointD const & point, uint32_t const count,
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "openlr/shared_edge_cache.hpp"
+
 #include "routing/data_source.hpp"
 #include "routing/features_road_graph.hpp"
 #include "routing/road_graph.hpp"
@@ -28,7 +30,10 @@ public:
   using EdgeVector = routing::FeaturesRoadGraph::EdgeVector;
   using Junction = geometry::PointWithAltitude;
 
-  Graph(DataSource & dataSource, std::shared_ptr<routing::CarModelFactory> carModelFactory);
+  /// \param edgeCache is shared by graphs of several threads with the same |dataSource|, regular edges
+  /// are cached by the graph itself if it's null.
+  Graph(DataSource & dataSource, std::shared_ptr<routing::CarModelFactory> carModelFactory,
+        std::shared_ptr<SharedEdgeCache> edgeCache = nullptr);
 
   // Appends edges such as that edge.GetStartJunction() == junction to the |edges|.
   void GetOutgoingEdges(geometry::PointWithAltitude const & junction, EdgeListT & edges);
@@ -58,5 +63,6 @@ private:
   routing::MwmDataSource m_dataSource;
   routing::FeaturesRoadGraph m_graph;
   EdgeCacheT m_outgoingCache, m_ingoingCache;
+  std::shared_ptr<SharedEdgeCache> m_sharedCache;
 };
 }  // namespace openlr
@@ -14,6 +14,7 @@
 #include "openlr/score_candidate_points_getter.hpp"
 #include "openlr/score_paths_connector.hpp"
 #include "openlr/score_types.hpp"
+#include "openlr/shared_edge_cache.hpp"
 #include "openlr/way_point.hpp"
 
 #include "routing/features_road_graph.hpp"
@@ -36,6 +37,7 @@
 #include "base/logging.hpp"
 #include "base/math.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread_safe_queue.hpp"
 #include "base/timer.hpp"
 
 #include <algorithm>
@@ -44,7 +46,10 @@
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <queue>
+#include <semaphore>
 #include <thread>
 #include <utility>
 
@@ -219,9 +224,10 @@ void CopyWithoutOffsets(InputIterator start, InputIterator stop, OutputIterator
 class SegmentsDecoderV2
 {
 public:
-  SegmentsDecoderV2(DataSource & dataSource, unique_ptr<CarModelFactory> cmf)
+  SegmentsDecoderV2(DataSource & dataSource, unique_ptr<CarModelFactory> cmf,
+                    shared_ptr<SharedEdgeCache> edgeCache = nullptr)
     : m_dataSource(dataSource)
-    , m_graph(dataSource, std::move(cmf))
+    , m_graph(dataSource, std::move(cmf), std::move(edgeCache))
     , m_infoGetter(dataSource)
   {}
 
@@ -308,9 +314,10 @@ private:
 class SegmentsDecoderV3
 {
 public:
-  SegmentsDecoderV3(DataSource & dataSource, unique_ptr<CarModelFactory> carModelFactory)
+  SegmentsDecoderV3(DataSource & dataSource, unique_ptr<CarModelFactory> carModelFactory,
+                    shared_ptr<SharedEdgeCache> edgeCache = nullptr)
     : m_dataSource(dataSource)
-    , m_graph(dataSource, std::move(carModelFactory))
+    , m_graph(dataSource, std::move(carModelFactory), std::move(edgeCache))
     , m_infoGetter(dataSource)
   {}
 
@@ -449,6 +456,18 @@ void OpenLRDecoder::DecodeV3(vector<LinearSegment> const & segments, uint32_t nu
   Decode<SegmentsDecoderV3, v2::Stats>(segments, numThreads, paths);
 }
 
+void OpenLRDecoder::StreamDecodeV2(SegmentReader const & readSegment, PathWriter const & writePath,
+                                   uint32_t numThreads, size_t queueSize)
+{
+  StreamDecode<SegmentsDecoderV2, v2::Stats>(readSegment, writePath, numThreads, queueSize);
+}
+
+void OpenLRDecoder::StreamDecodeV3(SegmentReader const & readSegment, PathWriter const & writePath,
+                                   uint32_t numThreads, size_t queueSize)
+{
+  StreamDecode<SegmentsDecoderV3, v2::Stats>(readSegment, writePath, numThreads, queueSize);
+}
+
 template <typename Decoder, typename Stats>
 void OpenLRDecoder::Decode(vector<LinearSegment> const & segments, uint32_t const numThreads,
                            vector<DecodedPath> & paths)
@@ -496,4 +515,80 @@ void OpenLRDecoder::Decode(vector<LinearSegment> const & segments, uint32_t cons
   allStats.Report();
   LOG(LINFO, ("Matching tool:", timer.ElapsedSeconds(), "seconds."));
 }
+
+template <typename Decoder, typename Stats>
+void OpenLRDecoder::StreamDecode(SegmentReader const & readSegment, PathWriter const & writePath,
+                                 uint32_t numThreads, size_t queueSize)
+{
+  CHECK_GREATER(numThreads, 0, ());
+  CHECK_GREATER(queueSize, 0, ());
+  CHECK(!m_dataSources.empty(), ());
+
+  // std::nullopt stops a worker. Free slots bound the queue, the reader waits while the queue is full.
+  threads::ThreadSafeQueue<optional<LinearSegment>> queue;
+  counting_semaphore<> freeSlots(static_cast<ptrdiff_t>(queueSize));
+  mutex writerMutex;
+  auto const edgeCache = make_shared<SharedEdgeCache>();
+
+  auto const worker = [&](size_t threadNum, Stats & stat)
+  {
+    size_t constexpr kProgressFrequency = 100;
+
+    Decoder decoder(m_dataSources[0], make_unique<CarModelFactory>(m_countryParentNameGetter), edgeCache);
+    optional<LinearSegment> segment;
+    DecodedPath path;
+    while (true)
+    {
+      queue.WaitAndPop(segment);
+      freeSlots.release();
+      if (!segment)
+        break;
+
+      path = {};
+      if (!decoder.DecodeSegment(*segment, path, stat))
+        ++stat.m_routesFailed;
+      ++stat.m_routesHandled;
+
+      {
+        lock_guard<mutex> lock(writerMutex);
+        writePath(path);
+      }
+
+      if (stat.m_routesHandled % kProgressFrequency == 0)
+        LOG(LINFO, ("Thread", threadNum, "processed", stat.m_routesHandled, "failed:", stat.m_routesFailed));
+    }
+  };
+
+  base::Timer timer;
+  vector<Stats> stats(numThreads);
+  vector<thread> workers;
+  for (size_t i = 0; i < numThreads; ++i)
+    workers.emplace_back(worker, i, ref(stats[i]));
+
+  LinearSegment segment;
+  while (readSegment(segment))
+  {
+    freeSlots.acquire();
+    queue.Push(std::move(segment));
+    segment = {};
+  }
+
+  for (size_t i = 0; i < numThreads; ++i)
+  {
+    freeSlots.acquire();
+    queue.Push(optional<LinearSegment>());
+  }
+
+  for (auto & worker : workers)
+    worker.join();
+
+  Stats allStats;
+  for (auto const & s : stats)
+    allStats.Add(s);
+
+  allStats.Report();
+  double const elapsed = timer.ElapsedSeconds();
+  LOG(LINFO, ("Matching tool:", elapsed, "seconds,", allStats.m_routesHandled / elapsed, "segments per second."));
+  LOG(LINFO, (edgeCache->GetStats()));
+}
 }  // namespace openlr
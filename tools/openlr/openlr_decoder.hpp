@@ -6,6 +6,7 @@
 
 #include "base/exception.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <string>
@@ -26,6 +27,11 @@ class OpenLRDecoder
 {
 public:
   using CountryParentNameGetter = std::function<std::string(std::string const &)>;
+  // Reads the next segment, returns false at the end of input.
+  using SegmentReader = std::function<bool(LinearSegment & segment)>;
+  using PathWriter = std::function<void(DecodedPath const & path)>;
+
+  static size_t constexpr kDefaultQueueSize = 1024;
 
   class SegmentsFilter
   {
@@ -48,10 +54,23 @@ public:
 
   void DecodeV3(std::vector<LinearSegment> const & segments, uint32_t numThreads, std::vector<DecodedPath> & paths);
 
+  // Decodes segments of |readSegment| in constant memory: segments are read into a queue of |queueSize|
+  // segments and every thread takes the next one as soon as it has decoded the previous one.
+  // All the threads use the first data source and share the road graph cache. |writePath| is called
+  // by one thread at a time in the order of decoding, not in the order of reading.
+  void StreamDecodeV2(SegmentReader const & readSegment, PathWriter const & writePath, uint32_t numThreads,
+                      size_t queueSize = kDefaultQueueSize);
+  void StreamDecodeV3(SegmentReader const & readSegment, PathWriter const & writePath, uint32_t numThreads,
+                      size_t queueSize = kDefaultQueueSize);
+
 private:
   template <typename Decoder, typename Stats>
   void Decode(std::vector<LinearSegment> const & segments, uint32_t const numThreads, std::vector<DecodedPath> & paths);
 
+  template <typename Decoder, typename Stats>
+  void StreamDecode(SegmentReader const & readSegment, PathWriter const & writePath, uint32_t numThreads,
+                    size_t queueSize);
+
   std::vector<FrozenDataSource> & m_dataSources;
   CountryParentNameGetter m_countryParentNameGetter;
 };
@@ -291,10 +291,22 @@ namespace openlr
 {
 bool ParseOpenlr(pugi::xml_document const & document, vector<LinearSegment> & segments)
 {
-  for (auto const segmentXpathNode : document.select_nodes("//reportSegments"))
+  SegmentsXMLReader reader(document);
+  LinearSegment segment;
+  while (reader.Read(segment))
+    segments.push_back(segment);
+  return !reader.IsFailed();
+}
+
+SegmentsXMLReader::SegmentsXMLReader(pugi::xml_document const & document)
+  : m_nodes(document.select_nodes("//reportSegments"))
+{}
+
+bool SegmentsXMLReader::Read(LinearSegment & segment)
+{
+  for (; m_next < m_nodes.size() && !m_failed; ++m_next)
   {
-    LinearSegment segment;
-    auto const & node = segmentXpathNode.node();
+    auto const & node = m_nodes[m_next].node();
     if (!IsLocationReferenceTag(node) && !IsCoordinatesTag(node))
     {
       LOG(LWARNING, ("A segment with a strange tag. It is not <coordinates>"
@@ -302,12 +314,17 @@ bool ParseOpenlr(pugi::xml_document const & document, vector<LinearSegment> & se
       continue;
     }
 
+    segment = {};
     if (!SegmentFromXML(node, segment))
+    {
+      m_failed = true;
       return false;
+    }
 
-    segments.push_back(segment);
+    ++m_next;
+    return true;
   }
-  return true;
+  return false;
 }
 
 bool SegmentFromXML(pugi::xml_node const & segmentNode, LinearSegment & segment)
@@ -1,12 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <vector>
 
-namespace pugi
-{
-class xml_document;
-class xml_node;
-}  // namespace pugi
+#include <pugixml.hpp>
 
 namespace openlr
 {
@@ -15,4 +12,20 @@ struct LinearSegment;
 bool SegmentFromXML(pugi::xml_node const & segmentNode, LinearSegment & segment);
 
 bool ParseOpenlr(pugi::xml_document const & document, std::vector<LinearSegment> & segments);
+
+// Parses segments of a document one by one, so parsed segments are not kept all together.
+class SegmentsXMLReader
+{
+public:
+  explicit SegmentsXMLReader(pugi::xml_document const & document);
+
+  // Returns false at the end of the document or if a segment can't be parsed, see IsFailed().
+  bool Read(LinearSegment & segment);
+  bool IsFailed() const { return m_failed; }
+
+private:
+  pugi::xpath_node_set const m_nodes;
+  size_t m_next = 0;
+  bool m_failed = false;
+};
 }  // namespace openlr
@@ -46,6 +46,10 @@ DEFINE_string(countries_filename, "",
               "Name of countries file which describes mwm tree. Used to get country specific "
               "routing restrictions.");
 DEFINE_int32(algo_version, 0, "Use new decoding algorithm");
+DEFINE_bool(stream, false,
+            "Decode segments in constant memory: all the threads share one data source and road graph cache, "
+            "segments are decoded in the order of the input file and decoded paths are written as soon as "
+            "they are ready. --assessment_output is not supported.");
 
 using namespace openlr;
 
@@ -166,6 +170,54 @@ void SaveNonMatchedIds(std::string const & filename, std::vector<DecodedPath> co
       ofs << p.m_segmentId << std::endl;
 }
 
+void StreamDecode(OpenLRDecoder & decoder, pugi::xml_document const & document, uint32_t numThreads)
+{
+  SegmentsXMLReader reader(document);
+  OpenLRDecoder::SegmentsFilter const filter(FLAGS_ids_path, FLAGS_multipoints_only);
+  int32_t readCount = 0;
+  auto const readSegment = [&](LinearSegment & segment)
+  {
+    while (FLAGS_limit == kHandleAllSegments || readCount < FLAGS_limit)
+    {
+      if (!reader.Read(segment))
+        return false;
+
+      ++readCount;
+      if (filter.Matches(segment))
+        return true;
+    }
+    return false;
+  };
+
+  std::ofstream nonMatchedIds;
+  if (!FLAGS_non_matched_ids.empty())
+    nonMatchedIds.open(FLAGS_non_matched_ids);
+  std::ofstream spark;
+  if (!FLAGS_spark_output.empty())
+    spark.open(FLAGS_spark_output);
+
+  auto const writePath = [&](DecodedPath const & path)
+  {
+    if (nonMatchedIds.is_open() && path.m_path.empty())
+      nonMatchedIds << path.m_segmentId << std::endl;
+    if (spark.is_open())
+      WriteAsMappingForSpark(spark, path);
+  };
+
+  switch (FLAGS_algo_version)
+  {
+  case 2: decoder.StreamDecodeV2(readSegment, writePath, numThreads); break;
+  case 3: decoder.StreamDecodeV3(readSegment, writePath, numThreads); break;
+  default: CHECK(false, ("Wrong algorithm version."));
+  }
+
+  if (reader.IsFailed())
+  {
+    LOG(LERROR, ("Can't parse data."));
+    exit(-1);
+  }
+}
+
 std::vector<LinearSegment> LoadSegments(pugi::xml_document & document)
 {
   std::vector<LinearSegment> segments;
@@ -244,7 +296,14 @@ int main(int argc, char * argv[])
 
   auto const numThreads = static_cast<uint32_t>(FLAGS_num_threads);
 
-  std::vector<FrozenDataSource> dataSources(numThreads);
+  if (FLAGS_stream && !FLAGS_assessment_output.empty())
+  {
+    LOG(LERROR, ("--assessment_output can't be used with --stream."));
+    exit(-1);
+  }
+
+  // Threads share one data source in the streaming mode.
+  std::vector<FrozenDataSource> dataSources(FLAGS_stream ? 1 : numThreads);
 
   LoadDataSources(FLAGS_mwms_path, dataSources);
 
@@ -260,6 +319,12 @@ int main(int argc, char * argv[])
   }
 
   std::setlocale(LC_ALL, "en_US.UTF-8");
+  if (FLAGS_stream)
+  {
+    StreamDecode(decoder, document, numThreads);
+    return 0;
+  }
+
   auto const segments = LoadSegments(document);
 
   std::vector<DecodedPath> paths(segments.size());
@@ -0,0 +1,97 @@
+#include "testing/testing.hpp"
+
+#include "openlr/shared_edge_cache.hpp"
+
+#include "geometry/point_with_altitude.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace openlr;
+using namespace std;
+
+namespace
+{
+using Junction = SharedEdgeCache::Junction;
+
+Junction MakeJunction(double x)
+{
+  return geometry::MakePointWithAltitudeForTesting(m2::PointD(x, 0.0));
+}
+
+SharedEdgeCache::EdgeListT MakeEdges(double x)
+{
+  SharedEdgeCache::EdgeListT edges;
+  edges.push_back(routing::Edge::MakeFake(MakeJunction(x), MakeJunction(x + 1.0)));
+  return edges;
+}
+
+UNIT_TEST(SharedEdgeCache_GetAndAdd)
+{
+  SharedEdgeCache cache;
+
+  SharedEdgeCache::EdgeListT edges;
+  TEST(!cache.GetEdges(MakeJunction(1.0), true /* isOutgoing */, edges), ());
+
+  cache.AddEdges(MakeJunction(1.0), true /* isOutgoing */, MakeEdges(1.0));
+  TEST(cache.GetEdges(MakeJunction(1.0), true /* isOutgoing */, edges), ());
+  TEST_EQUAL(edges.size(), 1, ());
+  TEST_EQUAL(edges[0], MakeEdges(1.0)[0], ());
+
+  // Ingoing edges of the same junction are cached separately.
+  TEST(!cache.GetEdges(MakeJunction(1.0), false /* isOutgoing */, edges), ());
+
+  // Cached edges are appended.
+  TEST(cache.GetEdges(MakeJunction(1.0), true /* isOutgoing */, edges), ());
+  TEST_EQUAL(edges.size(), 2, ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 2, ());
+  TEST_EQUAL(stats.m_misses, 2, ());
+  TEST_EQUAL(stats.m_evictions, 0, ());
+}
+
+UNIT_TEST(SharedEdgeCache_Eviction)
+{
+  SharedEdgeCache cache(10 /* maxEdgeListsCount */, 1 /* shardsCount */);
+  for (uint32_t i = 0; i < 20; ++i)
+    cache.AddEdges(MakeJunction(i), true /* isOutgoing */, MakeEdges(i));
+
+  TEST_EQUAL(cache.GetStats().m_evictions, 10, ());
+
+  SharedEdgeCache::EdgeListT edges;
+  // The first added edges are evicted first.
+  TEST(!cache.GetEdges(MakeJunction(0.0), true /* isOutgoing */, edges), ());
+  TEST(cache.GetEdges(MakeJunction(19.0), true /* isOutgoing */, edges), ());
+}
+
+UNIT_TEST(SharedEdgeCache_Threads)
+{
+  SharedEdgeCache cache;
+  uint32_t constexpr kJunctionsCount = 1000;
+
+  vector<thread> threads;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&]()
+    {
+      SharedEdgeCache::EdgeListT edges;
+      for (uint32_t j = 0; j < kJunctionsCount; ++j)
+      {
+        edges.clear();
+        if (!cache.GetEdges(MakeJunction(j), true /* isOutgoing */, edges))
+          cache.AddEdges(MakeJunction(j), true /* isOutgoing */, MakeEdges(j));
+        else
+          TEST_EQUAL(edges.size(), 1, ());
+      }
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits + stats.m_misses, 4 * kJunctionsCount, ());
+  TEST_GREATER_OR_EQUAL(stats.m_misses, kJunctionsCount, ());
+}
+}  // namespace
@@ -30,6 +30,8 @@ RoadInfoGetter::RoadInfo RoadInfoGetter::Get(FeatureID const & fid)
   CHECK(ft, ());
 
   RoadInfo info(*ft);
+  if (m_cache.size() >= kMaxCacheSize)
+    m_cache.clear();
   it = m_cache.emplace(fid, info).first;
 
   return it->second;
@@ -5,6 +5,7 @@
 #include "indexer/feature_data.hpp"
 #include "indexer/ftypes_matcher.hpp"
 
+#include <cstddef>
 #include <map>
 
 class Classificator;
@@ -30,6 +31,9 @@ public:
     bool m_isRoundabout = false;
   };
 
+  // The cache is cleared when it's full, so memory doesn't grow with the number of decoded segments.
+  static size_t constexpr kMaxCacheSize = 256 * 1024;
+
   explicit RoadInfoGetter(DataSource const & dataSource);
 
   RoadInfo Get(FeatureID const & fid);
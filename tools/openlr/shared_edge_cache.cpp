@@ -0,0 +1,84 @@
+#include "openlr/shared_edge_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <sstream>
+
+namespace openlr
+{
+using namespace std;
+
+SharedEdgeCache::SharedEdgeCache(size_t maxEdgeListsCount, size_t shardsCount)
+  : m_maxShardEdgeListsCount(max(maxEdgeListsCount / max(shardsCount, size_t{1}), size_t{1}))
+{
+  CHECK_GREATER(shardsCount, 0, ());
+
+  m_shards.reserve(shardsCount);
+  for (size_t i = 0; i < shardsCount; ++i)
+    m_shards.push_back(make_unique<Shard>());
+}
+
+bool SharedEdgeCache::GetEdges(Junction const & junction, bool isOutgoing, EdgeListT & edges) const
+{
+  Shard const & shard = GetShard(junction);
+
+  shared_lock<shared_mutex> lock(shard.m_mutex);
+  auto const it = shard.m_edges.find(Key(junction, isOutgoing));
+  if (it == shard.m_edges.cend())
+  {
+    shard.m_misses.fetch_add(1, memory_order_relaxed);
+    return false;
+  }
+
+  shard.m_hits.fetch_add(1, memory_order_relaxed);
+  edges.append(it->second.begin(), it->second.end());
+  return true;
+}
+
+void SharedEdgeCache::AddEdges(Junction const & junction, bool isOutgoing, EdgeListT const & edges)
+{
+  Shard & shard = GetShard(junction);
+  Key const key(junction, isOutgoing);
+
+  unique_lock<shared_mutex> lock(shard.m_mutex);
+  // Another thread may have added the same edges.
+  if (!shard.m_edges.emplace(key, edges).second)
+    return;
+
+  shard.m_fifo.push_back(key);
+  while (shard.m_fifo.size() > m_maxShardEdgeListsCount)
+  {
+    shard.m_edges.erase(shard.m_fifo.front());
+    shard.m_fifo.pop_front();
+    shard.m_evictions.fetch_add(1, memory_order_relaxed);
+  }
+}
+
+SharedEdgeCache::Stats SharedEdgeCache::GetStats() const
+{
+  Stats stats;
+  for (auto const & shard : m_shards)
+  {
+    stats.m_hits += shard->m_hits.load(memory_order_relaxed);
+    stats.m_misses += shard->m_misses.load(memory_order_relaxed);
+    stats.m_evictions += shard->m_evictions.load(memory_order_relaxed);
+  }
+  return stats;
+}
+
+SharedEdgeCache::Shard & SharedEdgeCache::GetShard(Junction const & junction) const
+{
+  size_t const hash = m2::PointD::Hash()(junction.GetPoint());
+  return *m_shards[hash % m_shards.size()];
+}
+
+string DebugPrint(SharedEdgeCache::Stats const & stats)
+{
+  ostringstream os;
+  os << "SharedEdgeCache::Stats [ hits: " << stats.m_hits << ", misses: " << stats.m_misses
+     << ", evictions: " << stats.m_evictions << " ]";
+  return os.str();
+}
+}  // namespace openlr
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "routing/road_graph.hpp"
+
+#include "geometry/point_with_altitude.hpp"
+
+#include "base/macros.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace openlr
+{
+/// \brief Regular edges of junctions shared by Graph instances of several decoding threads.
+/// The cache is split into shards by junction, every shard has its own shared mutex and keeps
+/// at most |maxEdgeListsCount| / |shardsCount| edge lists, the lists which were added first
+/// are evicted first.
+/// \note Edges keep FeatureIDs of the DataSource they were read from, so all the graphs which
+/// share a cache must use the same DataSource.
+class SharedEdgeCache final
+{
+public:
+  static size_t constexpr kDefaultMaxEdgeListsCount = 1024 * 1024;
+  static size_t constexpr kDefaultShardsCount = 64;
+
+  using EdgeListT = routing::IRoadGraph::EdgeListT;
+  using Junction = geometry::PointWithAltitude;
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+  };
+
+  explicit SharedEdgeCache(size_t maxEdgeListsCount = kDefaultMaxEdgeListsCount,
+                           size_t shardsCount = kDefaultShardsCount);
+  DISALLOW_COPY_AND_MOVE(SharedEdgeCache);
+
+  /// \brief Appends cached outgoing or ingoing edges of |junction| to |edges|.
+  /// \returns false if the edges are not cached.
+  bool GetEdges(Junction const & junction, bool isOutgoing, EdgeListT & edges) const;
+  void AddEdges(Junction const & junction, bool isOutgoing, EdgeListT const & edges);
+
+  Stats GetStats() const;
+
+private:
+  using Key = std::pair<Junction, bool>;
+
+  struct alignas(64) Shard
+  {
+    mutable std::shared_mutex m_mutex;
+    std::map<Key, EdgeListT> m_edges;
+    // Keys in order of adding.
+    std::deque<Key> m_fifo;
+
+    mutable std::atomic<uint64_t> m_hits{0};
+    mutable std::atomic<uint64_t> m_misses{0};
+    std::atomic<uint64_t> m_evictions{0};
+  };
+
+  Shard & GetShard(Junction const & junction) const;
+
+  size_t const m_maxShardEdgeListsCount;
+  std::vector<std::unique_ptr<Shard>> m_shards;
+};
+
+std::string DebugPrint(SharedEdgeCache::Stats const & stats);
+}  // namespace openlr
@@ -38,6 +38,10 @@ class GenTool:
         "make_coasts": bool,
         "make_cross_mwm": bool,
         "make_routing_index": bool,
+        "make_routing_shortcuts": bool,
+        "make_routing_landmarks": bool,
+        "make_routing_geometry": bool,
+        "make_routing_snap": bool,
         "make_transit_cross_mwm": bool,
         "make_transit_cross_mwm_experimental": bool,
         "preprocess": bool,
@@ -70,6 +74,7 @@ class GenTool:
         "regions_features": str,
         "regions_index": str,
         "regions_key_value": str,
+        "speed_profiles_path": str,
         "srtm_path": str,
         "transit_path": str,
         "transit_path_experimental": str,
@@ -0,0 +1,290 @@
+#include "track_analyzing/hmm_track_matcher.hpp"
+
+#include "routing/index_graph_loader.hpp"
+
+#include "routing_common/car_model.hpp"
+
+#include "indexer/scales.hpp"
+
+#include "geometry/distance_on_sphere.hpp"
+#include "geometry/mercator.hpp"
+#include "geometry/parametrized_segment.hpp"
+
+#include "base/assert.hpp"
+#include "base/math.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace track_analyzing
+{
+using namespace routing;
+using namespace std;
+
+namespace
+{
+// Matching range in meters, the same as TrackMatcher one.
+double constexpr kMatchingRange = 20.0;
+// Roads are loaded for the rect of this size around a point and reused for the next points.
+double constexpr kNearbyRoadsRange = 200.0;
+// Standard deviation of gps error in meters.
+double constexpr kGpsSigma = 10.0;
+// Scale of the exponential distribution of the difference between route distance and great circle
+// distance of consecutive points in meters.
+double constexpr kTransitionBeta = 10.0;
+// Routes which are longer than the great circle distance by these factor and meters are not considered.
+double constexpr kMaxDetourFactor = 2.0;
+double constexpr kMaxDetourMeters = 100.0;
+
+double constexpr kInfiniteDistance = numeric_limits<double>::infinity();
+}  // namespace
+
+HmmTrackMatcher::HmmTrackMatcher(platform::LocalCountryFile const & localCountryFile, NumMwmId mwmId)
+  : m_mwmId(mwmId)
+  , m_vehicleModel(CarModelFactory({}).GetVehicleModelForCountry(localCountryFile.GetCountryName()))
+{
+  auto const registerResult = m_dataSource.Register(localCountryFile);
+  CHECK_EQUAL(registerResult.second, MwmSet::RegResult::Success,
+              ("Can't register mwm", localCountryFile.GetCountryName()));
+
+  MwmSet::MwmHandle handle = m_dataSource.GetMwmHandleById(registerResult.first);
+
+  m_graph = make_unique<IndexGraph>(
+      make_shared<Geometry>(GeometryLoader::Create(handle, m_vehicleModel, false /* loadAltitudes */)),
+      EdgeEstimator::Create(VehicleType::Car, *m_vehicleModel, nullptr /* trafficStash */, nullptr /* dataSource */,
+                            nullptr /* numMvmIds */));
+
+  DeserializeIndexGraph(*handle.GetValue(), VehicleType::Car, *m_graph);
+}
+
+void HmmTrackMatcher::MatchTrack(vector<DataPoint> const & track, vector<MatchedTrack> & matchedTracks)
+{
+  m_pointsCount += track.size();
+
+  // Indexes of the points of the current part of the track and their candidates.
+  vector<size_t> pointIdxs;
+  vector<vector<Candidate>> steps;
+
+  auto const finishPart = [&]()
+  {
+    if (steps.empty())
+      return;
+
+    auto const path = m_decoder.GetPath();
+    CHECK_EQUAL(path.size(), steps.size(), ());
+
+    ++m_tracksCount;
+    MatchedTrack & matchedTrack = matchedTracks.emplace_back();
+    for (size_t i = 0; i < steps.size(); ++i)
+      matchedTrack.emplace_back(track[pointIdxs[i]], steps[i][path[i]].m_segment);
+
+    pointIdxs.clear();
+    steps.clear();
+  };
+
+  vector<Candidate> candidates;
+  vector<double> emissions;
+  vector<double> transitions;
+  for (size_t i = 0; i < track.size(); ++i)
+  {
+    FillCandidates(mercator::FromLatLon(track[i].m_latLon), candidates);
+    if (candidates.empty())
+    {
+      ++m_nonMatchedPointsCount;
+      finishPart();
+      continue;
+    }
+
+    emissions.clear();
+    for (auto const & candidate : candidates)
+      emissions.push_back(-0.5 * math::Pow2(candidate.m_distance / kGpsSigma));
+
+    bool added = false;
+    if (!steps.empty())
+    {
+      auto const & prevCandidates = steps.back();
+      CalcTransitions(track[pointIdxs.back()], track[i], prevCandidates, candidates, transitions);
+      added = m_decoder.Step(emissions, [&](size_t from, size_t to)
+      { return transitions[from * candidates.size() + to]; });
+    }
+
+    if (!added)
+    {
+      finishPart();
+      m_decoder.Start(emissions);
+    }
+
+    pointIdxs.push_back(i);
+    steps.push_back(std::move(candidates));
+    candidates.clear();
+  }
+
+  finishPart();
+}
+
+void HmmTrackMatcher::FillCandidates(m2::PointD const & point, vector<Candidate> & candidates)
+{
+  candidates.clear();
+
+  auto const rect = mercator::RectByCenterXYAndSizeInMeters(point, kMatchingRange);
+  if (!m_nearbyRect.IsRectInside(rect))
+    LoadNearbyRoads(point);
+
+  auto const addCandidate = [&](Segment const & segment, double distance, m2::PointD const & start,
+                                m2::PointD const & projection)
+  {
+    if (m_graph->GetAccessType(segment) == RoadAccess::Type::Yes)
+      candidates.push_back({segment, distance, mercator::DistanceOnEarth(start, projection)});
+  };
+
+  for (auto const & road : m_nearbyRoads)
+  {
+    if (!road.m_rect.IsIntersect(rect))
+      continue;
+
+    for (uint32_t segIdx = 0; segIdx + 1 < road.m_points.size(); ++segIdx)
+    {
+      auto const & begin = road.m_points[segIdx];
+      auto const & end = road.m_points[segIdx + 1];
+      m2::PointD const projection = m2::ParametrizedSegment<m2::PointD>(begin, end).ClosestPointTo(point);
+      double const distance = mercator::DistanceOnEarth(point, projection);
+      if (distance >= kMatchingRange)
+        continue;
+
+      addCandidate(Segment(m_mwmId, road.m_featureId, segIdx, true /* forward */), distance, begin, projection);
+      if (!road.m_oneWay)
+        addCandidate(Segment(m_mwmId, road.m_featureId, segIdx, false /* forward */), distance, end, projection);
+    }
+  }
+}
+
+void HmmTrackMatcher::LoadNearbyRoads(m2::PointD const & point)
+{
+  ++m_nearbyRoadsLoadsCount;
+  m_nearbyRoads.clear();
+  m_nearbyRect = mercator::RectByCenterXYAndSizeInMeters(point, kNearbyRoadsRange);
+
+  m_dataSource.ForEachInRect([&](FeatureType & ft)
+  {
+    if (!ft.GetID().IsValid())
+      return;
+
+    if (ft.GetID().m_mwmId.GetInfo()->GetType() != MwmInfo::COUNTRY)
+      return;
+
+    feature::TypesHolder const types(ft);
+    if (!m_vehicleModel->IsRoad(types))
+      return;
+
+    ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+
+    NearbyRoad & road = m_nearbyRoads.emplace_back();
+    road.m_featureId = ft.GetID().m_index;
+    road.m_oneWay = m_vehicleModel->IsOneWay(types);
+    road.m_points.reserve(ft.GetPointsCount());
+    for (size_t i = 0; i < ft.GetPointsCount(); ++i)
+    {
+      road.m_points.push_back(ft.GetPoint(i));
+      road.m_rect.Add(road.m_points.back());
+    }
+  }, m_nearbyRect, scales::GetUpperScale());
+}
+
+void HmmTrackMatcher::CalcTransitions(DataPoint const & fromPoint, DataPoint const & toPoint,
+                                      vector<Candidate> const & from, vector<Candidate> const & to,
+                                      vector<double> & transitions)
+{
+  double const greatCircleDistance = ms::DistanceOnEarth(fromPoint.m_latLon, toPoint.m_latLon);
+  double const maxDistance = greatCircleDistance * kMaxDetourFactor + kMaxDetourMeters;
+
+  transitions.assign(from.size() * to.size(), ViterbiDecoder::kImpossible);
+  vector<double> distances;
+  for (size_t i = 0; i < from.size(); ++i)
+  {
+    CalcRouteDistances(from[i], to, maxDistance, distances);
+    for (size_t j = 0; j < to.size(); ++j)
+    {
+      if (distances[j] != kInfiniteDistance)
+        transitions[i * to.size() + j] = -fabs(distances[j] - greatCircleDistance) / kTransitionBeta;
+    }
+  }
+}
+
+void HmmTrackMatcher::CalcRouteDistances(Candidate const & from, vector<Candidate> const & to, double maxDistance,
+                                         vector<double> & distances)
+{
+  distances.assign(to.size(), kInfiniteDistance);
+
+  // Candidates on |from| segment are reached without the graph. A small move back is a gps error,
+  // the car doesn't make a loop.
+  size_t targetsCount = 0;
+  for (size_t i = 0; i < to.size(); ++i)
+  {
+    if (to[i].m_segment != from.m_segment)
+      ++targetsCount;
+    else if (to[i].m_offset + kMatchingRange >= from.m_offset)
+      distances[i] = max(0.0, to[i].m_offset - from.m_offset);
+  }
+
+  // Distance from |from| to the end of its segment.
+  double const startDistance = max(0.0, GetSegmentLength(from.m_segment) - from.m_offset);
+  if (targetsCount == 0 || startDistance > maxDistance)
+    return;
+
+  // Dijkstra by distances from the end of |from| segment to the ends of segments.
+  m_distances.clear();
+  m_queue = {};
+  m_distances[from.m_segment] = 0.0;
+  m_queue.emplace(0.0, from.m_segment);
+  while (!m_queue.empty() && targetsCount != 0)
+  {
+    auto const [distance, segment] = m_queue.top();
+    m_queue.pop();
+    if (distance > m_distances[segment])
+      continue;
+
+    if (segment != from.m_segment)
+    {
+      double const segmentStartDistance = startDistance + distance - GetSegmentLength(segment);
+      for (size_t i = 0; i < to.size(); ++i)
+      {
+        if (to[i].m_segment != segment)
+          continue;
+
+        --targetsCount;
+        if (segmentStartDistance + to[i].m_offset <= maxDistance)
+          distances[i] = segmentStartDistance + to[i].m_offset;
+      }
+    }
+
+    if (startDistance + distance > maxDistance)
+      continue;
+
+    m_edges.clear();
+    m_graph->GetEdgeList(segment, true /* isOutgoing */, true /* useRoutingOptions */, m_edges);
+    for (auto const & edge : m_edges)
+    {
+      Segment const & target = edge.GetTarget();
+      if (segment.IsInverse(target))
+        continue;
+
+      double const targetDistance = distance + GetSegmentLength(target);
+      auto const [it, inserted] = m_distances.emplace(target, targetDistance);
+      if (!inserted)
+      {
+        if (it->second <= targetDistance)
+          continue;
+        it->second = targetDistance;
+      }
+      m_queue.emplace(targetDistance, target);
+    }
+  }
+}
+
+double HmmTrackMatcher::GetSegmentLength(Segment const & segment) const
+{
+  return ms::DistanceOnEarth(m_graph->GetPoint(segment, false /* front */),
+                             m_graph->GetPoint(segment, true /* front */));
+}
+}  // namespace track_analyzing
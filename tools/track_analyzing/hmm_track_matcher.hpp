@@ -0,0 +1,104 @@
+#pragma once
+
+#include "track_analyzing/track.hpp"
+#include "track_analyzing/viterbi_decoder.hpp"
+
+#include "routing/index_graph.hpp"
+#include "routing/segment.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+
+#include "indexer/data_source.hpp"
+
+#include "platform/local_country_file.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace track_analyzing
+{
+/// \brief Matches tracks to road segments by a hidden Markov model, see "Hidden Markov Map Matching
+/// Through Noise and Sparseness" by Newson and Krumm. States of a track point are road segments near it,
+/// emission probability depends on the distance from the point to the segment and transition probability
+/// depends on the difference between the route distance and the great circle distance of consecutive points.
+/// The most probable segments of the whole track are found by ViterbiDecoder, so an ambiguous point
+/// is matched by the points after it too.
+/// Roads are loaded once for all the points in kNearbyRoadsRange, not for every point.
+/// \note The matcher is used by one thread, it doesn't need Storage, so matchers of different threads
+/// may be created for the same mwm.
+class HmmTrackMatcher final
+{
+public:
+  HmmTrackMatcher(platform::LocalCountryFile const & localCountryFile, routing::NumMwmId mwmId);
+
+  /// \brief Appends parts of |track| which are matched to |matchedTracks|. A track is split
+  /// on points without segments nearby and on points which can't be reached from the previous ones.
+  void MatchTrack(std::vector<DataPoint> const & track, std::vector<MatchedTrack> & matchedTracks);
+
+  routing::NumMwmId GetMwmId() const { return m_mwmId; }
+  uint64_t GetTracksCount() const { return m_tracksCount; }
+  uint64_t GetPointsCount() const { return m_pointsCount; }
+  uint64_t GetNonMatchedPointsCount() const { return m_nonMatchedPointsCount; }
+  uint64_t GetNearbyRoadsLoadsCount() const { return m_nearbyRoadsLoadsCount; }
+
+private:
+  struct Candidate
+  {
+    routing::Segment m_segment;
+    // Distance from the point to the segment in meters.
+    double m_distance = 0.0;
+    // Distance from the segment start to the projection of the point in meters.
+    double m_offset = 0.0;
+  };
+
+  struct NearbyRoad
+  {
+    uint32_t m_featureId = 0;
+    bool m_oneWay = false;
+    m2::RectD m_rect;
+    std::vector<m2::PointD> m_points;
+  };
+
+  using Queue = std::priority_queue<std::pair<double, routing::Segment>,
+                                    std::vector<std::pair<double, routing::Segment>>, std::greater<>>;
+
+  void FillCandidates(m2::PointD const & point, std::vector<Candidate> & candidates);
+  void LoadNearbyRoads(m2::PointD const & point);
+  // Fills |transitions| of all the pairs of |from| and |to| candidates, |from| index is the major one.
+  void CalcTransitions(DataPoint const & fromPoint, DataPoint const & toPoint, std::vector<Candidate> const & from,
+                       std::vector<Candidate> const & to, std::vector<double> & transitions);
+  // Fills route distances from |from| to |to| candidates which are not longer than |maxDistance|,
+  // the others are infinite.
+  void CalcRouteDistances(Candidate const & from, std::vector<Candidate> const & to, double maxDistance,
+                          std::vector<double> & distances);
+  double GetSegmentLength(routing::Segment const & segment) const;
+
+  routing::NumMwmId const m_mwmId;
+  FrozenDataSource m_dataSource;
+  std::shared_ptr<routing::VehicleModelInterface> m_vehicleModel;
+  std::unique_ptr<routing::IndexGraph> m_graph;
+  ViterbiDecoder m_decoder;
+
+  // Roads of |m_nearbyRect|, candidates of a point are taken from them if its matching rect is inside.
+  m2::RectD m_nearbyRect;
+  std::vector<NearbyRoad> m_nearbyRoads;
+
+  // Buffers of CalcRouteDistances().
+  Queue m_queue;
+  std::unordered_map<routing::Segment, double> m_distances;
+  routing::IndexGraph::SegmentEdgeListT m_edges;
+
+  uint64_t m_tracksCount = 0;
+  uint64_t m_pointsCount = 0;
+  uint64_t m_nonMatchedPointsCount = 0;
+  uint64_t m_nearbyRoadsLoadsCount = 0;
+};
+}  // namespace track_analyzing
@@ -1,6 +1,7 @@
 #include "track_analyzing/track_analyzer/utils.hpp"
 
 #include "track_analyzing/serialization.hpp"
+#include "track_analyzing/hmm_track_matcher.hpp"
 #include "track_analyzing/track.hpp"
 #include "track_analyzing/track_analyzer/utils.hpp"
 #include "track_analyzing/track_matcher.hpp"
@@ -23,10 +24,13 @@
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <exception>
+#include <map>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 using namespace routing;
 using namespace std;
@@ -86,22 +90,122 @@ void MatchTracks(MwmToTracks const & mwmToTracks, storage::Storage const & stora
 
   ForTracksSortedByMwmName(mwmToTracks, numMwmIds, processMwm);
 
-  LOG(LINFO, ("Matching finished, elapsed:", timer.ElapsedSeconds(), "seconds, tracks:", tracksCount,
-              ", points:", pointsCount, ", non matched points:", nonMatchedPointsCount));
+  double const elapsed = timer.ElapsedSeconds();
+  LOG(LINFO, ("Matching finished, elapsed:", elapsed, "seconds, tracks:", tracksCount, ", points:", pointsCount,
+              ", non matched points:", nonMatchedPointsCount, ", points per second:", pointsCount / elapsed));
+}
+
+// Matches tracks by HmmTrackMatcher in |threadsCount| threads. Tracks of all the mwms are in one queue,
+// a thread takes the next track as soon as it has matched the previous one, so threads don't wait
+// for each other on long tracks and large mwms. The queue is sorted by mwms and a thread keeps
+// the matcher of its last mwm, long tracks of an mwm go first.
+void MatchTracksInParallel(MwmToTracks const & mwmToTracks, storage::Storage const & storage,
+                           NumMwmIds const & numMwmIds, size_t threadsCount, MwmToMatchedTracks & mwmToMatchedTracks)
+{
+  CHECK_GREATER(threadsCount, 0, ());
+  base::Timer timer;
+
+  struct Task
+  {
+    NumMwmId m_mwmId;
+    string const * m_user;
+    Track const * m_track;
+    vector<MatchedTrack> m_matchedTracks;
+  };
+
+  // Storage is used by the main thread only, so the local files are found beforehand.
+  map<NumMwmId, LocalFilePtr> localFiles;
+  vector<Task> tasks;
+  ForTracksSortedByMwmName(mwmToTracks, numMwmIds, [&](string const & mwmName, UserToTrack const & userToTrack)
+  {
+    auto const countryFile = platform::CountryFile(mwmName);
+    auto const mwmId = numMwmIds.GetId(countryFile);
+    auto localFile = storage.GetLatestLocalFile(countryFile);
+    CHECK(localFile, ("Can't find latest country file for", mwmName));
+    localFiles[mwmId] = std::move(localFile);
+
+    size_t const begin = tasks.size();
+    for (auto const & [user, track] : userToTrack)
+      tasks.push_back({mwmId, &user, &track, {}});
+    sort(tasks.begin() + begin, tasks.end(),
+         [](Task const & lhs, Task const & rhs) { return lhs.m_track->size() > rhs.m_track->size(); });
+  });
+
+  atomic<size_t> nextTask = 0;
+  atomic<uint64_t> tracksCount = 0;
+  atomic<uint64_t> pointsCount = 0;
+  atomic<uint64_t> nonMatchedPointsCount = 0;
+  atomic<uint64_t> nearbyRoadsLoadsCount = 0;
+
+  auto const matchTasks = [&]()
+  {
+    unique_ptr<HmmTrackMatcher> matcher;
+    auto const addCounters = [&]()
+    {
+      if (!matcher)
+        return;
+      tracksCount += matcher->GetTracksCount();
+      pointsCount += matcher->GetPointsCount();
+      nonMatchedPointsCount += matcher->GetNonMatchedPointsCount();
+      nearbyRoadsLoadsCount += matcher->GetNearbyRoadsLoadsCount();
+    };
+
+    for (size_t i = nextTask++; i < tasks.size(); i = nextTask++)
+    {
+      Task & task = tasks[i];
+      if (!matcher || matcher->GetMwmId() != task.m_mwmId)
+      {
+        addCounters();
+        matcher = make_unique<HmmTrackMatcher>(*localFiles.at(task.m_mwmId), task.m_mwmId);
+      }
+
+      try
+      {
+        matcher->MatchTrack(*task.m_track, task.m_matchedTracks);
+      }
+      catch (RootException const & e)
+      {
+        LOG(LERROR, ("Can't match track for mwm:", numMwmIds.GetFile(task.m_mwmId).GetName(), ", user:",
+                     *task.m_user));
+        LOG(LERROR, ("  ", e.what()));
+      }
+    }
+    addCounters();
+  };
+
+  vector<thread> threads;
+  for (size_t i = 0; i + 1 < threadsCount; ++i)
+    threads.emplace_back(matchTasks);
+  matchTasks();
+  for (auto & t : threads)
+    t.join();
+
+  for (auto & task : tasks)
+    if (!task.m_matchedTracks.empty())
+      mwmToMatchedTracks[task.m_mwmId][*task.m_user] = std::move(task.m_matchedTracks);
+
+  double const elapsed = timer.ElapsedSeconds();
+  LOG(LINFO, ("Matching finished, elapsed:", elapsed, "seconds, threads:", threadsCount, ", tracks:", tracksCount,
+              ", points:", pointsCount, ", non matched points:", nonMatchedPointsCount,
+              ", nearby roads loads:", nearbyRoadsLoadsCount, ", points per second:", pointsCount / elapsed,
+              ", points per second per thread:", pointsCount / elapsed / threadsCount));
 }
 }  // namespace
 
 namespace track_analyzing
 {
 void CmdMatch(string const & logFile, string const & trackFile, shared_ptr<NumMwmIds> const & numMwmIds,
-              Storage const & storage, Stats & stats)
+              Storage const & storage, bool hmm, size_t threadsCount, Stats & stats)
 {
   MwmToTracks mwmToTracks;
   ParseTracks(logFile, numMwmIds, mwmToTracks);
   stats.AddTracksStats(mwmToTracks, *numMwmIds, storage);
 
   MwmToMatchedTracks mwmToMatchedTracks;
-  MatchTracks(mwmToTracks, storage, *numMwmIds, mwmToMatchedTracks);
+  if (hmm)
+    MatchTracksInParallel(mwmToTracks, storage, *numMwmIds, threadsCount, mwmToMatchedTracks);
+  else
+    MatchTracks(mwmToTracks, storage, *numMwmIds, mwmToMatchedTracks);
 
   FileWriter writer(trackFile, FileWriter::OP_WRITE_TRUNCATE);
   MwmToMatchedTracksSerializer serializer(numMwmIds);
@@ -109,7 +213,8 @@ void CmdMatch(string const & logFile, string const & trackFile, shared_ptr<NumMw
   LOG(LINFO, ("Matched tracks were saved to", trackFile));
 }
 
-void CmdMatch(string const & logFile, string const & trackFile, string const & inputDistribution)
+void CmdMatch(string const & logFile, string const & trackFile, string const & inputDistribution, bool hmm,
+              size_t threadsCount)
 {
   LOG(LINFO, ("Matching", logFile));
   Storage storage;
@@ -117,12 +222,14 @@ void CmdMatch(string const & logFile, string const & trackFile, string const & i
   shared_ptr<NumMwmIds> numMwmIds = CreateNumMwmIds(storage);
 
   Stats stats;
-  CmdMatch(logFile, trackFile, numMwmIds, storage, stats);
+  if (threadsCount == 0)
+    threadsCount = max(thread::hardware_concurrency(), 1U);
+  CmdMatch(logFile, trackFile, numMwmIds, storage, hmm, threadsCount, stats);
   stats.SaveMwmDistributionToCsv(inputDistribution);
   stats.Log();
 }
 
-void UnzipAndMatch(Iter begin, Iter end, string const & trackExt, Stats & stats)
+void UnzipAndMatch(Iter begin, Iter end, string const & trackExt, bool hmm, Stats & stats)
 {
   Storage storage;
   storage.RegisterAllLocalMaps();
@@ -158,12 +265,13 @@ void UnzipAndMatch(Iter begin, Iter end, string const & trackExt, Stats & stats)
       continue;
     }
 
-    CmdMatch(file, file + trackExt, numMwmIds, storage, stats);
+    // Files are matched in parallel, so every file is matched by one thread.
+    CmdMatch(file, file + trackExt, numMwmIds, storage, hmm, 1 /* threadsCount */, stats);
     FileWriter::DeleteFileX(file);
   }
 }
 
-void CmdMatchDir(string const & logDir, string const & trackExt, string const & inputDistribution)
+void CmdMatchDir(string const & logDir, string const & trackExt, string const & inputDistribution, bool hmm)
 {
   LOG(LINFO, ("Matching dir:", logDir, ". Input distribution will be saved to:", inputDistribution));
   Platform::EFileType fileType = Platform::EFileType::Unknown;
@@ -207,11 +315,11 @@ void CmdMatchDir(string const & logDir, string const & trackExt, string const &
   for (size_t i = 0; i < threadsCount - 1; ++i)
   {
     auto end = begin + blockSize;
-    threads[i] = thread(UnzipAndMatch, begin, end, trackExt, ref(stats[i]));
+    threads[i] = thread(UnzipAndMatch, begin, end, trackExt, hmm, ref(stats[i]));
     begin = end;
   }
 
-  UnzipAndMatch(begin, filesList.end(), trackExt, ref(stats[threadsCount - 1]));
+  UnzipAndMatch(begin, filesList.end(), trackExt, hmm, ref(stats[threadsCount - 1]));
   for (auto & t : threads)
     t.join();
 
@@ -74,6 +74,13 @@ DEFINE_double(min_speed, 15.0, "minimum track average speed in km/hour");
 DEFINE_double(max_speed, 110.0, "maximum track average speed in km/hour");
 DEFINE_bool(ignore_traffic, true, "ignore tracks with traffic data");
 
+DEFINE_bool(hmm, false,
+            "match tracks by hidden Markov model with route distances between points instead of greedy matching. "
+            "It may be used with match and match_dir commands.");
+DEFINE_uint64(matching_threads, 0,
+              "number of threads to match tracks by hidden Markov model with match command, "
+              "0 means hardware concurrency.");
+
 size_t Checked_track()
 {
   if (FLAGS_track < 0)
@@ -97,10 +104,12 @@ namespace track_analyzing
 {
 // Print the specified track in C++ form that you can copy paste to C++ source for debugging.
 void CmdCppTrack(string const & trackFile, string const & mwmName, string const & user, size_t trackIdx);
-// Match raw gps logs to tracks.
-void CmdMatch(string const & logFile, string const & trackFile, string const & inputDistribution);
+// Match raw gps logs to tracks. Tracks are matched by hidden Markov model in |threadsCount| threads
+// if |hmm|, 0 threads means hardware concurrency.
+void CmdMatch(string const & logFile, string const & trackFile, string const & inputDistribution, bool hmm,
+              size_t threadsCount);
 // The same as match but applies for the directory with raw logs.
-void CmdMatchDir(string const & logDir, string const & trackExt, string const & inputDistribution);
+void CmdMatchDir(string const & logDir, string const & trackExt, string const & inputDistribution, bool hmm);
 // Parse |logFile| and save tracks (mwm name, aloha id, lats, lons, timestamps in seconds in csv).
 void CmdUnmatchedTracks(string const & logFile, string const & trackFileCsv);
 // Print aggregated tracks to csv table.
@@ -127,12 +136,13 @@ int main(int argc, char ** argv)
     if (cmd == "match")
     {
       string const & logFile = Checked_in();
-      CmdMatch(logFile, FLAGS_out.empty() ? logFile + ".track" : FLAGS_out, FLAGS_input_distribution);
+      CmdMatch(logFile, FLAGS_out.empty() ? logFile + ".track" : FLAGS_out, FLAGS_input_distribution, FLAGS_hmm,
+               static_cast<size_t>(FLAGS_matching_threads));
     }
     else if (cmd == "match_dir")
     {
       string const & logDir = Checked_in();
-      CmdMatchDir(logDir, FLAGS_track_extension, FLAGS_input_distribution);
+      CmdMatchDir(logDir, FLAGS_track_extension, FLAGS_input_distribution, FLAGS_hmm);
     }
     else if (cmd == "unmatched_tracks")
     {
@@ -0,0 +1,55 @@
+#include "testing/testing.hpp"
+
+#include "track_analyzing/viterbi_decoder.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+using namespace std;
+using namespace track_analyzing;
+
+double constexpr kImpossible = ViterbiDecoder::kImpossible;
+
+UNIT_TEST(ViterbiDecoderOneStepTest)
+{
+  ViterbiDecoder decoder;
+  decoder.Start({-2.0, -1.0, kImpossible});
+  TEST_EQUAL(decoder.GetStepsCount(), 1, ());
+  TEST_EQUAL(decoder.GetPath(), vector<size_t>({1}), ());
+}
+
+// The nearest state of the first step is not chosen because the next steps can't be reached from it.
+UNIT_TEST(ViterbiDecoderNextStepsTest)
+{
+  ViterbiDecoder decoder;
+  decoder.Start({-0.1, -1.0});
+
+  auto const straight = [](size_t from, size_t to) { return from == to ? 0.0 : -5.0; };
+  auto const fromSecond = [](size_t from, size_t to) { return from == 1 && to == 0 ? 0.0 : kImpossible; };
+  TEST(decoder.Step({-0.5, -0.5}, straight), ());
+  TEST(decoder.Step({-1.0}, fromSecond), ());
+
+  TEST_EQUAL(decoder.GetStepsCount(), 3, ());
+  TEST_EQUAL(decoder.GetPath(), vector<size_t>({1, 1, 0}), ());
+}
+
+UNIT_TEST(ViterbiDecoderUnreachableStepTest)
+{
+  ViterbiDecoder decoder;
+  decoder.Start({-1.0, -2.0});
+
+  auto const impossible = [](size_t, size_t) { return kImpossible; };
+  TEST(!decoder.Step({-1.0, -1.0}, impossible), ());
+  // A state with impossible emission is not reachable too.
+  TEST(!decoder.Step({kImpossible}, [](size_t, size_t) { return 0.0; }), ());
+  TEST_EQUAL(decoder.GetStepsCount(), 1, ());
+  TEST_EQUAL(decoder.GetPath(), vector<size_t>({0}), ());
+
+  // The decoder is restarted after an unreachable step.
+  decoder.Start({kImpossible, -3.0, -1.0});
+  TEST(decoder.Step({-1.0, -1.0}, [](size_t from, size_t to) { return from == 1 ? 0.0 : -10.0; }), ());
+  TEST_EQUAL(decoder.GetPath(), vector<size_t>({1, 0}), ());
+}
+}  // namespace
@@ -0,0 +1,30 @@
+#include "track_analyzing/viterbi_decoder.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace track_analyzing
+{
+using namespace std;
+
+void ViterbiDecoder::Start(vector<double> const & emissions)
+{
+  CHECK(!emissions.empty(), ());
+
+  m_scores = emissions;
+  m_parents.clear();
+  m_parents.emplace_back();
+}
+
+vector<size_t> ViterbiDecoder::GetPath() const
+{
+  CHECK(!m_parents.empty(), ("Start() is not called."));
+
+  vector<size_t> path(m_parents.size());
+  path.back() = static_cast<size_t>(distance(m_scores.cbegin(), max_element(m_scores.cbegin(), m_scores.cend())));
+  for (size_t i = path.size() - 1; i > 0; --i)
+    path[i - 1] = m_parents[i][path[i]];
+
+  return path;
+}
+}  // namespace track_analyzing
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "base/assert.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace track_analyzing
+{
+/// \brief Viterbi decoding of a hidden Markov model: finds the most probable states of a sequence
+/// of steps. Probabilities are logarithms, kImpossible is the logarithm of zero probability.
+class ViterbiDecoder final
+{
+public:
+  static double constexpr kImpossible = -std::numeric_limits<double>::infinity();
+
+  /// \brief Starts a new sequence with the first step, |emissions| are probabilities of its states.
+  void Start(std::vector<double> const & emissions);
+
+  /// \brief Adds the next step of the sequence.
+  /// \param emissions are probabilities of the states of the step.
+  /// \param transition(from, to) returns probability of the transition from state |from| of the previous step
+  /// to state |to| of the step.
+  /// \returns false and doesn't add the step if none of its states is reachable from the previous step.
+  template <typename Transition>
+  bool Step(std::vector<double> const & emissions, Transition && transition);
+
+  size_t GetStepsCount() const { return m_parents.size(); }
+
+  /// \returns the most probable states of all the steps added since Start().
+  std::vector<size_t> GetPath() const;
+
+private:
+  std::vector<double> m_scores;
+  std::vector<double> m_nextScores;
+  // Best previous state for every state of every step, the first step has no parents.
+  std::vector<std::vector<uint32_t>> m_parents;
+};
+
+template <typename Transition>
+bool ViterbiDecoder::Step(std::vector<double> const & emissions, Transition && transition)
+{
+  CHECK(!m_parents.empty(), ("Start() is not called."));
+
+  std::vector<uint32_t> parents(emissions.size(), 0);
+  m_nextScores.assign(emissions.size(), kImpossible);
+  bool reachable = false;
+  for (size_t to = 0; to < emissions.size(); ++to)
+  {
+    if (emissions[to] == kImpossible)
+      continue;
+
+    for (size_t from = 0; from < m_scores.size(); ++from)
+    {
+      if (m_scores[from] == kImpossible)
+        continue;
+
+      double const probability = transition(from, to);
+      if (probability == kImpossible)
+        continue;
+
+      double const score = m_scores[from] + probability + emissions[to];
+      if (score > m_nextScores[to])
+      {
+        m_nextScores[to] = score;
+        parents[to] = static_cast<uint32_t>(from);
+        reachable = true;
+      }
+    }
+  }
+
+  if (!reachable)
+    return false;
+
+  m_scores.swap(m_nextScores);
+  m_parents.push_back(std::move(parents));
+  return true;
+}
+}  // namespace track_analyzing